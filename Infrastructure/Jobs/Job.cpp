@@ -213,6 +213,9 @@ istream& operator>>(istream& input, Job** job)
         case Job::VISION_SAVE_IMAGES:
             *job = new SaveImagesJob(input);
             break;
+        case Job::VISION_SUBSAMPLE_IMAGE:
+            *job = new SubsampleImageJob(input);
+            break;
         default:
             errorlog << "Job::operator>>. UNKNOWN JOBID: " << jobid << ". Your stream might never recover :(" << endl;
             break;
@@ -52,6 +52,7 @@ public:
         // Vision job ids
         VISION_LOAD_LUT,
         VISION_SAVE_IMAGES,
+        VISION_SUBSAMPLE_IMAGE,
         // Localisation job ids
         LOCALISATION_RESET,
         // Behaviour job ids
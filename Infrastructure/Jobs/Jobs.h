@@ -30,6 +30,7 @@
 
 #include "VisionJob.h"
 #include "VisionJobs/SaveImagesJob.h"
+#include "VisionJobs/SubsampleImageJob.h"
 
 #include "LocalisationJob.h"
 #include "BehaviourJob.h"
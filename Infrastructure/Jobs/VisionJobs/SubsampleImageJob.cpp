@@ -0,0 +1,114 @@
+/*! @file SubsampleImageJob.cpp
+    @brief Implementation of SubsampleImageJob class
+
+ This file is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This file is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SubsampleImageJob.h"
+#include "debug.h"
+#include "debugverbosityjobs.h"
+
+/*! @brief Constructs a SubsampleImageJob
+
+    @param factor the subsampling factor, 2 for half resolution, 4 for quarter resolution and 1 for full resolution
+ */
+SubsampleImageJob::SubsampleImageJob(unsigned int factor) : VisionJob(Job::VISION_SUBSAMPLE_IMAGE)
+{
+    m_factor = factor;
+}
+
+/*! @brief Constructs a SubsampleImageJob from stream data
+    @param input the stream from which to make a SubsampleImageJob
+
+    Remember that only members introduced at this level are read at this level.
+ */
+SubsampleImageJob::SubsampleImageJob(istream& input) : VisionJob(Job::VISION_SUBSAMPLE_IMAGE)
+{
+    m_job_time = 0;
+    // Temporary read buffers
+    unsigned int uintbuffer;
+
+    // read in the m_factor unsigned int
+    input.read(reinterpret_cast<char*>(&uintbuffer), sizeof(uintbuffer));
+    m_factor = uintbuffer;
+}
+
+/*! @brief SubsampleImageJob destructor
+ */
+SubsampleImageJob::~SubsampleImageJob()
+{
+}
+
+/*! @brief Returns the subsampling factor, 1 for full resolution
+ */
+unsigned int SubsampleImageJob::getFactor()
+{
+    return m_factor;
+}
+
+/*! @brief Prints a human-readable summary to the stream
+ @param output the stream to be written to
+ */
+void SubsampleImageJob::summaryTo(ostream& output)
+{
+    output << "SubsampleImageJob: " << m_job_time << " " << m_factor << endl;
+}
+
+/*! @brief Prints a csv version to the stream
+ @param output the stream to be written to
+ */
+void SubsampleImageJob::csvTo(ostream& output)
+{
+    output << "SubsampleImageJob, " << m_job_time << ", " << m_factor << ", " << endl;
+}
+
+/*! @brief A helper function to ease writing Job objects to classes
+
+    This function calls its parents versions of the toStream, each parent
+    writes the members introduced at that level
+
+    @param output the stream to write the job to
+ */
+void SubsampleImageJob::toStream(ostream& output) const
+{
+    Job::toStream(output);                  // This writes data introduced at the base level
+    VisionJob::toStream(output);            // This writes data introduced at the vision level
+                                            // Then we write SubsampleImageJob specific data
+    output.write((char*) &m_factor, sizeof(m_factor));
+}
+
+/*! @relates SubsampleImageJob
+    @brief Stream insertion operator for a SubsampleImageJob
+
+    @param output the stream to write to
+    @param job the job to be written to the stream
+ */
+ostream& operator<<(ostream& output, const SubsampleImageJob& job)
+{
+    job.toStream(output);
+    return output;
+}
+
+/*! @relates SubsampleImageJob
+    @brief Stream insertion operator for a pointer to SubsampleImageJob
+
+    @param output the stream to write to
+    @param job the job to be written to the stream
+ */
+ostream& operator<<(ostream& output, const SubsampleImageJob* job)
+{
+    if (job != NULL)
+        job->toStream(output);
+    return output;
+}
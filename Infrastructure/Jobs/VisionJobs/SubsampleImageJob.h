@@ -0,0 +1,52 @@
+/*! @file SubsampleImageJob.h
+    @brief Declaration of SubsampleImageJob class.
+
+    @class SubsampleImageJob
+    @brief A job to set the resolution the vision system searches the image at.
+
+    With a factor of 2 or 4 the image is classified at half or quarter resolution first and only
+    refined at full resolution near colour boundaries, which is enough for coarse ball and goal
+    tracking while walking fast. A factor of 1 returns to full resolution. The field objects are
+    reported in full resolution coordinates either way.
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SUBSAMPLEIMAGEJOB_H
+#define SUBSAMPLEIMAGEJOB_H
+
+#include "../VisionJob.h"
+
+class SubsampleImageJob : public VisionJob
+{
+public:
+    SubsampleImageJob(unsigned int factor);
+    SubsampleImageJob(istream& input);
+    virtual ~SubsampleImageJob();
+
+    unsigned int getFactor();
+
+    virtual void summaryTo(ostream& output);
+    virtual void csvTo(ostream& output);
+
+    friend ostream& operator<<(ostream& output, const SubsampleImageJob& job);
+    friend ostream& operator<<(ostream& output, const SubsampleImageJob* job);
+protected:
+    virtual void toStream(ostream& output) const;
+private:
+    unsigned int m_factor;      //!< the number of full resolution pixels between the coarse pixels, 1 for full resolution
+};
+
+#endif
+
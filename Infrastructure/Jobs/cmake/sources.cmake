@@ -24,6 +24,7 @@ SET (YOUR_SRCS  JobList.cpp JobList.h
 		Job.cpp Job.h
 		VisionJob.h
 		VisionJobs/SaveImagesJob.h VisionJobs/SaveImagesJob.cpp
+		VisionJobs/SubsampleImageJob.h VisionJobs/SubsampleImageJob.cpp
 		LocalisationJob.h
 		BehaviourJob.h
 		MotionJob.cpp MotionJob.h
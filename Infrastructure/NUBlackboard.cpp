@@ -22,6 +22,7 @@
 #include "NUBlackboard.h"
 
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUSensorsData/SensorSnapshots.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/FieldObjects/FieldObjects.h"
@@ -38,6 +39,7 @@ NUBlackboard::NUBlackboard()
 {
     Blackboard = this;
     Sensors = 0;
+    SensorHistory = 0;
     Actions = 0;
     Image = 0;
     CameraSpecs = 0;
@@ -56,6 +58,8 @@ NUBlackboard::~NUBlackboard()
 {
     delete Sensors;
     Sensors = 0;
+    delete SensorHistory;
+    SensorHistory = 0;
     delete Actions;
     Actions = 0;
     delete Image;
@@ -84,6 +88,16 @@ void NUBlackboard::add(NUSensorsData* sensorsdata)
     delete oldsensors;
 }
 
+/*! @brief Adds a SensorSnapshots object to the blackboard. Note that ownership of the object is now with the Blackboard. 
+    @param snapshots a pointer to the new sensor snapshots
+ */
+void NUBlackboard::add(SensorSnapshots* snapshots)
+{
+    SensorSnapshots* oldsnapshots = SensorHistory;
+    SensorHistory = snapshots;
+    delete oldsnapshots;
+}
+
 /*! @brief Adds a NUActionatorsData object to the blackboard. Note that ownership of the object is now with the Blackboard. 
     @param actionsdata a pointer to the new actions data
  */
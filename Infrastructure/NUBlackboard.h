@@ -36,12 +36,13 @@
 
 
 #include "NUPlatform/NUCamera/NUCameraData.h"
-#include "Vision/VisionTypes/segmentedregion.h"
+#include "Vision/VisionTypes/coloursegment.h"
 #include "ConfigSystem/ConfigManager.h"
 using ConfigSystem::ConfigManager;
 
 
 class NUSensorsData;
+class SensorSnapshots;
 class NUActionatorsData;
 class NUImage;
 class FieldObjects;
@@ -58,6 +59,7 @@ public:
     ~NUBlackboard();
     
     void add(NUSensorsData* sensorsdata);
+    void add(SensorSnapshots* snapshots);
     void add(NUActionatorsData* actionsdata);
     void add(NUImage* image);
     void add(NUCameraData* camdata);
@@ -69,6 +71,7 @@ public:
     
 public:
     NUSensorsData* Sensors;
+    SensorSnapshots* SensorHistory;     /// The recent sensor data published by the SenseMoveThread, for reading in other threads
     NUActionatorsData* Actions;
     NUImage* Image;
     NUCameraData* CameraSpecs;
@@ -82,8 +85,8 @@ public:
     bool lookForFieldPoints;    /// Enables vision processing for lines, corners and the centre circle
     bool lookForObstacles;      /// Enables vision processing for obstacles
 
-    SegmentedRegion horizontalScans;    // For NUBugger
-    SegmentedRegion verticalScans;      // For NUBugger
+    vector<vector<ColourSegment> > horizontalScans;    // For NUBugger (copied out of the vision frame arena)
+    vector<vector<ColourSegment> > verticalScans;      // For NUBugger (copied out of the vision frame arena)
 };
 
 extern NUBlackboard* Blackboard;
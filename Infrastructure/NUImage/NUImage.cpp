@@ -2,20 +2,25 @@
 #include <cstring>
 #include <string>
 #include "ColorModelConversions.h"
+#include "debug.h"
 /*!
 @file NUImage.h
 @brief Declaration of NUbots NUImage class. Storage class for images.
 */
 
-NUImage::NUImage(): m_imageWidth(0), m_imageHeight(0), m_usingInternalBuffer(false)
+unsigned int NUImage::s_deep_copy_count = 0;
+
+NUImage::NUImage(): m_imageWidth(0), m_imageHeight(0), m_usingInternalBuffer(false), m_readOnly(false)
 {
-    m_image = 0;
+    m_data = 0;
+    m_stride = 0;
     flipped = false;
 }
 
-NUImage::NUImage(int width, int height, bool useInternalBuffer): m_imageWidth(width), m_imageHeight(height), m_usingInternalBuffer(useInternalBuffer)
+NUImage::NUImage(int width, int height, bool useInternalBuffer): m_imageWidth(width), m_imageHeight(height), m_usingInternalBuffer(useInternalBuffer), m_readOnly(false)
 {
-    m_image = 0;
+    m_data = 0;
+    m_stride = width;
     if(m_usingInternalBuffer)
     {
         addInternalBuffer(width, height);
@@ -23,45 +28,38 @@ NUImage::NUImage(int width, int height, bool useInternalBuffer): m_imageWidth(wi
     flipped = false;
 }
 
-NUImage::NUImage(const NUImage& source): TimestampedData(), m_imageWidth(0), m_imageHeight(0), m_usingInternalBuffer(false)
+NUImage::NUImage(const NUImage& source): TimestampedData(), m_imageWidth(0), m_imageHeight(0), m_usingInternalBuffer(false), m_readOnly(false)
 {
-    m_image = 0;
+    __sync_add_and_fetch(&s_deep_copy_count, 1);
+    m_data = 0;
+    m_stride = 0;
     int sourceWidth = source.getWidth();
     int sourceHeight = source.getHeight();
     setImageDimensions(sourceWidth, sourceHeight);
     useInternalBuffer(true);
     m_timestamp = source.m_timestamp;
-    for(int y = 0; y < sourceHeight; y++)
-    {
-        memcpy ( &m_image[y][0], &source.m_image[y][0], sizeof(source.m_image[y][0])*sourceWidth);
-    }
+    copyRows(source);
     flipped = source.flipped;
 }
 
 NUImage::~NUImage()
 {
+    checkViews("NUImage::~NUImage()");
     if (m_usingInternalBuffer)
     {
         removeInternalBuffer();
     }
-    else
-    {
-        delete [] m_image;
-        m_image = 0;
-    }
 }
 
 void NUImage::copyFromExisting(const NUImage& source)
 {
+    checkViews("NUImage::copyFromExisting()");
+    __sync_add_and_fetch(&s_deep_copy_count, 1);
     int sourceWidth = source.getWidth();
     int sourceHeight = source.getHeight();
     setImageDimensions(sourceWidth, sourceHeight);
     useInternalBuffer(true);
-
-    for(int y = 0; y < sourceHeight; y++)
-    {
-        memcpy ( &m_image[y][0], &source.m_image[y][0], sizeof(source.m_image[y][0])*sourceWidth);
-    }
+    copyRows(source);
     m_timestamp = source.m_timestamp;
     flipped = source.flipped;
 }
@@ -77,11 +75,31 @@ void NUImage::cloneExisting(const NUImage& source)
     }
     else
     {
-        MapYUV422BufferToImage((unsigned char*)&source.m_image[0][0], sourceWidth*2, sourceHeight*2, source.flipped);
+        checkViews("NUImage::cloneExisting()");
+        useInternalBuffer(false);
+        mapBuffer(source.m_data, sourceWidth, sourceHeight, source.m_stride);
+        m_readOnly = source.m_readOnly;
+        flipped = source.flipped;
     }
     m_timestamp = source.m_timestamp;
 }
 
+void NUImage::copyRows(const NUImage& source)
+{
+    int width = source.getWidth();
+    int height = source.getHeight();
+    if(m_stride == width && source.m_stride == width)
+    {
+        // both buffers are contiguous, copy in one go
+        memcpy(m_data, source.m_data, sizeof(Pixel)*width*height);
+        return;
+    }
+    for(int y = 0; y < height; y++)
+    {
+        memcpy(m_data + y*m_stride, source.getRow(y), sizeof(Pixel)*width);
+    }
+}
+
 void NUImage::useInternalBuffer(bool newCondition)
 {
     if(m_usingInternalBuffer == newCondition) return;
@@ -96,13 +114,21 @@ void NUImage::useInternalBuffer(bool newCondition)
     }
 }
 
+void NUImage::checkViews(const char* caller) const
+{
+    int views = getViewCount();
+    if(views != 0)
+    {
+        errorlog << caller << " - WARNING - " << views << " views still reference the image." << std::endl;
+    }
+}
+
 void NUImage::removeInternalBuffer()
 {
     if (m_usingInternalBuffer)
     {
-        delete [] m_image;
         delete [] m_localBuffer;
-        m_image = 0;
+        m_data = 0;
         m_localBuffer = 0;
     }
     m_usingInternalBuffer = false;
@@ -111,7 +137,7 @@ void NUImage::removeInternalBuffer()
 void NUImage::addInternalBuffer(int width, int height)
 {
     Pixel* buffer = allocateBuffer(width, height);
-    MapBufferToImage(buffer, width, height);
+    mapBuffer(buffer, width, height, width);
     m_usingInternalBuffer = true;
 }
 
@@ -124,36 +150,17 @@ Pixel* NUImage::allocateBuffer(int width, int height)
 
 void NUImage::MapYUV422BufferToImage(const unsigned char* buffer, int width, int height, bool flip)
 {
+    checkViews("NUImage::MapYUV422BufferToImage()");
     useInternalBuffer(false);
-    int arrayWidth = width;
-    // halve the width and height since we want to skip
-    width /= 2;
-    height /= 2;
-    Pixel* pixelisedBuffer = (Pixel*) buffer;
-    if(height != this->getHeight())
-    {
-        delete [] m_image;
-        m_image = 0;
-    }
-    if(m_image == 0)
-    {
-        //Allocate memory for array of elements of column
-        m_image = new Pixel*[height];
-    }
-    // Now point the pointers in the right place
-    int pixelIndex = 0;
-    for( int i = 0; i < height; ++i)
-    {
-        m_image[i] = &pixelisedBuffer[pixelIndex];
-        pixelIndex += arrayWidth;
-    }
-    m_imageWidth = width;
-    m_imageHeight = height;
+    // halve the width and height since we want to skip every second pixel and row,
+    // each Pixel covers two YUV422 pixels so a whole buffer row is skipped by stepping width Pixels
+    mapBuffer((Pixel*) buffer, width/2, height/2, width);
     flipped = flip;
 }
 
 void NUImage::CopyFromYUV422Buffer(const unsigned char* buffer, int width, int height)
 {
+    checkViews("NUImage::CopyFromYUV422Buffer()");
     width /= 2;
     height /= 2;
     setImageDimensions(width, height);
@@ -163,33 +170,76 @@ void NUImage::CopyFromYUV422Buffer(const unsigned char* buffer, int width, int h
     {
        for(int x = 0; x < width; x++)
        {
-           this->m_image[y][x] = pixelisedBuffer[y*width*2 + x];
+           m_data[y*m_stride + x] = pixelisedBuffer[y*width*2 + x];
        }
     }
     return;
 }
 
-void NUImage::MapBufferToImage(Pixel* buffer, int width, int height)
+size_t NUImage::MapStreamedImage(const char* frame, size_t size)
 {
-    if(height != this->getHeight())
-    {
-        delete [] m_image;
-        m_image = 0;
-    }
-    if(m_image == 0)
-    {
-        //Allocate memory for array of elements of column
-        m_image = new Pixel*[height];
-    }
-    // Now point the pointers in the right place
-    int pixelIndex = 0;
-    for( int i = 0; i < height; ++i)
+    Header header;
+    int width, height;
+    double timestamp;
+    bool flip = false;
+    size_t offset = sizeof(header) + sizeof(width) + sizeof(height) + sizeof(timestamp);
+    if(size < offset)
+        return 0;
+    memcpy(&header, frame, sizeof(header));
+    if(!validHeader(header))
+        return 0;
+    memcpy(&width, frame + sizeof(header), sizeof(width));
+    memcpy(&height, frame + sizeof(header) + sizeof(width), sizeof(height));
+    memcpy(&timestamp, frame + sizeof(header) + sizeof(width) + sizeof(height), sizeof(timestamp));
+    if(header.version >= VERSION_001)
     {
-        m_image[i] = &buffer[pixelIndex];
-        pixelIndex += width;
+        if(size < offset + sizeof(flip))
+            return 0;
+        memcpy(&flip, frame + offset, sizeof(flip));
+        offset += sizeof(flip);
     }
+    if(width < 0 || height < 0)
+        return 0;
+    size_t pixels = sizeof(Pixel)*width*height;
+    if(size - offset < pixels)
+        return 0;
+
+    checkViews("NUImage::MapStreamedImage()");
+    useInternalBuffer(false);
+    // the frame is usually a read only mapping, the image copies it before it is written
+    mapBuffer(reinterpret_cast<Pixel*>(const_cast<char*>(frame + offset)), width, height, width);
+    m_readOnly = true;
+    m_timestamp = timestamp;
+    flipped = flip;
+    return offset + pixels;
+}
+
+void NUImage::MapBufferToImage(Pixel* buffer, int width, int height)
+{
+    checkViews("NUImage::MapBufferToImage()");
+    mapBuffer(buffer, width, height, width);
+}
+
+void NUImage::mapBuffer(Pixel* buffer, int width, int height, int stride)
+{
+    m_data = buffer;
+    m_stride = stride;
     m_imageWidth = width;
     m_imageHeight = height;
+    m_readOnly = false;
+}
+
+void NUImage::makeWritable()
+{
+    const Pixel* source = m_data;
+    int source_stride = m_stride;
+    int width = getWidth();
+    int height = getHeight();
+    addInternalBuffer(width, height);
+    for(int y = 0; y < height; y++)
+    {
+        memcpy(m_data + y*m_stride, source + y*source_stride, sizeof(Pixel)*width);
+    }
 }
 
 void NUImage::setImageDimensions(int newWidth, int newHeight)
@@ -237,7 +287,7 @@ QImage NUImage::getSubImage(int x, int y, int width, int height, int decimation_
         for (int y_ = y; y_ < y+height; y_ += decimation_spacing)
         {
             //qDebug() << "1 (" << x_ << "," << y_ <<")";
-            p = &m_image[y_][x_];
+            p = &m_data[y_*m_stride + x_];
             //qDebug() << "2: "<< p->y << "," << p->cb << "," << p->cr;
             ColorModelConversions::fromYCbCrToRGB( p->y, p->cb, p->cr, r, g, b);
             //qDebug() << "3: " << r << "," << g << "," << b;
@@ -266,7 +316,7 @@ std::ostream& operator<< (std::ostream& output, const NUImage& p_image)
     output.write(reinterpret_cast<char*>(&flipped), sizeof(flipped));
     for(int y = 0; y < sourceHeight; y++)
     {
-        output.write(reinterpret_cast<char*>(p_image.m_image[y]), sizeof(p_image.m_image[y][0])*sourceWidth);
+        output.write(reinterpret_cast<const char*>(p_image.getRow(y)), sizeof(Pixel)*sourceWidth);
     }
     return output;
 }
@@ -295,12 +345,13 @@ std::istream& operator>> (std::istream& input, NUImage& p_image)
     {
         input.read(reinterpret_cast<char*>(&p_image.flipped), sizeof(p_image.flipped));
     }
+    p_image.checkViews("operator>>(istream, NUImage)");
     p_image.setImageDimensions(width, height);
     p_image.useInternalBuffer(true);
     for(int y = 0; y < height; y++)
     {
         if(!input.good()) throw std::exception();
-        input.read((char*) p_image.m_image[y], sizeof(p_image.m_image[y][0])*width);
+        input.read((char*) (p_image.m_data + y*p_image.m_stride), sizeof(Pixel)*width);
     }
     return input;
 }
@@ -27,6 +27,7 @@ platforms.
 
 class NUImage: public TimestampedData
 {
+    friend class NUImageView;
 public:
     enum Version
     {
@@ -128,6 +129,16 @@ public:
     */
     void CopyFromYUV422Buffer(const unsigned char* buffer, int width, int height);
 
+    /*!
+    @brief Maps the image onto a frame written by the output streaming operation that is held in memory,
+    such as a memory mapped stream file. A local copy IS NOT made, the memory must outlive the image's use of it.
+    The memory is never written, the image is read only until it is first written to, which copies it.
+    @param frame The start of the frame.
+    @param size The number of bytes available from the start of the frame.
+    @return The size of the frame in bytes, or 0 if there is not a valid frame, in which case the image is unchanged.
+    */
+    size_t MapStreamedImage(const char* frame, size_t size);
+
     /*!
     @brief Output streaming operation.
     @param output The output stream.
@@ -169,14 +180,25 @@ public:
         return getWidth()*getHeight();
     }
 
+    /*!
+    @brief Set the pixel at the desired position of the image.
+    A read only image is first copied into an internal buffer.
+    @param x Image x coordinate
+    @param y Image y coordinate
+    @param px The new pixel value.
+    */
     void setPixel(unsigned int x, unsigned int y, Pixel px) {
+        if(m_readOnly)
+        {
+            makeWritable();
+        }
         if(flipped)
         {
-            m_image[getHeight() - y - 1][getWidth() - x - 1] = px;
+            m_data[(getHeight() - y - 1)*m_stride + getWidth() - x - 1] = px;
         }
         else
         {
-            m_image[y][x] = px;
+            m_data[y*m_stride + x] = px;
         }
     }
 
@@ -213,7 +235,90 @@ public:
     */
     const Pixel& at(unsigned int x, unsigned int y) const
     {
-        return m_image[y][x];
+        return m_data[y*m_stride + x];
+    }
+
+    /*!
+    @brief Get the distance between the starts of consecutive buffer rows.
+    @return The row stride in pixels.
+    */
+    int getStride() const
+    {
+        return m_stride;
+    }
+
+    /*!
+    @brief Get the start of a buffer row, the row's pixels are contiguous.
+    @param y Buffer y position
+    @return The first pixel of the row.
+    */
+    const Pixel* getRow(unsigned int y) const
+    {
+        return m_data + y*m_stride;
+    }
+
+    /*!
+    @brief A run of pixels along a row or column in image coordinates.
+
+    The image flip is resolved when the span is created by choosing the direction the
+    buffer is walked in, so hot loops can step through the pixels with plain pointer
+    arithmetic and no per pixel flip check.
+    */
+    struct Span
+    {
+        const Pixel* first;     //!< The first pixel of the span.
+        int step;               //!< The distance in pixels between consecutive pixels, negative when walking the buffer backwards.
+        int length;             //!< The number of pixels in the span.
+
+        const Pixel& operator[](int i) const
+        {
+            return first[i*step];
+        }
+    };
+
+    /*!
+    @brief Get the pixels of an image row from left to right.
+    @param y Image y coordinate
+    @return The row span.
+    */
+    Span getRowSpan(unsigned int y) const
+    {
+        Span span;
+        if(flipped)
+        {
+            span.first = &at(getWidth() - 1, getHeight() - y - 1);
+            span.step = -1;
+        }
+        else
+        {
+            span.first = &at(0, y);
+            span.step = 1;
+        }
+        span.length = getWidth();
+        return span;
+    }
+
+    /*!
+    @brief Get the pixels of an image column from start_y to the bottom of the image.
+    @param x Image x coordinate
+    @param start_y Image y coordinate of the first pixel.
+    @return The column span.
+    */
+    Span getColumnSpan(unsigned int x, unsigned int start_y = 0) const
+    {
+        Span span;
+        if(flipped)
+        {
+            span.first = &at(getWidth() - x - 1, getHeight() - start_y - 1);
+            span.step = -m_stride;
+        }
+        else
+        {
+            span.first = &at(x, start_y);
+            span.step = m_stride;
+        }
+        span.length = getHeight() - start_y;
+        return span;
     }
 
     /*!
@@ -225,6 +330,35 @@ public:
         return m_usingInternalBuffer;
     }
 
+    /*!
+    @brief Get whether the image buffer is memory that must not be written, such as a read only file mapping.
+    @return True when the image is read only.
+    */
+    bool isReadOnly() const
+    {
+        return m_readOnly;
+    }
+
+    /*!
+    @brief Get the number of NUImageViews currently referencing this image.
+    The buffer should not be remapped or released while this is non-zero.
+    @return The number of views.
+    */
+    int getViewCount() const
+    {
+        return __sync_add_and_fetch(&m_view_count.count, 0);
+    }
+
+    /*!
+    @brief Get the number of deep copies of image data made so far (copy constructor and copyFromExisting).
+    Used to check that no full image copies are made in places that should not need them.
+    @return The total number of deep copies.
+    */
+    static unsigned int getDeepCopyCount()
+    {
+        return __sync_add_and_fetch(&s_deep_copy_count, 0);
+    }
+
     double GetTimestamp() const
     {
         return m_timestamp;
@@ -270,14 +404,29 @@ public:
     bool flipped;
 
 protected:
-    Pixel **m_image;                    //!< Pointer to the image array.
+    Pixel *m_data;                      //!< Pointer to the first pixel of the image buffer.
+    int m_stride;                       //!< The distance in pixels between the starts of consecutive rows.
     double m_timestamp;			//!< Time point at which the image was captured. (Unix Time)
     int m_imageWidth;                   //!< The current image width.
     int m_imageHeight;                  //!< The current image height.
     bool m_usingInternalBuffer;         //!< The current image buffering state. True when buffered internally. false when buffered externally.
+    bool m_readOnly;                    //!< True when the external buffer must not be written, such as a read only file mapping.
     Pixel *m_localBuffer;               //!< Pointer to the local storage buffer.
     CameraSettings m_currentCameraSettings;   //!< Copy Of Current Camera Settings.
     /*!
+    @brief View reference count that is never copied, so assigning or copying an image
+    does not carry over the views of the source. It is only changed with atomic operations.
+    */
+    struct ViewCount
+    {
+        int count;
+        ViewCount() : count(0) {}
+        ViewCount(const ViewCount&) : count(0) {}
+        ViewCount& operator=(const ViewCount&) {return *this;}
+    };
+    mutable ViewCount m_view_count;     //!< The number of NUImageViews referencing this image.
+    static unsigned int s_deep_copy_count;    //!< The number of deep copies made of any image, only changed with atomic operations.
+    /*!
     @brief Selects the buffering mode for the image.
     @param newCondition Select the new buffering mode. True the image is buffered internally.
     False it is not.
@@ -291,11 +440,38 @@ protected:
     */
     void setImageDimensions(int newWidth, int newHeight);
 
+    /*!
+    @brief Points the image at a buffer with the given layout, no data is copied.
+    @param buffer The first pixel of the buffer.
+    @param width The width of the image.
+    @param height The height of the image.
+    @param stride The distance in pixels between the starts of consecutive rows.
+    */
+    void mapBuffer(Pixel* buffer, int width, int height, int stride);
+
+    /*!
+    @brief Copies a read only image into an internal buffer so that it can be written.
+    */
+    void makeWritable();
+
+    /*!
+    @brief Copies the pixels of the source image into this image's buffer, row by row.
+    The image must already have the source's dimensions.
+    @param source The source image.
+    */
+    void copyRows(const NUImage& source);
+
     /*!
     @brief Removes the current internal buffer.
     */
     void removeInternalBuffer();
 
+    /*!
+    @brief Logs an error if NUImageViews still reference the image, as the pixels they read are about to change.
+    @param caller The function about to remap, overwrite or release the pixels.
+    */
+    void checkViews(const char* caller) const;
+
     /*!
     @brief Adds a new internal buffer of the specified dimensions.
     @param width The width of the new internal buffer.
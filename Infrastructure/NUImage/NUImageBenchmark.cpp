@@ -0,0 +1,135 @@
+#include "NUImageBenchmark.h"
+#include "NUImage.h"
+
+#include <iostream>
+#include <vector>
+#include <time.h>
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+/*!
+@brief The previous NUImage storage, a table of row pointers with the flip checked on every access.
+*/
+class RowPointerImage
+{
+public:
+    RowPointerImage(const NUImage& img) : m_width(img.getWidth()), m_height(img.getHeight()), m_flipped(img.flipped), m_rows(img.getHeight())
+    {
+        for(int y = 0; y < m_height; y++)
+        {
+            m_rows[y] = img.getRow(y);
+        }
+    }
+
+    const Pixel& operator()(unsigned int x, unsigned int y) const
+    {
+        if(m_flipped)
+        {
+            return m_rows[m_height - y - 1][m_width - x - 1];
+        }
+        else
+        {
+            return m_rows[y][x];
+        }
+    }
+
+    int m_width;
+    int m_height;
+    bool m_flipped;
+    std::vector<const Pixel*> m_rows;
+};
+
+//! Returns a position dependent checksum of every row then every column, as read through operator().
+static unsigned int traverseRowPointers(const RowPointerImage& img)
+{
+    unsigned int sum = 0;
+    for(int y = 0; y < img.m_height; y++)
+    {
+        for(int x = 0; x < img.m_width; x++)
+        {
+            sum = sum*31 + img(x, y).color;
+        }
+    }
+    for(int x = 0; x < img.m_width; x++)
+    {
+        for(int y = 0; y < img.m_height; y++)
+        {
+            sum = sum*31 + img(x, y).color;
+        }
+    }
+    return sum;
+}
+
+//! Returns the same checksum as traverseRowPointers, walking spans with pointer arithmetic.
+static unsigned int traverseSpans(const NUImage& img)
+{
+    unsigned int sum = 0;
+    for(int y = 0; y < img.getHeight(); y++)
+    {
+        NUImage::Span row = img.getRowSpan(y);
+        const Pixel* px = row.first;
+        for(int i = 0; i < row.length; i++, px += row.step)
+        {
+            sum = sum*31 + px->color;
+        }
+    }
+    for(int x = 0; x < img.getWidth(); x++)
+    {
+        NUImage::Span column = img.getColumnSpan(x);
+        const Pixel* px = column.first;
+        for(int i = 0; i < column.length; i++, px += column.step)
+        {
+            sum = sum*31 + px->color;
+        }
+    }
+    return sum;
+}
+
+bool NUImageTraversalBenchmark(int width, int height, int repetitions)
+{
+    std::vector<unsigned char> buffer(width*height*2);
+    for(size_t i = 0; i < buffer.size(); i++)
+    {
+        buffer[i] = static_cast<unsigned char>(i*2654435761u >> 13);
+    }
+
+    bool success = true;
+    for(int flip = 0; flip < 2; flip++)
+    {
+        NUImage img;
+        img.MapYUV422BufferToImage(&buffer[0], width, height, flip == 1);
+        RowPointerImage old_img(img);
+
+        unsigned int old_sum = 0, new_sum = 0;
+        double start = benchmarkTime();
+        for(int i = 0; i < repetitions; i++)
+        {
+            old_sum += traverseRowPointers(old_img);
+        }
+        double middle = benchmarkTime();
+        for(int i = 0; i < repetitions; i++)
+        {
+            new_sum += traverseSpans(img);
+        }
+        double end = benchmarkTime();
+
+        double old_time = (middle - start)/repetitions,
+               new_time = (end - middle)/repetitions;
+        std::cout << "NUImageTraversalBenchmark - " << img.getWidth() << "x" << img.getHeight() << (flip ? " flipped" : " unflipped") << std::endl;
+        std::cout << "\trow pointers: " << old_time << " ms/image" << std::endl;
+        std::cout << "\tspans:        " << new_time << " ms/image" << std::endl;
+        std::cout << "\tspeedup: " << old_time/new_time << std::endl;
+
+        if(old_sum != new_sum)
+        {
+            std::cout << "NUImageTraversalBenchmark - traversal order differs" << std::endl;
+            success = false;
+        }
+    }
+    return success;
+}
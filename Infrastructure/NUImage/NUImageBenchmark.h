@@ -0,0 +1,22 @@
+/*!
+@file NUImageBenchmark.h
+@brief Compares full image traversal through the old row-pointer layout and the strided NUImage layout.
+*/
+
+#ifndef NUIMAGEBENCHMARK_H
+#define NUIMAGEBENCHMARK_H
+
+/*!
+@brief Walks every row and every column of a synthetic YUV422 camera image.
+
+The old layout is reproduced with a row-pointer table and a flip check per pixel,
+the new one uses NUImage::getRowSpan() and NUImage::getColumnSpan(). Both are run on
+flipped and unflipped images and must visit the same pixels in the same order.
+@param width The width of the camera image in YUV422 pixels.
+@param height The height of the camera image in rows.
+@param repetitions The number of full traversals to time.
+@return Whether both layouts produced the same checksums.
+*/
+bool NUImageTraversalBenchmark(int width = 640, int height = 480, int repetitions = 200);
+
+#endif
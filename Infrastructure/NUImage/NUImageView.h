@@ -0,0 +1,106 @@
+/*!
+@file NUImageView.h
+@brief Declaration of the NUImageView class, a read-only reference counted handle to an NUImage.
+*/
+
+#ifndef NUIMAGEVIEW_H
+#define NUIMAGEVIEW_H
+
+#include "NUImage.h"
+
+/*!
+@brief Read-only handle to an image owned elsewhere.
+
+Views never copy pixels. Each view holds a reference on the image it points to, and NUImage
+logs an error when it is remapped, overwritten or destroyed while views still reference it.
+The owner of the image (e.g. the camera or a data wrapper) can check NUImage::getViewCount()
+before remapping or releasing a buffer that is still being read. Camera buffers mapped with
+MapYUV422BufferToImage are handed from the grab through to the detectors this way.
+
+The count is changed atomically, so views may be copied and released on any thread.
+*/
+class NUImageView
+{
+public:
+    /*!
+    @brief Default constructor, the view does not reference an image.
+    */
+    NUImageView() : m_image(0) {}
+
+    /*!
+    @brief Creates a view of the given image.
+    @param image The image to view, may be null.
+    */
+    explicit NUImageView(const NUImage* image) : m_image(image)
+    {
+        acquire();
+    }
+
+    NUImageView(const NUImageView& other) : m_image(other.m_image)
+    {
+        acquire();
+    }
+
+    ~NUImageView()
+    {
+        release();
+    }
+
+    NUImageView& operator=(const NUImageView& other)
+    {
+        if(m_image != other.m_image)
+        {
+            release();
+            m_image = other.m_image;
+            acquire();
+        }
+        return *this;
+    }
+
+    /*!
+    @brief Drops the reference, the view no longer references an image.
+    */
+    void reset()
+    {
+        release();
+        m_image = 0;
+    }
+
+    //! Returns whether the view references an image.
+    bool valid() const {return m_image != 0;}
+
+    //! Returns the viewed image.
+    const NUImage& image() const {return *m_image;}
+    //! Returns a pointer to the viewed image, null if there is none.
+    const NUImage* get() const {return m_image;}
+
+    const NUImage& operator*() const {return *m_image;}
+    const NUImage* operator->() const {return m_image;}
+
+    int getWidth() const {return m_image->getWidth();}
+    int getHeight() const {return m_image->getHeight();}
+    bool isFlipped() const {return m_image->flipped;}
+
+    //! Image coordinate access, see NUImage::operator().
+    const Pixel& operator()(unsigned int x, unsigned int y) const {return (*m_image)(x, y);}
+    //! Raw buffer access, see NUImage::at().
+    const Pixel& at(unsigned int x, unsigned int y) const {return m_image->at(x, y);}
+
+private:
+    void acquire()
+    {
+        if(m_image)
+            __sync_add_and_fetch(&m_image->m_view_count.count, 1);
+    }
+
+    void release()
+    {
+        if(m_image)
+            __sync_sub_and_fetch(&m_image->m_view_count.count, 1);
+    }
+
+private:
+    const NUImage* m_image;     //!< The viewed image.
+};
+
+#endif
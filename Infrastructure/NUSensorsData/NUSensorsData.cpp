@@ -21,6 +21,7 @@
 
 #include "NUSensorsData.h"
 #include "Tools/Math/StlVector.h"
+#include "Tools/Math/FixedMatrix.h"
 
 #include "debug.h"
 #include "debugverbositynusensors.h"
@@ -105,6 +106,7 @@ NUSensorsData::NUSensorsData() : NUData(), TimestampedData()
 
     for (size_t i=0; i<m_ids.size(); i++)
         m_sensors.push_back(Sensor(m_ids[i]->Name));
+    initialiseJointTable();
 }
 
 NUSensorsData::~NUSensorsData()
@@ -123,6 +125,7 @@ void NUSensorsData::addSensors(const vector<string>& hardwarenames)
     
     // the addDevices function will just setup the groups for the joints
     addDevices(hardwarenames);
+    initialiseJointTable();
 }
 
 /******************************************************************************************************************************************
@@ -690,6 +693,20 @@ bool NUSensorsData::get(const id_t& id, string& data)
         return false;
 }
 
+/*! @brief Gets a 4x4 transform sensor reading for id, eg. the NUSensorsData::CameraTransform. This does not allocate.
+    @param id the id of the sensor
+    @param data will be updated with the sensor reading
+    @return true if the data is valid, false otherwise
+ */
+bool NUSensorsData::get(const id_t& id, FixedMatrix<4,4>& data)
+{
+    const vector<int>& ids = mapIdToIndices(id);
+    if (ids.size() == 1)
+        return m_sensors[ids[0]].get(data);
+    else
+        return false;
+}
+
 /* Gets a single type of joint sensor information, eg. a Temperature with getJointData(NUSensorsData::HeadPitch, NUSensorsData::TemperatureId, data)
    @param id the id of the group of joints
    @param in the index into a joint sensor vector for the desired type of information
@@ -701,24 +718,12 @@ bool NUSensorsData::getJointData(const id_t& id, const JointSensorIndices& in, f
     if (id < All or id > NumJointIds) 			// check that the id is actually that of a joint
         return false;
     
-    const vector<int>& ids = mapIdToIndices(id);
-    if (ids.size() == 1)
+    unsigned int size;
+    const float* span = getJointSpan(id, in, size);
+    if (span and size == 1)
     {
-        vector<float> vectorBuffer;
-        if (m_sensors[ids[0]].get(vectorBuffer))
-        {
-            if (static_cast<unsigned>(in) < vectorBuffer.size())
-            	data = vectorBuffer[in];
-            else
-                data = numeric_limits<float>::quiet_NaN();
-            
-            if (isnan(data))
-                return false;
-            else
-                return true;
-        }
-        else
-            return false;
+        data = span[0];
+        return not isnan(data);
     }
     else
         return false;
@@ -739,6 +744,17 @@ bool NUSensorsData::getJointData(const id_t& id, const JointSensorIndices& in, v
     size_t numids = ids.size();
     if (numids <= 1)
         return false;
+    
+    unsigned int size;
+    const float* span = getJointSpan(id, in, size);
+    if (span)
+    {   // the joints are contiguous in the table, so they are copied straight out of it
+        data.assign(span, span + size);
+        bool successful = true;
+        for (unsigned int i=0; i<size; i++)
+            successful &= not isnan(span[i]);
+        return successful;
+    }
     else
     {
         data.clear();
@@ -760,6 +776,26 @@ bool NUSensorsData::getJointData(const id_t& id, const JointSensorIndices& in, v
     }
 }
 
+/*! @brief Returns a single type of joint sensor information for a joint, or a group of joints, straight from the joint table.
+ 
+    Nothing is copied, so this is the fastest way to read joint data. For example, getJointSpan(NUSensorsData::LLeg, NUSensorsData::PositionId, size)
+    returns the positions of the left leg joints. The readings of invalid joints are NaN.
+    @param id the id of the joint or group of joints
+    @param in the index into a joint sensor vector for the desired type of information
+    @param size will be updated with the number of joints in the span
+    @return a pointer to the first reading, valid until the sensors are next added, or NULL if id is not a joint or its joints are not contiguous
+ */
+const float* NUSensorsData::getJointSpan(const id_t& id, const JointSensorIndices& in, unsigned int& size) const
+{
+    if (id.Id < 0 or static_cast<size_t>(id.Id) >= m_joint_span_start.size() or static_cast<unsigned>(in) >= NumJointSensorIndices)
+        return NULL;
+    int start = m_joint_span_start[id.Id];
+    if (start < 0)
+        return NULL;
+    size = m_joint_span_size[id.Id];
+    return &m_joint_table[in*m_joint_sensors.size() + start];
+}
+
 /* Gets a single type of end effector information, eg. a bumper value with getEndEffectorData(NUSensorsData::LArm, NUSensorsData::BumperId, data)
    @param id the id of the end effector
    @param in the index into a end effector sensor vector for the desired type of information
@@ -927,7 +963,10 @@ void NUSensorsData::set(const id_t& id, double time, const float& data)
     #endif
     const vector<int>& ids = mapIdToIndices(id);
     for (size_t i=0; i<ids.size(); i++)
+    {
         m_sensors[ids[i]].set(time, data);
+        updateJointRow(ids[i]);
+    }
 }
 
 /*! @brief Sets the current sensor reading for id. If id is a group the each element of data will be given to each member of the group
@@ -947,11 +986,15 @@ void NUSensorsData::set(const id_t& id, double time, const vector<float>& data)
     else if (numids == 1)
     {   // if id is a single sensor
         m_sensors[ids[0]].set(time, data);
+        updateJointRow(ids[0]);
     }
     else if (numids == data.size())
     {   // if id is a group of sensors
         for (size_t i=0; i<numids; i++)
+        {
             m_sensors[ids[i]].set(time, data[i]);
+            updateJointRow(ids[i]);
+        }
     }
     else
     {
@@ -977,11 +1020,15 @@ void NUSensorsData::set(const id_t& id, double time, const vector<vector<float>
     else if (numids == 1)
     {   // if id is a single sensor
         m_sensors[ids[0]].set(time, data);
+        updateJointRow(ids[0]);
     }
     else if (numids == data.size())
     {   // if id is a group of sensors
         for (size_t i=0; i<numids; i++)
+        {
             m_sensors[ids[i]].set(time, data[i]);
+            updateJointRow(ids[i]);
+        }
     }
     else
     {
@@ -1002,7 +1049,26 @@ void NUSensorsData::set(const id_t& id, double time, const string& data)
     #endif
     const vector<int>& ids = mapIdToIndices(id);
     for (size_t i=0; i<ids.size(); i++)
+    {
+        m_sensors[ids[i]].set(time, data);
+        updateJointRow(ids[i]);
+    }
+}
+
+/*! @brief Sets the current sensor reading for id to a 4x4 transform. The transform is stored flattened as Matrix::asVector() would,
+           so it can still be read with get(id, vector<float>) and Matrix4x4fromVector. This does not allocate.
+    @param id the id of the targetted sensor
+    @param time the time in ms the value was captured
+    @param data the transform
+ */
+void NUSensorsData::set(const id_t& id, double time, const FixedMatrix<4,4>& data)
+{
+    const vector<int>& ids = mapIdToIndices(id);
+    for (size_t i=0; i<ids.size(); i++)
+    {
         m_sensors[ids[i]].set(time, data);
+        updateJointRow(ids[i]);
+    }
 }
 
 /*! @brief Sets the readings for sensor id to be invalid 
@@ -1012,7 +1078,10 @@ void NUSensorsData::setAsInvalid(const id_t& id)
 {
     const vector<int>& ids = mapIdToIndices(id);
     for (size_t i=0; i<ids.size(); i++)
+    {
         m_sensors[ids[i]].setAsInvalid();
+        updateJointRow(ids[i]);
+    }
 }
 
 /*! @brief Modifies existing sensor data. This is especially for updating 'packed' sensors.
@@ -1028,7 +1097,10 @@ void NUSensorsData::modify(const id_t& id, int start, double time, const float&
     #endif
     const vector<int>& ids = mapIdToIndices(id);
     for (size_t i=0; i<ids.size(); i++)
+    {
         m_sensors[ids[i]].modify(time, start, data);
+        updateJointRow(ids[i]);
+    }
 }
 
 /*! @brief Modifies existing sensor data. This is especially for updating 'packed' sensors.
@@ -1049,11 +1121,15 @@ void NUSensorsData::modify(const id_t& id, int start, double time, const vector<
     else if (numids == 1)
     {   // if id is a single sensor
         m_sensors[ids[0]].modify(time, start, data);
+        updateJointRow(ids[0]);
     }
     else if (numids == data.size())
     {   // if id is a group of sensors
         for (size_t i=0; i<numids; i++)
+        {
             m_sensors[ids[i]].modify(time, start, data[i]);
+            updateJointRow(ids[i]);
+        }
     }
     else
     {
@@ -1062,6 +1138,78 @@ void NUSensorsData::modify(const id_t& id, int start, double time, const vector<
     }
 }
 
+/******************************************************************************************************************************************
+                                                                                                                                Joint Table
+ ******************************************************************************************************************************************/
+
+/*! @brief Lays out the joint table for the available joints, and works out which joint ids are contiguous rows. 
+           This needs to be called whenever the available sensors change.
+ */
+void NUSensorsData::initialiseJointTable()
+{
+    const int numids = m_id_to_indices.size();
+    m_joint_rows.assign(numids, -1);
+    m_joint_sensors.clear();
+    for (int i=NumCommonGroupIds.Id+1; i<NumJointIds.Id and i<numids; i++)
+    {   // a joint is available when it maps to itself
+        if (m_id_to_indices[i].size() == 1 and m_id_to_indices[i][0] == i)
+        {
+            m_joint_rows[i] = m_joint_sensors.size();
+            m_joint_sensors.push_back(i);
+        }
+    }
+    
+    m_joint_span_start.assign(numids, -1);
+    m_joint_span_size.assign(numids, 0);
+    for (int i=0; i<NumJointIds.Id and i<numids; i++)
+    {   // a joint id has a span when all of its joints are available and in consecutive rows
+        const vector<int>& indices = m_id_to_indices[i];
+        if (indices.empty())
+            continue;
+        bool contiguous = true;
+        for (size_t j=0; j<indices.size() and contiguous; j++)
+        {
+            int index = indices[j];
+            contiguous = index >= 0 and index < numids and m_joint_rows[index] >= 0 and m_joint_rows[index] == m_joint_rows[indices[0]] + static_cast<int>(j);
+        }
+        if (contiguous)
+        {
+            m_joint_span_start[i] = m_joint_rows[indices[0]];
+            m_joint_span_size[i] = indices.size();
+        }
+    }
+    
+    m_joint_table.assign(NumJointSensorIndices*m_joint_sensors.size(), numeric_limits<float>::quiet_NaN());
+    loadJointTable();
+}
+
+/*! @brief Copies every joint sensor into the joint table. Use this after the sensors have been changed directly.
+ */
+void NUSensorsData::loadJointTable()
+{
+    for (size_t i=0; i<m_joint_sensors.size(); i++)
+        updateJointRow(m_joint_sensors[i]);
+}
+
+/*! @brief Copies the sensor at index into its row of the joint table, if it is a joint. 
+           The readings the sensor does not have, and all of the readings of an invalid sensor, are NaN in the table.
+    @param index the index of the sensor in m_sensors
+ */
+void NUSensorsData::updateJointRow(int index)
+{
+    if (index < 0 or static_cast<size_t>(index) >= m_joint_rows.size() or static_cast<size_t>(index) >= m_sensors.size())
+        return;
+    const int row = m_joint_rows[index];
+    if (row < 0)
+        return;
+    
+    const Sensor& sensor = m_sensors[index];
+    const size_t numrows = m_joint_sensors.size();
+    const size_t numvalues = sensor.ValidVector ? sensor.VectorData.size() : 0;
+    for (size_t in=0; in<NumJointSensorIndices; in++)
+        m_joint_table[in*numrows + row] = in < numvalues ? sensor.VectorData[in] : numeric_limits<float>::quiet_NaN();
+}
+
 /******************************************************************************************************************************************
                                                                                                       Displaying Contents and Serialisation
  ******************************************************************************************************************************************/
@@ -1229,6 +1377,7 @@ istream& operator>> (istream& input, NUSensorsData& p_data)
         if(tempSensor.Time > lastUpdateTime) lastUpdateTime = tempSensor.Time;
     }
     p_data.CurrentTime = lastUpdateTime;
+    p_data.initialiseJointTable();
     //force eofbit
     input.ignore(128, '\n');
     input.peek();
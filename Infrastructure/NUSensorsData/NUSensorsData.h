@@ -151,6 +151,9 @@ public:
     bool getTemperature(const id_t id, float& data);
     bool getTemperature(const id_t id, vector<float>& data);
     
+    // Get method for the joint table
+    const float* getJointSpan(const id_t& id, const JointSensorIndices& in, unsigned int& size) const;
+    
     // Get methods for end effector information
     bool getBumper(const id_t& id, float& data);
     bool getForce(const id_t& id, float& data);
@@ -197,6 +200,7 @@ public:
     bool get(const id_t& id, vector<float>& data);
     bool get(const id_t& id, vector<vector<float> >& data);
     bool get(const id_t& id, string& data);
+    bool get(const id_t& id, FixedMatrix<4,4>& data);
     
     
     
@@ -206,6 +210,7 @@ public:
     void set(const id_t& id, double time, const vector<float>& data);
     void set(const id_t& id, double time, const vector<vector<float> >& data);
     void set(const id_t& id, double time, const string& data);
+    void set(const id_t& id, double time, const FixedMatrix<4,4>& data);
     void setAsInvalid(const id_t& id);    
     void modify(const id_t& id, int start, double time, const float& data);
     void modify(const id_t& id, int start, double time, const vector<float>& data);
@@ -215,6 +220,9 @@ public:
     
     friend ostream& operator<< (ostream& output, const NUSensorsData& p_sensor);
     friend istream& operator>> (istream& input, NUSensorsData& p_sensor);
+    friend class SensorLogWriter;
+    friend class SensorLogReader;
+    friend class SensorFrame;
     
     int size() const;
     double GetTimestamp() const {return CurrentTime;}
@@ -225,10 +233,23 @@ private:
     bool getJointData(const id_t& id, const JointSensorIndices& in, vector<float>& data);
     bool getEndEffectorData(const id_t& id, const EndEffectorIndices& in, float& data);
     bool getButtonData(const id_t& id, const ButtonSensorIndices& in, float& data);
+    
+    void initialiseJointTable();
+    void loadJointTable();
+    void updateJointRow(int index);
 
 private:
     static vector<id_t*> m_ids;				 //!< a vector containing all of the actionator ids
     vector<Sensor> m_sensors;                //!< a vector of all of the sensors
+    
+    // The joint table holds a copy of the joint sensors as a structure of arrays; one array for each of the JointSensorIndices
+    // with one row for each available joint in id order. It is kept up to date by the set methods, and the joint get methods 
+    // read from it. A group of joints that are next to each other in the table can be read as a single span.
+    vector<float> m_joint_table;             //!< the joint readings, the reading for index in of row r is m_joint_table[in*m_joint_sensors.size() + r]. NaN if invalid.
+    vector<int> m_joint_sensors;             //!< the index in m_sensors of each row
+    vector<int> m_joint_rows;                //!< the row of each sensor index, -1 if it is not an available joint
+    vector<int> m_joint_span_start;          //!< the first row of each joint id, -1 if its joints are not contiguous rows
+    vector<int> m_joint_span_size;           //!< the number of rows of each joint id
 };
 
 void readIdList(istream& input, std::vector<NUData::id_t*>& list);
@@ -21,6 +21,7 @@
 #include "Sensor.h"
 
 #include "Tools/Math/StlVector.h"
+#include "Tools/Math/FixedMatrix.h"
 
 #include "debug.h"
 #include "debugverbositynusensors.h"
@@ -136,6 +137,23 @@ bool Sensor::get(string& data) const
         return false;
 }
 
+/*! @brief Gets a 4x4 transform sensor reading, stored as a flattened vector. Returns true if sucessful, false otherwise
+    @param data will be updated with reading
+    @return true if valid sensor reading, false otherwise
+ */
+bool Sensor::get(FixedMatrix<4,4>& data) const
+{
+    if (ValidVector and VectorData.size() == 16)
+    {
+        double* x = data.getx();
+        for (unsigned int i=0; i<16; i++)
+            x[i] = VectorData[i];
+        return true;
+    }
+    else
+        return false;
+}
+
 /*! @brief Updates the sensors data
     @param time the time in milliseconds the data was captured
     @param data the new sensor data
@@ -192,6 +210,24 @@ void Sensor::set(double time, const string& data)
     ValidMatrix = false;
 }
 
+/*! @brief Updates the sensors data with a 4x4 transform, flattened row by row as Matrix::asVector() does.
+    This does not allocate once the sensor has held a vector.
+    @param time the time in milliseconds the data was captured
+    @param data the new transform
+ */
+void Sensor::set(double time, const FixedMatrix<4,4>& data)
+{
+    Time = time;
+    VectorData.resize(16);
+    const double* x = data.getx();
+    for (unsigned int i=0; i<16; i++)
+        VectorData[i] = x[i];
+    ValidVector = true;
+    ValidFloat = false;
+    ValidMatrix = false;
+    ValidString = false;
+}
+
 /*! @brief Sets all of the sensor data as being invalid */
 void Sensor::setAsInvalid()
 {
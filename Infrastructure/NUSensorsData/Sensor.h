@@ -33,6 +33,8 @@
 #include <string>
 using namespace std;
 
+template <unsigned int M, unsigned int N> class FixedMatrix;
+
 class Sensor 
 {
 public:
@@ -43,11 +45,13 @@ public:
     bool get(vector<float>& data) const;
     bool get(vector<vector<float> >& data) const;
     bool get(string& data) const;
+    bool get(FixedMatrix<4,4>& data) const;
     
     void set(double time, const float& data);
     void set(double time, const vector<float>& data);
     void set(double time, const vector<vector<float> >& data);
     void set(double time, const string& data);
+    void set(double time, const FixedMatrix<4,4>& data);
     void setAsInvalid();
     
     void modify(double time, unsigned int start, const float& data);
@@ -57,6 +61,10 @@ public:
     
     friend ostream& operator<< (ostream& output, const Sensor& p_sensor);
     friend istream& operator>> (istream& input, Sensor& p_sensor);
+    friend class SensorLogWriter;
+    friend class SensorLogReader;
+    friend class SensorFrame;
+    friend class NUSensorsData;
     Sensor& operator= (const Sensor & source);
 public:
     string Name;                        //!< the sensor's name
@@ -0,0 +1,214 @@
+/*! @file SensorFrame.cpp
+    @brief Implementation of the SensorFrame class
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SensorFrame.h"
+#include "NUSensorsData.h"
+
+#include <algorithm>
+#include <cstring>
+
+static inline uint64_t doubleBits(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static inline double bitsDouble(uint64_t bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+SensorFrame::SensorFrame() : Timestamp(0), m_num_sensors(0)
+{
+}
+
+/*! @brief Exchanges the contents of the two frames without copying their words */
+void SensorFrame::swap(SensorFrame& other)
+{
+    std::swap(Timestamp, other.Timestamp);
+    std::swap(m_num_sensors, other.m_num_sensors);
+    Shape.swap(other.Shape);
+    Words.swap(other.Words);
+}
+
+/*! @brief Fills the frame with the shape and the words of the data */
+void SensorFrame::capture(const NUSensorsData& data)
+{
+    Timestamp = data.GetTimestamp();
+    const uint64_t timestamp = doubleBits(Timestamp);
+    const unsigned int n = data.m_sensors.size();
+    m_num_sensors = n;
+    Shape.resize(n);
+    Words.resize(2*n);
+    for (unsigned int i=0; i<n; i++)
+    {
+        const Sensor& sensor = data.m_sensors[i];
+        uint32_t flags = (sensor.ValidFloat ? ValidFloat : 0) | (sensor.ValidVector ? ValidVector : 0) |
+                         (sensor.ValidMatrix ? ValidMatrix : 0) | (sensor.ValidString ? ValidString : 0);
+        uint32_t length = 0;
+        if (sensor.ValidFloat)
+            length = 1;
+        else if (sensor.ValidVector)
+            length = sensor.VectorData.size();
+        else if (sensor.ValidMatrix)
+            length = sensor.MatrixData.size();
+        else if (sensor.ValidString)
+            length = sensor.StringData.size();
+        Shape[i] = flags | (length << FlagBits);
+
+        uint64_t time = doubleBits(sensor.Time) ^ timestamp;
+        Words[2*i] = static_cast<uint32_t>(time);
+        Words[2*i + 1] = static_cast<uint32_t>(time >> 32);
+    }
+
+    for (unsigned int i=0; i<n; i++)
+    {
+        const Sensor& sensor = data.m_sensors[i];
+        if (sensor.ValidFloat)
+        {
+            uint32_t word;
+            memcpy(&word, &sensor.FloatData, sizeof(word));
+            Words.push_back(word);
+        }
+        else if (sensor.ValidVector)
+        {
+            size_t start = Words.size();
+            Words.resize(start + sensor.VectorData.size());
+            if (not sensor.VectorData.empty())
+                memcpy(&Words[start], &sensor.VectorData[0], sizeof(uint32_t)*sensor.VectorData.size());
+        }
+        else if (sensor.ValidMatrix)
+        {
+            for (size_t r=0; r<sensor.MatrixData.size(); r++)
+            {
+                const std::vector<float>& row = sensor.MatrixData[r];
+                Shape.push_back(row.size());
+                size_t start = Words.size();
+                Words.resize(start + row.size());
+                if (not row.empty())
+                    memcpy(&Words[start], &row[0], sizeof(uint32_t)*row.size());
+            }
+        }
+        else if (sensor.ValidString)
+        {
+            size_t start = Words.size();
+            Words.resize(start + (sensor.StringData.size() + 3)/4, 0);
+            if (not sensor.StringData.empty())
+                memcpy(&Words[start], sensor.StringData.data(), sensor.StringData.size());
+        }
+    }
+}
+
+/*! @brief Returns the number of words the Shape needs, or ~0 if the shape is invalid */
+unsigned int SensorFrame::countWords() const
+{
+    const unsigned int n = m_num_sensors;
+    if (Shape.size() < n)
+        return ~0u;
+    unsigned int count = 2*n;
+    unsigned int row = n;
+    for (unsigned int i=0; i<n; i++)
+    {
+        uint32_t flags = Shape[i] & ((1 << FlagBits) - 1);
+        uint32_t length = Shape[i] >> FlagBits;
+        if (flags & ValidFloat)
+            count += 1;
+        else if (flags & ValidVector)
+            count += length;
+        else if (flags & ValidMatrix)
+        {
+            if (row + length > Shape.size())
+                return ~0u;
+            for (uint32_t r=0; r<length; r++)
+                count += Shape[row++];
+        }
+        else if (flags & ValidString)
+            count += (length + 3)/4;
+    }
+    return row == Shape.size() ? count : ~0u;
+}
+
+/*! @brief Returns true if the Shape is consistent and the Words are the size it needs */
+bool SensorFrame::valid() const
+{
+    return Words.size() == countWords();
+}
+
+/*! @brief Copies the frame into data, which must have the same sensors as the data the frame was captured from
+    @param data the sensor data to restore the frame into
+    @return true if the frame was restored, false if the frame is invalid or data has a different number of sensors
+ */
+bool SensorFrame::restore(NUSensorsData& data) const
+{
+    const unsigned int n = m_num_sensors;
+    if (data.m_sensors.size() != n or not valid())
+        return false;
+
+    const uint64_t timestamp_bits = doubleBits(Timestamp);
+    unsigned int word = 2*n;
+    unsigned int row = n;
+    for (unsigned int i=0; i<n; i++)
+    {
+        Sensor& sensor = data.m_sensors[i];
+        uint32_t flags = Shape[i] & ((1 << FlagBits) - 1);
+        uint32_t length = Shape[i] >> FlagBits;
+        sensor.ValidFloat = flags & ValidFloat;
+        sensor.ValidVector = flags & ValidVector;
+        sensor.ValidMatrix = flags & ValidMatrix;
+        sensor.ValidString = flags & ValidString;
+        sensor.Time = bitsDouble((static_cast<uint64_t>(Words[2*i + 1]) << 32 | Words[2*i]) ^ timestamp_bits);
+
+        if (sensor.ValidFloat)
+        {
+            memcpy(&sensor.FloatData, &Words[word], sizeof(float));
+            word += 1;
+        }
+        else if (sensor.ValidVector)
+        {
+            sensor.VectorData.resize(length);
+            if (length > 0)
+                memcpy(&sensor.VectorData[0], &Words[word], sizeof(float)*length);
+            word += length;
+        }
+        else if (sensor.ValidMatrix)
+        {
+            sensor.MatrixData.resize(length);
+            for (uint32_t r=0; r<length; r++)
+            {
+                uint32_t columns = Shape[row++];
+                sensor.MatrixData[r].resize(columns);
+                if (columns > 0)
+                    memcpy(&sensor.MatrixData[r][0], &Words[word], sizeof(float)*columns);
+                word += columns;
+            }
+        }
+        else if (sensor.ValidString)
+        {
+            if (length > 0)
+                sensor.StringData.assign(reinterpret_cast<const char*>(&Words[word]), length);
+            else
+                sensor.StringData.clear();
+            word += (length + 3)/4;
+        }
+    }
+    data.CurrentTime = Timestamp;
+    data.loadJointTable();
+    return true;
+}
@@ -0,0 +1,78 @@
+/*! @file SensorFrame.h
+    @brief Declaration of the SensorFrame class
+
+    @class SensorFrame
+    @brief A NUSensorsData flattened into two arrays of 32 bit words
+
+    The sensors of a NUSensorsData are held in vectors, strings and matrices, so copying one
+    allocates and it can not be read while another thread is writing it. A SensorFrame holds the
+    same data as plain words, which can be copied with a memcpy, stored in a fixed size buffer or
+    written to a file, and then restored into a NUSensorsData with the same sensors.
+
+    The frame is made of
+        - the shape: one word per sensor holding its valid flags and the length of its data,
+          followed by the length of each row of the matrix sensors
+        - the words: two words per sensor holding its time, xor'ed with the frame timestamp so a
+          sensor read at the time of the frame is zero, followed by the data of each sensor in
+          sensor order; the floats of the float, vector and matrix sensors and the characters of
+          the string sensors padded to a whole word
+    Once the shape is known every sensor's data is at a fixed offset in the words.
+
+    Capturing and restoring only allocate when a frame is bigger than any frame before it.
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SENSORFRAME_H
+#define SENSORFRAME_H
+
+#include <vector>
+#include <stdint.h>
+
+class NUSensorsData;
+
+class SensorFrame
+{
+public:
+    //! The valid flags of a sensor, in the low bits of its shape word
+    enum ValidFlags
+    {
+        ValidFloat = 0x1,
+        ValidVector = 0x2,
+        ValidMatrix = 0x4,
+        ValidString = 0x8,
+        FlagBits = 4
+    };
+
+    SensorFrame();
+
+    void capture(const NUSensorsData& data);
+    bool restore(NUSensorsData& data) const;
+    bool valid() const;
+    void swap(SensorFrame& other);
+
+    unsigned int numSensors() const {return m_num_sensors;}
+    void setNumSensors(unsigned int n) {m_num_sensors = n;}
+    unsigned int countWords() const;
+
+public:
+    double Timestamp;                   //!< the timestamp of the NUSensorsData
+    std::vector<uint32_t> Shape;        //!< the valid flags and lengths of the sensors, then the row lengths of the matrices
+    std::vector<uint32_t> Words;        //!< the times of the sensors, then their data
+private:
+    unsigned int m_num_sensors;         //!< the number of sensors, set by capture() or setNumSensors()
+};
+
+#endif
+
@@ -0,0 +1,219 @@
+/*! @file SensorSnapshots.cpp
+    @brief Implementation of the SensorSnapshots and SensorSnapshotReader classes
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SensorSnapshots.h"
+#include "NUSensorsData.h"
+
+#include <cmath>
+#include <cstring>
+
+const unsigned int SensorSnapshots::c_history;
+
+//! The number of times a reader tries to copy a snapshot before giving up. It only fails if the writer keeps lapping it.
+static const unsigned int c_read_attempts = 4;
+
+SensorSnapshots::SensorSnapshots() : m_storage(0), m_capacity(0), m_published(0), m_dropped(0)
+{
+    for (unsigned int i=0; i<c_history; i++)
+    {
+        m_slots[i].Sequence = 0;
+        m_slots[i].Timestamp = 0;
+        m_slots[i].PreviousTime = 0;
+        m_slots[i].ShapeSize = 0;
+        m_slots[i].WordsSize = 0;
+        m_slots[i].Data = 0;
+    }
+}
+
+SensorSnapshots::~SensorSnapshots()
+{
+    delete [] m_storage;
+}
+
+/*! @brief Publishes a copy of the data as the latest snapshot. Only call this from one thread.
+
+    The first call allocates the slots. After that the data is copied into the oldest slot without
+    blocking or allocating.
+    @param data the sensor data to publish
+    @return true if the data was published, false if it does not fit in a slot or has different sensors to the first data published
+ */
+bool SensorSnapshots::publish(const NUSensorsData& data)
+{
+    m_frame.capture(data);
+    const unsigned int shape_size = m_frame.Shape.size();
+    const unsigned int words_size = m_frame.Words.size();
+
+    if (m_storage == 0)
+    {
+        m_capacity = 2*(shape_size + words_size) + 64;
+        m_storage = new uint32_t[c_history*m_capacity];
+        for (unsigned int i=0; i<c_history; i++)
+            m_slots[i].Data = m_storage + i*m_capacity;
+        m_template = data;
+    }
+    else if (shape_size + words_size > m_capacity or static_cast<int>(m_frame.numSensors()) != m_template.size())
+    {
+        m_dropped++;
+        return false;
+    }
+
+    const unsigned int published = m_published;
+    Slot& slot = m_slots[published % c_history];
+    slot.Sequence = slot.Sequence + 1;
+    __sync_synchronize();
+    slot.Timestamp = m_frame.Timestamp;
+    slot.PreviousTime = data.PreviousTime;
+    slot.ShapeSize = shape_size;
+    slot.WordsSize = words_size;
+    if (shape_size > 0)
+        memcpy(slot.Data, &m_frame.Shape[0], sizeof(uint32_t)*shape_size);
+    if (words_size > 0)
+        memcpy(slot.Data + shape_size, &m_frame.Words[0], sizeof(uint32_t)*words_size);
+    __sync_synchronize();
+    slot.Sequence = slot.Sequence + 1;
+    __sync_synchronize();
+    m_published = published + 1;
+    return true;
+}
+
+/*! @brief Returns the number of frames published so far */
+unsigned int SensorSnapshots::published() const
+{
+    unsigned int published = m_published;
+    __sync_synchronize();
+    return published;
+}
+
+/*! @brief Copies the snapshot in a slot into the frame
+    @param index the index of the slot
+    @param frame the frame to copy the snapshot into. Its number of sensors must already be set.
+    @param previous will be set to the snapshot's previous time
+    @return true if a coherent copy was made, false if the slot was being written
+ */
+bool SensorSnapshots::read(unsigned int index, SensorFrame& frame, double& previous) const
+{
+    const Slot& slot = m_slots[index];
+    const unsigned int before = slot.Sequence;
+    __sync_synchronize();
+    if (before & 1)
+        return false;
+
+    const unsigned int shape_size = slot.ShapeSize;
+    const unsigned int words_size = slot.WordsSize;
+    frame.Timestamp = slot.Timestamp;
+    previous = slot.PreviousTime;
+    // the sizes can be garbage if the slot is being rewritten, so they are checked before they are used
+    if (shape_size + words_size > m_capacity or shape_size > m_capacity)
+        return false;
+    frame.Shape.resize(shape_size);
+    frame.Words.resize(words_size);
+    if (shape_size > 0)
+        memcpy(&frame.Shape[0], slot.Data, sizeof(uint32_t)*shape_size);
+    if (words_size > 0)
+        memcpy(&frame.Words[0], slot.Data + shape_size, sizeof(uint32_t)*words_size);
+
+    __sync_synchronize();
+    return slot.Sequence == before;
+}
+
+// ------------------------------------------------------------------------------------------------------------------- SensorSnapshotReader
+
+SensorSnapshotReader::SensorSnapshotReader(const SensorSnapshots* snapshots) : m_snapshots(snapshots), m_setup_data(0), m_previous_time(0)
+{
+}
+
+/*! @brief Copies the latest snapshot into data
+    @param data the sensor data to copy the snapshot into
+    @return true if the data was set, false if nothing has been published
+ */
+bool SensorSnapshotReader::latest(NUSensorsData& data)
+{
+    if (m_snapshots == 0)
+        return false;
+
+    for (unsigned int attempt=0; attempt<c_read_attempts; attempt++)
+    {
+        unsigned int published = m_snapshots->published();
+        if (published == 0)
+            return false;
+        if (m_snapshots->read((published - 1) % SensorSnapshots::c_history, m_frame, m_previous_time))
+            return restore(data);
+    }
+    return false;
+}
+
+/*! @brief Copies the snapshot with the timestamp closest to time into data.
+
+    Use this with an image's timestamp to get the joint angles the image was taken with.
+    @param time the time to match
+    @param data the sensor data to copy the snapshot into
+    @return true if the data was set, false if nothing has been published
+ */
+bool SensorSnapshotReader::closest(double time, NUSensorsData& data)
+{
+    if (m_snapshots == 0)
+        return false;
+
+    for (unsigned int attempt=0; attempt<c_read_attempts; attempt++)
+    {
+        unsigned int published = m_snapshots->published();
+        if (published == 0)
+            return false;
+
+        // the slot after the latest is the next to be written, so only the others are searched
+        unsigned int available = published < SensorSnapshots::c_history ? published : SensorSnapshots::c_history - 1;
+        unsigned int best = (published - 1) % SensorSnapshots::c_history;
+        double best_timestamp = m_snapshots->m_slots[best].Timestamp;
+        for (unsigned int i=1; i<available; i++)
+        {
+            unsigned int index = (published - 1 - i) % SensorSnapshots::c_history;
+            double timestamp = m_snapshots->m_slots[index].Timestamp;
+            if (fabs(timestamp - time) < fabs(best_timestamp - time))
+            {
+                best = index;
+                best_timestamp = timestamp;
+            }
+            else if (timestamp < time)
+                break;          // the snapshots only get older from here
+        }
+
+        // the timestamp read in the search is only a hint until the slot has been copied
+        if (m_snapshots->read(best, m_frame, m_previous_time) and m_frame.Timestamp == best_timestamp)
+            return restore(data);
+    }
+    return false;
+}
+
+/*! @brief Restores the copied frame into data.
+
+    The first time the reader restores into a NUSensorsData it is set up with the sensors and ids of the first
+    data published, so that the ids map to the same sensors as in the data the SenseMoveThread publishes.
+ */
+bool SensorSnapshotReader::restore(NUSensorsData& data)
+{
+    const NUSensorsData* sensors = &m_snapshots->m_template;
+    if (&data != m_setup_data or data.size() != sensors->size())
+    {
+        data = *sensors;
+        m_setup_data = &data;
+    }
+    m_frame.setNumSensors(sensors->size());
+    if (not m_frame.restore(data))
+        return false;
+    data.PreviousTime = m_previous_time;
+    return true;
+}
@@ -0,0 +1,111 @@
+/*! @file SensorSnapshots.h
+    @brief Declaration of the SensorSnapshots and SensorSnapshotReader classes
+
+    @class SensorSnapshots
+    @brief A history of the recent sensor data, published by one thread and read by any other
+
+    The SenseMoveThread updates the sensors at the motion rate while the SeeThinkThread is using
+    them, so anything read straight from Blackboard->Sensors by vision, localisation or behaviour
+    can be half way through an update, and the joint angles used for the camera transform are the
+    ones from when the image is processed, not from when it was taken.
+
+    Instead, after each motion frame the SenseMoveThread publishes the sensors here, and the other
+    thread reads them with a SensorSnapshotReader. The snapshots are kept as SensorFrames in a ring
+    of c_history fixed size slots, each protected by a sequence lock:
+        - publish() never blocks and never allocates after the first frame. It writes the slot after
+          the latest one, making the slot's sequence odd while it is being written.
+        - A reader copies a slot and checks its sequence did not change while it was copying, so a
+          copy is never torn. The slot being written is never the latest one, so a reader only
+          retries if the writer laps the whole ring while it is copying a single frame.
+        - The latest snapshot, or the one closest to a given time, is found in O(c_history).
+
+    The slots are sized when the first frame is published, at twice its size. A frame that does not
+    fit, or that does not have the same sensors as the first, is not published and is counted in
+    dropped(). A copy of the first frame's NUSensorsData is kept so that the readers' data can be
+    set up with the same sensors and ids.
+
+    @class SensorSnapshotReader
+    @brief Reads coherent copies of the NUSensorsData published to a SensorSnapshots
+
+    Each thread reading the snapshots needs its own reader, which holds the copy buffer. The first
+    time a reader copies into a NUSensorsData the data is set up with the published sensors and ids,
+    so each reader should be used with the same NUSensorsData each time.
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SENSORSNAPSHOTS_H
+#define SENSORSNAPSHOTS_H
+
+#include "SensorFrame.h"
+#include "NUSensorsData.h"
+
+class SensorSnapshots
+{
+public:
+    static const unsigned int c_history = 16;   //!< the number of snapshots kept
+
+    SensorSnapshots();
+    ~SensorSnapshots();
+
+    bool publish(const NUSensorsData& data);
+
+    unsigned int published() const;
+    unsigned int dropped() const {return m_dropped;}
+
+private:
+    friend class SensorSnapshotReader;
+
+    //! A snapshot. Everything except the sequence is only valid if the sequence is even and unchanged after reading it
+    struct Slot
+    {
+        volatile unsigned int Sequence;         //!< incremented before and after each write, so it is odd while the slot is written
+        double Timestamp;                       //!< the timestamp of the data
+        double PreviousTime;                    //!< the timestamp of the data before it
+        unsigned int ShapeSize;                 //!< the number of shape words
+        unsigned int WordsSize;                 //!< the number of data words
+        uint32_t* Data;                         //!< the shape followed by the words, m_capacity long
+    };
+
+    bool read(unsigned int index, SensorFrame& frame, double& previous) const;
+
+    Slot m_slots[c_history];
+    uint32_t* m_storage;                        //!< the storage for all of the slots' data
+    unsigned int m_capacity;                    //!< the number of words in each slot
+    NUSensorsData m_template;                   //!< a copy of the first data published, set when the slots are allocated
+    SensorFrame m_frame;                        //!< the frame being published, kept to avoid allocating each frame
+    volatile unsigned int m_published;          //!< the number of frames published, the latest is in slot (m_published - 1) % c_history
+    unsigned int m_dropped;                     //!< the number of frames that could not be published
+};
+
+class SensorSnapshotReader
+{
+public:
+    SensorSnapshotReader(const SensorSnapshots* snapshots = 0);
+
+    void setSnapshots(const SensorSnapshots* snapshots) {m_snapshots = snapshots;}
+    bool latest(NUSensorsData& data);
+    bool closest(double time, NUSensorsData& data);
+
+private:
+    bool restore(NUSensorsData& data);
+
+    const SensorSnapshots* m_snapshots;         //!< the snapshots read, not owned by the reader
+    const NUSensorsData* m_setup_data;          //!< the data last set up with the published sensors and ids
+    SensorFrame m_frame;                        //!< the copy of the last snapshot read
+    double m_previous_time;                     //!< the previous time of the last snapshot read
+};
+
+#endif
+
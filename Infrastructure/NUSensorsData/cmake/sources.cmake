@@ -22,6 +22,8 @@ ENDIF()
 ########## List your source files here! ############################################
 SET (YOUR_SRCS  NUSensorsData.cpp NUSensorsData.h
                 Sensor.cpp Sensor.h
+                SensorFrame.cpp SensorFrame.h
+                SensorSnapshots.cpp SensorSnapshots.h
 		NULocalisationSensors.cpp NULocalisationSensors.h
 )
 ####################################################################################
@@ -1,51 +1,76 @@
 #include "EndEffector.h"
 #include "debug.h"
 #include <assert.h>
+using namespace TransformMatrices;
 
 EndEffector::EndEffector(const Matrix& startTrans, const std::vector<Link>& endEffectorlinks, const Matrix& endTrans, const std::string& effectorName):
         m_startTransform(startTrans), m_links(endEffectorlinks), m_endTransform(endTrans), m_name(effectorName)
 {
     m_transforms.resize(m_links.size());
+    m_jointValues.assign(m_links.size(), 0.0f);
+    updateChain(0);
 }
 
-void EndEffector::UpdateModel(std::vector<float> jointValues)
+void EndEffector::UpdateModel(const std::vector<float>& jointValues)
 {
-    Matrix result(m_startTransform);
-    if(jointValues.size() != m_links.size())
+    if(jointValues.empty())
+        UpdateModel(NULL, 0);
+    else
+        UpdateModel(&jointValues[0], jointValues.size());
+}
+
+/*! @brief Updates the transforms of the effector to the given joint values.
+
+    Only the links from the first joint that has changed onwards are recalculated, and only the links
+    whose joint has changed recalculate their own transform. Nothing is allocated.
+    @param jointValues the value of each joint in the chain
+    @param numValues the number of joint values, which must match the number of links
+    @return true if the model was updated, false if the number of joint values was wrong
+ */
+bool EndEffector::UpdateModel(const float* jointValues, unsigned int numValues)
+{
+    if(numValues != m_links.size())
     {
         errorlog << "EndEffector::CalculateTransform - Joint values do not match links. ";
-        errorlog << m_links.size() << " Links but only " << jointValues.size() << " joint values given." << std::endl;
+        errorlog << m_links.size() << " Links but only " << numValues << " joint values given." << std::endl;
+        return false;
     }
-    else
+
+    unsigned int first = 0;
+    while(first < numValues and jointValues[first] == m_jointValues[first])
+        ++first;
+    if(first == numValues)
+        return true;        // Nothing has moved.
+
+    for(unsigned int i = first; i < numValues; ++i)
+        m_jointValues[i] = jointValues[i];
+    updateChain(first);
+    return true;
+}
+
+/*! @brief Recalculates the transforms from link first to the end of the effector, using m_jointValues.
+ */
+void EndEffector::updateChain(unsigned int first)
+{
+    assert(m_links.size() == m_transforms.size());
+    const FixedMatrix<4,4>* previous = first == 0 ? &m_startTransform : &m_transforms[first - 1];
+    for(unsigned int i = first; i < m_links.size(); ++i)
     {
-        // Check stuff is ok.
-        assert(m_links.size() == jointValues.size());
-        assert(m_links.size() == m_transforms.size());
-        // Make iterators
-        std::vector<Link>::const_iterator endLinks = m_links.end();
-        std::vector<Link>::iterator currLink = m_links.begin();
-        std::vector<float>::iterator currJointAngle = jointValues.begin();
-        std::vector<Matrix>::iterator currTransform = m_transforms.begin();
-        // Loop through the joints.
-        while (currLink != endLinks)
-        {
-            result = result * currLink->calculateTransform(*currJointAngle);
-            (*currTransform) = result; // Save transform
-            ++currLink;
-            ++currJointAngle;
-            ++currTransform;
-        }
+        MultiplyTransforms(*previous, m_links[i].transform(m_jointValues[i]), m_transforms[i]);
+        previous = &m_transforms[i];
     }
+    MultiplyTransforms(*previous, m_endTransform, m_endPosition);
 }
 
 Matrix EndEffector::EndPosition() const
 {
-    return m_transforms.back() * m_endTransform;
+    return m_endPosition;
 }
 
-Matrix EndEffector::CalculateTransform(std::vector<float> jointValues)
+Matrix EndEffector::CalculateTransform(const std::vector<float>& jointValues)
 {
-    Matrix result(m_startTransform);
+    FixedMatrix<4,4> result(m_startTransform);
+    FixedMatrix<4,4> temp;
     if(jointValues.size() != m_links.size())
     {
         errorlog << "EndEffector::CalculateTransform - Joint values do not match links. ";
@@ -53,17 +78,12 @@ Matrix EndEffector::CalculateTransform(std::vector<float> jointValues)
     }
     else
     {
-        // Make iterators
-        std::vector<Link>::const_iterator endLinks = m_links.end();
-        std::vector<Link>::iterator currLink = m_links.begin();
-        std::vector<float>::iterator currJointAngle = jointValues.begin();
-        while (currLink != endLinks)
+        for(unsigned int i = 0; i < m_links.size(); ++i)
         {
-            result = result * currLink->calculateTransform(*currJointAngle);
-            ++currLink;
-            ++currJointAngle;
+            MultiplyTransforms(result, m_links[i].transform(jointValues[i]), temp);
+            result = temp;
         }
     }
-    result = result * m_endTransform;
-    return result;
+    MultiplyTransforms(result, m_endTransform, temp);
+    return temp;
 }
@@ -2,24 +2,31 @@
 #define ENDEFFECTOR_H
 #include <vector>
 #include "Tools/Math/Matrix.h"
+#include "Tools/Math/FixedMatrix.h"
 #include "Link.h"
 
 class EndEffector
 {
-    Matrix m_startTransform;
+    FixedMatrix<4,4> m_startTransform;
     std::vector<Link> m_links;
-    std::vector<Matrix> m_transforms;
-    Matrix m_endTransform;
+    std::vector<FixedMatrix<4,4> > m_transforms;    //!< the transform to the end of each link
+    std::vector<float> m_jointValues;               //!< the joint values m_transforms were calculated with
+    FixedMatrix<4,4> m_endTransform;
+    FixedMatrix<4,4> m_endPosition;                 //!< the transform to the end of the effector
     std::string m_name;
 
+    void updateChain(unsigned int first);
+
 public:
     EndEffector(const Matrix& startTrans,
                 const std::vector<Link>& endEffectorlinks,
                 const Matrix& endTrans,
                 const std::string& effectorName = std::string("Unknown"));
-    Matrix CalculateTransform(std::vector<float> jointValues);
-    void UpdateModel(std::vector<float> jointValues);
+    Matrix CalculateTransform(const std::vector<float>& jointValues);
+    void UpdateModel(const std::vector<float>& jointValues);
+    bool UpdateModel(const float* jointValues, unsigned int numValues);
     Matrix EndPosition() const;
+    const FixedMatrix<4,4>& EndTransform() const {return m_endPosition;}
     std::string name() const {return m_name;}
     const std::vector<Link>* links() const {return &m_links;}
 };
@@ -243,11 +243,21 @@ void Kinematics::UpdateEffector(unsigned int index, const std::vector<float>& jo
     m_endEffectors[index].UpdateModel(jointValues);
 }
 
+bool Kinematics::UpdateEffector(unsigned int index, const float* jointValues, unsigned int numValues)
+{
+    return m_endEffectors[index].UpdateModel(jointValues, numValues);
+}
+
 Matrix Kinematics::EndEffectorPosition(unsigned int index) const
 {
     return m_endEffectors[index].EndPosition();
 }
 
+const FixedMatrix<4,4>& Kinematics::EndEffectorTransform(unsigned int index) const
+{
+    return m_endEffectors[index].EndTransform();
+}
+
 Matrix Kinematics::CalculateTransform(unsigned int index, const std::vector<float>& jointValues)
 {
     return m_endEffectors[index].CalculateTransform(jointValues);
@@ -316,6 +326,16 @@ Matrix Kinematics::CalculateCamera2GroundTransform(const Matrix& origin2SupportL
     return Translation(legOffsetX,legOffsetY,0)* InverseMatrix(origin2SupportLegTransform) * origin2CameraTransform;
 }
 
+FixedMatrix<4,4> Kinematics::CalculateCamera2GroundTransform(const FixedMatrix<4,4>& origin2SupportLegTransform, const FixedMatrix<4,4>& origin2CameraTransform)
+{
+    FixedMatrix<4,4> result;
+    MultiplyTransforms(InverseTransform(origin2SupportLegTransform), origin2CameraTransform, result);
+    // Translation(legOffsetX, legOffsetY, 0) only adds the offsets to the translation of the result
+    result[0][3] += origin2SupportLegTransform[0][3];
+    result[1][3] += origin2SupportLegTransform[1][3];
+    return result;
+}
+
 std::vector<double> Kinematics::TransformPosition(const Matrix& Camera2GroundTransform, const std::vector<double>& cameraBasedPosition)
 {
     Matrix cameraBasedPosMatrix(3,1);
@@ -80,7 +80,9 @@ public:
     static Link LinkFromText(const std::string& text);
 
     void UpdateEffector(unsigned int index, const std::vector<float>& jointValues);
+    bool UpdateEffector(unsigned int index, const float* jointValues, unsigned int numValues);
     Matrix EndEffectorPosition(unsigned int index) const;
+    const FixedMatrix<4,4>& EndEffectorTransform(unsigned int index) const;
     //Vector3<float> calculateCentreOfMass();
 
 
@@ -105,6 +107,7 @@ public:
     * @return Transform matrix from the camera to the ground space.
     */
     static Matrix CalculateCamera2GroundTransform(const Matrix& origin2SupportLegTransform, const Matrix& origin2Camera);
+    static FixedMatrix<4,4> CalculateCamera2GroundTransform(const FixedMatrix<4,4>& origin2SupportLegTransform, const FixedMatrix<4,4>& origin2Camera);
 
     /*!
     * @brief Calculates the position of an object in sperical coordinates centred at the robot feet, given the position in an image.
@@ -172,10 +175,23 @@ public:
     static std::vector<float> PositionFromTransform(const Matrix& transformMatrix)
     {
         std::vector<float> result(3,0.0f);
+        PositionFromTransform(transformMatrix, result);
+        return result;
+    }
+
+    /*!
+    * @brief Calculate position in relative 3D space from a 4x4 transform matrix, without allocating.
+    *
+    * @param transformMatrix The transform matrix, either a Matrix or a FixedMatrix<4,4>, from which to extract a position.
+    * @param result Will be updated with the 3D position in terms of x, y, and z.
+    */
+    template <typename T>
+    static void PositionFromTransform(const T& transformMatrix, std::vector<float>& result)
+    {
+        result.resize(3);
         result[0] = transformMatrix[0][3];
         result[1] = transformMatrix[1][3];
         result[2] = transformMatrix[2][3];
-        return result;
     }
 
     /*!
@@ -186,8 +202,22 @@ public:
     */
     static std::vector<float> OrientationFromTransform(const Matrix& transformMatrix)
     {
-		// Derived from matrix formed by RotZ(psi)*RotY(theta)*RotX(Phi)
         std::vector<float> result(3,0.0f);
+        OrientationFromTransform(transformMatrix, result);
+        return result;
+    }
+
+    /*!
+    * @brief Calculate orientation in relative 3D space from a 4x4 transform matrix, without allocating.
+    *
+    * @param transformMatrix The transform matrix, either a Matrix or a FixedMatrix<4,4>, from which to extract an orientation.
+    * @param result Will be updated with the 3D orientation in terms of x rotation, y rotation, and z rotaion.
+    */
+    template <typename T>
+    static void OrientationFromTransform(const T& transformMatrix, std::vector<float>& result)
+    {
+		// Derived from matrix formed by RotZ(psi)*RotY(theta)*RotX(Phi)
+        result.resize(3);
         result[1] = asin(transformMatrix[2][0]);
         result[0] = -atan2(transformMatrix[2][1], transformMatrix[2][2]);
         result[2] = atan2(transformMatrix[1][0], transformMatrix[0][0]);
@@ -200,8 +230,6 @@ public:
 		{
 			result[2] = mathGeneral::normaliseAngle(result[2] + mathGeneral::PI);
 		}
-
-        return result;
     }
 
     /*!
@@ -1,10 +1,20 @@
 #include "Link.h"
+#include <cmath>
 using namespace TransformMatrices;
 Link::Link(const TransformMatrices::DHParameters& linkParameters, const std::string& linkName):
         m_name(linkName), m_parameters(linkParameters)
 {
-    m_bufferedAngle = 0.0f;
-    m_bufferedTransform = ModifiedDH(m_parameters, m_bufferedAngle);
+    // Only theta changes with the joint, so the rest of the modified D-H transform is fixed.
+    m_sinAlpha = sin(m_parameters.alpha);
+    m_cosAlpha = cos(m_parameters.alpha);
+    m_bufferedTransform[0][2] = 0.0;
+    m_bufferedTransform[0][3] = m_parameters.a;
+    m_bufferedTransform[1][2] = -m_sinAlpha;
+    m_bufferedTransform[1][3] = -m_parameters.d*m_sinAlpha;
+    m_bufferedTransform[2][2] = m_cosAlpha;
+    m_bufferedTransform[2][3] = m_parameters.d*m_cosAlpha;
+    m_bufferedTransform[3][3] = 1.0;
+    updateTransform(0.0);
 }
 
 
@@ -14,11 +24,34 @@ Link::~Link()
 }
 
 Matrix Link::calculateTransform(double angle)
+{
+    return transform(angle);
+}
+
+/*! @brief Returns the modified D-H transform of the link at the given joint angle.
+    The transform is only recalculated when the angle is different to the last call.
+ */
+const FixedMatrix<4,4>& Link::transform(double angle)
 {
     if(angle != m_bufferedAngle)
-    {
-        m_bufferedTransform = ModifiedDH(m_parameters, angle);
-        m_bufferedAngle = angle;
-    }
+        updateTransform(angle);
     return m_bufferedTransform;
 }
+
+void Link::updateTransform(double angle)
+{
+    //[            cos(theta),           -sin(theta),           0,             a]
+    //[ cos(alpha)*sin(theta), cos(alpha)*cos(theta), -sin(alpha), -d*sin(alpha)]
+    //[ sin(alpha)*sin(theta), sin(alpha)*cos(theta),  cos(alpha),  d*cos(alpha)]
+    //[                     0,                     0,           0,             1]
+    double thetaTotal = m_parameters.thetaOffset + angle;
+    double st = sin(thetaTotal);
+    double ct = cos(thetaTotal);
+    m_bufferedTransform[0][0] = ct;
+    m_bufferedTransform[0][1] = -st;
+    m_bufferedTransform[1][0] = m_cosAlpha*st;
+    m_bufferedTransform[1][1] = m_cosAlpha*ct;
+    m_bufferedTransform[2][0] = m_sinAlpha*st;
+    m_bufferedTransform[2][1] = m_sinAlpha*ct;
+    m_bufferedAngle = angle;
+}
@@ -9,13 +9,18 @@ public:
     Link(const TransformMatrices::DHParameters& linkParameters, const std::string& linkName = std::string("Unknown"));
     ~Link();
     Matrix calculateTransform(double angle);
+    const FixedMatrix<4,4>& transform(double angle);
     std::string name() const {return m_name;}
 private:
+    void updateTransform(double angle);
+
     std::string m_name;
     TransformMatrices::DHParameters m_parameters;
     // Cached values to increase efficiency with multiple calls.
+    double m_sinAlpha;
+    double m_cosAlpha;
     double m_bufferedAngle;
-    Matrix m_bufferedTransform;
+    FixedMatrix<4,4> m_bufferedTransform;
 };
 
 #endif // LINK_H
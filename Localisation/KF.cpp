@@ -52,7 +52,7 @@ KF::KF():odom_Model(0.07,0.00005,0.00005,0.000005)
   m_toBeActivated = false; // Model to be in use.
 
 // Update Uncertainty
-  updateUncertainties = Matrix(7, 7, true);
+  updateUncertainties = StateMatrix(true);
   updateUncertainties[5][5] = c_ballDecayRate; // Ball velocity x
   updateUncertainties[6][6] = c_ballDecayRate; // Ball velocity y
   updateUncertainties[3][5] = 1.0f/30.0f; // [ballX][ballXvelocity]
@@ -61,7 +61,7 @@ KF::KF():odom_Model(0.07,0.00005,0.00005,0.000005)
   init();									//Initialisation of Xhat and S
 
 // Process Noise - Matrix Square Root of Q
-  sqrtOfProcessNoise = Matrix(7,7,true);
+  sqrtOfProcessNoise = StateMatrix(true);
   sqrtOfProcessNoise[0][0] = 0.2; // Robot X coord.
   sqrtOfProcessNoise[1][1] = 0.2; // Robot Y coord.
   sqrtOfProcessNoise[2][2] = 0.005; // Robot Theta. 0.00001
@@ -90,7 +90,7 @@ KF::KF():odom_Model(0.07,0.00005,0.00005,0.000005)
 //  sqrtOfProcessNoiseReset[3][3] = 20.0; // ball itself shouldn't have moved much?
 //  sqrtOfProcessNoiseReset[4][4] = 20.0; // just being cautious
 	
-  sqrtOfProcessNoiseReset = Matrix(7,7,false);
+  sqrtOfProcessNoiseReset = StateMatrix();
   sqrtOfProcessNoiseReset[0][0] = 150.0; // extra 50cm sd when kidnapped?
   sqrtOfProcessNoiseReset[1][1] = 100.0; // extra 50cm sd when kidnapped?
   //sqrtOfProcessNoiseReset[2][2] = 0.25; // extra 15deg shift when kidnapped? 0.25
@@ -102,10 +102,7 @@ KF::KF():odom_Model(0.07,0.00005,0.00005,0.000005)
   nStates = stateEstimates.getm(); // number of states.
 
 
-  const unsigned int numSigmaPoints = 2*nStates+1;
-
   // Create square root of W matrix
-  sqrtOfTestWeightings = Matrix(1,numSigmaPoints,false);
   sqrtOfTestWeightings[0][0] = sqrt(c_Kappa/(nStates+c_Kappa));
   double outerWeighting = sqrt(1.0/(2*(nStates+c_Kappa)));
   for(int i=1; i <= 2*nStates; i++)
@@ -119,11 +116,11 @@ KF::KF():odom_Model(0.07,0.00005,0.00005,0.000005)
 
 void KF::init(){
   // Initial state estimates
-    stateEstimates= Matrix(7,1,true);
+    stateEstimates = StateVector();
     stateEstimates[2][0]=3+3.1416/2.0; // 0 for all values but robot bearing = 3.
   // S = Standard deviation matrix.
   // Initial Uncertainty
-    stateStandardDeviations = Matrix(7,7,false);
+    stateStandardDeviations = StateMatrix();
     stateStandardDeviations[0][0] = 150; // 100 cm
     stateStandardDeviations[1][1] = 100; // 150 cm
     stateStandardDeviations[2][2] = 2;   // 2 radians
@@ -193,8 +190,7 @@ void KF::performFiltering(double odom_X, double odom_Y, double odom_Theta)
 	// Step 2 : Calculate new sigma points based on previous covariance
 	double sigmaAngleMax = 2.5;               // required for normalising Angle
 	
-        Matrix sigmaPoints = CalculateSigmaPoints();
-        const unsigned int numSigmaPoints = sigmaPoints.getn();
+        SigmaPoints sigmaPoints = CalculateSigmaPoints();
 	//-----------------------------------------------------------------------------------------------
 	
 	
@@ -225,7 +221,7 @@ void KF::performFiltering(double odom_X, double odom_Y, double odom_Theta)
 	
 	
 	// Step 4: Calculate new state based on propagated sigma points and the weightings of the sigmaPoints
-	Matrix newStateEstimates(stateEstimates.getm(),stateEstimates.getn(), false);
+	StateVector newStateEstimates;
 	
         for(int i=0; i < numSigmaPoints; i++)
 	{
@@ -235,8 +231,7 @@ void KF::performFiltering(double odom_X, double odom_Y, double odom_Theta)
 	//-----------------------------------------------------------------------------------------------
 	
 	// Step 5: Calculate measurement error and then find new srukfSx
-	Matrix newSrukfSx(stateStandardDeviations.getm(),stateStandardDeviations.getn(), false);
-	Matrix Mx(sigmaPoints.getm(),sigmaPoints.getn(), false);
+	SigmaPoints Mx;
   	
         for(int i=0; i < numSigmaPoints; i++)
 	{
@@ -325,18 +320,14 @@ KfUpdateResult KF::odometeryUpdate(double odom_X, double odom_Y, double odom_The
 	
 // 	std::cout << "Calculating sigma points." << std::endl;
   // Unscented KF Stuff.
-	Matrix yBar;                                  	//reset
-	Matrix Py;
-	Matrix Pxy=Matrix(7, 2, false);                    //Pxy=[0;0;0];
-        Matrix scriptX = CalculateSigmaPoints();
-        const unsigned int numSigmaPoints = scriptX.getn();
+        SigmaPoints scriptX = CalculateSigmaPoints();
 
 	//----------------------------------------------------------------
 // 	std::cout << "Running motion model." << std::endl;
 	Pose2D oldPose, diffOdom;
         double *newPose;
 
-        Matrix sigmaPoints = scriptX;
+        SigmaPoints sigmaPoints = scriptX;
 
         for (int i = 0 ; i < scriptX.getn(); i++)
 	{
@@ -362,8 +353,8 @@ KfUpdateResult KF::odometeryUpdate(double odom_X, double odom_Y, double odom_The
 //   std::cout << "Calculating new mean and variance." << std::endl;
     
   // Update Mean
-	Matrix newStateEstimates(stateEstimates.getm(),stateEstimates.getn(), false);
-	Matrix newCovariance(stateStandardDeviations.getm(),stateStandardDeviations.getn(), false);
+	StateVector newStateEstimates;
+	StateMatrix newCovariance;
 
 //   std::cout << "Calculating Mean." << std::endl;
         for(int i=0; i < numSigmaPoints; i++){
@@ -371,7 +362,7 @@ KfUpdateResult KF::odometeryUpdate(double odom_X, double odom_Y, double odom_The
 	}
 	cout<<"New Mean    = ["<<newStateEstimates[0][0]<<", "<<newStateEstimates[1][0]<<", "<<newStateEstimates[1][0]<<" ]"<<endl;
 // std::cout << "Calculating Covariance." << std::endl;
-	Matrix temp;
+	StateVector temp;
   // Update Covariance
         for(int i=0; i < numSigmaPoints; i++){
 		temp = sigmaPoints.getCol(i) - newStateEstimates;
@@ -393,44 +384,43 @@ KfUpdateResult KF::ballmeas(double Ballmeas, double theta_Ballmeas){
   double R_bearing = c_R_ball_theta;
     
   // Calculate update uncertainties - S_ball_rel & R_ball_rel.
-  Matrix S_ball_rel = Matrix(2,2,false);
+  FixedMatrix<2,2> S_ball_rel;
   S_ball_rel[0][0] = cos(theta_Ballmeas) * sqrt(R_range);
   S_ball_rel[0][1] = -sin(theta_Ballmeas) * Ballmeas * sqrt(R_bearing);
   S_ball_rel[1][0] = sin(theta_Ballmeas) * sqrt(R_range);
   S_ball_rel[1][1] = cos(theta_Ballmeas) * Ballmeas * sqrt(R_bearing);
 
-  Matrix R_ball_rel = S_ball_rel * S_ball_rel.transp();  // R = S^2
+  FixedMatrix<2,2> R_ball_rel = S_ball_rel * S_ball_rel.transp();  // R = S^2
 
-  Matrix yBar;                                  	//reset
-  Matrix Py;
-  Matrix Pxy = Matrix(7,2,false);                    //Pxy=[0;0;0];
+  FixedMatrix<2,1> yBar;                                  	//reset
+  FixedMatrix<2,2> Py;
+  FixedMatrix<numStates,2> Pxy;                    //Pxy=[0;0;0];
 
-  Matrix scriptX = CalculateSigmaPoints();
-  const unsigned int numSigmaPoints = scriptX.getn();
+  SigmaPoints scriptX = CalculateSigmaPoints();
 
-  Matrix scriptY = Matrix(2, numSigmaPoints, false);
-  Matrix temp = Matrix(2,1,false);
+  FixedMatrix<2,numSigmaPoints> scriptY;
+  FixedMatrix<2,1> temp;
   for(int i = 0; i < numSigmaPoints; i++){
     temp[0][0] = (scriptX[3][i] - scriptX[0][i]) * cos(scriptX[2][i]) + (scriptX[4][i] - scriptX[1][i]) * sin(scriptX[2][i]);
     temp[1][0] = -(scriptX[3][i] - scriptX[0][i]) * sin(scriptX[2][i]) + (scriptX[4][i] - scriptX[1][i]) * cos(scriptX[2][i]);
     scriptY.setCol(i,temp.getCol(0));
   }
     
-  Matrix Mx = Matrix(scriptX.getm(), numSigmaPoints, false);
-  Matrix My = Matrix(scriptY.getm(), numSigmaPoints, false);
+  SigmaPoints Mx;
+  FixedMatrix<2,numSigmaPoints> My;
   for(int i = 0; i < numSigmaPoints; i++){
     Mx.setCol(i, sqrtOfTestWeightings[0][i] * scriptX.getCol(i));
     My.setCol(i, sqrtOfTestWeightings[0][i] * scriptY.getCol(i));
   }                                      
 
-  Matrix M1 = sqrtOfTestWeightings;
+  FixedMatrix<1,numSigmaPoints> M1 = sqrtOfTestWeightings;
   yBar = My * M1.transp(); // Predicted Measurement
   Py = (My - yBar * M1) * (My - yBar * M1).transp();
   Pxy = (Mx - stateEstimates * M1) * (My -yBar * M1).transp();
     
-  Matrix K = Pxy * Invert22(Py + R_ball_rel);   // Kalman Filter Gain.
+  FixedMatrix<numStates,2> K = Pxy * Invert22(Py + R_ball_rel);   // Kalman Filter Gain.
 
-  Matrix y = Matrix(2,1,false); // Measurement.
+  FixedMatrix<2,1> y; // Measurement.
   y[0][0] = ballX_rel;
   y[1][0] = ballY_rel;
 	
@@ -647,21 +637,20 @@ KfUpdateResult KF::fieldObjectmeas(double distance,double bearing,double objX, d
   //if(not_goal && INGORE_RANGE) R_range= 22500;	//150^2
 
   // Calculate update uncertainties - S_obj_rel & R_obj_rel
-  Matrix S_obj_rel = Matrix(2,2,false);
+  FixedMatrix<2,2> S_obj_rel;
   S_obj_rel[0][0] = sqrt(R_range);
   S_obj_rel[1][1] = sqrt(R_bearing);
 
-  Matrix R_obj_rel = S_obj_rel * S_obj_rel.transp(); // R = S^2
+  FixedMatrix<2,2> R_obj_rel = S_obj_rel * S_obj_rel.transp(); // R = S^2
 
   // Unscented KF Stuff.
-  Matrix yBar;                                  	//reset
-  Matrix Py;
-  Matrix Pxy=Matrix(7, 2, false);                    //Pxy=[0;0;0];
-  Matrix scriptX = CalculateSigmaPoints();
-  const unsigned int numSigmaPoints = scriptX.getn();
+  FixedMatrix<2,1> yBar;                                  	//reset
+  FixedMatrix<2,2> Py;
+  FixedMatrix<numStates,2> Pxy;                    //Pxy=[0;0;0];
+  SigmaPoints scriptX = CalculateSigmaPoints();
         //----------------------------------------------------------------
-  Matrix scriptY = Matrix(2, numSigmaPoints, false);
-  Matrix temp = Matrix(2, 1, false);
+  FixedMatrix<2,numSigmaPoints> scriptY;
+  FixedMatrix<2,1> temp;
 
   double dX,dY,Cc,Ss;
 
@@ -673,21 +662,21 @@ KfUpdateResult KF::fieldObjectmeas(double distance,double bearing,double objX, d
         temp[1][0] = normaliseAngle(atan2(dY,dX) - scriptX[2][i]);
         scriptY.setCol(i, temp.getCol(0));
   }
-  Matrix Mx = Matrix(scriptX.getm(), numSigmaPoints, false);
-  Matrix My = Matrix(scriptY.getm(), numSigmaPoints, false);
+  SigmaPoints Mx;
+  FixedMatrix<2,numSigmaPoints> My;
   for(int i = 0; i < numSigmaPoints; i++){
     Mx.setCol(i, sqrtOfTestWeightings[0][i] * scriptX.getCol(i));
     My.setCol(i, sqrtOfTestWeightings[0][i] * scriptY.getCol(i));
   }
 
-  Matrix M1 = sqrtOfTestWeightings;
+  FixedMatrix<1,numSigmaPoints> M1 = sqrtOfTestWeightings;
   yBar = My * M1.transp(); // Predicted Measurement.
   Py = (My - yBar * M1) * (My - yBar * M1).transp();
   Pxy = (Mx - stateEstimates * M1) * (My - yBar * M1).transp();
 
-  Matrix K = Pxy * Invert22(Py + R_obj_rel); // K = Kalman filter gain.
+  FixedMatrix<numStates,2> K = Pxy * Invert22(Py + R_obj_rel); // K = Kalman filter gain.
 
-  Matrix y = Matrix(2,1,false); // Measurement. I terms of relative (x,y).
+  FixedMatrix<2,1> y; // Measurement. I terms of relative (x,y).
   y[0][0] = distance;
   y[1][0] = bearing;
 
@@ -750,31 +739,30 @@ void KF::linear2MeasurementUpdate(double Y1,double Y2, double SR11, double SR12,
   //
   // Example Call (given data from wireless: ballX, ballY, SRballXX, SRballXY, SRballYY)
   //      linear2MeasurementUpdate( ballX, ballY, SRballXX, SRballXY, SRballYY, 3, 4 )
-  Matrix SR = Matrix(2,2,false);
+  FixedMatrix<2,2> SR;
   SR[0][0] = SR11;
   SR[0][1] = SR12;
   SR[1][1] = SR22;
 
-  Matrix R = Matrix(2,2,false);
-  R = SR * SR.transp();
+  FixedMatrix<2,2> R = SR * SR.transp();
 
-  Matrix Py = Matrix(2, 2, false);
-  Matrix Pxy = Matrix(7, 2, false);                   
+  FixedMatrix<2,2> Py;
+  FixedMatrix<numStates,2> Pxy;
  
-  Matrix CS = Matrix(2, 7, false);
+  FixedMatrix<2,numStates> CS;
   CS.setRow(0, stateStandardDeviations.getRow(index1));
   CS.setRow(1, stateStandardDeviations.getRow(index2));
 
   Py = CS * CS.transp();
   Pxy = stateStandardDeviations * CS.transp();
 
-  Matrix K = Pxy * Invert22(Py + R);   //Invert22
+  FixedMatrix<numStates,2> K = Pxy * Invert22(Py + R);   //Invert22
 
-  Matrix y = Matrix(2, 1, false);
+  FixedMatrix<2,1> y;
   y[0][0] = Y1;
   y[1][0] = Y2;
     
-  Matrix yBar = Matrix(2, 1, false); //Estimated values of the measurements Y1,Y2
+  FixedMatrix<2,1> yBar; //Estimated values of the measurements Y1,Y2
   yBar[0][0] = stateEstimates[index1][0];
   yBar[1][0] = stateEstimates[index2][0]; 
 	//RHM: (3) Outlier rejection.
@@ -823,11 +811,10 @@ KfUpdateResult KF::updateAngleBetween(double angle, double x1, double y1, double
     // Unscented KF Stuff.
     double yBar;                                  	//reset
     double Py;
-    Matrix Pxy = Matrix(7, 1, false);                    //Pxy=[0;0;0];
-    Matrix scriptX = CalculateSigmaPoints();
-    const unsigned int numSigmaPoints = scriptX.getn();
+    StateVector Pxy;                    //Pxy=[0;0;0];
+    SigmaPoints scriptX = CalculateSigmaPoints();
     //----------------------------------------------------------------
-    Matrix scriptY = Matrix(1, numSigmaPoints, false);
+    FixedMatrix<1,numSigmaPoints> scriptY;
 
     double angleToObj1;
     double angleToObj2;
@@ -839,22 +826,22 @@ KfUpdateResult KF::updateAngleBetween(double angle, double x1, double y1, double
         scriptY[0][i] = normaliseAngle(angleToObj1 - angleToObj2);
     }
 
-    Matrix Mx = Matrix(scriptX.getm(), numSigmaPoints, false);
-    Matrix My = Matrix(scriptY.getm(), numSigmaPoints, false);
+    SigmaPoints Mx;
+    FixedMatrix<1,numSigmaPoints> My;
     for (int i = 0; i < numSigmaPoints; i++)
     {
         Mx.setCol(i, sqrtOfTestWeightings[0][i] * scriptX.getCol(i));
         My.setCol(i, sqrtOfTestWeightings[0][i] * scriptY.getCol(i));
     }
 
-    Matrix M1 = sqrtOfTestWeightings;
+    FixedMatrix<1,numSigmaPoints> M1 = sqrtOfTestWeightings;
     yBar = convDble ( My * M1.transp() ); // Predicted Measurement.
     Py = convDble ((My - yBar * M1) * (My - yBar * M1).transp());
     Pxy = (Mx - stateEstimates * M1) * (My - yBar * M1).transp();
 
     R_angle  = sd_angle * sd_angle;
 
-    Matrix K = Pxy /( Py + R_angle ); // K = Kalman filter gain.
+    StateVector K = Pxy /( Py + R_angle ); // K = Kalman filter gain.
 
     double y = angle;    //end of standard ukf stuff
     //Outlier rejection.
@@ -898,7 +885,10 @@ double KF::state(int stateID) const
 
 Matrix KF::GetBallSR() const
 {
-  return HT(vertcat(stateStandardDeviations.getRow(3), stateStandardDeviations.getRow(4)));
+  FixedMatrix<2,numStates> ballRows;
+  ballRows.setRow(0, stateStandardDeviations.getRow(3));
+  ballRows.setRow(1, stateStandardDeviations.getRow(4));
+  return HT(ballRows);
 }
 
 
@@ -934,7 +924,7 @@ bool KF::clipState(int stateIndex, double minValue, double maxValue){
     bool clipped = false;
 	if(stateEstimates[stateIndex][0] > maxValue){
 		double mult, Pii;
-		Matrix Si;
+		FixedMatrix<1,numStates> Si;
 		Si = stateStandardDeviations.getRow(stateIndex);
 		Pii = convDble(Si * Si.transp());
 		mult = (stateEstimates[stateIndex][0] - maxValue) / Pii;
@@ -944,7 +934,7 @@ bool KF::clipState(int stateIndex, double minValue, double maxValue){
 	}
 	if(stateEstimates[stateIndex][0] < minValue){
 		double mult, Pii;
-		Matrix Si;
+		FixedMatrix<1,numStates> Si;
 		Si = stateStandardDeviations.getRow(stateIndex);
 		Pii = convDble(Si * Si.transp());
 		mult = (stateEstimates[stateIndex][0] - minValue) / Pii;
@@ -956,10 +946,9 @@ bool KF::clipState(int stateIndex, double minValue, double maxValue){
     return clipped;
 }
 
-Matrix KF::CalculateSigmaPoints() const
+KF::SigmaPoints KF::CalculateSigmaPoints() const
 {
-    const unsigned int numSigmaPoints = 2 * nStates + 1;
-    Matrix sigmaPoints = Matrix(stateEstimates.getm(), numSigmaPoints, false);
+    SigmaPoints sigmaPoints;
     sigmaPoints.setCol(0, stateEstimates);                         //scriptX(:,1)=Xhat;
 
 //----------------Saturate ScriptX angle sigma points to not wrap
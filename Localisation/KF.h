@@ -5,6 +5,7 @@
 
 #include <math.h>
 #include "Tools/Math/Matrix.h"
+#include "Tools/Math/FixedMatrix.h"
 #include "odometryMotionModel.h"
 #include <string>
 enum KfUpdateResult
@@ -31,6 +32,11 @@ class KF {
             ballYVelocity,
             numStates
         };
+        enum {numSigmaPoints = 2*numStates + 1};
+
+        typedef FixedMatrix<numStates,1> StateVector;
+        typedef FixedMatrix<numStates,numStates> StateMatrix;
+        typedef FixedMatrix<numStates,numSigmaPoints> SigmaPoints;
 
         // Functions
 
@@ -80,21 +86,21 @@ class KF {
         */
         friend std::istream& operator>> (std::istream& input, KF& p_kf);
 
-        Matrix CalculateSigmaPoints() const;
+        SigmaPoints CalculateSigmaPoints() const;
         float CalculateAlphaWeighting(const Matrix& innovation, const Matrix& innovationVariance, float outlierLikelyhood) const;
         // Variables
 
         // Multiple Models - Model state Description.
         bool m_toBeActivated;
 
-        Matrix updateUncertainties; // Update Uncertainty. (A matrix)
-        Matrix stateEstimates; // State estimates. (Xhat Matrix)
-        Matrix stateStandardDeviations; // Standard Deviation Matrix. (S Matrix)
+        StateMatrix updateUncertainties; // Update Uncertainty. (A matrix)
+        StateVector stateEstimates; // State estimates. (Xhat Matrix)
+        StateMatrix stateStandardDeviations; // Standard Deviation Matrix. (S Matrix)
 
         int nStates; // Number of states. (Constant)
-        Matrix sqrtOfTestWeightings; // Square root of W (Constant)
-        Matrix sqrtOfProcessNoise; // Square root of Process Noise (Q matrix). (Constant)
-        Matrix sqrtOfProcessNoiseReset; // Square root of Q when resetting. (Conastant) 
+        FixedMatrix<1,numSigmaPoints> sqrtOfTestWeightings; // Square root of W (Constant)
+        StateMatrix sqrtOfProcessNoise; // Square root of Process Noise (Q matrix). (Constant)
+        StateMatrix sqrtOfProcessNoiseReset; // Square root of Q when resetting. (Conastant) 
 	
 	// Motion Model
 	OdometryMotionModel odom_Model;
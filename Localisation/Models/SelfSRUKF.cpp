@@ -32,13 +32,7 @@ SelfSRUKF::SelfSRUKF(double time): SelfModel(time)
 SelfSRUKF::SelfSRUKF(const SelfModel& source): SelfModel(source)
 {
     InitialiseCachedValues();
-    Matrix newCovariance = covariance();
-    m_sqrt_covariance = cholesky(newCovariance);
-    if(!m_sqrt_covariance.isValid())
-    {
-        m_sqrt_covariance = cholesky(newCovariance.transp());
-        assert(m_sqrt_covariance.isValid());
-    }
+    InitialiseSqrtCovariance();
 }
 
 /*! @brief Split constructor
@@ -56,13 +50,7 @@ SelfSRUKF::SelfSRUKF(const SelfModel& parent, const AmbiguousObject& object, con
     InitialiseCachedValues();
     StationaryObject update(splitOption);
     update.CopyObject(object);
-    Matrix newCovariance = covariance();
-    m_sqrt_covariance = cholesky(newCovariance);
-    if(!m_sqrt_covariance.isValid())
-    {
-        m_sqrt_covariance = cholesky(newCovariance.transp());
-        assert(m_sqrt_covariance.isValid());
-    }
+    InitialiseSqrtCovariance();
 
     SelfSRUKF::updateResult result = MeasurementUpdate(update, error);
     if(result == RESULT_OUTLIER)
@@ -76,14 +64,33 @@ SelfSRUKF::SelfSRUKF(const SelfModel& parent, const AmbiguousObject& object, con
     return;
 }
 
+/*! @brief Split constructor without the update
+
+Takes a parent filter and records a split on an ambiguous object using the given split option,
+without performing the measurement update. This is used when the updates of many split models
+are performed together in a SelfSRUKFBank.
+
+@param parent The parent model from which the split orignates.
+@param object The ambiguous object belong evaluated by the split.
+@param splitOption The option to be evaluated within this model.
+@param time The current time of the update
+*/
+SelfSRUKF::SelfSRUKF(const SelfModel& parent, const AmbiguousObject& object, const StationaryObject& splitOption, float time):
+        SelfModel(parent, object, splitOption, time)
+{
+    InitialiseCachedValues();
+    InitialiseSqrtCovariance();
+}
+
 void SelfSRUKF::setCovariance(const Matrix& newCovariance)
 {
     SelfModel::setCovariance(newCovariance);
-    m_sqrt_covariance = cholesky(newCovariance);
+    const StateMatrix covariance(newCovariance);
+    m_sqrt_covariance = cholesky(covariance);
     if(!m_sqrt_covariance.isValid())
     {
         std::cout << newCovariance << std::endl;
-        m_sqrt_covariance = cholesky(newCovariance.transp());
+        m_sqrt_covariance = cholesky(covariance.transp());
         assert(m_sqrt_covariance.isValid());
     }
     return;
@@ -95,12 +102,42 @@ void SelfSRUKF::setSqrtCovariance(const Matrix& newSqrtCovariance)
     m_sqrt_covariance = newSqrtCovariance;
 }
 
-void SelfSRUKF::InitialiseCachedValues()
+/*! @brief Sets the mean and the square root covariance, and so the covariance, without allocating.
+
+    As in Moment::setMean and Moment::setCovariance, invalid values are not stored.
+ */
+void SelfSRUKF::setState(const StateVector& newMean, const StateMatrix& newSqrtCovariance)
 {
-    const unsigned int numSigmaPoints = 2*states_total+1;
+    const StateMatrix newCovariance = newSqrtCovariance * newSqrtCovariance.transp();
+    assert(newCovariance.isValid());
+    if(newCovariance.isValid())
+    {
+        newCovariance.copyTo(m_covariance);
+        m_sqrt_covariance = newSqrtCovariance;
+    }
+    assert(newMean.isValid());
+    if(newMean.isValid())
+    {
+        newMean.copyTo(m_mean);
+    }
+}
 
+/*! @brief Calculates the square root covariance from the covariance.
+ */
+void SelfSRUKF::InitialiseSqrtCovariance()
+{
+    const StateMatrix newCovariance(m_covariance);
+    m_sqrt_covariance = cholesky(newCovariance);
+    if(!m_sqrt_covariance.isValid())
+    {
+        m_sqrt_covariance = cholesky(newCovariance.transp());
+        assert(m_sqrt_covariance.isValid());
+    }
+}
+
+void SelfSRUKF::InitialiseCachedValues()
+{
     // Create square root of W matrix
-    sqrtOfTestWeightings = Matrix(1,numSigmaPoints,false);
     sqrtOfTestWeightings[0][0] = sqrt(c_Kappa/(states_total+c_Kappa));
     double outerWeighting = sqrt(1.0/(2*(states_total+c_Kappa)));
     for(int i=1; i <= 2*states_total; i++)
@@ -108,7 +145,7 @@ void SelfSRUKF::InitialiseCachedValues()
       sqrtOfTestWeightings[0][i] = (outerWeighting);
     }
 
-    sqrtOfProcessNoise = Matrix(3,3,true);
+    sqrtOfProcessNoise = StateMatrix(true);
     sqrtOfProcessNoise[0][0] = 0.5; // Robot X coord.
     sqrtOfProcessNoise[1][1] = 0.5; // Robot Y coord.
     sqrtOfProcessNoise[2][2] = 0.0001; // Robot Theta. 0.00001
@@ -130,8 +167,7 @@ SelfSRUKF::updateResult SelfSRUKF::TimeUpdate(const std::vector<float>& odometry
     float heading = odometry[2];
 
     // Step 1 : Calculate new sigma points based on previous covariance
-    Matrix sigmaPoints = CalculateSigmaPoints();
-    const unsigned int numSigmaPoints = sigmaPoints.getn();
+    SigmaPoints sigmaPoints = CalculateSigmaPoints();
     //-----------------------------------------------------------------------------------------------
 
     // Step 3: Update the state estimate - Pass all sigma points through motion model
@@ -142,7 +178,7 @@ SelfSRUKF::updateResult SelfSRUKF::TimeUpdate(const std::vector<float>& odometry
     diffOdom.Y = y;
     diffOdom.Theta = heading;
 
-    for (unsigned int i = 0 ; i < numSigmaPoints; i++)
+    for (unsigned int i = 0 ; i < num_sigma_points; i++)
     {
         oldPose.X = sigmaPoints[0][i];
         oldPose.Y = sigmaPoints[1][i];
@@ -156,44 +192,129 @@ SelfSRUKF::updateResult SelfSRUKF::TimeUpdate(const std::vector<float>& odometry
     }
 
     // Step 4: Calculate new state based on propagated sigma points and the weightings of the sigmaPoints
-    Matrix newMean(m_mean.getm(),m_mean.getn(), false);
+    StateVector newMean;
 
-    for(unsigned int i=0; i < numSigmaPoints; i++)
+    for(unsigned int i=0; i < num_sigma_points; i++)
     {
         // Eqn 20
-        newMean = newMean + sqrtOfTestWeightings[0][i]*sqrtOfTestWeightings[0][i]*sigmaPoints.getCol(i);
+        newMean += sqrtOfTestWeightings[0][i]*sqrtOfTestWeightings[0][i]*sigmaPoints.getCol(i);
     }
     //-----------------------------------------------------------------------------------------------
 
     // Step 5: Calculate measurement error and then find new srukfSx
-    Matrix newSrukfSx(m_covariance.getm(),m_covariance.getn(), false);
-    Matrix Mx(sigmaPoints.getm(),sigmaPoints.getn(), false);
+    SigmaPoints Mx;
 
-    for(unsigned int i=0; i < numSigmaPoints; i++)
+    for(unsigned int i=0; i < num_sigma_points; i++)
     {
         // Eqn 21 part
         Mx.setCol(i, sqrtOfTestWeightings[0][i] * (sigmaPoints.getCol(i) - newMean));      // Error matrix
     }
 
     const float odomPercentage = 0.1;
-    Matrix odometryNoise(states_total, states_total, false);
+    StateMatrix odometryNoise;
     odometryNoise[states_x][states_x] = odomPercentage * x;
     odometryNoise[states_y][states_y] = odomPercentage * y;
     odometryNoise[states_heading][states_heading] = odomPercentage * heading;
 
-    Matrix new_sqrt_covariance = HT(horzcat(Mx, sqrtOfProcessNoise+odometryNoise));
-    Matrix new_mean = newMean;
-
-    setSqrtCovariance(new_sqrt_covariance);
-    setMean(new_mean);
+    setState(newMean, HT(horzcat(Mx, sqrtOfProcessNoise+odometryNoise)));
 
     return RESULT_OK;
 }
 
 
+/*! @brief  Multiple object update
+Performs a simultaneous update for N landmarks, with the sizes of the matrices fixed at compile time.
+This is the same update as MultipleObjectUpdate, but nothing is allocated.
+
+@param locations The location of the landmarks seen. Nx2 Matrix.
+@param measurements The measurements obtained to these landmarks. Nx2 Matrix.
+@param R_Measurement The measurment noise of the updates. Nx2 Matrix.
+
+@return The result of the update. RESULT_OK if update was successful, RESULT_OUTLIER if the update was ignored.
+*/
+template <unsigned int NUM_MEASUREMENTS>
+SelfModel::updateResult SelfSRUKF::FixedMultipleObjectUpdate(const Matrix& locations, const Matrix& measurements, const Matrix& R_Measurement)
+{
+    typedef FixedMatrix<NUM_MEASUREMENTS,1> MeasurementVector;
+    typedef FixedMatrix<NUM_MEASUREMENTS,NUM_MEASUREMENTS> MeasurementMatrix;
+    typedef FixedMatrix<NUM_MEASUREMENTS,num_sigma_points> MeasurementSigmaPoints;
+    typedef FixedMatrix<states_total,NUM_MEASUREMENTS> Gain;
+
+    const float c_threshold2 = 15.0f;
+    const MeasurementMatrix R_obj_rel(R_Measurement);       // R = S^2
+    const MeasurementMatrix S_obj_rel(cholesky(R_obj_rel)); // R = S^2
+
+    // Unscented KF Stuff.
+    const StateVector mean(m_mean);
+    const SigmaPoints scriptX = CalculateSigmaPoints();
+    MeasurementSigmaPoints scriptY;
+
+    double dX,dY;
+
+    for(unsigned int i = 0; i < num_sigma_points; i++)
+    {
+        for(unsigned int j=0; j < NUM_MEASUREMENTS; j+=2)
+        {
+            dX = locations[j][0]-scriptX[0][i];
+            dY = locations[j+1][0]-scriptX[1][i];
+            scriptY[j][i] = sqrt(dX*dX + dY*dY);
+            scriptY[j+1][i] = mathGeneral::normaliseAngle(atan2(dY,dX) - scriptX[2][i]);
+        }
+    }
+
+    SigmaPoints Mx;
+    MeasurementSigmaPoints My;
+    for(unsigned int i = 0; i < num_sigma_points; i++){
+        Mx.setCol(i, sqrtOfTestWeightings[0][i] * scriptX.getCol(i));
+        My.setCol(i, sqrtOfTestWeightings[0][i] * scriptY.getCol(i));
+    }
+
+    const SigmaWeights& M1 = sqrtOfTestWeightings;
+    const MeasurementVector yBar = My * M1.transp(); // Predicted Measurement.
+    const MeasurementMatrix Py = (My - yBar * M1) * (My - yBar * M1).transp();
+    const Gain Pxy = (Mx - mean * M1) * (My - yBar * M1).transp();
+
+    const MeasurementMatrix invPyRObj = InverseMatrix(Py + R_obj_rel);
+
+    const Gain K = Pxy * invPyRObj; // K = Kalman filter gain.
+
+    const MeasurementVector y(measurements); // Measurement. I terms of relative (x,y).
+
+    //end of standard ukf stuff
+    //RHM: 20/06/08 Outlier rejection.
+    const MeasurementVector yDiffTemp = (yBar - y);
+
+    for(unsigned int i = 0; i < NUM_MEASUREMENTS; i+=2)
+    {
+        FixedMatrix<2,2> inv;
+        inv[0][0] = invPyRObj[i][i];
+        inv[0][1] = invPyRObj[i][i+1];
+        inv[1][0] = invPyRObj[i+1][i];
+        inv[1][1] = invPyRObj[i+1][i+1];
+
+        FixedMatrix<2,1> diff;
+        diff[0][0] = yDiffTemp[i][0];
+        diff[1][0] = yDiffTemp[i+1][0];
+        double innovation2 = convDble(diff.transp() * inv * diff);
+        if(innovation2 > c_threshold2)
+        {
+            return RESULT_OUTLIER;
+        }
+    }
+
+    // Update Alpha
+    double innovation2measError = convDble(yDiffTemp.transp() * InverseMatrix(R_obj_rel) * yDiffTemp);
+    m_alpha *= 1 / (1 + innovation2measError);
+
+    setState(mean - K*yDiffTemp, HT( horzcat(Mx - mean*M1 - K*My + K*yBar*M1, K*S_obj_rel) ));
+    return RESULT_OK;
+}
+
 /*! @brief  Multiple object update
 Performs a simultaneous update for N landmarks.
 
+Updates with up to six landmarks are done by FixedMultipleObjectUpdate, which does not allocate.
+
 @param locations The location of the landmarks seen. Nx2 Matrix.
 @param measurements The measurements obtained to these landmarks. Nx2 Matrix.
 @param R_Measurement The measurment noise of the updates. Nx2 Matrix.
@@ -203,6 +324,17 @@ Performs a simultaneous update for N landmarks.
 SelfModel::updateResult SelfSRUKF::MultipleObjectUpdate(const Matrix& locations, const Matrix& measurements, const Matrix& R_Measurement)
 {
     unsigned int numObs = measurements.getm();
+    switch(numObs)
+    {
+        case 2: return FixedMultipleObjectUpdate<2>(locations, measurements, R_Measurement);
+        case 4: return FixedMultipleObjectUpdate<4>(locations, measurements, R_Measurement);
+        case 6: return FixedMultipleObjectUpdate<6>(locations, measurements, R_Measurement);
+        case 8: return FixedMultipleObjectUpdate<8>(locations, measurements, R_Measurement);
+        case 10: return FixedMultipleObjectUpdate<10>(locations, measurements, R_Measurement);
+        case 12: return FixedMultipleObjectUpdate<12>(locations, measurements, R_Measurement);
+        default: break;
+    }
+
     const float c_threshold2 = 15.0f;
     Matrix R_obj_rel(R_Measurement);        // R = S^2
     Matrix S_obj_rel(cholesky(R_obj_rel)); // R = S^2
@@ -294,58 +426,59 @@ Performs an update for a single landmark.
 */
 SelfModel::updateResult SelfSRUKF::MeasurementUpdate(const StationaryObject& object, const MeasurementError& error)
 {
+    typedef FixedMatrix<2,1> MeasurementVector;
+    typedef FixedMatrix<2,2> MeasurementMatrix;
+    typedef FixedMatrix<2,num_sigma_points> MeasurementSigmaPoints;
+    typedef FixedMatrix<states_total,2> Gain;
+
     const float c_threshold2 = 15.0f;
     // Calculate update uncertainties - S_obj_rel & R_obj_rel
-    Matrix S_obj_rel = Matrix(2,2,false);
+    MeasurementMatrix S_obj_rel;
     S_obj_rel[0][0] = sqrt(error.distance());
     S_obj_rel[1][1] = sqrt(error.heading());
 
-    Matrix R_obj_rel = S_obj_rel * S_obj_rel.transp(); // R = S^2
+    const MeasurementMatrix R_obj_rel = S_obj_rel * S_obj_rel.transp(); // R = S^2
 
     // Unscented KF Stuff.
-    Matrix yBar;                                  	//reset
-    Matrix Py;
-    Matrix Pxy = Matrix(7, 2, false);                   //Pxy=[0;0;0];
-    Matrix scriptX = CalculateSigmaPoints();
-    const unsigned int numSigmaPoints = scriptX.getn();
-
-    Matrix scriptY = Matrix(2, numSigmaPoints, false);
-    Matrix temp = Matrix(2, 1, false);
+    const StateVector mean(m_mean);
+    const SigmaPoints scriptX = CalculateSigmaPoints();
+    MeasurementSigmaPoints scriptY;
 
-    for(unsigned int i = 0; i < numSigmaPoints; i++)
+    for(unsigned int i = 0; i < num_sigma_points; i++)
     {
         const double dX = object.X() - scriptX[0][i];
         const double dY = object.Y() - scriptX[1][i];
-        temp[0][0] = sqrt(dX*dX + dY*dY);
-        temp[1][0] = mathGeneral::normaliseAngle(atan2(dY,dX) - scriptX[2][i]);
-        scriptY.setCol(i, temp.getCol(0));
+        scriptY[0][i] = sqrt(dX*dX + dY*dY);
+        scriptY[1][i] = mathGeneral::normaliseAngle(atan2(dY,dX) - scriptX[2][i]);
     }
 
-    Matrix Mx = Matrix(scriptX.getm(), numSigmaPoints, false);
-    Matrix My = Matrix(scriptY.getm(), numSigmaPoints, false);
-    for(unsigned int i = 0; i < numSigmaPoints; i++)
+    SigmaPoints Mx;
+    MeasurementSigmaPoints My;
+    for(unsigned int i = 0; i < num_sigma_points; i++)
     {
         Mx.setCol(i, sqrtOfTestWeightings[0][i] * scriptX.getCol(i));
         My.setCol(i, sqrtOfTestWeightings[0][i] * scriptY.getCol(i));
     }
 
-    Matrix M1 = sqrtOfTestWeightings;
-    yBar = My * M1.transp(); // Predicted Measurement.
-    Py = (My - yBar * M1) * (My - yBar * M1).transp();
-    Pxy = (Mx - m_mean * M1) * (My - yBar * M1).transp();
+    const SigmaWeights& M1 = sqrtOfTestWeightings;
+    const MeasurementVector yBar = My * M1.transp(); // Predicted Measurement.
+    const MeasurementMatrix Py = (My - yBar * M1) * (My - yBar * M1).transp();
+    const Gain Pxy = (Mx - mean * M1) * (My - yBar * M1).transp();
 
-    Matrix K = Pxy * Invert22(Py + R_obj_rel); // K = Kalman filter gain.
+    const MeasurementMatrix invPyR = Invert22(Py + R_obj_rel);
+    const Gain K = Pxy * invPyR; // K = Kalman filter gain.
 
-    Matrix y = Matrix(2,1,false); // Measurement. (Distance, heading).
+    MeasurementVector y; // Measurement. (Distance, heading).
     y[0][0] = object.measuredDistance() * cos(object.measuredElevation());
     y[1][0] = object.measuredBearing();
 
     //end of standard ukf stuff
     //RHM: 20/06/08 Outlier rejection.
-    double innovation2 = convDble((yBar - y).transp() * Invert22(Py + R_obj_rel) * (yBar - y));
+    const MeasurementVector innovation = yBar - y;
+    double innovation2 = convDble(innovation.transp() * invPyR * innovation);
 
     // Update Alpha
-    double innovation2measError = convDble((yBar - y).transp() * Invert22(R_obj_rel) * (yBar - y));
+    double innovation2measError = convDble(innovation.transp() * Invert22(R_obj_rel) * innovation);
     m_alpha *= 1 / (1 + innovation2measError);
     //alpha *= CalculateAlphaWeighting(yBar - y,Py+R_obj_rel,c_outlierLikelyhood);
 
@@ -354,15 +487,14 @@ SelfModel::updateResult SelfSRUKF::MeasurementUpdate(const StationaryObject& obj
         return RESULT_OUTLIER;
     }
 
-    Matrix new_sqrt_covariance = HT( horzcat(Mx - m_mean*M1 - K*My + K*yBar*M1, K*S_obj_rel) );
-    setSqrtCovariance(new_sqrt_covariance);
-    Matrix new_mean = m_mean - K*(yBar - y);
-    setMean(new_mean);
+    setState(mean - K*innovation, HT( horzcat(Mx - mean*M1 - K*My + K*yBar*M1, K*S_obj_rel) ));
     return RESULT_OK;
 }
 
 SelfModel::updateResult SelfSRUKF::updateAngleBetween(double angle, double x1, double y1, double x2, double y2, double angle_variance)
 {
+    typedef FixedMatrix<1,num_sigma_points> MeasurementSigmaPoints;
+
     const float c_threshold2 = 15.0f;
         // Method to take the angle between two objects, that is,
         // angle between object 1 (with fixed field coords (x1,y1))
@@ -373,37 +505,36 @@ SelfModel::updateResult SelfSRUKF::updateAngleBetween(double angle, double x1, d
     // Unscented KF Stuff.
     double yBar;                                  	//reset
     double Py;
-    Matrix Pxy = Matrix(7, 1, false);                    //Pxy=[0;0;0];
-    Matrix scriptX = CalculateSigmaPoints();
-    const unsigned int numSigmaPoints = scriptX.getn();
+    const StateVector mean(m_mean);
+    const SigmaPoints scriptX = CalculateSigmaPoints();
     //----------------------------------------------------------------
-    Matrix scriptY = Matrix(1, numSigmaPoints, false);
+    MeasurementSigmaPoints scriptY;
 
     double angleToObj1;
     double angleToObj2;
 
-    for (int i = 0; i < numSigmaPoints; i++)
+    for (unsigned int i = 0; i < num_sigma_points; i++)
     {
         angleToObj1 = atan2 ( y1 - scriptX[1][i], x1 - scriptX[0][i] );
         angleToObj2 = atan2 ( y2 - scriptX[1][i], x2 - scriptX[0][i] );
         scriptY[0][i] = mathGeneral::normaliseAngle(angleToObj1 - angleToObj2);
     }
 
-    Matrix Mx = Matrix(scriptX.getm(), numSigmaPoints, false);
-    Matrix My = Matrix(scriptY.getm(), numSigmaPoints, false);
-    for (int i = 0; i < numSigmaPoints; i++)
+    SigmaPoints Mx;
+    MeasurementSigmaPoints My;
+    for (unsigned int i = 0; i < num_sigma_points; i++)
     {
         Mx.setCol(i, sqrtOfTestWeightings[0][i] * scriptX.getCol(i));
         My.setCol(i, sqrtOfTestWeightings[0][i] * scriptY.getCol(i));
     }
 
-    Matrix M1 = sqrtOfTestWeightings;
+    const SigmaWeights& M1 = sqrtOfTestWeightings;
     yBar = convDble ( My * M1.transp() ); // Predicted Measurement.
     Py = convDble ((My - yBar * M1) * (My - yBar * M1).transp());
-    Pxy = (Mx - m_mean * M1) * (My - yBar * M1).transp();
+    const StateVector Pxy = (Mx - mean * M1) * (My - yBar * M1).transp();
 
 
-    Matrix K = Pxy /( Py + angle_variance ); // K = Kalman filter gain.
+    const StateVector K = Pxy /( Py + angle_variance ); // K = Kalman filter gain.
 
     double y = angle;    //end of standard ukf stuff
     //Outlier rejection.
@@ -417,10 +548,7 @@ SelfModel::updateResult SelfSRUKF::updateAngleBetween(double angle, double x1, d
     {
         return RESULT_OUTLIER;
     }
-    Matrix newSqrtCov = HT( horzcat(Mx - m_mean*M1 - K*My + K*yBar*M1, K*sqrt(angle_variance)) );
-    setSqrtCovariance(newSqrtCov);
-    Matrix newMean = m_mean - K*(yBar - y);
-    setMean(newMean);
+    setState(mean - K*(yBar - y), HT( horzcat(Mx - mean*M1 - K*My + K*yBar*M1, K*sqrt(angle_variance)) ));
     return RESULT_OK;
 }
 
@@ -429,11 +557,11 @@ Calculates the sigma points for the current model state.
 
 @return Matrix containing the sigma points for the current model.
 */
-Matrix SelfSRUKF::CalculateSigmaPoints() const
+SelfSRUKF::SigmaPoints SelfSRUKF::CalculateSigmaPoints() const
 {
-    const unsigned int numSigmaPoints = 2 * states_total + 1;
-    Matrix sigmaPoints = Matrix(m_mean.getm(), numSigmaPoints, false);
-    sigmaPoints.setCol(0, m_mean);
+    const StateVector mean(m_mean);
+    SigmaPoints sigmaPoints;
+    sigmaPoints.setCol(0, mean);
 
     //----------------Saturate ScriptX angle sigma points to not wrap
     double sigmaAngleMax = 2.5;
@@ -442,13 +570,13 @@ Matrix SelfSRUKF::CalculateSigmaPoints() const
     {//hack to make test points distributed
         neg_index = states_total + i;
         // Addition Portion.
-        sigmaPoints.setCol(i, m_mean + sqrt((double)states_total + c_Kappa) * m_sqrt_covariance.getCol(i - 1));
+        sigmaPoints.setCol(i, mean + sqrt((double)states_total + c_Kappa) * m_sqrt_covariance.getCol(i - 1));
         // Crop heading
-        sigmaPoints[states_heading][i] = mathGeneral::crop(sigmaPoints[states_heading][i], (-sigmaAngleMax + m_mean[states_heading][0]), (sigmaAngleMax + m_mean[states_heading][0]));
+        sigmaPoints[states_heading][i] = mathGeneral::crop(sigmaPoints[states_heading][i], (-sigmaAngleMax + mean[states_heading][0]), (sigmaAngleMax + mean[states_heading][0]));
         // Subtraction Portion.
-        sigmaPoints.setCol(neg_index, m_mean - sqrt((double)states_total + c_Kappa) * m_sqrt_covariance.getCol(i - 1));
+        sigmaPoints.setCol(neg_index, mean - sqrt((double)states_total + c_Kappa) * m_sqrt_covariance.getCol(i - 1));
         // Crop heading
-        sigmaPoints[states_heading][neg_index] = mathGeneral::crop(sigmaPoints[states_heading][neg_index], (-sigmaAngleMax + m_mean[states_heading][0]), (sigmaAngleMax + m_mean[states_heading][0]));
+        sigmaPoints[states_heading][neg_index] = mathGeneral::crop(sigmaPoints[states_heading][neg_index], (-sigmaAngleMax + mean[states_heading][0]), (sigmaAngleMax + mean[states_heading][0]));
     }
     return sigmaPoints;
 }
@@ -4,20 +4,32 @@
 #include "Infrastructure/FieldObjects/StationaryObject.h"
 #include "Localisation/odometryMotionModel.h"
 #include "Localisation/MeasurementError.h"
+#include "Tools/Math/FixedMatrix.h"
+
+class SelfSRUKFBank;
 
 class SelfSRUKF: public SelfModel
 {
+    friend class SelfSRUKFBank;
 public:
+    enum {num_sigma_points = 2*states_total + 1};
+
+    typedef FixedMatrix<states_total,1> StateVector;
+    typedef FixedMatrix<states_total,states_total> StateMatrix;
+    typedef FixedMatrix<states_total,num_sigma_points> SigmaPoints;
+
     // Constructors
     SelfSRUKF();
     SelfSRUKF(double time);
     SelfSRUKF(const SelfModel& source);
     SelfSRUKF(const SelfModel& parent, const AmbiguousObject& object, const StationaryObject& splitOption, const MeasurementError& error, float time);
+    SelfSRUKF(const SelfModel& parent, const AmbiguousObject& object, const StationaryObject& splitOption, float time);
     virtual ~SelfSRUKF()
     {
     }
 
     void InitialiseCachedValues();
+    void InitialiseSqrtCovariance();
 
     // Update functions
     updateResult TimeUpdate(const std::vector<float>& odometry, OdometryMotionModel& motion_model, float deltaTime);
@@ -29,7 +41,7 @@ public:
     void setSqrtCovariance(const Matrix& newSqrtCovariance);
 
 
-    Matrix CalculateSigmaPoints() const;
+    SigmaPoints CalculateSigmaPoints() const;
     float CalculateAlphaWeighting(const Matrix& innovation, const Matrix& innovationVariance, float outlierLikelyhood) const;
 
     bool operator ==(const SelfSRUKF& b) const;
@@ -66,10 +78,16 @@ public:
 
 
 protected:
-    Matrix sqrtOfTestWeightings; // Square root of W (Constant)
-    Matrix sqrtOfProcessNoise; // Square root of Process Noise (Q matrix). (Constant)
+    typedef FixedMatrix<1,num_sigma_points> SigmaWeights;
+
+    template <unsigned int NUM_MEASUREMENTS>
+    updateResult FixedMultipleObjectUpdate(const Matrix& locations, const Matrix& measurements, const Matrix& R_Measurement);
+    void setState(const StateVector& newMean, const StateMatrix& newSqrtCovariance);
+
+    SigmaWeights sqrtOfTestWeightings; // Square root of W (Constant)
+    StateMatrix sqrtOfProcessNoise; // Square root of Process Noise (Q matrix). (Constant)
     static const float c_Kappa;
-    Matrix m_sqrt_covariance;
+    StateMatrix m_sqrt_covariance;
 };
 
 
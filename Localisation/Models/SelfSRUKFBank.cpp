@@ -0,0 +1,387 @@
+#include "SelfSRUKFBank.h"
+#include "Tools/Math/General.h"
+#include <math.h>
+#include <assert.h>
+
+SelfSRUKFBank::SelfSRUKFBank(): m_capacity(0)
+{
+    m_sqrt_weights[0] = sqrt(SelfSRUKF::c_Kappa/(num_states+SelfSRUKF::c_Kappa));
+    const double outerWeighting = sqrt(1.0/(2*(num_states+SelfSRUKF::c_Kappa)));
+    for(int i=1; i < num_sigma_points; i++)
+    {
+        m_sqrt_weights[i] = outerWeighting;
+    }
+}
+
+/*! @brief Removes all of the lanes from the bank.
+ */
+void SelfSRUKFBank::clear()
+{
+    m_models.clear();
+    m_results.clear();
+}
+
+/*! @brief Adds a model to the bank, to be updated with the given landmark.
+
+@param model The model to be updated. It must outlive the call to MeasurementUpdate().
+@param object The landmark containing the relative measurement and location of the object.
+@param error The measurment error.
+*/
+void SelfSRUKFBank::add(SelfSRUKF* model, const StationaryObject& object, const MeasurementError& error)
+{
+    const unsigned int lane = m_models.size();
+    if(lane >= m_capacity)
+    {
+        resize(m_capacity > 0 ? 2*m_capacity : 16);
+    }
+    m_models.push_back(model);
+    m_results.push_back(SelfModel::RESULT_FAILED);
+
+    for(int i = 0; i < num_states; i++)
+    {
+        row(row_mean + i)[lane] = model->m_mean[i][0];
+        for(int j = 0; j < num_states; j++)
+        {
+            row(row_sqrt_covariance + num_states*i + j)[lane] = model->m_sqrt_covariance[i][j];
+        }
+    }
+    row(row_location_x)[lane] = object.X();
+    row(row_location_y)[lane] = object.Y();
+    row(row_measured_distance)[lane] = object.measuredDistance() * cos(object.measuredElevation());
+    row(row_measured_bearing)[lane] = object.measuredBearing();
+    row(row_sqrt_r_distance)[lane] = sqrt(error.distance());
+    row(row_sqrt_r_bearing)[lane] = sqrt(error.heading());
+}
+
+/*! @brief Performs SelfSRUKF::MeasurementUpdate on every lane in the bank.
+
+The models are updated in place, and the result of each update is available from result().
+*/
+void SelfSRUKFBank::MeasurementUpdate()
+{
+    if(m_models.empty()) return;
+    CalculateSigmaPoints();
+    CalculatePredictions();
+    CalculateGains();
+    Triangularise();
+    WriteModels();
+}
+
+/*! @brief Grows each row to hold capacity lanes, keeping the lanes already added.
+ */
+void SelfSRUKFBank::resize(unsigned int capacity)
+{
+    std::vector<double> rows(num_rows*capacity, 0.0);
+    for(unsigned int r = 0; r < num_rows; r++)
+    {
+        for(unsigned int lane = 0; lane < m_models.size(); lane++)
+        {
+            rows[r*capacity + lane] = m_rows[r*m_capacity + lane];
+        }
+    }
+    m_rows.swap(rows);
+    m_capacity = capacity;
+}
+
+/*! @brief Calculates the sigma points of every lane, as in SelfSRUKF::CalculateSigmaPoints.
+ */
+void SelfSRUKFBank::CalculateSigmaPoints()
+{
+    const unsigned int lanes = m_models.size();
+    const double spread = sqrt((double)num_states + SelfSRUKF::c_Kappa);
+    const double sigmaAngleMax = 2.5;
+
+    for(int i = 0; i < num_states; i++)
+    {
+        const double* mean = row(row_mean + i);
+        double* centre = row(row_sigma_points + num_sigma_points*i);
+        for(unsigned int lane = 0; lane < lanes; lane++)
+        {
+            centre[lane] = mean[lane];
+        }
+        for(int j = 0; j < num_states; j++)
+        {
+            const double* sqrt_covariance = row(row_sqrt_covariance + num_states*i + j);
+            double* positive = row(row_sigma_points + num_sigma_points*i + 1 + j);
+            double* negative = row(row_sigma_points + num_sigma_points*i + 1 + num_states + j);
+            for(unsigned int lane = 0; lane < lanes; lane++)
+            {
+                positive[lane] = mean[lane] + spread*sqrt_covariance[lane];
+                negative[lane] = mean[lane] - spread*sqrt_covariance[lane];
+            }
+        }
+    }
+
+    // Crop heading
+    const double* heading = row(row_mean + SelfModel::states_heading);
+    for(int s = 1; s < num_sigma_points; s++)
+    {
+        double* point = row(row_sigma_points + num_sigma_points*SelfModel::states_heading + s);
+        for(unsigned int lane = 0; lane < lanes; lane++)
+        {
+            point[lane] = mathGeneral::crop(point[lane], (-sigmaAngleMax + heading[lane]), (sigmaAngleMax + heading[lane]));
+        }
+    }
+}
+
+/*! @brief Calculates the predicted measurement of each sigma point of every lane.
+ */
+void SelfSRUKFBank::CalculatePredictions()
+{
+    const unsigned int lanes = m_models.size();
+    const double* location_x = row(row_location_x);
+    const double* location_y = row(row_location_y);
+    for(int s = 0; s < num_sigma_points; s++)
+    {
+        const double* x = row(row_sigma_points + num_sigma_points*SelfModel::states_x + s);
+        const double* y = row(row_sigma_points + num_sigma_points*SelfModel::states_y + s);
+        const double* heading = row(row_sigma_points + num_sigma_points*SelfModel::states_heading + s);
+        double* distance = row(row_predictions + s);
+        double* bearing = row(row_predictions + num_sigma_points + s);
+        for(unsigned int lane = 0; lane < lanes; lane++)
+        {
+            const double dX = location_x[lane] - x[lane];
+            const double dY = location_y[lane] - y[lane];
+            distance[lane] = sqrt(dX*dX + dY*dY);
+            bearing[lane] = atan2(dY,dX);
+        }
+        // the trigonometry is kept in its own loop so that the loop above vectorises
+        for(unsigned int lane = 0; lane < lanes; lane++)
+        {
+            bearing[lane] = mathGeneral::normaliseAngle(bearing[lane] - heading[lane]);
+        }
+    }
+}
+
+/*! @brief Calculates the predicted measurement, its covariance, the kalman gain, the innovations
+    and the matrix to be triangularised for every lane.
+ */
+void SelfSRUKFBank::CalculateGains()
+{
+    const unsigned int lanes = m_models.size();
+    const double* w = m_sqrt_weights;
+    const double* X[num_states][num_sigma_points];
+    const double* Y[num_measurements][num_sigma_points];
+    for(int s = 0; s < num_sigma_points; s++)
+    {
+        for(int i = 0; i < num_states; i++)
+            X[i][s] = row(row_sigma_points + num_sigma_points*i + s);
+        for(int k = 0; k < num_measurements; k++)
+            Y[k][s] = row(row_predictions + num_sigma_points*k + s);
+    }
+    const double* mean[num_states];
+    double* new_mean[num_states];
+    double* factor[num_states][num_factor_columns];
+    for(int i = 0; i < num_states; i++)
+    {
+        mean[i] = row(row_mean + i);
+        new_mean[i] = row(row_new_mean + i);
+        for(int c = 0; c < num_factor_columns; c++)
+            factor[i][c] = row(row_factor + num_factor_columns*i + c);
+    }
+    const double* measured_distance = row(row_measured_distance);
+    const double* measured_bearing = row(row_measured_bearing);
+    const double* sqrt_r_distance = row(row_sqrt_r_distance);
+    const double* sqrt_r_bearing = row(row_sqrt_r_bearing);
+    double* innovation2 = row(row_innovation2);
+    double* innovation2_measurement_error = row(row_innovation2_measurement_error);
+
+    for(unsigned int lane = 0; lane < lanes; lane++)
+    {
+        // My and yBar
+        double My[num_measurements][num_sigma_points];
+        double yBar[num_measurements];
+        for(int k = 0; k < num_measurements; k++)
+        {
+            yBar[k] = 0;
+            for(int s = 0; s < num_sigma_points; s++)
+            {
+                My[k][s] = w[s]*Y[k][s][lane];
+                yBar[k] += My[k][s]*w[s];
+            }
+        }
+
+        // Py and Pxy
+        double dy[num_measurements][num_sigma_points];
+        for(int k = 0; k < num_measurements; k++)
+            for(int s = 0; s < num_sigma_points; s++)
+                dy[k][s] = My[k][s] - yBar[k]*w[s];
+        double dx[num_states][num_sigma_points];
+        for(int i = 0; i < num_states; i++)
+            for(int s = 0; s < num_sigma_points; s++)
+                dx[i][s] = w[s]*X[i][s][lane] - mean[i][lane]*w[s];
+
+        double Py[num_measurements][num_measurements];
+        for(int k = 0; k < num_measurements; k++)
+        {
+            for(int l = 0; l < num_measurements; l++)
+            {
+                Py[k][l] = 0;
+                for(int s = 0; s < num_sigma_points; s++)
+                    Py[k][l] += dy[k][s]*dy[l][s];
+            }
+        }
+        double Pxy[num_states][num_measurements];
+        for(int i = 0; i < num_states; i++)
+        {
+            for(int k = 0; k < num_measurements; k++)
+            {
+                Pxy[i][k] = 0;
+                for(int s = 0; s < num_sigma_points; s++)
+                    Pxy[i][k] += dx[i][s]*dy[k][s];
+            }
+        }
+
+        // K = Pxy * Invert22(Py + R)
+        const double R00 = sqrt_r_distance[lane]*sqrt_r_distance[lane];
+        const double R11 = sqrt_r_bearing[lane]*sqrt_r_bearing[lane];
+        const double P00 = Py[0][0] + R00;
+        const double P01 = Py[0][1];
+        const double P10 = Py[1][0];
+        const double P11 = Py[1][1] + R11;
+        const double divisor = P00*P11 - P01*P10;
+        const double inv00 = P11/divisor;
+        const double inv01 = -P01/divisor;
+        const double inv10 = -P10/divisor;
+        const double inv11 = P00/divisor;
+        double K[num_states][num_measurements];
+        for(int i = 0; i < num_states; i++)
+        {
+            K[i][0] = Pxy[i][0]*inv00 + Pxy[i][1]*inv10;
+            K[i][1] = Pxy[i][0]*inv01 + Pxy[i][1]*inv11;
+        }
+
+        // Outlier rejection and alpha
+        const double innovation0 = yBar[0] - measured_distance[lane];
+        const double innovation1 = yBar[1] - measured_bearing[lane];
+        innovation2[lane] = (innovation0*inv00 + innovation1*inv10)*innovation0 + (innovation0*inv01 + innovation1*inv11)*innovation1;
+        const double R_divisor = R00*R11;
+        innovation2_measurement_error[lane] = (innovation0*(R11/R_divisor))*innovation0 + (innovation1*(R00/R_divisor))*innovation1;
+
+        // [Mx - m*M1 - K*My + K*yBar*M1, K*S_obj_rel]
+        for(int i = 0; i < num_states; i++)
+        {
+            const double KyBar = K[i][0]*yBar[0] + K[i][1]*yBar[1];
+            for(int s = 0; s < num_sigma_points; s++)
+                factor[i][s][lane] = (dx[i][s] - (K[i][0]*My[0][s] + K[i][1]*My[1][s])) + KyBar*w[s];
+            factor[i][num_sigma_points][lane] = K[i][0]*sqrt_r_distance[lane];
+            factor[i][num_sigma_points + 1][lane] = K[i][1]*sqrt_r_bearing[lane];
+            new_mean[i][lane] = mean[i][lane] - (K[i][0]*innovation0 + K[i][1]*innovation1);
+        }
+    }
+}
+
+/*! @brief Householder triangularisation of every lane's factor, the same algorithm as HT().
+    The new square root covariance is left in the last num_states columns of the factor.
+ */
+void SelfSRUKFBank::Triangularise()
+{
+    const unsigned int lanes = m_models.size();
+    const int r = num_factor_columns - num_states;
+    double* sigma = row(row_householder_scale);
+    double* v[num_factor_columns];
+    for(int j = 0; j < num_factor_columns; j++)
+        v[j] = row(row_householder + j);
+
+    for(int k = num_states - 1; k >= 0; k--)
+    {
+        double* A_k = row(row_factor + num_factor_columns*k);
+        for(unsigned int lane = 0; lane < lanes; lane++)
+            sigma[lane] = 0.0;
+        for(int j = 0; j <= r+k; j++)
+            for(unsigned int lane = 0; lane < lanes; lane++)
+                sigma[lane] += A_k[j*m_capacity + lane]*A_k[j*m_capacity + lane];
+
+        for(unsigned int lane = 0; lane < lanes; lane++)
+        {
+            const double a = sqrt(sigma[lane]);
+            sigma[lane] = 0.0;
+            for(int j = 0; j <= r+k; j++)
+            {
+                v[j][lane] = (j == r+k) ? A_k[j*m_capacity + lane] - a : A_k[j*m_capacity + lane];
+                sigma[lane] += v[j][lane]*v[j][lane];
+            }
+            sigma[lane] = 2.0/(sigma[lane] + 1e-15);
+        }
+
+        for(int i = 0; i <= k; i++)
+        {
+            double* A_i = row(row_factor + num_factor_columns*i);
+            double* b = row(row_householder_projection);
+            for(unsigned int lane = 0; lane < lanes; lane++)
+                b[lane] = 0.0;
+            for(int j = 0; j <= r+k; j++)
+                for(unsigned int lane = 0; lane < lanes; lane++)
+                    b[lane] += A_i[j*m_capacity + lane]*v[j][lane];
+            for(unsigned int lane = 0; lane < lanes; lane++)
+                b[lane] *= sigma[lane];
+            for(int j = 0; j <= r+k; j++)
+                for(unsigned int lane = 0; lane < lanes; lane++)
+                    A_i[j*m_capacity + lane] -= b[lane]*v[j][lane];
+        }
+    }
+}
+
+/*! @brief Writes the alpha, and unless the update was an outlier the mean and covariance, back into each model.
+
+    As SelfSRUKF::setState does for a single model, a mean or covariance containing NaNs (left by a degenerate
+    update where Py + R is singular) is not stored, and the update is still reported as RESULT_OK.
+ */
+void SelfSRUKFBank::WriteModels()
+{
+    const float c_threshold2 = 15.0f;
+    const int r = num_factor_columns - num_states;
+    double sqrt_covariance[num_states][num_states];
+    double covariance[num_states][num_states];
+    for(unsigned int lane = 0; lane < m_models.size(); lane++)
+    {
+        SelfSRUKF* model = m_models[lane];
+        model->m_alpha *= 1 / (1 + row(row_innovation2_measurement_error)[lane]);
+
+        if(row(row_innovation2)[lane] > c_threshold2)
+        {
+            m_results[lane] = SelfModel::RESULT_OUTLIER;
+            continue;
+        }
+
+        bool covariance_valid = true;
+        bool mean_valid = true;
+        for(int i = 0; i < num_states; i++)
+        {
+            for(int j = 0; j < num_states; j++)
+                sqrt_covariance[i][j] = row(row_factor + num_factor_columns*i + r + j)[lane];
+        }
+        for(int i = 0; i < num_states; i++)
+        {
+            for(int j = 0; j < num_states; j++)
+            {
+                double temp = 0;
+                for(int k = 0; k < num_states; k++)
+                    temp += sqrt_covariance[i][k]*sqrt_covariance[j][k];
+                covariance[i][j] = temp;
+                covariance_valid = covariance_valid and temp == temp;
+            }
+            const double mean = row(row_new_mean + i)[lane];
+            mean_valid = mean_valid and mean == mean;
+        }
+        assert(covariance_valid);
+        if(covariance_valid)
+        {
+            for(int i = 0; i < num_states; i++)
+            {
+                for(int j = 0; j < num_states; j++)
+                {
+                    model->m_sqrt_covariance[i][j] = sqrt_covariance[i][j];
+                    model->m_covariance[i][j] = covariance[i][j];
+                }
+            }
+        }
+        assert(mean_valid);
+        if(mean_valid)
+        {
+            for(int i = 0; i < num_states; i++)
+                model->m_mean[i][0] = row(row_new_mean + i)[lane];
+        }
+        m_results[lane] = SelfModel::RESULT_OK;
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef SELFSRUKFBANK_H
+#define SELFSRUKFBANK_H
+#include "SelfSRUKF.h"
+#include <vector>
+
+/*!
+  * A batch of SelfSRUKF models updated together.
+  *
+  * Each model added to the bank, along with the landmark it is to be updated with, becomes a lane.
+  * The means, square root covariances, sigma points and every intermediate of the update are stored
+  * as one row per quantity with one column per lane (a structure of arrays), so each step of the
+  * update is a loop over all of the lanes that the compiler can vectorise. The arithmetic is the
+  * same as SelfSRUKF::MeasurementUpdate, and the results are written back into the models, so a
+  * model updated in a bank is indistinguishable from one updated on its own.
+  *
+  * The rows are kept between batches; once the bank has seen the largest batch it does not allocate.
+  */
+class SelfSRUKFBank
+{
+public:
+    SelfSRUKFBank();
+
+    void clear();
+    void add(SelfSRUKF* model, const StationaryObject& object, const MeasurementError& error);
+    unsigned int size() const {return m_models.size();}
+
+    void MeasurementUpdate();
+    SelfSRUKF* model(unsigned int lane) const {return m_models[lane];}
+    SelfModel::updateResult result(unsigned int lane) const {return m_results[lane];}
+
+private:
+    void resize(unsigned int capacity);
+    double* row(unsigned int index) {return &m_rows[index*m_capacity];}
+
+    void CalculateSigmaPoints();
+    void CalculatePredictions();
+    void CalculateGains();
+    void Triangularise();
+    void WriteModels();
+
+    enum
+    {
+        num_states = SelfModel::states_total,
+        num_measurements = 2,
+        num_sigma_points = 2*num_states + 1,
+        num_factor_columns = num_sigma_points + num_measurements
+    };
+
+    //! The rows of m_rows. Matrices are stored row by row, one row of m_rows per element.
+    enum
+    {
+        row_mean = 0,                                                       //!< the current means
+        row_sqrt_covariance = row_mean + num_states,                        //!< the current square root covariances
+        row_location_x = row_sqrt_covariance + num_states*num_states,       //!< the field locations of the landmarks
+        row_location_y,
+        row_measured_distance,                                              //!< the flat distances measured to the landmarks
+        row_measured_bearing,                                               //!< the bearings measured to the landmarks
+        row_sqrt_r_distance,                                                //!< the square root of the distance measurement variance
+        row_sqrt_r_bearing,                                                 //!< the square root of the bearing measurement variance
+        row_sigma_points,                                                   //!< num_states by num_sigma_points
+        row_predictions = row_sigma_points + num_states*num_sigma_points,   //!< num_measurements by num_sigma_points
+        row_innovation2 = row_predictions + num_measurements*num_sigma_points, //!< the normalised innovations, compared with the outlier threshold
+        row_innovation2_measurement_error,                                  //!< the innovations normalised by the measurement error only
+        row_new_mean,                                                       //!< the updated means
+        row_factor = row_new_mean + num_states,                             //!< num_states by num_factor_columns, triangularised to get the new square root covariance
+        row_householder = row_factor + num_states*num_factor_columns,       //!< the householder vector
+        row_householder_scale = row_householder + num_factor_columns,       //!< 2/|v|^2 for the householder vector
+        row_householder_projection,                                         //!< the projection of a row of the factor onto the householder vector
+        num_rows
+    };
+
+    std::vector<SelfSRUKF*> m_models;                       //!< the model in each lane
+    std::vector<SelfModel::updateResult> m_results;         //!< the result of the last update of each lane
+    std::vector<double> m_rows;                             //!< num_rows rows of m_capacity lanes
+    unsigned int m_capacity;                                //!< the number of lanes allocated in each row
+    double m_sqrt_weights[num_sigma_points];                //!< square root of the sigma point weights
+};
+
+#endif // SELFSRUKFBANK_H
@@ -9,7 +9,7 @@
 
 /*! @brief Default constructor
  */
-SelfUKF::SelfUKF(): UKF(states_total), WeightedModel(0.0)
+SelfUKF::SelfUKF(): UKF<states_total>(), WeightedModel(0.0)
 {
     m_previous_decisions.resize(FieldObjects::NUM_AMBIGUOUS_FIELD_OBJECTS, FieldObjects::NUM_STAT_FIELD_OBJECTS);
 }
@@ -18,7 +18,7 @@ SelfUKF::SelfUKF(): UKF(states_total), WeightedModel(0.0)
 
     This constructor requires a creation time.
  */
-SelfUKF::SelfUKF(double time): UKF(states_total), WeightedModel(time)
+SelfUKF::SelfUKF(double time): UKF<states_total>(), WeightedModel(time)
 {
     m_previous_decisions.resize(FieldObjects::NUM_AMBIGUOUS_FIELD_OBJECTS, FieldObjects::NUM_STAT_FIELD_OBJECTS);
 }
@@ -26,7 +26,7 @@ SelfUKF::SelfUKF(double time): UKF(states_total), WeightedModel(time)
 /*! @brief Copy constructor
 
  */
-SelfUKF::SelfUKF(const SelfUKF& source): UKF(states_total), WeightedModel(0.0)
+SelfUKF::SelfUKF(const SelfUKF& source): UKF<states_total>(), WeightedModel(0.0)
 {
     *this = source;
 }
@@ -41,7 +41,7 @@ Takes a parent filter and performs a split on an ambiguous object using the give
 @param time The current time of the update
 */
 SelfUKF::SelfUKF(const SelfUKF& parent, const AmbiguousObject& object, const StationaryObject& splitOption, const MeasurementError& error, float time):
-    UKF(parent), WeightedModel(parent,time)
+    UKF<states_total>(parent), WeightedModel(parent,time)
 {
     StationaryObject updateObject(splitOption);
     updateObject.CopyObject(object);
@@ -66,6 +66,12 @@ void SelfUKF::setMean(const Matrix& newMean)
     m_mean[states_heading][0] = mathGeneral::normaliseAngle(m_mean[states_heading][0]);
 }
 
+void SelfUKF::constrainMean(StateVector& mean) const
+{
+    // normalise angle.
+    mean[states_heading][0] = mathGeneral::normaliseAngle(mean[states_heading][0]);
+}
+
 
 /*!
  * @brief The process equation is used to update the systems state using the process euquations of the system.
@@ -74,9 +80,9 @@ void SelfUKF::setMean(const Matrix& newMean)
  * @param measurement The measurement of the odometry used to update the objects new relative position.
  * @return The new estimated system state.
  */
-Matrix SelfUKF::processEquation(const Matrix& sigma_point, double deltaT, const Matrix& measurement)
+SelfUKF::StateVector SelfUKF::processEquation(const StateVector& sigma_point, double deltaT, const Matrix& measurement)
 {
-    Matrix result(sigma_point); // Start at original state.
+    StateVector result(sigma_point); // Start at original state.
     double tempx, tempy;
 
     assert(measurement.getm()==3); // Check the correct number of measurements have been given.
@@ -107,7 +113,7 @@ Matrix SelfUKF::processEquation(const Matrix& sigma_point, double deltaT, const
  * @param measurementArgs Additional arguments used to calculate the measurement. In this implementation it is unused.
  * @return The expected measurement for the given states.
  */
-Matrix SelfUKF::measurementEquation(const Matrix& sigma_point, const Matrix& measurementArgs)
+SelfUKF::MeasurementVector SelfUKF::measurementEquation(const StateVector& sigma_point, const Matrix& measurementArgs)
 {
     // measurementArgs not required, since the measurements are only reliant on the current state.
     // Measurement is to be in polar coordinates (distance, theta).
@@ -128,7 +134,7 @@ Matrix SelfUKF::measurementEquation(const Matrix& sigma_point, const Matrix& mea
     double angle = mathGeneral::normaliseAngle(atan2(dy, dx) - my_theta);
 
     // Write to matrix for return.
-    Matrix expected_measurement(2,1,false);
+    MeasurementVector expected_measurement;
     expected_measurement[0][0] = distance;
     expected_measurement[1][0] = angle;
 
@@ -137,13 +143,13 @@ Matrix SelfUKF::measurementEquation(const Matrix& sigma_point, const Matrix& mea
 
 bool SelfUKF::MeasurementUpdate(const StationaryObject& object, const MeasurementError& error)
 {
-    Matrix meas_noise = error.errorCovariance();
+    MeasurementMatrix meas_noise(error.errorCovariance());
 
     Matrix args(2,1,false);
     args[0][0] = object.X();
     args[1][0] = object.Y();
 
-    Matrix measurement(2,1,false);
+    MeasurementVector measurement;
     measurement[0][0] = object.measuredDistance() * cos(object.measuredElevation());
     measurement[1][0] = object.measuredBearing();
     return measurementUpdate(measurement, meas_noise, args);
@@ -156,86 +162,62 @@ bool SelfUKF::MeasurementUpdate(const StationaryObject& object, const Measuremen
  * @param measurementArgs Any additional information about the measurement, if required.
  * @return True if the measurement update was performed successfully. False if it was not.
  */
-bool SelfUKF::measurementUpdate(const Matrix& measurement, const Matrix& measurementNoise, const Matrix& measurementArgs)
+bool SelfUKF::measurementUpdate(const MeasurementVector& measurement, const MeasurementMatrix& measurementNoise, const Matrix& measurementArgs)
 {
-    const unsigned int totalPoints = totalSigmaPoints();
-    const unsigned int numStates = totalStates();
-    const unsigned int totalMeasurements = measurement.getm();
-    Matrix currentPoint; // temporary storage.
-
-    Matrix Yprop(totalMeasurements, totalPoints);
+    MeasurementSigmaPoints Yprop;
 
     // First step is to calculate the expected measurmenent for each sigma point.
-    for (unsigned int i = 0; i < totalPoints; ++i)
+    for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
     {
-        currentPoint = m_sigma_points.getCol(i);    // Get the sigma point.
-        Yprop.setCol(i, measurementEquation(currentPoint, measurementArgs));
+        Yprop.setCol(i, measurementEquation(m_sigma_points.getCol(i), measurementArgs));
     }
 
     // Now calculate the mean of these measurement sigmas.
-    Matrix Ymean = CalculateMeanFromSigmas(Yprop);
+    const MeasurementVector Ymean = CalculateMeanFromSigmas(Yprop);
 
-    Matrix Pyy(measurementNoise);   // measurement noise is added, so just use as the beginning value of the sum.
-    Matrix Pxy(numStates, totalMeasurements, false);
+    MeasurementMatrix Pyy(measurementNoise);   // measurement noise is added, so just use as the beginning value of the sum.
+    Gain Pxy;
 
     // Calculate the Pyy and Pxy variance matrices.
-    for(unsigned int i = 0; i < totalPoints; ++i)
+    for(unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
     {
-        double weight = m_covariance_weights[0][i];
+        const double weight = m_covariance_weights[0][i];
         // store difference between prediction and measurement.
-        currentPoint = Yprop.getCol(i) - Ymean;
+        const MeasurementVector currentPoint = Yprop.getCol(i) - Ymean;
         // Innovation covariance - Add Measurement noise
-        Pyy = Pyy + weight * currentPoint * currentPoint.transp();
+        Pyy += weight * currentPoint * currentPoint.transp();
         // Cross correlation matrix
-        Pxy = Pxy + weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint.transp();    // Important: Use mean from estimate, not current mean.
+        Pxy += weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint.transp();    // Important: Use mean from estimate, not current mean.
     }
 
+    const MeasurementMatrix invPyy = Invert22(Pyy);
 
     // This is the new part for calculating the new model weighting.
-    double innovation2 = convDble((Ymean - measurement).transp() * Invert22(Pyy) * (Ymean - measurement));
+    double innovation2 = convDble((Ymean - measurement).transp() * invPyy * (Ymean - measurement));
     float new_alpha = WeightedModel::alpha() * 1 / (1 + innovation2);
     setAlpha(new_alpha);
 
     // Calculate the Kalman filter gain
-    Matrix K;
-    // If we have a 2 dimensional measurement, use the faster shortcut function.
-    if(totalMeasurements == 2)
-    {
-        K = Pxy * Invert22(Pyy);
-    }
-    else
-    {
-        K = Pxy * InverseMatrix(Pyy);
-    }
+    const Gain K = Pxy * invPyy;
 
-    Matrix newMean = mean() + K * (measurement - Ymean);
-    Matrix newCovariance = covariance() - K*Pyy*K.transp();
-
-    setMean(newMean);
-    setCovariance(newCovariance);
+    setState(StateVector(m_mean) + K * (measurement - Ymean), StateMatrix(m_covariance) - K*Pyy*K.transp());
     return true;
 }
 
 bool SelfUKF::measurementUpdateAngleBetweenTwoObjects(double angle, double x1, double y1, double x2, double y2, double angle_variance)
 {
-    const unsigned int totalPoints = totalSigmaPoints();
-    const unsigned int numStates = totalStates();
-    const unsigned int totalMeasurements = 1;
     double measurement = angle;
-    Matrix currentPoint; // temporary storage.
-
-    Matrix Yprop(totalMeasurements, totalPoints);
+    FixedMatrix<1,NUM_SIGMA_POINTS> Yprop;
 
     double angleToObj1;
     double angleToObj2;
     double sigma_x;
     double sigma_y;
     // First step is to calculate the expected measurmenent for each sigma point.
-    for (unsigned int i = 0; i < totalPoints; ++i)
+    for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
     {
-        currentPoint = m_sigma_points.getCol(i);    // Get the sigma point.
-        sigma_x = currentPoint[states_x][0];
-        sigma_y = currentPoint[states_y][0];
+        sigma_x = m_sigma_points[states_x][i];
+        sigma_y = m_sigma_points[states_y][i];
         angleToObj1 = atan2 ( y1 - sigma_y, x1 - sigma_x );
         angleToObj2 = atan2 ( y2 - sigma_y, x2 - sigma_x );
         Yprop[0][i] = mathGeneral::normaliseAngle(angleToObj1 - angleToObj2);
@@ -245,18 +227,18 @@ bool SelfUKF::measurementUpdateAngleBetweenTwoObjects(double angle, double x1, d
     float Ymean = convDble(CalculateMeanFromSigmas(Yprop));
 
     float Pyy(angle_variance);   // measurement noise is added, so just use as the beginning value of the sum.
-    Matrix Pxy(numStates, totalMeasurements, false);
+    StateVector Pxy;
 
     // Calculate the Pyy and Pxy variance matrices.
-    for(unsigned int i = 0; i < totalPoints; ++i)
+    for(unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
     {
         double weight = m_covariance_weights[0][i];
         // store difference between prediction and measurement.
-        currentPoint = Yprop.getCol(i) - Ymean;
+        const double currentPoint = Yprop[0][i] - Ymean;
         // Innovation covariance - Add Measurement noise
-        Pyy = Pyy + weight * convDble(currentPoint * currentPoint.transp());
+        Pyy = Pyy + weight * currentPoint * currentPoint;
         // Cross correlation matrix
-        Pxy = Pxy + weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint.transp();    // Important: Use mean from estimate, not current mean.
+        Pxy += weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint;    // Important: Use mean from estimate, not current mean.
     }
 
 
@@ -266,15 +248,9 @@ bool SelfUKF::measurementUpdateAngleBetweenTwoObjects(double angle, double x1, d
     setAlpha(new_alpha);
 
     // Calculate the Kalman filter gain
-    Matrix K;
-    // If we have a 2 dimensional measurement, use the faster shortcut function.
-    K = Pyy * Pxy;
-
-    Matrix newMean = mean() + K * (measurement - Ymean);
-    Matrix newCovariance = covariance() - K*Pyy*K.transp();
+    const StateVector K = Pyy * Pxy;
 
-    setMean(newMean);
-    setCovariance(newCovariance);
+    setState(StateVector(m_mean) + K * (measurement - Ymean), StateMatrix(m_covariance) - K*Pyy*K.transp());
     return true;
 }
 
@@ -316,7 +292,7 @@ unsigned int SelfUKF::previousSplitOption(const AmbiguousObject& theObject) cons
 */
 std::ostream& SelfUKF::writeStreamBinary (std::ostream& output) const
 {
-    UKF::writeStreamBinary(output);
+    UKF<states_total>::writeStreamBinary(output);
     WeightedModel::writeStreamBinary(output);
     return output;
 }
@@ -328,7 +304,7 @@ std::ostream& SelfUKF::writeStreamBinary (std::ostream& output) const
 */
 std::istream& SelfUKF::readStreamBinary (std::istream& input)
 {
-    UKF::readStreamBinary(input);
+    UKF<states_total>::readStreamBinary(input);
     WeightedModel::readStreamBinary(input);
     return input;
 }
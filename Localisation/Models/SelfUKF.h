@@ -8,7 +8,7 @@
 #include "Tools/Math/Filters/UKF.h"
 #include "WeightedModel.h"
 
-class SelfUKF: public UKF, public WeightedModel
+class SelfUKF: public UKF<3>, public WeightedModel   // the three states below
 {
 public:
 
@@ -27,13 +27,14 @@ public:
     SelfUKF(const SelfUKF& parent, const AmbiguousObject& object, const StationaryObject& splitOption, const MeasurementError& error, float time);
 
     bool clipState(int stateIndex, double minValue, double maxValue);
-    Matrix processEquation(const Matrix& sigma_point, double deltaT, const Matrix& measurement);
-    Matrix measurementEquation(const Matrix& sigma_point, const Matrix& measurementArgs);
+    StateVector processEquation(const StateVector& sigma_point, double deltaT, const Matrix& measurement);
+    MeasurementVector measurementEquation(const StateVector& sigma_point, const Matrix& measurementArgs);
 
     void setMean(const Matrix& newMean);
 
     bool MeasurementUpdate(const StationaryObject& object, const MeasurementError& error);
-    bool measurementUpdate(const Matrix& measurement, const Matrix& measurementNoise, const Matrix& measurementArgs = Matrix());
+    using UKF<states_total>::measurementUpdate;
+    bool measurementUpdate(const MeasurementVector& measurement, const MeasurementMatrix& measurementNoise, const Matrix& measurementArgs = Matrix());
     bool measurementUpdateAngleBetweenTwoObjects(double angle, double x1, double y1, double x2, double y2, double angle_variance);
 
     Self GenerateSelfState() const;
@@ -56,6 +57,9 @@ public:
     */
     std::istream& readStreamBinary (std::istream& input);
 
+protected:
+    void constrainMean(StateVector& mean) const;
+
 private:
     unsigned int m_split_option;    //!< Most recent option used for split from parent.
     std::vector<unsigned int> m_previous_decisions; //!< Stores the last decision for each of the ambiguous object types.
@@ -23,6 +23,7 @@ ENDIF()
 SET (YOUR_SRCS
         SelfModel.cpp 		SelfModel.h
         SelfSRUKF.cpp 		SelfSRUKF.h
+        SelfSRUKFBank.cpp	SelfSRUKFBank.h
         SelfUKF.cpp  		SelfUKF.h
         WeightedModel.cpp	WeightedModel.h
 )
@@ -1351,6 +1351,24 @@ int SelfLocalisation::landmarkUpdate(StationaryObject &landmark)
     temp_error.setDistance(c_obj_range_offset_variance + c_obj_range_relative_variance * pow(flatObjectDistance,2));
     temp_error.setHeading(c_obj_theta_variance);
 
+    if(landmark.measuredBearing() != landmark.measuredBearing())
+    {
+#if DEBUG_LOCALISATION_VERBOSITY > 0
+        debug_out  << "ABORTED Object Update Bearing is NaN skipping object." << endl;
+#endif // DEBUG_LOCALISATION_VERBOSITY > 0
+        return numSuccessfulUpdates;
+    }
+
+    // Update all of the active models together.
+    m_model_bank.clear();
+    for (ModelContainer::const_iterator model_it = m_models.begin(); model_it != m_models.end(); ++model_it)
+    {
+        if((*model_it)->active() == false) continue; // Skip Inactive models.
+        m_model_bank.add(static_cast<Model*>(*model_it), landmark, temp_error);
+    }
+    m_model_bank.MeasurementUpdate();
+
+    unsigned int lane = 0;
     for (ModelContainer::const_iterator model_it = m_models.begin(); model_it != m_models.end(); ++model_it)
     {
         if((*model_it)->active() == false) continue; // Skip Inactive models.
@@ -1363,17 +1381,7 @@ int SelfLocalisation::landmarkUpdate(StationaryObject &landmark)
         debug_out  << " Location = (" << landmark.X() << "," << landmark.Y() << ")...";
 #endif // DEBUG_LOCALISATION_VERBOSITY > 1
 
-        if(landmark.measuredBearing() != landmark.measuredBearing())
-	{
-#if DEBUG_LOCALISATION_VERBOSITY > 0
-            debug_out  << "ABORTED Object Update Bearing is NaN skipping object." << endl;
-#endif // DEBUG_LOCALISATION_VERBOSITY > 0
-            continue;
-        }
-        kf_return = SelfModel::RESULT_OK;
-
-
-        kf_return = (*model_it)->MeasurementUpdate(landmark, temp_error);
+        kf_return = m_model_bank.result(lane++);
 
 //        kf_return = m_models[modelID].fieldObjectmeas(flatObjectDistance, landmark.measuredBearing(),landmark.X(), landmark.Y(),
 //			distanceOffsetError, distanceRelativeError, bearingError);
@@ -1518,7 +1526,9 @@ bool SelfLocalisation::ballUpdate(const MobileObject& ball)
             m_ball_model->setMean(currMean);
         }
         m_prev_ball_update_time = m_timestamp;
+        return true;
     }
+    return false;
 }
 
 /*! @brief Prunes the models using a selectable method. This is a interface function to access a variety of methods.
@@ -1652,13 +1662,31 @@ int SelfLocalisation::ambiguousLandmarkUpdateExhaustive(AmbiguousObject &ambiguo
 
     MeasurementError error = calculateError(ambiguousObject);
 
+    // Split every active model on every option, and perform all of the updates together.
+    m_model_bank.clear();
+    for (ModelContainer::const_iterator model_it = m_models.begin(); model_it != m_models.end(); ++model_it)
+    {
+        if((*model_it)->inactive()) continue;
+        for(std::vector<StationaryObject*>::const_iterator obj_it = possibleObjects.begin(); obj_it != possibleObjects.end(); ++obj_it)
+        {
+            Model* split_model = new Model(*(*model_it), ambiguousObject, *(*obj_it), GetTimestamp());
+            StationaryObject update(*(*obj_it));
+            update.CopyObject(ambiguousObject);
+            m_model_bank.add(split_model, update, error);
+        }
+    }
+    m_model_bank.MeasurementUpdate();
+
+    unsigned int lane = 0;
     for (ModelContainer::const_iterator model_it = m_models.begin(); model_it != m_models.end(); ++model_it)
     {
         if((*model_it)->inactive()) continue;
         unsigned int models_added = 0;
         for(std::vector<StationaryObject*>::const_iterator obj_it = possibleObjects.begin(); obj_it != possibleObjects.end(); ++obj_it)
         {
-            temp_mod = new Model(*(*model_it), ambiguousObject, *(*obj_it), error, GetTimestamp());
+            temp_mod = m_model_bank.model(lane);
+            temp_mod->setActive(m_model_bank.result(lane) != SelfModel::RESULT_OUTLIER);
+            lane++;
             new_models.push_back(temp_mod);
 #if LOC_SUMMARY > 0
             m_frame_log << "Model [" << (*model_it)->id() << " - > " << temp_mod->id() << "] Ambiguous object update: " << std::string((*obj_it)->getName());
@@ -1,6 +1,7 @@
 #ifndef SELF_LOCWM_H_DEFINED
 #define SELF_LOCWM_H_DEFINED
 #include "Models/SelfSRUKF.h"
+#include "Models/SelfSRUKFBank.h"
 #include "Models/SelfUKF.h"
 #include "Tools/Math/Filters/MobileObjectUKF.h"
 
@@ -180,6 +181,7 @@ class SelfLocalisation: public TimestampedData
         static const int c_MAX_MODELS_AFTER_MERGE = 6; // Max models at the end of the frame
         static const int c_MAX_MODELS = (c_MAX_MODELS_AFTER_MERGE*8+2); // Total models
         ModelContainer m_models;
+        SelfSRUKFBank m_model_bank;     //!< used to update all of the models together
         MobileObjectUKF* m_ball_model;
 
 	#if DEBUG_LOCALISATION_VERBOSITY > 0
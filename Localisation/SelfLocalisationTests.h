@@ -7,5 +7,7 @@ bool MaxLikelyhoodTest();
 bool ViterbiTest();
 bool NscanTest();
 bool timingTest();
+bool processTimingTest();
+bool modelBankTest();
 
 #endif // SELFLOCALISATIONTESTS_H
@@ -2,6 +2,9 @@
 #include "SelfLocalisation.h"
 #include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/FieldObjects/FieldObjects.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/GameInformation/GameInformation.h"
+#include "Infrastructure/TeamInformation/TeamInformation.h"
 #include <iostream>
 #include <QTime>
 
@@ -522,3 +525,118 @@ bool NscanTest()
 
     return correct_num_models and all_models_found_n1 and all_models_found_n2;
 }
+
+/*! @brief Times SelfLocalisation::process with odometry, two goal posts and the ball seen every frame.
+    Run before and after a change to the filters to compare the cost of a frame.
+ */
+bool processTimingTest()
+{
+    const unsigned int total_frames = 10000;
+    SelfLocalisation loc(2);
+    NUSensorsData sensors;
+    FieldObjects objects;
+    GameInformation game_info(2, 0);
+    TeamInformation team_info(2, 0);
+    game_info.doManualStateChange();            // penalised
+    game_info.doManualStateChange();            // playing
+
+    StationaryObject* leftYGoal = &objects.stationaryFieldObjects[FieldObjects::FO_YELLOW_LEFT_GOALPOST];
+    StationaryObject* rightYGoal = &objects.stationaryFieldObjects[FieldObjects::FO_YELLOW_RIGHT_GOALPOST];
+    MobileObject* ball = &objects.mobileFieldObjects[FieldObjects::FO_BALL];
+
+    Vector3<float> left_measure(130,-0.19, 0);
+    Vector3<float> right_measure(161.92, -1.17, 0);
+    Vector3<float> ball_measure(80, 0.3, 0);
+    Vector3<float> empty_3f;
+    Vector2<float> empty_2f;
+    Vector2<int> empty_2i;
+
+    std::vector<float> odometry(3, 0);
+    odometry[0] = 0.5;
+    odometry[2] = 0.001;
+
+    QTime process_time;
+    process_time.start();
+    for (unsigned int i = 0; i < total_frames; ++i)
+    {
+        const double time = 1000 + 33.0*i;
+        sensors.CurrentTime = time;
+        sensors.set(NUSensorsData::Odometry, time, odometry);
+        objects.preProcess(time);
+        leftYGoal->UpdateVisualObject(left_measure, empty_3f, empty_2f, empty_2i, empty_2i, time);
+        rightYGoal->UpdateVisualObject(right_measure, empty_3f, empty_2f, empty_2i, empty_2i, time);
+        ball->UpdateVisualObject(ball_measure, empty_3f, empty_2f, empty_2i, empty_2i, time);
+        loc.process(&sensors, &objects, &game_info, &team_info);
+    }
+    int elapsed = process_time.elapsed();
+    std::cout << "SelfLocalisation::process " << total_frames << " frames: " << elapsed << " ms (";
+    std::cout << 1000.0*elapsed/total_frames << " us per frame)" << std::endl;
+    return loc.getNumActiveModels() > 0;
+}
+
+/*! @brief Checks that a SelfSRUKFBank gives the same results as updating each model on its own,
+    and compares the time taken by each for a full set of models.
+ */
+bool modelBankTest()
+{
+    const unsigned int num_models = 50;
+    const unsigned int total_updates = 1000;
+
+    FieldObjects objects;
+    StationaryObject* leftYGoal = &objects.stationaryFieldObjects[FieldObjects::FO_YELLOW_LEFT_GOALPOST];
+    Vector3<float> left_measure(200, -0.3, 0);
+    Vector3<float> empty_3f;
+    Vector2<float> empty_2f;
+    Vector2<int> empty_2i;
+    leftYGoal->UpdateVisualObject(left_measure, empty_3f, empty_2f, empty_2i, empty_2i, 100.00f);
+
+    MeasurementError error;
+    error.setDistance(100 + 0.04 * pow(leftYGoal->measuredDistance(),2));
+    error.setHeading(0.0025);
+
+    // spread the models over the field, so some of the updates are outliers
+    std::vector<Model*> single_models;
+    std::vector<Model*> bank_models;
+    for (unsigned int i = 0; i < num_models; ++i)
+    {
+        Model* model = new Model(0.0);
+        model->setMean(SelfLocalisation::mean_matrix(-300.0f + 600.0f*i/num_models, 200.0f - 400.0f*(i%7)/7, -3.0f + 6.0f*(i%11)/11));
+        model->setCovariance(SelfLocalisation::covariance_matrix(150.0f, 100.0f + i, 0.5f));
+        model->setAlpha(1.0f);
+        single_models.push_back(model);
+        bank_models.push_back(new Model(*model));
+    }
+
+    SelfSRUKFBank bank;
+    bool success = true;
+    QTime single_time;
+    single_time.start();
+    for (unsigned int n = 0; n < total_updates; ++n)
+    {
+        for (unsigned int i = 0; i < num_models; ++i)
+            single_models[i]->MeasurementUpdate(*leftYGoal, error);
+    }
+    int single_elapsed = single_time.elapsed();
+
+    QTime bank_time;
+    bank_time.start();
+    for (unsigned int n = 0; n < total_updates; ++n)
+    {
+        bank.clear();
+        for (unsigned int i = 0; i < num_models; ++i)
+            bank.add(bank_models[i], *leftYGoal, error);
+        bank.MeasurementUpdate();
+    }
+    int bank_elapsed = bank_time.elapsed();
+
+    for (unsigned int i = 0; i < num_models; ++i)
+    {
+        success = success and (single_models[i]->mean() == bank_models[i]->mean());
+        success = success and (single_models[i]->covariance() == bank_models[i]->covariance());
+        success = success and (single_models[i]->alpha() == bank_models[i]->alpha());
+        delete single_models[i];
+        delete bank_models[i];
+    }
+    std::cout << num_models << " models, " << total_updates << " updates: single " << single_elapsed << " ms, bank " << bank_elapsed << " ms" << std::endl;
+    return success;
+}
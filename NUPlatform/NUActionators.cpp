@@ -77,5 +77,8 @@ void NUActionators::copyToSound()
     vector<string> sounds;
     m_data->getNextSounds(sounds);
     for (unsigned int i=0; i<sounds.size(); i++)
-        m_sound_thread->pushBack(sounds[i]);
+    {
+        if (!m_sound_thread->pushBack(sounds[i]))
+            errorlog << "NUActionators::copyToSound(). The sound queue is full, " << sounds[i] << " was dropped." << endl;
+    }
 }
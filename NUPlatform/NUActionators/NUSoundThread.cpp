@@ -69,11 +69,11 @@ void NUSoundThread::run()
     int err = 0;
     while (err == 0 && errno != EINTR)
     {
-        waitForCondition();
+        string sound;
+        waitForData(sound);
         // ------------------------------------------------------------------------------------------------------------------------------------------
-        debug << "NUSoundThread Processing: " << m_player_command + m_sound_dir + m_queue.front() << endl;
-        err = system((m_player_command + m_sound_dir + m_queue.front()).c_str());
-        m_queue.pop_front();
+        debug << "NUSoundThread Processing: " << m_player_command + m_sound_dir + sound << endl;
+        err = system((m_player_command + m_sound_dir + sound).c_str());
         // ------------------------------------------------------------------------------------------------------------------------------------------
     } 
     errorlog << "NUSoundThread is exiting. err: " << err << " errno: " << errno << endl;
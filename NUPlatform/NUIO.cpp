@@ -37,6 +37,7 @@
 #include "Infrastructure/Jobs/Jobs.h"
 #include "Infrastructure/GameInformation/GameInformation.h"
 #include "Infrastructure/NUImage/NUImage.h"
+#include "Tools/Profiling/ProfileRecorder.h"
 
 #include <sstream>
 #include <string>
@@ -184,7 +185,7 @@ NUIO& operator<<(NUIO& io, NUbot& p_nubot)
         if(netdata.size > 0)
         {
 	   
-            io.m_vision_port->sendData(*(Blackboard->Image), *(Blackboard->Sensors));
+            io.m_vision_port->sendData(*(Blackboard->Image), *(Blackboard->Sensors), ProfileRecorder::summary());
         }
         if(io.m_localisation_port)
         {
@@ -26,6 +26,7 @@
 #include "TcpPort.h"
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/Profiling/ProfileRecorder.h"
 #include "debug.h"
 #include "debugverbositynetwork.h"
 #include <string.h>
@@ -232,7 +233,13 @@ void TcpPort::sendData(network_data_t netdata)
     return;
 }
 
-void TcpPort::sendData(const NUImage& p_image, const NUSensorsData &p_sensors)
+/*! @brief Sends an image, the sensor data and the vision profile summary
+
+    The size of the sensor data comes first, then the image header, the image rows and the sensor data,
+    as they always have. The profile summary is appended after them, preceded by its size, so that the
+    offsets of everything before it are unchanged.
+ */
+void TcpPort::sendData(const NUImage& p_image, const NUSensorsData &p_sensors, const ProfileSummary& p_profile)
 {
     network_data_t netdata;
     stringstream buffer;
@@ -242,6 +249,15 @@ void TcpPort::sendData(const NUImage& p_image, const NUSensorsData &p_sensors)
     string sensorsString = sensorsbuffer.str();
     sensordata.data = (char*) sensorsString.c_str();
     sensordata.size = sensorsString.size();
+    stringstream profilebuffer;
+    profilebuffer << p_profile;
+    string profileText = profilebuffer.str();
+    int profileSize = profileText.size();
+    string profileString(reinterpret_cast<char*>(&profileSize), sizeof(profileSize));
+    profileString += profileText;
+    network_data_t profiledata;
+    profiledata.data = (char*) profileString.c_str();
+    profiledata.size = profileString.size();
     
     int sensorsSize = sensordata.size;
     NUImage::Header image_header = NUImage::currentVersionHeader();
@@ -271,7 +287,7 @@ void TcpPort::sendData(const NUImage& p_image, const NUSensorsData &p_sensors)
         sendData(linedata);
     }
     sendData(sensordata);
-    
+    sendData(profiledata);
 }
 
 #if defined(USE_LOCALISATION)
@@ -38,6 +38,7 @@
 #include "Tools/Threading/Thread.h"
 class NUImage;
 class NUSensorsData;
+class ProfileSummary;
 class Localisation;
 class SelfLocalisation;
 class FieldObjects;
@@ -61,7 +62,7 @@ public:
     TcpPort(int portnumber);
     virtual ~TcpPort();
     void sendData(network_data_t netData);
-    void sendData(const NUImage& p_image, const NUSensorsData& p_sensors);
+    void sendData(const NUImage& p_image, const NUSensorsData& p_sensors, const ProfileSummary& p_profile);
     #if defined(USE_LOCALISATION)
         void sendData(const Localisation& p_locwm, const FieldObjects& p_objects);
         void sendData(const SelfLocalisation& p_locwm, const FieldObjects& p_objects);
@@ -34,6 +34,7 @@
 
 #include "Tools/Math/General.h"
 #include "Tools/Math/StlVector.h"
+#include "Tools/Math/FixedMatrix.h"
 #include "Motion/Tools/MotionFileTools.h"
 #include "Tools/Math/FIRFilter.h"
 
@@ -54,10 +55,10 @@ NUSensors::NUSensors(): m_initialised(false)
 #if DEBUG_NUSENSORS_VERBOSITY > 0
     debug << "NUSensors::NUSensors" << endl;
 #endif
-    m_current_time = Platform->getTime();
+    m_current_time = Platform ? Platform->getTime() : 0;     // there is no platform when NUSensors is benchmarked
     m_previous_time = -1000;
     m_data = new NUSensorsData();
-    m_touch = new EndEffectorTouch();
+    m_touch = new EndEffectorTouch(m_data);
     m_kinematicModel = new Kinematics();
     m_kinematicModel->LoadModel();
     m_orientationFilter = new OrientationUKF();
@@ -198,6 +199,7 @@ void NUSensors::initialise()
         // Add all of the values that we have discovered to the table.
         KinematicMap temp;
         temp.joints = effector_buffer;
+        temp.positions.resize(effector_buffer.size());
         temp.effector_id = p_effector_id;
         temp.transform_id = p_transform_id;
         temp.index = index;
@@ -245,11 +247,10 @@ void NUSensors::calculateOrientation()
     }
     else if (m_data->get(NUSensorsData::Gyro, gyros) && m_data->get(NUSensorsData::Accelerometer, acceleration))
     {
-        vector<float> supportLegTransformFlat;
-        bool validKinematics = m_data->get(NUSensorsData::SupportLegTransform, supportLegTransformFlat);
-        Matrix supportLegTransform = Matrix4x4fromVector(supportLegTransformFlat);
+        FixedMatrix<4,4> supportLegTransform;
+        bool validKinematics = m_data->get(NUSensorsData::SupportLegTransform, supportLegTransform);
         if(validKinematics)
-            orientation = Kinematics::OrientationFromTransform(supportLegTransform);
+            Kinematics::OrientationFromTransform(supportLegTransform, orientation);
 
         validKinematics = validKinematics && (fabs(acceleration[2]) > 2*fabs(acceleration[1]) && fabs(acceleration[2]) > 2*fabs(acceleration[0]));
 
@@ -288,10 +289,9 @@ void NUSensors::calculateHorizon()
     debug << "NUSensors::calculateHorizon()" << endl;
 #endif
     Horizon HorizonLine;
-    vector<float> cameraToGroundTransformFlat;
+    FixedMatrix<4,4> cameraToGroundTransform;
 
-    bool validKinematics = m_data->get(NUSensorsData::CameraToGroundTransform, cameraToGroundTransformFlat);
-    Matrix cameraToGroundTransform = Matrix4x4fromVector(cameraToGroundTransformFlat);
+    bool validKinematics = m_data->get(NUSensorsData::CameraToGroundTransform, cameraToGroundTransform);
 
     //Vector2<double> camFOV( Blackboard->CameraSpecs->m_horizontalFov, Blackboard->CameraSpecs->m_verticalFov);
     Vector2<double> camFOV(1.04719755, 0.802851456);
@@ -561,25 +561,19 @@ void NUSensors::calculateKinematics()
 {
     const double time = m_data->CurrentTime;
 
-    // Note that the kinematics uses the Matrix class, however, at this stage the NUSensorsData stores vector<float> and vector<vector<float>>
-    // In this early version we continue to use the method used in 2010:
-    //		- Matrices are stored in NUSensorsData as flattened vector<float> using Matrix.asVector()
-    //		- Matrices are then loaded from NUSensorsData into a temporary vector<float> then a Matrix is constructed from it using Matrix4x4fromVector
-        // There is no doubt this is messy, however, meh
+    // The transforms are calculated as FixedMatrix<4,4> and stored in NUSensorsData as flattened vector<float>, so nothing here allocates.
+    // Anything still reading them with get(id, vector<float>) and Matrix4x4fromVector sees the same values as before.
 
     // First get the joint data in the order required by the kinematic model. And find the resulting transform
     for (vector<KinematicMap>::iterator eff_it = m_kinematics_map.begin(); eff_it != m_kinematics_map.end(); ++eff_it)
     {
         // For each actuator, get the joint values
-        std::vector<float> joint_positions;
-        joint_positions.clear();
-        float temp;
-        Matrix result(4,4,false);
+        unsigned int numjoints = 0;
         for(vector<const NUData::id_t*>::iterator joint_it = eff_it->joints.begin(); joint_it != eff_it->joints.end(); ++joint_it)
         {
-            if(m_data->getPosition(*(*joint_it),temp))
+            if(m_data->getPosition(*(*joint_it),eff_it->positions[numjoints]))
             {
-                joint_positions.push_back(temp);
+                ++numjoints;
             }
             else
             {
@@ -588,33 +582,33 @@ void NUSensors::calculateKinematics()
                 break;  // no use going further with this effector.
             }
         }
-        if(joint_positions.size() == eff_it->joints.size())
+        if(numjoints == eff_it->joints.size() and m_kinematicModel->UpdateEffector(eff_it->index, eff_it->positions.empty() ? NULL : &eff_it->positions[0], numjoints))
         {
-            m_kinematicModel->UpdateEffector(eff_it->index, joint_positions);
-//            result = m_kinematicModel->CalculateTransform(eff_it->index, joint_positions);
-            result = m_kinematicModel->EndEffectorPosition(eff_it->index);
-            m_data->set(*eff_it->transform_id, time, result.asVector());
+            const FixedMatrix<4,4>& result = m_kinematicModel->EndEffectorTransform(eff_it->index);
+            m_data->set(*eff_it->transform_id, time, result);
             // If the effectors position and orientation are kept, write modify them here.
             if(eff_it->effector_id)
             {
-                m_data->modify(*eff_it->effector_id, NUSensorsData::EndPositionXId, time, Kinematics::PositionFromTransform(result));
-                m_data->modify(*eff_it->effector_id, NUSensorsData::EndPositionRollId, time, Kinematics::OrientationFromTransform(result));
+                Kinematics::PositionFromTransform(result, m_kinematics_buffer);
+                m_data->modify(*eff_it->effector_id, NUSensorsData::EndPositionXId, time, m_kinematics_buffer);
+                Kinematics::OrientationFromTransform(result, m_kinematics_buffer);
+                m_data->modify(*eff_it->effector_id, NUSensorsData::EndPositionRollId, time, m_kinematics_buffer);
             }
 
         }
         else
         {
             m_data->setAsInvalid(*eff_it->transform_id);
-            debug << "NUSensors::calculateKinematics(). WARNING: Incorrect number of joints: " << eff_it->transform_id << ": " << eff_it->joints.size() << " Required, " << joint_positions.size() << " Found." << endl;
-            errorlog << "NUSensors::calculateKinematics(). WARNING: Incorrect number of joints: " << eff_it->transform_id << ": " << eff_it->joints.size() << " Required, " << joint_positions.size() << " Found." << endl;
+            debug << "NUSensors::calculateKinematics(). WARNING: Incorrect number of joints: " << eff_it->transform_id << ": " << eff_it->joints.size() << " Required, " << numjoints << " Found." << endl;
+            errorlog << "NUSensors::calculateKinematics(). WARNING: Incorrect number of joints: " << eff_it->transform_id << ": " << eff_it->joints.size() << " Required, " << numjoints << " Found." << endl;
         }
     }
 
 
     // This next part calculates the more complex transform requried.
-    Matrix supportLegTransform;     // transform from torso to leg.
+    FixedMatrix<4,4> supportLegTransform;     // transform from torso to leg.
+    FixedMatrix<4,4> temp;                    // buffer for the other transforms.
     bool legTransform = false;      // flag used to indicate the required leg transfrom was available.
-    std::vector<float> temp;        // temp buffer used to store the vectorised matrices.
 
     bool leftFootSupport = false, rightFootSupport = false;     // flags to indicate if each foot is providing support.
 
@@ -636,9 +630,9 @@ void NUSensors::calculateKinematics()
         float leftHeight = 0;
         float rightHeight = 0;
         data_ok = m_data->get(NUSensorsData::LLegTransform, temp);
-        if(data_ok) leftHeight = Matrix4x4fromVector(temp)[2][3];
+        if(data_ok) leftHeight = temp[2][3];
         data_ok = m_data->get(NUSensorsData::RLegTransform, temp);
-        if(data_ok) rightHeight = Matrix4x4fromVector(temp)[2][3];
+        if(data_ok) rightHeight = temp[2][3];
         if(rightHeight < leftHeight)
         {
             leftSupport = false;
@@ -656,24 +650,23 @@ void NUSensors::calculateKinematics()
         // if left foot cannot be used use right
         if(!leftSupport && rightSupport)
         {
-            legTransform = m_data->get(NUSensorsData::LLegTransform, temp);
+            legTransform = m_data->get(NUSensorsData::LLegTransform, supportLegTransform);
         }
         // otherwise use left
         else if(leftSupport)
         {
-            legTransform = m_data->get(NUSensorsData::RLegTransform, temp);
+            legTransform = m_data->get(NUSensorsData::RLegTransform, supportLegTransform);
         }
 
         // if the leg transform was successfully retrieved.
         if(legTransform)
         {
-            supportLegTransform = Matrix4x4fromVector(temp);    // convert from vector to matrix
-            m_data->set(NUSensorsData::SupportLegTransform, time, temp);    // set the support leg transform to the one retrieved.
+            m_data->set(NUSensorsData::SupportLegTransform, time, supportLegTransform);    // set the support leg transform to the one retrieved.
             if(m_data->get(NUSensorsData::CameraTransform, temp))   // get camera transform
             {
                 // if successful
-                Matrix cameraToGroundTransform = Kinematics::CalculateCamera2GroundTransform(supportLegTransform, Matrix4x4fromVector(temp));  // calculate complete transform
-                m_data->set(NUSensorsData::CameraToGroundTransform, time, cameraToGroundTransform.asVector());  // set the new transform
+                FixedMatrix<4,4> cameraToGroundTransform = Kinematics::CalculateCamera2GroundTransform(supportLegTransform, temp);  // calculate complete transform
+                m_data->set(NUSensorsData::CameraToGroundTransform, time, cameraToGroundTransform);  // set the new transform
             }
             else
             {
@@ -698,10 +691,9 @@ void NUSensors::calculateCameraHeight()
 #if DEBUG_NUSENSORS_VERBOSITY > 4
     debug << "NUSensors::calculateCameraHeight()" << endl;
 #endif
-    vector<float> cgtvector;
-    if (m_data->get(NUSensorsData::CameraToGroundTransform, cgtvector))
+    FixedMatrix<4,4> cameraGroundTransform;
+    if (m_data->get(NUSensorsData::CameraToGroundTransform, cameraGroundTransform))
     {
-        Matrix cameraGroundTransform = Matrix4x4fromVector(cgtvector);
         m_data->set(NUSensorsData::CameraHeight, m_data->CurrentTime, static_cast<float>(cameraGroundTransform[2][3]));
     }
     else
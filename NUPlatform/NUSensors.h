@@ -91,11 +91,13 @@ protected:
     struct KinematicMap
     {
         std::vector<const NUData::id_t*> joints;
+        std::vector<float> positions;       //!< buffer for the joint positions, so that the kinematics do not allocate
         const NUData::id_t* transform_id;
         const NUData::id_t* effector_id;
         unsigned int index;
     };
     std::vector<KinematicMap> m_kinematics_map;
+    std::vector<float> m_kinematics_buffer;     //!< buffer for the effector positions and orientations
 //    vector< vector<const NUData::id_t*> > m_kinematics_joint_map;   //!< Vector matching the joint ordering in the Kinematics model to the joint is used by NUSensorData for each effector.
 //    vector<const NUData::id_t*> m_kinematics_transform_ids;         //!< Vector matching the transform of the above effectors to the ids used bu NUSensorsData.
 //    vector<const NUData::id_t*> m_kinematics_effector_ids;          //!< Vector matching the above effectors to the ids used bu NUSensorsData.
@@ -20,7 +20,6 @@
  */
 #include "EndEffectorTouch.h"
 
-#include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
 
 #include "Tools/Math/General.h"
@@ -33,9 +32,10 @@
 #include <math.h>
 #include <limits>
 
-/*! @brief Default constructor
+/*! @brief Constructor
+    @param data the sensor data the touch sensors are read from and the soft sensors are written to
  */
-EndEffectorTouch::EndEffectorTouch()
+EndEffectorTouch::EndEffectorTouch(NUSensorsData* data) : m_data(data)
 {
     #if DEBUG_NUSENSORS_VERBOSITY > 0
         debug << "EndEffectorTouch::EndEffectorTouch()" << endl;
@@ -104,13 +104,13 @@ void EndEffectorTouch::calculate(const NUData::id_t& endeffector)
 {
     bool success = false;
     if (endeffector == NUSensorsData::LArmEndEffector)
-        success = Blackboard->Sensors->get(NUSensorsData::LHandTouch, m_touch_data);
+        success = m_data->get(NUSensorsData::LHandTouch, m_touch_data);
     else if (endeffector == NUSensorsData::RArmEndEffector)
-        success = Blackboard->Sensors->get(NUSensorsData::RHandTouch, m_touch_data);
+        success = m_data->get(NUSensorsData::RHandTouch, m_touch_data);
     else if (endeffector == NUSensorsData::LLegEndEffector)
-        success = Blackboard->Sensors->get(NUSensorsData::LFootTouch, m_touch_data);
+        success = m_data->get(NUSensorsData::LFootTouch, m_touch_data);
     else if (endeffector == NUSensorsData::RLegEndEffector)
-        success = Blackboard->Sensors->get(NUSensorsData::RFootTouch, m_touch_data);
+        success = m_data->get(NUSensorsData::RFootTouch, m_touch_data);
     else
         return;
     
@@ -145,7 +145,7 @@ void EndEffectorTouch::calculateForce(const NUData::id_t& endeffector)
         m_max_forces[j] = result;
     
     // store the result
-    Blackboard->Sensors->modify(endeffector, NUSensorsData::ForceId, Blackboard->Sensors->CurrentTime, result);
+    m_data->modify(endeffector, NUSensorsData::ForceId, m_data->CurrentTime, result);
 }
 
 /*! @brief Calculates whether the end effector is in contact with something
@@ -155,7 +155,7 @@ void EndEffectorTouch::calculateForce(const NUData::id_t& endeffector)
 void EndEffectorTouch::calculateContact(const NUData::id_t& endeffector)
 {
     float force;
-    if (Blackboard->Sensors->getForce(endeffector, force))
+    if (m_data->getForce(endeffector, force))
     {
         int j = endeffector.Id - m_id_offset;
         float min = m_min_forces[j];
@@ -164,10 +164,10 @@ void EndEffectorTouch::calculateContact(const NUData::id_t& endeffector)
         bool result = false;
         if (force > min + 0.1*range)
             result = true;
-        Blackboard->Sensors->modify(endeffector, NUSensorsData::ContactId, Blackboard->Sensors->CurrentTime, result);
+        m_data->modify(endeffector, NUSensorsData::ContactId, m_data->CurrentTime, result);
     }
     else
-        Blackboard->Sensors->modify(endeffector, NUSensorsData::ContactId, Blackboard->Sensors->CurrentTime, m_Nan);
+        m_data->modify(endeffector, NUSensorsData::ContactId, m_data->CurrentTime, m_Nan);
 }
 
 /*! @brief Calculates the centre of pressure under the end effector based on the touch data
@@ -179,7 +179,7 @@ void EndEffectorTouch::calculateCentreOfPressure(const NUData::id_t& endeffector
     bool contact = false;
     float copx = m_Nan;
     float copy = m_Nan;
-    if (Blackboard->Sensors->getContact(endeffector, contact) and contact)
+    if (m_data->getContact(endeffector, contact) and contact)
     {	// centre of pressure calculation is only valid if we are in contact with an object
     	vector<vector<float> >& hull = m_hulls[endeffector.Id - m_id_offset];
     	if (hull.size() == m_touch_data.size())
@@ -199,8 +199,8 @@ void EndEffectorTouch::calculateCentreOfPressure(const NUData::id_t& endeffector
             copy /= sum;
         }
     }
-    Blackboard->Sensors->modify(endeffector, NUSensorsData::CoPXId, Blackboard->Sensors->CurrentTime, copx);
-    Blackboard->Sensors->modify(endeffector, NUSensorsData::CoPYId, Blackboard->Sensors->CurrentTime, copy);
+    m_data->modify(endeffector, NUSensorsData::CoPXId, m_data->CurrentTime, copx);
+    m_data->modify(endeffector, NUSensorsData::CoPYId, m_data->CurrentTime, copy);
 }
 
 /*! @brief Calculates whether the endeffector is supporting the robot. 
@@ -212,14 +212,14 @@ void EndEffectorTouch::calculateSupport(const NUData::id_t& endeffector)
 {
     bool contact = false;
 	bool support = false;
-    if (Blackboard->Sensors->getContact(endeffector, contact) and contact)
+    if (m_data->getContact(endeffector, contact) and contact)
     {	// we can only be supporting if there is contact on the end effector
         vector<float> cop;
-        if (Blackboard->Sensors->getCoP(endeffector, cop))		// if there is valid centre of pressure measurement
+        if (m_data->getCoP(endeffector, cop))		// if there is valid centre of pressure measurement
             if (mathGeneral::PointInsideConvexHull(cop[0], cop[1], m_hulls[endeffector.Id - m_id_offset], 0.2))		// if the cop is inside the convex hull
         		support = true;
     }
-    Blackboard->Sensors->modify(endeffector, NUSensorsData::SupportId, Blackboard->Sensors->CurrentTime, support);
+    m_data->modify(endeffector, NUSensorsData::SupportId, m_data->CurrentTime, support);
 }
 
 /*! @brief Invalidates all of the touch related end effector sensor values
@@ -227,5 +227,5 @@ void EndEffectorTouch::calculateSupport(const NUData::id_t& endeffector)
  */
 void EndEffectorTouch::invalidate(const NUData::id_t& endeffector)
 {
-    Blackboard->Sensors->modify(endeffector, NUSensorsData::ForceId, Blackboard->Sensors->CurrentTime, m_Nan_all);
+    m_data->modify(endeffector, NUSensorsData::ForceId, m_data->CurrentTime, m_Nan_all);
 }
@@ -40,10 +40,12 @@
 #include <vector>
 using namespace std;
 
+class NUSensorsData;
+
 class EndEffectorTouch
 {
 public:
-    EndEffectorTouch();
+    EndEffectorTouch(NUSensorsData* data);
     ~EndEffectorTouch();
     
     void calculate();
@@ -59,6 +61,7 @@ private:
     
     void getHull(const NUData::id_t& endeffector, vector<vector<float> >& hull);
 private:
+    NUSensorsData* m_data;                                  //!< the sensor data the touch sensors are read from and the soft sensors are written to
     vector<float> m_touch_data;								//!< the current touch data we are working with
     
     int m_id_offset;
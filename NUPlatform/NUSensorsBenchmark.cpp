@@ -0,0 +1,145 @@
+/*! @file NUSensorsBenchmark.cpp
+    @brief Implementation of the NUSensors soft sensor benchmark
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "NUSensorsBenchmark.h"
+#include "NUSensors.h"
+
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Kinematics/Kinematics.h"
+#include "Tools/Math/FixedMatrix.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cmath>
+#include <time.h>
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+/*! @brief A NUSensors whose joints are set by the benchmark instead of the hardware */
+class BenchmarkSensors : public NUSensors
+{
+public:
+    BenchmarkSensors() : m_loaded(false) {}
+
+    bool load(const std::string& model_file)
+    {
+        std::ifstream file(model_file.c_str());
+        m_loaded = file.is_open() and m_kinematicModel->LoadModelFromFile(file);
+        if (not m_loaded)
+            return false;
+
+        // the sensors are the joints of the model
+        std::vector<std::string> names;
+        const Kinematics::RobotModel* model = m_kinematicModel->getModel();
+        for (Kinematics::RobotModel::const_iterator effector = model->begin(); effector != model->end(); ++effector)
+            for (std::vector<Link>::const_iterator link = effector->links()->begin(); link != effector->links()->end(); ++link)
+                if (std::find(names.begin(), names.end(), link->name()) == names.end())
+                    names.push_back(link->name());
+        m_data->addSensors(names);
+        m_joints = m_data->mapIdToIds(NUSensorsData::All);
+        m_joint.assign(NUSensorsData::NumJointSensorIndices, 0.0f);
+        initialise();
+        return true;
+    }
+
+    /*! @brief Sets the joints for the frame, only the first two (the head) move unless move_all is true */
+    void setJoints(unsigned int frame, bool move_all)
+    {
+        double time = 1000 + 10.0*frame;
+        m_data->PreviousTime = m_data->CurrentTime;
+        m_data->CurrentTime = time;
+        m_current_time = time;
+        for (size_t i=0; i<m_joints.size(); i++)
+        {
+            m_joint[NUSensorsData::PositionId] = (move_all or i < 2) ? 0.3f*sin(0.01f*frame + i) : 0.1f*i;
+            m_data->set(*m_joints[i], time, m_joint);
+        }
+    }
+
+    void kinematics() {calculateKinematics();}
+    void softSensors() {calculateSoftSensors();}
+
+    /*! @brief Checks the published transforms against a full recalculation of each chain */
+    bool check()
+    {
+        bool matches = true;
+        FixedMatrix<4,4> published;
+        for (std::vector<KinematicMap>::iterator map = m_kinematics_map.begin(); map != m_kinematics_map.end(); ++map)
+        {
+            std::vector<float> positions;
+            float position;
+            for (size_t i=0; i<map->joints.size(); i++)
+                if (m_data->getPosition(*map->joints[i], position))
+                    positions.push_back(position);
+            if (not m_data->get(*map->transform_id, published))
+                return false;
+            Matrix expected = m_kinematicModel->CalculateTransform(map->index, positions);
+            for (unsigned int r=0; r<4; r++)
+                for (unsigned int c=0; c<4; c++)
+                    matches &= fabs(published[r][c] - expected[r][c]) < 1e-4;
+        }
+        return matches;
+    }
+
+private:
+    bool m_loaded;
+    std::vector<NUData::id_t*> m_joints;
+    std::vector<float> m_joint;
+};
+
+bool NUSensorsBenchmark(const std::string& model_file, unsigned int frames)
+{
+    BenchmarkSensors sensors;
+    if (not sensors.load(model_file))
+    {
+        std::cout << "NUSensorsBenchmark - unable to load " << model_file << std::endl;
+        return false;
+    }
+
+    bool success = true;
+    std::cout << "NUSensorsBenchmark - " << model_file << std::endl;
+    for (int move_all = 1; move_all >= 0; move_all--)
+    {
+        double start = benchmarkTime();
+        for (unsigned int i=0; i<frames; i++)
+        {
+            sensors.setJoints(i, move_all);
+            sensors.kinematics();
+        }
+        double middle = benchmarkTime();
+        for (unsigned int i=0; i<frames; i++)
+        {
+            sensors.setJoints(i, move_all);
+            sensors.softSensors();
+        }
+        double end = benchmarkTime();
+        success &= sensors.check();
+
+        std::cout << (move_all ? "\tall joints moving" : "\tonly the head moving") << std::endl;
+        std::cout << "\t\tcalculateKinematics:  " << 1e3*(middle - start)/frames << " us/frame" << std::endl;
+        std::cout << "\t\tcalculateSoftSensors: " << 1e3*(end - middle)/frames << " us/frame" << std::endl;
+    }
+    if (not success)
+        std::cout << "NUSensorsBenchmark - the published transforms differ from the recalculated ones" << std::endl;
+    return success;
+}
@@ -0,0 +1,35 @@
+/*! @file NUSensorsBenchmark.h
+    @brief Times the soft sensor calculations of NUSensors with a kinematic model.
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef NUSENSORSBENCHMARK_H
+#define NUSENSORSBENCHMARK_H
+
+#include <string>
+
+/*! @brief Times NUSensors::calculateKinematics() and NUSensors::calculateSoftSensors() with the given kinematic model.
+
+    The joints of the model are added to a NUSensorsData and moved along a smooth trajectory. Each model is timed
+    with every joint moving, and with only the head moving, where the cached leg transforms are reused. The
+    transforms the kinematics publish are checked against Kinematics::CalculateTransform, which recalculates
+    the whole chain.
+    @param model_file the kinematic model, eg. Config/NAO/Motion/Kinematics.cfg or Config/Darwin/Motion/Kinematics.cfg
+    @param frames the number of sensor frames timed in each run
+    @return true if the model was loaded and every published transform matched the recalculated one
+ */
+bool NUSensorsBenchmark(const std::string& model_file, unsigned int frames = 20000);
+
+#endif
@@ -178,6 +178,14 @@ storedTimeStamp(Platform->getTime())
 
     // enable streaming
     setStreaming(true);
+
+#ifdef THREAD_SEETHINK_PIPELINED
+    m_current_frame.index = -1;
+    m_capturing = true;
+    sem_init(&m_captured_count, 0, 0);
+    m_capture_thread = new CaptureThread(this);
+    m_capture_thread->start();
+#endif
 }
 
 DarwinCamera::~DarwinCamera()
@@ -185,8 +193,17 @@ DarwinCamera::~DarwinCamera()
 #if DEBUG_NUCAMERA_VERBOSITY > 4
     debug << "DarwinCamera::~DarwinCamera()" << endl;
 #endif
+#ifdef THREAD_SEETHINK_PIPELINED
+  // stop capturing, turning the stream off wakes the capture thread if it is waiting on the driver
+  m_capturing = false;
+  setStreaming(false);
+  m_capture_thread->join();
+  delete m_capture_thread;
+  sem_destroy(&m_captured_count);
+#else
   // disable streaming
   setStreaming(false);
+#endif
 
   // unmap buffers
   for(int i = 0; i < frameBufferCount; ++i)
@@ -339,6 +356,7 @@ double DarwinCamera::getTimeStamp() const
   return timeStamp;
 }
 
+#ifndef THREAD_SEETHINK_PIPELINED
 NUImage* DarwinCamera::grabNewImage()
 {
     while(!capturedNew());
@@ -347,6 +365,90 @@ NUImage* DarwinCamera::grabNewImage()
     currentBufferedImage.setCameraSettings(m_settings);
     return &currentBufferedImage;
 }
+#else
+/*! @brief Returns the newest frame captured by the capture thread, waiting for one if none are ready.
+
+    The buffer of the previously returned image is given back to the driver, so the previous image
+    must no longer be in use. Frames that were captured but superseded before this call are dropped.
+ */
+NUImage* DarwinCamera::grabNewImage()
+{
+    if(m_current_frame.index >= 0)
+        requeueFrame(m_current_frame);
+
+    while(sem_wait(&m_captured_count) != 0 && errno == EINTR);
+    m_captured.pop(m_current_frame);
+
+    // only the newest frame is processed, the rest go straight back to the driver
+    CapturedFrame newer;
+    while(sem_trywait(&m_captured_count) == 0 && m_captured.pop(newer))
+    {
+        requeueFrame(m_current_frame);
+        m_current_frame = newer;
+    }
+
+    currentBufferedImage.MapYUV422BufferToImage(static_cast<unsigned char*>(mem[m_current_frame.index]), WIDTH, HEIGHT, true);
+    currentBufferedImage.setTimestamp(m_current_frame.timestamp);
+    currentBufferedImage.setCameraSettings(m_settings);
+    return &currentBufferedImage;
+}
+
+/*! @brief Blocks until the driver has filled a frame buffer, and then dequeues it.
+    @param frame will be set to the dequeued buffer
+    @return false if no buffer could be dequeued, for example when streaming has been turned off
+ */
+bool DarwinCamera::dequeueFrame(CapturedFrame& frame)
+{
+    struct v4l2_buffer dequeued;
+    memset(&dequeued, 0, sizeof(dequeued));
+    dequeued.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    dequeued.memory = V4L2_MEMORY_MMAP;
+    if(ioctl(fd, VIDIOC_DQBUF, &dequeued) == -1)
+        return false;
+
+    ASSERT(dequeued.bytesused == SIZE);
+    frame.index = dequeued.index;
+    frame.timestamp = Platform->getTime();
+    return true;
+}
+
+/*! @brief Gives a dequeued frame buffer back to the driver to be filled again */
+void DarwinCamera::requeueFrame(const CapturedFrame& frame)
+{
+    struct v4l2_buffer queued;
+    memset(&queued, 0, sizeof(queued));
+    queued.index = frame.index;
+    queued.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    queued.memory = V4L2_MEMORY_MMAP;
+    VERIFY(ioctl(fd, VIDIOC_QBUF, &queued) != -1);
+}
+
+DarwinCamera::CaptureThread::CaptureThread(DarwinCamera* camera) : Thread(string("DarwinCameraCapture"), THREAD_SEETHINK_PRIORITY), m_camera(camera)
+{
+}
+
+/*! @brief The capture stage. Each dequeued buffer is pushed to the ring and counted.
+
+    There are only frameBufferCount buffers and the ring holds that many, so the push can not fail.
+ */
+void DarwinCamera::CaptureThread::run()
+{
+    CapturedFrame frame;
+    while(m_camera->m_capturing)
+    {
+        if(m_camera->dequeueFrame(frame))
+        {
+            m_camera->m_captured.push(frame);
+            sem_post(&m_camera->m_captured_count);
+        }
+        else if(m_camera->m_capturing && errno != EINTR)
+        {
+            errorlog << "DarwinCamera::CaptureThread::run(). Failed to dequeue a frame: " << strerror(errno) << endl;
+            usleep(5000);
+        }
+    }
+}
+#endif
 
 void DarwinCamera::readCameraSettings()
 {
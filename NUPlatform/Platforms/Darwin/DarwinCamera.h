@@ -30,7 +30,18 @@
 #include "NUPlatform/NUCamera.h"
 #include "NUPlatform/NUCamera/CameraSettings.h"
 #include "Infrastructure/NUImage/NUImage.h"
+#include "nubotconfig.h"
 
+#ifdef THREAD_SEETHINK_PIPELINED
+    #include "Tools/Threading/Thread.h"
+    #include "Tools/Threading/SPSCRing.h"
+    #include <semaphore.h>
+#endif
+
+/*! When THREAD_SEETHINK_PIPELINED is defined a capture thread dequeues and timestamps frames while
+    the previous frame is being processed. Captured buffers are handed over through a lock-free
+    ring, and grabNewImage() returns the newest of them, giving the older ones back to the driver.
+ */
 class DarwinCamera : public NUCamera
 {
 public:
@@ -48,7 +59,11 @@ private:
 private:
   enum
     {
+#ifdef THREAD_SEETHINK_PIPELINED
+        frameBufferCount = 4, //!< Number of available frame buffers, one being filled, one being processed and the rest queued.
+#else
         frameBufferCount = 1, //!< Number of available frame buffers.
+#endif
         WIDTH = 640,
         HEIGHT = 480,
         SIZE = WIDTH * HEIGHT * 2
@@ -73,6 +88,36 @@ private:
     double getTimeStamp() const;
 
     NUImage currentBufferedImage;
+
+#ifdef THREAD_SEETHINK_PIPELINED
+    /*! @brief A dequeued frame buffer */
+    struct CapturedFrame
+    {
+        int index;                      //!< The index of the frame buffer.
+        double timestamp;               //!< The time the buffer was dequeued.
+    };
+
+    /*! @brief The capture stage, dequeues frame buffers as soon as the driver fills them */
+    class CaptureThread : public Thread
+    {
+    public:
+        CaptureThread(DarwinCamera* camera);
+    protected:
+        void run();
+    private:
+        DarwinCamera* m_camera;
+    };
+    friend class CaptureThread;
+
+    bool dequeueFrame(CapturedFrame& frame);
+    void requeueFrame(const CapturedFrame& frame);
+
+    CaptureThread* m_capture_thread;
+    volatile bool m_capturing;                              //!< Cleared to stop the capture thread.
+    SPSCRing<CapturedFrame, frameBufferCount> m_captured;   //!< Frames dequeued by the capture thread, oldest first.
+    sem_t m_captured_count;                                 //!< Counts the frames in m_captured.
+    CapturedFrame m_current_frame;                          //!< The frame held by currentBufferedImage, index is -1 if there is none.
+#endif
 };
 
 #endif
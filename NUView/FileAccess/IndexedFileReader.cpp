@@ -1,6 +1,12 @@
 #include "IndexedFileReader.h"
+#include <QFileInfo>
+#include <QDateTime>
 #include <cmath>
-IndexedFileReader::IndexedFileReader(): m_fileEndLocation(0)
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+IndexedFileReader::IndexedFileReader(): m_persistIndex(true), m_fileEndLocation(0)
 {
     m_selectedFrame = m_index.end();
 }
@@ -22,7 +28,8 @@ bool IndexedFileReader::IsValid()
 
 /**
   *     Open constructor. Initialises the StreamFileReader and opens and indexes the file described by the filename.
-  *     Indexing of the file is then performed allowing fast random access to occur.
+  *     Indexing of the file is then performed allowing fast random access to occur. If the file has a valid sidecar
+  *     index it is loaded instead.
   *     @param filename The file path and name used to open the file.
   *     @return True when the file is opened and indexed correctly. False when the file is unable to be correctly opened and accessed.
   */
@@ -35,7 +42,12 @@ bool IndexedFileReader::OpenFile(const std::string& filename)
         m_file.seekg(0,std::ios_base::end);
         m_fileEndLocation = m_file.tellg();
         m_filename = filename;
-        IndexFile();
+        if(!m_persistIndex || !LoadIndex())
+        {
+            IndexFile();
+            if(m_persistIndex && IsValid())
+                SaveIndex();
+        }
     }
     if(!IsValid()) m_filename.clear();
     return IsValid();
@@ -203,3 +215,115 @@ void IndexedFileReader::ClearIndex()
     m_index.clear();
     m_timeIndex.clear();
 }
+
+// The sidecar index is a header followed by one entry per frame, in sequence order.
+namespace
+{
+    const char c_indexMagic[4] = {'N', 'U', 'I', 'X'};
+    const uint32_t c_indexVersion = 1;
+
+    struct SidecarHeader
+    {
+        char magic[4];
+        uint32_t version;
+        int64_t fileSize;               //!< The size of the indexed file.
+        int64_t fileModified;           //!< The modification time of the indexed file in seconds.
+        uint32_t frames;
+        uint32_t reserved;
+    };
+
+    struct SidecarEntry
+    {
+        double timestamp;
+        uint32_t frameSequenceNumber;
+        uint32_t reserved;
+        int64_t position;
+    };
+}
+
+/**
+  *     The name of the sidecar index file for the open file.
+  */
+std::string IndexedFileReader::IndexFileName() const
+{
+    return m_filename + ".idx";
+}
+
+/**
+  *     Load the index from the sidecar file.
+  *     @return True if the sidecar exists, matches the open file and was loaded. False if the file must be indexed.
+  */
+bool IndexedFileReader::LoadIndex()
+{
+    QFileInfo info(QString::fromLocal8Bit(m_filename.c_str()));
+    std::ifstream sidecar(IndexFileName().c_str(), std::ios_base::in | std::ios_base::binary);
+    if(!sidecar.good())
+        return false;
+
+    SidecarHeader header;
+    sidecar.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if(sidecar.gcount() != sizeof(header) || memcmp(header.magic, c_indexMagic, sizeof(c_indexMagic)) != 0 || header.version != c_indexVersion)
+        return false;
+    if(header.fileSize != info.size() || header.fileModified != static_cast<int64_t>(info.lastModified().toTime_t()))
+        return false;
+
+    std::vector<SidecarEntry> entries(header.frames);
+    if(header.frames > 0)
+    {
+        sidecar.read(reinterpret_cast<char*>(&entries[0]), sizeof(SidecarEntry)*entries.size());
+        if(sidecar.gcount() != static_cast<std::streamsize>(sizeof(SidecarEntry)*entries.size()))
+            return false;
+    }
+
+    ClearIndex();
+    FrameEntry temp;
+    for(unsigned int i = 0; i < entries.size(); i++)
+    {
+        if(entries[i].position < 0 || entries[i].position >= header.fileSize)
+        {
+            ClearIndex();
+            return false;
+        }
+        temp.frameSequenceNumber = entries[i].frameSequenceNumber;
+        temp.position = entries[i].position;
+        m_index.insert(IndexEntry(entries[i].timestamp, temp));
+        m_timeIndex.push_back(entries[i].timestamp);
+    }
+    return IsValid();
+}
+
+/**
+  *     Save the index to the sidecar file. Failing to save it, for example because the directory is read only, is not an error.
+  */
+void IndexedFileReader::SaveIndex()
+{
+    QFileInfo info(QString::fromLocal8Bit(m_filename.c_str()));
+    std::ofstream sidecar(IndexFileName().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    if(!sidecar.good())
+        return;
+
+    SidecarHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, c_indexMagic, sizeof(c_indexMagic));
+    header.version = c_indexVersion;
+    header.fileSize = info.size();
+    header.fileModified = info.lastModified().toTime_t();
+    header.frames = m_timeIndex.size();
+    sidecar.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    SidecarEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    for(unsigned int i = 0; i < m_timeIndex.size(); i++)
+    {
+        const FrameEntry& frame = m_index[m_timeIndex[i]];
+        entry.timestamp = m_timeIndex[i];
+        entry.frameSequenceNumber = frame.frameSequenceNumber;
+        entry.position = static_cast<std::streamoff>(frame.position);
+        sidecar.write(reinterpret_cast<const char*>(&entry), sizeof(entry));
+    }
+    if(!sidecar.good())
+    {
+        sidecar.close();
+        remove(IndexFileName().c_str());
+    }
+}
@@ -8,6 +8,12 @@
     data within a file. Classes which inherit from this class must define the
     indexing method as well as any data reading methods required.
 
+    The file is memory mapped, see MappedFile. Once a file has been indexed the index
+    is saved next to it in a sidecar file (the file name with .idx appended), and when
+    the file is opened again the index is loaded from the sidecar instead of scanning
+    the file. The sidecar is ignored if the size or modification time of the file has
+    changed since it was written.
+
     @author Steven Nicklin
 
   Copyright (c) 2010 Steven Nicklin
@@ -28,6 +34,7 @@
 
 #ifndef INDEXEDFILEREADER_H
 #define INDEXEDFILEREADER_H
+#include "MappedFile.h"
 #include <string>
 #include <fstream>
 #include <map>
@@ -78,11 +85,15 @@ protected:
     bool ValidEntry(IndexIterator entry);
     IndexIterator GetIndexFromTime(double time);
     void ClearIndex();
+    bool LoadIndex();
+    void SaveIndex();
+    std::string IndexFileName() const;
 
     // Protected member variables
     FileIndex m_index;                  //!< Index mapping timestamp to Frame entries.
     TimeIndex m_timeIndex;              //!< Index mapping sequence number to timestamp.
-    std::fstream m_file;                //!< The file.
+    MappedFile m_file;                  //!< The file.
+    bool m_persistIndex;                //!< True if the index is to be saved to and loaded from a sidecar file.
     Position m_fileEndLocation;         //!< The end position of the file.
     IndexIterator m_selectedFrame;      //!< Reference to the currently selected frame in the FileIndex.
     std::string m_filename;             //!< The name of the open file.
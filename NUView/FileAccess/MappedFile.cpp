@@ -0,0 +1,97 @@
+#include "MappedFile.h"
+
+MappedFile::MappedFile(): std::istream(NULL), m_mapping(NULL)
+{
+    rdbuf(&m_buffer);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+/**
+  *     Open and map the file. On failure the stream's failbit is set, as it is for a std::ifstream.
+  *     @param filename The file path and name.
+  *     @param mode The open mode, only reading is supported.
+  */
+void MappedFile::open(const char* filename, std::ios_base::openmode mode)
+{
+    close();
+    m_qfile.setFileName(QString::fromLocal8Bit(filename));
+    if(m_qfile.open(QIODevice::ReadOnly) && m_qfile.size() > 0)
+    {
+        m_mapping = m_qfile.map(0, m_qfile.size());
+    }
+    if(m_mapping)
+    {
+        m_buffer.setBlock(reinterpret_cast<const char*>(m_mapping), m_qfile.size());
+        rdbuf(&m_buffer);
+        clear();
+    }
+    else if(m_fallback.open(filename, mode | std::ios_base::in))
+    {
+        m_qfile.close();
+        rdbuf(&m_fallback);
+        clear();
+    }
+    else
+    {
+        m_qfile.close();
+        rdbuf(&m_buffer);
+        setstate(std::ios_base::failbit);
+    }
+}
+
+/**
+  *     Unmap and close the file. Pointers into the mapping are invalid afterwards.
+  */
+void MappedFile::close()
+{
+    if(m_mapping)
+    {
+        m_qfile.unmap(m_mapping);
+        m_mapping = NULL;
+    }
+    m_qfile.close();
+    m_fallback.close();
+    m_buffer.setBlock(NULL, 0);
+    rdbuf(&m_buffer);
+}
+
+bool MappedFile::is_open() const
+{
+    return m_mapping != NULL || m_fallback.is_open();
+}
+
+void MappedFile::MemoryBuffer::setBlock(const char* begin, std::streamsize size)
+{
+    char* start = const_cast<char*>(begin);
+    setg(start, start, start + size);
+}
+
+MappedFile::MemoryBuffer::pos_type MappedFile::MemoryBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    off_type position;
+    if(dir == std::ios_base::beg)
+        position = off;
+    else if(dir == std::ios_base::cur)
+        position = (gptr() - eback()) + off;
+    else
+        position = (egptr() - eback()) + off;
+    return seekpos(position, which);
+}
+
+MappedFile::MemoryBuffer::pos_type MappedFile::MemoryBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    off_type position = pos;
+    if(!(which & std::ios_base::in) || position < 0 || position > egptr() - eback())
+        return pos_type(off_type(-1));
+    setg(eback(), eback() + position, egptr());
+    return pos;
+}
+
+std::streamsize MappedFile::MemoryBuffer::showmanyc()
+{
+    return gptr() < egptr() ? egptr() - gptr() : -1;
+}
@@ -0,0 +1,77 @@
+/*! @file MappedFile.h
+    @brief Declaration of the MappedFile class
+
+    @class MappedFile
+    @brief A read only input stream over a memory mapped file.
+
+    The file is mapped into memory when it is opened, and the stream reads straight out of the
+    mapping, so seeking is free and reading a frame is a copy from memory instead of a read from
+    the disk. The mapping itself is available through data(), so frames can also be used in place
+    without being copied at all. Pages are only read from the disk when they are first touched.
+
+    If the file cannot be mapped, for example when it is larger than the address space, the
+    stream falls back to reading the file through a std::filebuf and data() returns NULL.
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+#include <istream>
+#include <fstream>
+#include <streambuf>
+#include <QFile>
+
+class MappedFile: public std::istream
+{
+public:
+    MappedFile();
+    ~MappedFile();
+
+    void open(const char* filename, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary);
+    void close();
+    bool is_open() const;
+
+    /**
+      *     The start of the mapping, which is valid until the file is closed.
+      *     @return The first byte of the file, or NULL if the file is not mapped.
+      */
+    const char* data() const {return m_buffer.begin();}
+    /**
+      *     @return The size of the mapping in bytes, 0 if the file is not mapped.
+      */
+    std::streamsize size() const {return m_buffer.size();}
+
+private:
+    /*! @brief A stream buffer reading from a block of memory */
+    class MemoryBuffer: public std::streambuf
+    {
+    public:
+        MemoryBuffer() {setBlock(NULL, 0);}
+        void setBlock(const char* begin, std::streamsize size);
+        const char* begin() const {return eback();}
+        std::streamsize size() const {return egptr() - eback();}
+    protected:
+        pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which = std::ios_base::in);
+        pos_type seekpos(pos_type pos, std::ios_base::openmode which = std::ios_base::in);
+        std::streamsize showmanyc();
+    };
+
+    QFile m_qfile;                      //!< The file that is mapped.
+    uchar* m_mapping;                   //!< The mapping, NULL if the file is not mapped.
+    MemoryBuffer m_buffer;              //!< The buffer reading from the mapping.
+    std::filebuf m_fallback;            //!< The buffer reading from the file when it cannot be mapped.
+};
+
+#endif // MAPPEDFILE_H
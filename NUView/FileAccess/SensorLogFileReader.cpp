@@ -0,0 +1,178 @@
+#include "SensorLogFileReader.h"
+#include <QDebug>
+#include <cmath>
+
+SensorLogFileReader::SensorLogFileReader(): IndexedFileReader(), m_decodedFrame(0)
+{
+    // indexing only reads the frame headers, and the key frames are not in the sidecar
+    m_persistIndex = false;
+    m_dataBuffer = new NUSensorsData();
+}
+
+SensorLogFileReader::~SensorLogFileReader()
+{
+    delete m_dataBuffer;
+}
+
+/**
+  *     Determine if a file is a binary sensor log.
+  *     @param filename The file path and name.
+  *     @return True if the file starts with the sensor log header.
+  */
+bool SensorLogFileReader::IsSensorLog(const std::string& filename)
+{
+    std::ifstream file(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+    return file.good() && SensorLog::isSensorLog(file);
+}
+
+/**
+  *     Read in the frame with the sequence number given. The first frame is at sequence number 1.
+  *     @param frameSequenceNumber The sequence number of the desired frame.
+  *     @return A pointer to the frame read from the file. NULL is returned if an error occurs.
+  */
+NUSensorsData* SensorLogFileReader::ReadFrameNumber(int frameSequenceNumber)
+{
+    double time = TimeAtSequenceNumber(frameSequenceNumber);
+    if(time >= 0.0)
+        return ReadFrame(GetIndexFromTime(time));
+    else
+        return NULL;
+}
+
+NUSensorsData* SensorLogFileReader::ReadFirstFrame()
+{
+    return ReadFrame(m_index.begin());
+}
+
+NUSensorsData* SensorLogFileReader::ReadNextFrame()
+{
+    IndexIterator entry = m_selectedFrame;
+    ++entry;
+    return ReadFrame(entry);
+}
+
+NUSensorsData* SensorLogFileReader::ReadPrevFrame()
+{
+    IndexIterator entry = m_selectedFrame;
+    if(entry != m_index.begin())
+    {
+        --entry;
+        return ReadFrame(entry);
+    }
+    return NULL;
+}
+
+NUSensorsData* SensorLogFileReader::ReadLastFrame()
+{
+    IndexIterator entry = m_index.end();
+    if(entry != m_index.begin())
+    {
+        --entry;
+        return ReadFrame(entry);
+    }
+    return NULL;
+}
+
+NUSensorsData* SensorLogFileReader::ReadFrameAtTime(double time)
+{
+    return ReadFrame(GetIndexFromTime(time));
+}
+
+/**
+  *     Decode the frame described by the given entry into the data buffer. The frames are decoded forwards from
+  *     the frame in the buffer when it can be, otherwise from the key frame the entry depends on.
+  *     @param entry Iterator pointing to the desired entry.
+  *     @return Pointer to the buffer containing the frame. NULL if the frame could not be read.
+  */
+NUSensorsData* SensorLogFileReader::ReadFrame(IndexIterator entry)
+{
+    if(!ValidEntry(entry) || !m_file.is_open())
+        return NULL;
+
+    unsigned int target = (*entry).second.frameSequenceNumber;
+    if(target == 0 || target > m_positions.size())
+        return NULL;
+
+    if(target != m_decodedFrame)
+    {
+        // carry on from the frame in the buffer if it is between the key frame and the target
+        unsigned int next = m_keyFrames[target - 1];
+        if(m_decodedFrame != 0 && m_decodedFrame >= next && m_decodedFrame < target)
+            next = m_decodedFrame + 1;
+
+        m_file.clear();
+        m_file.seekg(m_positions[next - 1], std::ios_base::beg);
+        m_decodedFrame = 0;
+        for(; next <= target; next++)
+        {
+            if(!m_reader.readFrame(m_file, *m_dataBuffer))
+                return NULL;
+        }
+        m_decodedFrame = target;
+    }
+    m_selectedFrame = entry;
+    return m_dataBuffer;
+}
+
+/**
+  *     Read the file header and the header of each frame, and index the location and timestamp of each frame
+  *     and the key frame it depends on.
+  */
+void SensorLogFileReader::IndexFile()
+{
+    m_positions.clear();
+    m_keyFrames.clear();
+    m_decodedFrame = 0;
+    if (!m_file.is_open())
+        return;
+
+    m_file.seekg(0, std::ios_base::beg);
+    m_index.clear();
+    m_timeIndex.clear();
+    if(!m_reader.readHeader(m_file, *m_dataBuffer))
+    {
+        qDebug("ERROR Reading Sensor Log Header. Check File Format.");
+        CloseFile();
+        return;
+    }
+
+    FrameEntry temp;
+    temp.frameSequenceNumber = 0;
+    unsigned int keyFrame = 0;
+    SensorLogFrameHeader header;
+    while(true)
+    {
+        Position pos = m_file.tellg();
+        if(!SensorLogReader::readFrameHeader(m_file, header))
+            break;
+        if(m_fileEndLocation - m_file.tellg() < static_cast<std::streamoff>(header.size))
+        {
+            qDebug("Incomplete frame found at %d", static_cast<int>(pos));
+            break;
+        }
+        m_file.seekg(header.size, std::ios_base::cur);
+
+        if(header.type == SensorLog::KeyFrame)
+            keyFrame = temp.frameSequenceNumber + 1;
+        if(keyFrame == 0)
+        {
+            qDebug("ERROR Sensor Log does not start with a key frame.");
+            break;
+        }
+
+        double timestamp = floor(0.5 + header.timestamp);
+        if(HasTime(timestamp))
+        {
+            qDebug("File: %s - Found duplicate frame time: %f", m_filename.c_str(), timestamp);
+            while(HasTime(timestamp)) timestamp += 1.0;
+        }
+        temp.frameSequenceNumber++;
+        temp.position = pos;
+        m_index.insert(IndexEntry(timestamp, temp));
+        m_timeIndex.push_back(timestamp);
+        m_positions.push_back(pos);
+        m_keyFrames.push_back(keyFrame);
+    }
+    m_file.clear();
+    m_selectedFrame = m_index.end();
+}
@@ -0,0 +1,62 @@
+/*! @file SensorLogFileReader.h
+    @brief Declaration of the SensorLogFileReader class
+
+    @class SensorLogFileReader
+    @brief Class used to read NUSensorsData from a binary sensor log.
+
+    Provides the same access to a binary sensor log (see Tools/FileFormats/SensorLogFormat.h)
+    as StreamFileReader<NUSensorsData> does to a text one. Indexing only reads the fixed size
+    header of each frame, so no frames are decoded until they are asked for.
+
+    Delta frames can only be decoded after the frame before them, so the position of the key frame
+    each frame depends on is indexed too. Stepping forwards decodes a single frame, any other move
+    decodes forwards from the key frame, which is at most SensorLog::c_key_frame_interval frames.
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SENSORLOGFILEREADER_H
+#define SENSORLOGFILEREADER_H
+#include "IndexedFileReader.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/FileFormats/SensorLogFormat.h"
+
+class SensorLogFileReader: public IndexedFileReader
+{
+public:
+    SensorLogFileReader();
+    ~SensorLogFileReader();
+
+    static bool IsSensorLog(const std::string& filename);
+
+    NUSensorsData* ReadFrameNumber(int frameSequenceNumber);
+    NUSensorsData* ReadFirstFrame();
+    NUSensorsData* ReadNextFrame();
+    NUSensorsData* ReadPrevFrame();
+    NUSensorsData* ReadLastFrame();
+    NUSensorsData* ReadFrameAtTime(double time);
+
+    void IndexFile();
+
+private:
+    NUSensorsData* ReadFrame(IndexIterator entry);
+
+    NUSensorsData* m_dataBuffer;                //!< The buffer the frames are decoded into.
+    SensorLogReader m_reader;                   //!< The decoder, which holds the previous frame for delta frames.
+    std::vector<Position> m_positions;          //!< The position of each frame, by sequence number - 1.
+    std::vector<unsigned int> m_keyFrames;      //!< The sequence number of the key frame each frame depends on, by sequence number - 1.
+    unsigned int m_decodedFrame;                //!< The sequence number of the frame in the buffer, 0 if there is none.
+};
+
+#endif // SENSORLOGFILEREADER_H
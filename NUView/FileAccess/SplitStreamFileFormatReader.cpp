@@ -43,7 +43,11 @@ const NUImage* SplitStreamFileFormatReader::GetImageData()
 
 const NUSensorsData* SplitStreamFileFormatReader::GetSensorData()
 {
-    if(sensorReader.IsValid())
+    if(binarySensorReader.IsValid())
+    {
+        return binarySensorReader.ReadFrameNumber(m_currentFrameIndex);
+    }
+    else if(sensorReader.IsValid())
     {
         return sensorReader.ReadFrameNumber(m_currentFrameIndex);
     }
@@ -161,6 +165,14 @@ int SplitStreamFileFormatReader::openFile(const QString& filename)
         {
             temp = (*fileIt).baseName();
             index = m_knownDataTypes.indexOf(temp);
+            if(m_knownDataTypes[index] == "sensor")
+            {
+                // sensor logs can be either text or binary
+                if(SensorLogFileReader::IsSensorLog((*fileIt).filePath().toStdString()))
+                    m_fileReaders[index] = &binarySensorReader;
+                else
+                    m_fileReaders[index] = &sensorReader;
+            }
             successIndicator = m_fileReaders[index]->OpenFile((*fileIt).filePath().toStdString());
 
             if(successIndicator)
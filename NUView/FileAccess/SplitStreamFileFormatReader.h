@@ -2,6 +2,7 @@
 #define SPLITSTREAMFILEFORMATREADER_H
 #include "LogFileFormatReader.h"
 #include "StreamFileReader.h"
+#include "SensorLogFileReader.h"
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Localisation/Localisation.h"
 #include "Localisation/SelfLocalisation.h"
@@ -58,6 +59,7 @@ protected:
     void setKnownDataTypes();
     StreamFileReader<NUImage> imageReader;
     StreamFileReader<NUSensorsData> sensorReader;
+    SensorLogFileReader binarySensorReader;
     StreamFileReader<NULocalisationSensors> locsensorReader;
     StreamFileReader<Localisation> locwmReader;
     StreamFileReader<SelfLocalisation> selflocwmReader;
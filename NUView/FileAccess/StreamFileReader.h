@@ -13,6 +13,8 @@
     Because it is a templated class, any timestamped data can be read from a stream file
     containing it. However any class used in the template must implement the abstract class
     TimestampedData found in the /Tools/FileFormats/ directory so as to access timestamps.
+    Images are not copied out of the file, the NUImage returned references the memory mapped
+    frame directly and is valid until the file is closed.
 
     @author Steven Nicklin
 
@@ -39,6 +41,35 @@
 #include <cmath>
 #include "IndexedFileReader.h"
 #include "Tools/FileFormats/FileFormatException.h"
+#include "Infrastructure/NUImage/NUImage.h"
+
+/**
+  *     Read the frame at the current position of the file into data, and leave the file at the start of the next frame.
+  */
+template<class C>
+inline void ReadStreamFrame(MappedFile& file, C& data)
+{
+    file >> data;
+}
+
+/**
+  *     Images are mapped in place when the file is memory mapped, instead of being copied out of it.
+  */
+inline void ReadStreamFrame(MappedFile& file, NUImage& image)
+{
+    if(file.data() == NULL)
+    {
+        file >> image;
+        return;
+    }
+    std::streamoff position = file.tellg();
+    if(position < 0)
+        throw std::exception();
+    size_t frame_size = image.MapStreamedImage(file.data() + position, file.size() - position);
+    if(frame_size == 0)
+        throw std::exception();
+    file.seekg(frame_size, std::ios_base::cur);
+}
 
 template<class C>
 class StreamFileReader: public IndexedFileReader
@@ -163,7 +194,7 @@ private:
             {
                 m_file.seekg(startingLocation,std::ios_base::beg);
                 try{
-                    m_file >> (*m_dataBuffer);
+                    ReadStreamFrame(m_file, *m_dataBuffer);
                     m_selectedFrame = entry;
                     return m_dataBuffer;
                 }   catch(...){}
@@ -192,11 +223,11 @@ private:
             const unsigned int min_length = 12;
             while (m_file.good() && ((m_fileEndLocation - m_file.tellg()) > min_length))
             {
-                int pos = m_file.tellg();
+                Position pos = m_file.tellg();
                 //qDebug("Indexing Frame %d at %d", temp.frameSequenceNumber, pos);
                 temp.position = m_file.tellg();
                 try{
-                    m_file >> (*m_dataBuffer);
+                    ReadStreamFrame(m_file, *m_dataBuffer);
                 }
                 catch(FileFormatException& e){
                     qDebug("Bad frame found: %s", e.getMessage().c_str());
@@ -63,6 +63,7 @@ HEADERS += ui_mainwindow.h \
     openglmanager.h \
     GLDisplay.h \
     ../Infrastructure/NUImage/NUImage.h \
+    ../Infrastructure/NUImage/NUImageView.h \
     ../Infrastructure/NUImage/ClassifiedImage.h \
     #../VisionOld/ClassifiedSection.h \
     #../VisionOld/ScanLine.h \
@@ -105,6 +106,7 @@ HEADERS += ui_mainwindow.h \
     ../Tools/Threading/Thread.h \
     ../Tools/Threading/ConditionalThread.h \
     ../Tools/Threading/PeriodicThread.h \
+    ../Tools/Threading/TaskPool.h \
     NUViewIO/NUViewIO.h \
     ../Kinematics/Kinematics.h \
     ../Tools/Math/TransformMatrices.h \
@@ -114,6 +116,8 @@ HEADERS += ui_mainwindow.h \
     ../Kinematics/EndEffector.h \
     ../NUPlatform/NUSensors.h \
     ../Infrastructure/NUSensorsData/NUSensorsData.h \
+    ../Infrastructure/NUSensorsData/SensorFrame.h \
+    ../Infrastructure/NUSensorsData/SensorSnapshots.h \
     ../Infrastructure/NUData.h \
     ../Infrastructure/NUBlackboard.h \
     ../NUPlatform/NUPlatform.h \
@@ -163,11 +167,14 @@ HEADERS += ui_mainwindow.h \
     #../VisionOld/fitellipsethroughcircle.h \
     ../Localisation/LocWmFrame.h \
     FileAccess/IndexedFileReader.h \
+    FileAccess/MappedFile.h \
+    FileAccess/SensorLogFileReader.h \
     LUTGlDisplay.h \
     ../NUPlatform/NUSensors/EndEffectorTouch.h \
     ../NUPlatform/NUSensors/OdometryEstimator.h \
     ../Tools/Math/StlVector.h \
     ../Tools/Profiling/Profiler.h \
+    ../Tools/Profiling/ProfileRecorder.h \
     MotionWidgets/WalkParameterWidget.h \
     MotionWidgets/KickWidget.h \
     MotionWidgets/MotionFileEditor.h \
@@ -180,15 +187,20 @@ HEADERS += ui_mainwindow.h \
     ObjectDisplayWidget.h \
     TeamInformationDisplayWidget.h \
     GameInformationDisplayWidget.h \
+    ProfileDisplayWidget.h \
     ../Infrastructure/TeamInformation/TeamInformation.h \
     ../Tools/FileFormats/LogRecorder.h \
+    ../Tools/FileFormats/LogWriterThread.h \
+    ../Tools/FileFormats/SensorLogFormat.h \
     ../Tools/FileFormats/FileFormatException.h \
     offlinelocalisationdialog.h \
     ../Tools/Math/Moment.h \
+    ../Tools/Math/FixedMatrix.h \
     ../Localisation/Models/SelfModel.h \
     ../Localisation/Models/SelfUKF.h \
     ../Localisation/SelfLocalisation.h \
     ../Localisation/Models/SelfSRUKF.h \
+    ../Localisation/Models/SelfSRUKFBank.h \
     ../Localisation/MeasurementError.h \
     ../Localisation/SelfLocalisationTests.h \
     OfflineLocalisationSettingsDialog.h \
@@ -298,6 +310,7 @@ SOURCES += mainwindow.cpp \
     ../Tools/Threading/Thread.cpp \
     ../Tools/Threading/ConditionalThread.cpp \
     ../Tools/Threading/PeriodicThread.cpp \
+    ../Tools/Threading/TaskPool.cpp \
     ../Kinematics/Kinematics.cpp \
     ../Tools/Math/TransformMatrices.cpp \
     frameInformationWidget.cpp \
@@ -319,11 +332,14 @@ SOURCES += mainwindow.cpp \
     #../VisionOld/fitellipsethroughcircle.cpp \
     ../Localisation/LocWmFrame.cpp \
     FileAccess/IndexedFileReader.cpp \
+    FileAccess/MappedFile.cpp \
+    FileAccess/SensorLogFileReader.cpp \
     LUTGlDisplay.cpp \
     ../NUPlatform/NUSensors/EndEffectorTouch.cpp \
     ../Tools/Math/FieldCalculations.cpp \
     ../NUPlatform/NUSensors/OdometryEstimator.cpp \
     ../Tools/Profiling/Profiler.cpp \
+    ../Tools/Profiling/ProfileRecorder.cpp \
     MotionWidgets/WalkParameterWidget.cpp \
     MotionWidgets/KickWidget.cpp \
     MotionWidgets/MotionFileEditor.cpp \
@@ -334,12 +350,16 @@ SOURCES += mainwindow.cpp \
     ObjectDisplayWidget.cpp \
     TeamInformationDisplayWidget.cpp \
     GameInformationDisplayWidget.cpp \
+    ProfileDisplayWidget.cpp \
     ../Tools/FileFormats/LogRecorder.cpp \
+    ../Tools/FileFormats/LogWriterThread.cpp \
+    ../Tools/FileFormats/SensorLogFormat.cpp \
     offlinelocalisationdialog.cpp \
     ../Tools/Math/Moment.cpp \
     ../Localisation/Models/SelfModel.cpp \
     ../Localisation/SelfLocalisation.cpp \
     ../Localisation/Models/SelfSRUKF.cpp \
+    ../Localisation/Models/SelfSRUKFBank.cpp \
     ../Localisation/MeasurementError.cpp \
     ../Localisation/SelfLocalisationtests.cpp \
     OfflineLocalisationSettingsDialog.cpp \
@@ -349,7 +369,6 @@ SOURCES += mainwindow.cpp \
     ../NUPlatform/NUCamera/NUCameraData.cpp \
     ../Tools/Math/statistics.cpp \
     OfflineLocBatch.cpp \
-    ../Tools/Math/Filters/UKF.cpp \
     ../Tools/Math/Filters/MobileObjectUKF.cpp \
     ../Localisation/Models/WeightedModel.cpp \
     ../Tools/Math/depUKF.cpp \
@@ -380,6 +399,11 @@ HEADERS += \
     ../Vision/VisionWrapper/datawrappernuview.h \
     ../Vision/VisionTools/pccamera.h \
     ../Vision/VisionTools/lookuptable.h \
+    ../Vision/VisionTools/compressedlut.h \
+    ../Vision/VisionTools/scanlineclassifier.h \
+    ../Vision/VisionTools/subsampledimage.h \
+    ../Vision/VisionTools/framearena.h \
+    ../Vision/VisionTools/imageclassifier.h \
     ../Vision/VisionTools/classificationcolours.h \
     ../Vision/VisionTools/transformer.h \
     ../Vision/Modules/*.h \
@@ -393,6 +417,11 @@ SOURCES += \
     ../Vision/VisionTypes/VisionFieldObjects/*.cpp \
     ../Vision/VisionTools/pccamera.cpp \
     ../Vision/VisionTools/lookuptable.cpp \
+    ../Vision/VisionTools/compressedlut.cpp \
+    ../Vision/VisionTools/scanlineclassifier.cpp \
+    ../Vision/VisionTools/subsampledimage.cpp \
+    ../Vision/VisionTools/framearena.cpp \
+    ../Vision/VisionTools/imageclassifier.cpp \
     ../Vision/VisionTools/classificationcolours.cpp \
     ../Vision/VisionTools/transformer.cpp \
     ../Vision/Modules/*.cpp \
@@ -0,0 +1,26 @@
+#include "ProfileDisplayWidget.h"
+#include "Tools/Profiling/ProfileRecorder.h"
+#include <sstream>
+#include <iomanip>
+
+ProfileDisplayWidget::ProfileDisplayWidget(QWidget *parent) :
+    QTextBrowser(parent)
+{
+    setLineWrapMode(QTextEdit::NoWrap);
+}
+
+/*! @brief Displays the percentiles of each module in a vision profile summary, in ms */
+void ProfileDisplayWidget::setProfileSummary(const ProfileSummary* newSummary)
+{
+    std::stringstream text;
+    text << std::fixed << std::setprecision(2);
+    text << std::setw(8) << "count" << std::setw(8) << "p50" << std::setw(8) << "p95" << std::setw(8) << "p99" << std::setw(8) << "max" << "  module" << std::endl;
+    for (size_t i = 0; i < newSummary->Modules.size(); i++)
+    {
+        const ProfileStatistics& statistics = newSummary->Modules[i];
+        text << std::setw(8) << statistics.Count << std::setw(8) << statistics.Median << std::setw(8) << statistics.P95;
+        text << std::setw(8) << statistics.P99 << std::setw(8) << statistics.Max << "  " << statistics.Name << std::endl;
+    }
+    text << newSummary->Dropped << " events dropped" << std::endl;
+    setPlainText(QString(text.str().c_str()));
+}
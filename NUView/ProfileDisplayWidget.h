@@ -0,0 +1,20 @@
+#ifndef PROFILEDISPLAYWIDGET_H
+#define PROFILEDISPLAYWIDGET_H
+
+#include <QWidget>
+#include <QTextBrowser>
+class ProfileSummary;
+
+class ProfileDisplayWidget : public QTextBrowser
+{
+Q_OBJECT
+public:
+    explicit ProfileDisplayWidget(QWidget *parent = 0);
+
+signals:
+
+public slots:
+    void setProfileSummary(const ProfileSummary* newSummary);
+};
+
+#endif // PROFILEDISPLAYWIDGET_H
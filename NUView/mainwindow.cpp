@@ -38,6 +38,8 @@
 #include "frameInformationWidget.h"
 
 #include "offlinelocalisationdialog.h"
+#include "Tools/FileFormats/SensorLogFormat.h"
+#include <fstream>
 
 #include "Kinematics/Kinematics.h"
 
@@ -102,6 +104,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent)
     teamInfoDisplay = new TeamInformationDisplayWidget(this);
     addAsDockable(teamInfoDisplay, "Team Information");
 
+    // Vision Profile Widget
+    profileDisplay = new ProfileDisplayWidget(this);
+    addAsDockable(profileDisplay, "Vision Profile");
+
     // Localisation info display
     locInfoDisplay = new QTextBrowser(this);
     addAsDockable(locInfoDisplay, "Localisation Information");
@@ -224,6 +230,11 @@ void MainWindow::createActions()
     LUT_Action->setStatusTip(tr("Open a LUT file"));
     connect(LUT_Action, SIGNAL(triggered()), this, SLOT(openLUT()));
 
+    // Convert Sensor Log Action
+    convertSensorLogAction = new QAction(tr("Con&vert Sensor Log..."), this);
+    convertSensorLogAction->setStatusTip(tr("Convert a text sensor log to a binary sensor log"));
+    connect(convertSensorLogAction, SIGNAL(triggered()), this, SLOT(convertSensorLog()));
+
     // Exit Action
     exitAction = new QAction(tr("E&xit"), this);
     exitAction->setShortcut(tr("Ctrl+Q"));
@@ -319,6 +330,7 @@ void MainWindow::createMenus()
     QMenu* fileMenu = menuBar()->addMenu(tr("&File"));
     fileMenu->addAction(openAction);
     fileMenu->addAction(LUT_Action);
+    fileMenu->addAction(convertSensorLogAction);
     fileMenu->addSeparator();
     fileMenu->addAction(exitAction);
 
@@ -438,6 +450,7 @@ void MainWindow::createConnections()
     connect(VisionStreamer,SIGNAL(rawImageChanged(const NUImage*)),virtualRobot, SLOT(processVisionFrame()));
     connect(VisionStreamer,SIGNAL(sensorsDataChanged(NUSensorsData*)),virtualRobot, SLOT(setSensorData(NUSensorsData*)));
     connect(VisionStreamer,SIGNAL(sensorsDataChanged(NUSensorsData*)),sensorDisplay, SLOT(SetSensorData(NUSensorsData*)));
+    connect(VisionStreamer,SIGNAL(profileSummaryChanged(const ProfileSummary*)),profileDisplay, SLOT(setProfileSummary(const ProfileSummary*)));
     // Setup navigation control enabling/disabling
     connect(LogReader,SIGNAL(firstFrameAvailable(bool)),firstFrameAction, SLOT(setEnabled(bool)));
     connect(LogReader,SIGNAL(nextFrameAvailable(bool)),nextFrameAction, SLOT(setEnabled(bool)));
@@ -449,6 +462,7 @@ void MainWindow::createConnections()
     connect(virtualRobot,SIGNAL(imageDisplayChanged(const NUImage*,GLDisplay::display)),&glManager, SLOT(writeNUImageToDisplay(const NUImage*,GLDisplay::display)));
     connect(virtualRobot,SIGNAL(lineDisplayChanged(Line*, GLDisplay::display)),&glManager, SLOT(writeLineToDisplay(Line*, GLDisplay::display)));
     connect(virtualRobot,SIGNAL(classifiedDisplayChanged(ClassifiedImage*, GLDisplay::display)),&glManager, SLOT(writeClassImageToDisplay(ClassifiedImage*, GLDisplay::display)));
+    connect(virtualRobot,SIGNAL(classifiedPixelsChanged(const unsigned int*, int, int, GLDisplay::display)),&glManager, SLOT(writeClassifiedPixelsToDisplay(const unsigned int*, int, int, GLDisplay::display)));
     connect(virtualRobot,SIGNAL(pointsDisplayChanged(std::vector<Point>, GLDisplay::display)),&glManager, SLOT(writePointsToDisplay(std::vector<Point>, GLDisplay::display)));
     connect(virtualRobot, SIGNAL(segmentsDisplayChanged(std::vector<std::vector<ColourSegment> >,GLDisplay::display)), &glManager, SLOT(writeSegmentsToDisplay(std::vector<std::vector<ColourSegment> >,GLDisplay::display)));
     //connect(virtualRobot,SIGNAL(transitionSegmentsDisplayChanged(std::vector< TransitionSegment >, GLDisplay::display)),&glManager, SLOT(writeTransitionSegmentsToDisplay(std::vector< TransitionSegment >, GLDisplay::display)));
@@ -536,6 +550,36 @@ void MainWindow::openLog()
     return;
 }
 
+void MainWindow::convertSensorLog()
+{
+    QString intial_directory = ".";
+    if(!m_previous_log_path.isEmpty())
+    {
+        intial_directory = m_previous_log_path;
+    }
+    QString sourceName = QFileDialog::getOpenFileName(this, tr("Open Text Sensor Log"), intial_directory, tr("Stream File(*.strm);;All Files(*.*)"));
+    if(sourceName.isEmpty()) return;
+    QString destinationName = QFileDialog::getSaveFileName(this, tr("Save Binary Sensor Log"), QFileInfo(sourceName).absolutePath(), tr("Stream File(*.strm);;All Files(*.*)"));
+    if(destinationName.isEmpty()) return;
+    if(QFileInfo(destinationName).absoluteFilePath() == QFileInfo(sourceName).absoluteFilePath())
+    {
+        QMessageBox::warning(this, tr("Convert Sensor Log"), tr("The binary log must be saved to a different file."));
+        return;
+    }
+
+    std::ifstream source(sourceName.toStdString().c_str(), std::ios_base::in | std::ios_base::binary);
+    if(SensorLog::isSensorLog(source))
+    {
+        QMessageBox::warning(this, tr("Convert Sensor Log"), tr("%1 is already a binary sensor log.").arg(sourceName));
+        return;
+    }
+    std::ofstream destination(destinationName.toStdString().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    unsigned int frames = SensorLogWriter::convert(source, destination);
+    QApplication::restoreOverrideCursor();
+    statusBar()->showMessage(tr("Converted %1 sensor frames to %2").arg(frames).arg(destinationName), 5000);
+}
+
 void MainWindow::openLog(const QString& fileName)
 {
     if (!fileName.isEmpty()){
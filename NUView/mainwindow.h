@@ -18,6 +18,7 @@
 #include "SensorDisplayWidget.h"
 #include "ObjectDisplayWidget.h"
 #include "GameInformationDisplayWidget.h"
+#include "ProfileDisplayWidget.h"
 #include "TeamInformationDisplayWidget.h"
 #include "plotselectionwidget.h"
 #include <QHostInfo>
@@ -72,6 +73,7 @@ public slots:
     void copy();                    //!< To copy the contents of the selected display to file.
     void saveViewImage();               //!< To save the contents of the selected display to the local executable directory.
     void openLUT();                 //!< To open a LUT file
+    void convertSensorLog();        //!< To convert a text sensor log to a binary sensor log
     void selectFrame();             //!< Takes you to a selected frame
 
     void shrinkToNativeAspectRatio();
@@ -170,6 +172,7 @@ private:
     ObjectDisplayWidget* objectDisplayLog;
     GameInformationDisplayWidget* gameInfoDisplay;
     TeamInformationDisplayWidget* teamInfoDisplay;
+    ProfileDisplayWidget* profileDisplay;
     QTextBrowser* locInfoDisplay;
     QTextBrowser* selflocInfoDisplay;
 
@@ -188,6 +191,7 @@ private:
     QAction *saveAction;            //!< Instance of the save action
     QAction *undoAction;            //!< Instance of the undo action
     QAction *LUT_Action;            //!< Instance of the open action
+    QAction *convertSensorLogAction;//!< Instance of the convert sensor log action
     QAction *exitAction;            //!< Instance of the exit action
     QAction *firstFrameAction;      //!< Instance of the first frame action; brings you back to first frame
     QAction *previousFrameAction;   //!< Instance of the previous frame action
@@ -21,12 +21,14 @@
 
 #include "ColorModelConversions.h"
 #include "Vision/VisionTools/classificationcolours.h"
+#include "Vision/VisionTools/imageclassifier.h"
 #include "openglmanager.h"
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/NUImage/ClassifiedImage.h"
 #include "Kinematics/Horizon.h"
 #include <QPainter>
 #include <QDebug>
+#include <cstring>
 
 // Apple has to be different...
 #if defined(__APPLE__) || defined(MACOSX)
@@ -35,12 +37,67 @@
   #include <GL/glu.h>
 #endif
 
+/*!
+  @brief Converts rows of raw pixels to RGBA texture pixels.
+
+  Gives exactly the colours of ColorModelConversions::fromYCbCrToRGB. R and B each depend on Y
+  and one chroma channel so they are looked up, G is calculated from tabulated chroma terms.
+  */
+class YCbCrToRGBA
+{
+public:
+    static void convert(const NUImage::Span& row, unsigned int* out)
+    {
+        static const YCbCrToRGBA tables;
+        const Pixel* pix = row.first;
+        for (int x = 0; x < row.length; x++, pix += row.step)
+        {
+            float g = pix->y - tables.cbTerm[pix->cb] - tables.crTerm[pix->cr];
+            if(g < 0) g = 0; else if(g > 255) g = 255;
+            // The bytes in memory order, as glTexImage2D reads them.
+            unsigned char rgba[4] = {tables.red[(pix->y << 8) | pix->cr],
+                                     (unsigned char) mathGeneral::roundNumberToInt(g),
+                                     tables.blue[(pix->y << 8) | pix->cb],
+                                     255};
+            memcpy(&out[x], rgba, sizeof(rgba));
+        }
+    }
+
+private:
+    YCbCrToRGBA()
+    {
+        unsigned char r, g, b;
+        for (int y = 0; y < 256; y++)
+        {
+            for (int c = 0; c < 256; c++)
+            {
+                ColorModelConversions::fromYCbCrToRGB(y, c, c, r, g, b);
+                red[(y << 8) | c] = r;
+                blue[(y << 8) | c] = b;
+            }
+        }
+        for (int c = 0; c < 256; c++)
+        {
+            cbTerm[c] = 0.3455 * (c - 128);
+            crTerm[c] = 0.7169 * (c - 128);
+        }
+    }
+
+    unsigned char red[256*256];     //!< R for each Y and Cr.
+    unsigned char blue[256*256];    //!< B for each Y and Cb.
+    double cbTerm[256];             //!< The Cb term of G.
+    double crTerm[256];             //!< The Cr term of G.
+};
+
 OpenglManager::OpenglManager(): width(320), height(240)
 {
     for(int id = 0; id < GLDisplay::numDisplays; id++)
     {
         textureStored[id] = false;
         displayStored[id] = false;
+        textureWidths[id] = textureHeights[id] = 0;
+        textureTopRowFirst[id] = false;
+        textureListCurrent[id] = false;
     }
 }
 
@@ -54,68 +111,134 @@ OpenglManager::~OpenglManager()
 }
 
 void OpenglManager::createDrawTextureImage(const QImage& image, int displayId)
+{
+    QImage tex = QGLWidget::convertToGLFormat( image );
+    createDrawTexture(tex.bits(), tex.width(), tex.height(), false, displayId);
+}
+
+void OpenglManager::createDrawTexture(const void* rgba, int textureWidth, int textureHeight, bool topRowFirst, int displayId)
 {
     makeCurrent();
-    // If there is a texture already stored, delete it.
-    if(textureStored[displayId])
+    // Each display keeps its texture, a new frame of the same size is copied into it.
+    bool newSize = !textureStored[displayId] || (textureWidths[displayId] != textureWidth) || (textureHeights[displayId] != textureHeight);
+    if(!textureStored[displayId])
     {
-        glDeleteTextures(1,&textures[displayId]);
-        textureStored[displayId] = false;
+        glGenTextures( 1, &textures[displayId] );
+        textureStored[displayId] = true;
     }
 
-    QImage tex = QGLWidget::convertToGLFormat( image );
-    glGenTextures( 1, &textures[displayId] );
-
-    // Create Nearest Filtered Texture
     glBindTexture(GL_TEXTURE_2D, textures[displayId]);
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
-    glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
-    glTexImage2D(GL_TEXTURE_2D, 0, 4, tex.width(), tex.height(), 0, GL_RGBA, GL_UNSIGNED_BYTE, tex.bits());
-
-    textureStored[displayId] = true;
-
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
+    if(newSize)
     {
-        glDeleteLists(displays[displayId],1);
-        displayStored[displayId] = false;
+        // Create Nearest Filtered Texture
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);
+        glTexImage2D(GL_TEXTURE_2D, 0, 4, textureWidth, textureHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+        textureWidths[displayId] = textureWidth;
+        textureHeights[displayId] = textureHeight;
     }
+    else
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, textureWidth, textureHeight, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+    }
+
+    // The list only has to be rebuilt when the quad changes.
+    if(textureListCurrent[displayId] && !newSize && (textureTopRowFirst[displayId] == topRowFirst))
+        return;
 
-    displays[displayId] = glGenLists(1);
+    // Textures read from the top row first are drawn with the t coordinate reversed.
+    float bottom = topRowFirst ? 1.0f : 0.0f;
+    float top = 1.0f - bottom;
 
-    glNewList(displays[displayId],GL_COMPILE);
+    beginDisplayList(displayId);
         glBindTexture(GL_TEXTURE_2D, textures[displayId]);
         glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MAG_FILTER,GL_NEAREST);    // Turn off filtering of textures
         glTexParameteri(GL_TEXTURE_2D,GL_TEXTURE_MIN_FILTER,GL_NEAREST);    // Turn off filtering of textures
         glBegin(GL_QUADS);
-            glTexCoord2f(0.0f, 0.0f); glVertex3f(0.0f, (float)height,  1.0f);      // Bottom Left Of The Texture and Quad
-            glTexCoord2f(1.0f, 0.0f); glVertex3f( (float)width, (float)height,  1.0f);    // Bottom Right Of The Texture and Quad
-            glTexCoord2f(1.0f, 1.0f); glVertex3f( (float)width,  0.0f,  1.0f);     // Top Right Of The Texture and Quad
-            glTexCoord2f(0.0f, 1.0f); glVertex3f(0.0f,  0.0f,  1.0f);       // Top Left Of The Texture and Quad
+            glTexCoord2f(0.0f, bottom); glVertex3f(0.0f, (float)textureHeight,  1.0f);      // Bottom Left Of The Texture and Quad
+            glTexCoord2f(1.0f, bottom); glVertex3f( (float)textureWidth, (float)textureHeight,  1.0f);    // Bottom Right Of The Texture and Quad
+            glTexCoord2f(1.0f, top); glVertex3f( (float)textureWidth,  0.0f,  1.0f);     // Top Right Of The Texture and Quad
+            glTexCoord2f(0.0f, top); glVertex3f(0.0f,  0.0f,  1.0f);       // Top Left Of The Texture and Quad
         glEnd();
-    glEndList();
+    endDisplayList(displayId);
+    textureTopRowFirst[displayId] = topRowFirst;
+    textureListCurrent[displayId] = true;
+}
+
+void OpenglManager::beginDisplayList(int displayId)
+{
+    makeCurrent();
+    // The list is compiled over the old one, so a display's id never changes once it has one.
+    if(!displayStored[displayId])
+    {
+        displays[displayId] = glGenLists(1);
+    }
+    textureListCurrent[displayId] = false;
+    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+}
+
+void OpenglManager::endDisplayList(int displayId)
+{
+    glEndList();                                    // END OF LIST
     displayStored[displayId] = true;
 }
 
+void OpenglManager::drawOverlayArrays(GLenum mode)
+{
+    if(!overlayVertices.empty())
+    {
+        // The arrays are copied into the list being compiled, so they can be reused straight away.
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(2, GL_FLOAT, 0, &overlayVertices[0]);
+        if(!overlayColours.empty())
+        {
+            glEnableClientState(GL_COLOR_ARRAY);
+            glColorPointer(3, GL_UNSIGNED_BYTE, 0, &overlayColours[0]);
+        }
+        glDrawArrays(mode, 0, overlayVertices.size()/2);
+        if(!overlayColours.empty())
+        {
+            glDisableClientState(GL_COLOR_ARRAY);
+        }
+        glDisableClientState(GL_VERTEX_ARRAY);
+    }
+    overlayVertices.clear();
+    overlayColours.clear();
+}
+
+void OpenglManager::addHollowCircle(float cx, float cy, float r, int num_segments)
+{
+    // The same vertices as drawHollowCircle, with each edge of the loop as a separate line.
+    int stepSize = 360 / num_segments;
+    float firstX = cx + sinf(0) * r;
+    float firstY = cy + cosf(0) * r;
+    overlayVertices.push_back(firstX);
+    overlayVertices.push_back(firstY);
+    for(int angle = stepSize; angle < 360; angle += stepSize)
+    {
+        float x = cx + sinf(angle) * r;
+        float y = cy + cosf(angle) * r;
+        overlayVertices.push_back(x);
+        overlayVertices.push_back(y);
+        overlayVertices.push_back(x);
+        overlayVertices.push_back(y);
+    }
+    overlayVertices.push_back(firstX);
+    overlayVertices.push_back(firstY);
+}
+
 void OpenglManager::writeNUImageToDisplay(const NUImage* newImage, GLDisplay::display displayId)
 {
     width = newImage->getWidth();
     height = newImage->getHeight();
 
-    QImage image(width,height,QImage::Format_ARGB32);
-    unsigned char r, g, b;
-    QRgb* imageLine;
+    // Converted straight from the image buffer into the texture's pixels, top row first.
+    rawPixels.resize(width*height);
     for (int y = 0; y < height; y++)
     {
-        imageLine = (QRgb*)image.scanLine(y);
-        for (int x = 0; x < width; x++)
-        {
-            const Pixel& pix = (*newImage)(x,y);
-            ColorModelConversions::fromYCbCrToRGB(pix.y, pix.cb, pix.cr, r, g, b);
-            imageLine[x] = qRgb(r,g,b);
-        }
+        YCbCrToRGBA::convert(newImage->getRowSpan(y), &rawPixels[y*width]);
     }
-    createDrawTextureImage(image, displayId);
+    createDrawTexture(&rawPixels[0], width, height, true, displayId);
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
 }
@@ -124,38 +247,28 @@ void OpenglManager::writeClassImageToDisplay(ClassifiedImage* newImage, GLDispla
 {
     width = newImage->width();
     height = newImage->height();
-    QImage image(width,height,QImage::Format_ARGB32);
-    unsigned char r, g, b, alpha;
-    QRgb* imageLine;
-    int tempIndex;
+    classifiedPixels.resize(width*height);
     for (int y=0; y < height; y++)
     {
-        imageLine = (QRgb*)image.scanLine(y);
-        for (int x=0; x < width; x++)
-        {
-            alpha = 255;
-            tempIndex = newImage->image[y][x];
-            if(tempIndex == Vision::unclassified) alpha = 0;
-            Vision::getColourAsRGB(Vision::getColourFromIndex(tempIndex), r, g, b);
-            imageLine[x] = qRgba(r,g,b,alpha);
-        }
+        ImageClassifier::coloursToPixels(newImage->image[y], width, &classifiedPixels[y*width], ImageClassifier::RGBA);
     }
-    createDrawTextureImage(image, displayId);
+    createDrawTexture(&classifiedPixels[0], width, height, true, displayId);
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
 }
 
-void OpenglManager::writeLineToDisplay(Line* newLine, GLDisplay::display displayId)
+void OpenglManager::writeClassifiedPixelsToDisplay(const unsigned int* pixels, int newWidth, int newHeight, GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
+    width = newWidth;
+    height = newHeight;
+    createDrawTexture(pixels, width, height, true, displayId);
+    emit updatedDisplay(displayId, displays[displayId], width, height);
+    return;
+}
 
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+void OpenglManager::writeLineToDisplay(Line* newLine, GLDisplay::display displayId)
+{
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
 
     glLineWidth(2.0);       // Line width
@@ -164,9 +277,7 @@ void OpenglManager::writeLineToDisplay(Line* newLine, GLDisplay::display display
     glVertex2i( (int)width, (int)newLine->findYFromX(width));    // End point
     glEnd();                                        // End Lines
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
 
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
@@ -174,24 +285,15 @@ void OpenglManager::writeLineToDisplay(Line* newLine, GLDisplay::display display
 
 void OpenglManager::writePointsToDisplay(std::vector<Point> newpoints, GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
     for (int pointNum = 0; pointNum < (int)newpoints.size(); pointNum++)
     {
-        drawHollowCircle(newpoints[pointNum].x+0.5, newpoints[pointNum].y+0.5, 0.5, 50);
+        addHollowCircle(newpoints[pointNum].x+0.5, newpoints[pointNum].y+0.5, 0.5, 50);
     }
+    drawOverlayArrays(GL_LINES);
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
 
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
@@ -199,15 +301,7 @@ void OpenglManager::writePointsToDisplay(std::vector<Point> newpoints, GLDisplay
 
 void OpenglManager::writeSegmentsToDisplay(vector<vector<ColourSegment> > updatedSegments, GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
 
     glLineWidth(1.0);       // Line width
@@ -215,24 +309,27 @@ void OpenglManager::writeSegmentsToDisplay(vector<vector<ColourSegment> > update
     {
         vector<ColourSegment>& line = updatedSegments[i];
         for(unsigned int k = 0 ; k < line.size(); k++) {
-            ColourSegment& segment = line[i];
+            ColourSegment& segment = line[k];
             const Point& s = segment.getStart();
             const Point& e = segment.getEnd();
             unsigned char r, g, b;
 
-
             Vision::getColourAsRGB(segment.getColour(), r, g, b);
-            glColor3ub(r,g,b);
-            glBegin(GL_LINES);                              // Start Lines
-            glVertex2i( int(s.x), int(s.y) );                 // Starting point
-            glVertex2i( int(e.x), int(e.y) );               // Ending point
-            glEnd();  // End Lines
+            overlayVertices.push_back(int(s.x));                 // Starting point
+            overlayVertices.push_back(int(s.y));
+            overlayVertices.push_back(int(e.x));                 // Ending point
+            overlayVertices.push_back(int(e.y));
+            for(int v = 0; v < 2; v++)
+            {
+                overlayColours.push_back(r);
+                overlayColours.push_back(g);
+                overlayColours.push_back(b);
+            }
         }
     }
+    drawOverlayArrays(GL_LINES);
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
 
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
@@ -314,16 +411,7 @@ void OpenglManager::writeSegmentsToDisplay(vector<vector<ColourSegment> > update
 
 void OpenglManager::writeWMLineToDisplay(WMLine* newWMLine, int numLines,GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
 
     glLineWidth(1.0);       // Line width
@@ -335,32 +423,19 @@ void OpenglManager::writeWMLineToDisplay(WMLine* newWMLine, int numLines,GLDispl
     }
     glEnd();                                        // End Lines
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
 }
 void OpenglManager::writeWMBallToDisplay(float x, float y, float radius, GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
 
     drawHollowCircle(x, y, radius, 50);
 
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
 
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
@@ -368,15 +443,7 @@ void OpenglManager::writeWMBallToDisplay(float x, float y, float radius, GLDispl
 
 void OpenglManager::writeCalGridToDisplay(GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
 
 
@@ -393,22 +460,16 @@ void OpenglManager::writeCalGridToDisplay(GLDisplay::display displayId)
     drawHollowCircle(240, 180, 10, 50);
 
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
 }
 
 void OpenglManager::clearDisplay(GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-    displays[displayId] = glGenLists(1);
+    // An empty list, the display keeps its id.
+    beginDisplayList(displayId);
+    endDisplayList(displayId);
 
     emit updatedDisplay(displayId, displays[displayId], width, height);
     return;
@@ -475,20 +536,23 @@ void OpenglManager::writeLinesPointsToDisplay(vector<Point> linepoints, GLDispla
 
 void OpenglManager::writeLinesToDisplay(std::vector< LSFittedLine > lines, GLDisplay::display displayId)
 {
-    makeCurrent();
-    // If there is an old list stored, delete it first.
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
 
-    glLineWidth(2.0);       // Line width
-    
+    glLineWidth(3.0);       // Line width
+
+    switch(displayId) {
+    case GLDisplay::GoalEdgeLinesStart:
+        glColor3ub(0,255,255);  //cyan
+        break;
+    case GLDisplay::GoalEdgeLinesEnd:
+        glColor3ub(255,0,255);    //magenta
+        break;
+    default:
+        glColor3ub(255,0,0);    //red
+    }
 
+    // The end points of every line are drawn in one batch, then the points they were fitted to in another.
     for(unsigned int i = 0 ; i < lines.size(); i++)
     {
         const LSFittedLine& line = lines[i];
@@ -496,56 +560,37 @@ void OpenglManager::writeLinesToDisplay(std::vector< LSFittedLine > lines, GLDis
         {
             Vector2<double> ep1, ep2;
             line.getEndPoints(ep1, ep2);
+            overlayVertices.push_back(int(ep1.x));                 // Starting point
+            overlayVertices.push_back(int(ep1.y));
+            overlayVertices.push_back(int(ep2.x));                 // Ending point
+            overlayVertices.push_back(int(ep2.y));
+        }
+        //HOW CAN WE RENDER AN INVALID LINE?
+    }
+    drawOverlayArrays(GL_LINES);
 
-            glLineWidth(3.0);       // Line width
-
-            switch(displayId) {
-            case GLDisplay::GoalEdgeLinesStart:
-                glColor3ub(0,255,255);  //cyan
-                break;
-            case GLDisplay::GoalEdgeLinesEnd:
-                glColor3ub(255,0,255);    //magenta
-                break;
-            default:
-                glColor3ub(255,0,0);    //red
-            }
-
-
-
-            glBegin(GL_LINES);                              // Start Lines
-            glVertex2i( int(ep1.x), int(ep1.y) );                 // Starting point
-            glVertex2i( int(ep2.x), int(ep2.y) );               // Ending point
-            glEnd();  // End Lines
-
+    for(unsigned int i = 0 ; i < lines.size(); i++)
+    {
+        const LSFittedLine& line = lines[i];
+        if(line.valid == true)
+        {
             const std::vector< Vector2<double> >& linePoints = line.getPoints();
-            glBegin(GL_TRIANGLES);
             for (unsigned int j =0; j < linePoints.size(); j++)
             {
-                glVertex3f(int(linePoints[j].x),int(linePoints[j].y),0.0);
-                glVertex3f(int(linePoints[j].x),int(linePoints[j].y-1),0.0);
-                glVertex3f(int(linePoints[j].x),int(linePoints[j].y+1),0.0);
+                overlayVertices.push_back(int(linePoints[j].x));
+                overlayVertices.push_back(int(linePoints[j].y));
+                overlayVertices.push_back(int(linePoints[j].x));
+                overlayVertices.push_back(int(linePoints[j].y-1));
+                overlayVertices.push_back(int(linePoints[j].x));
+                overlayVertices.push_back(int(linePoints[j].y+1));
             }
-            glEnd();
         }
-        //HOW CAN WE RENDER AN INVALID LINE?
-//        else
-//        {
-//            glLineWidth(2.0);       // Line width
-//            glColor3ub(100,0,50);
-//            glBegin(GL_LINES);                              // Start Lines
-//            glVertex2i( int(ep1.x), int(ep1.y) );                 // Starting point
-//            glVertex2i( int(ep2.x), int(ep2.y) );               // Ending point
-//            glEnd();  // End Lines
-//        }
     }
-        //glEnable(GL_TEXTURE_2D);
-        //glEndList();                                    // END OF LIST
-
-        displayStored[displayId] = true;
-
-        //qDebug() << "Updating FieldLines:" << fieldLines.size();
-   // emit updatedDisplay(displayId, displays[displayId], width, height);
+    drawOverlayArrays(GL_TRIANGLES);
+    glEnable(GL_TEXTURE_2D);
+    endDisplayList(displayId);
 
+    emit updatedDisplay(displayId, displays[displayId], width, height);
 }
 //void OpenglManager::writeCornersToDisplay(std::vector< CornerPoint > corners, GLDisplay::display displayId)
 //{
@@ -589,15 +634,8 @@ void OpenglManager::stub(QImage image, GLDisplay::display displayId)
 
 void OpenglManager::writeFieldObjectsToDisplay(FieldObjects* AllObjects, GLDisplay::display displayId)
 {
-    makeCurrent();
     //! CLEAR DRAWING LIST
-    if(displayStored[displayId])
-    {
-        glDeleteLists(displays[displayId],1);
-    }
-
-    displays[displayId] = glGenLists(1);
-    glNewList(displays[displayId],GL_COMPILE);    // START OF LIST
+    beginDisplayList(displayId);
     glDisable(GL_TEXTURE_2D);
     glLineWidth(2.0);       // Line width
 
@@ -779,9 +817,7 @@ void OpenglManager::writeFieldObjectsToDisplay(FieldObjects* AllObjects, GLDispl
 
     //! UPDATE THE DISPLAY:
     glEnable(GL_TEXTURE_2D);
-    glEndList();                                    // END OF LIST
-
-    displayStored[displayId] = true;
+    endDisplayList(displayId);
 
     emit updatedDisplay(displayId, displays[displayId], width, height);
 }
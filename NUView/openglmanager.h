@@ -92,6 +92,14 @@ public:
           @param displayId The id of the display layer to write to.
           */
         void writeClassImageToDisplay(ClassifiedImage* newImage, GLDisplay::display displayId);
+        /*!
+          @brief Accepts a new classified image already converted to pixels and maps it to display instructions.
+          @param pixels The classified image as RGBA pixels, top row first.
+          @param newWidth The width of the image.
+          @param newHeight The height of the image.
+          @param displayId The id of the display layer to write to.
+          */
+        void writeClassifiedPixelsToDisplay(const unsigned int* pixels, int newWidth, int newHeight, GLDisplay::display displayId);
         /*!
           @brief Accepts a new line object and maps it to display instructions.
           @param newHorizon The new horizon line.
@@ -232,12 +240,52 @@ public:
         GLuint textures[GLDisplay::numDisplays];    //!< Storage for textures.
         bool displayStored[GLDisplay::numDisplays]; //!< Tracking of drawing instruction storage.
         bool textureStored[GLDisplay::numDisplays]; //!< Tracking of texture storage.
+        int textureWidths[GLDisplay::numDisplays];  //!< Width each texture was allocated with.
+        int textureHeights[GLDisplay::numDisplays]; //!< Height each texture was allocated with.
+        bool textureTopRowFirst[GLDisplay::numDisplays];    //!< Orientation each texture's quad was drawn with.
+        bool textureListCurrent[GLDisplay::numDisplays];    //!< True while a display's list draws its texture, so a new frame only needs the texture updated.
+        std::vector<unsigned int> rawPixels;        //!< Conversion buffer for raw images.
+        std::vector<unsigned int> classifiedPixels; //!< Conversion buffer for classified images.
+        std::vector<GLfloat> overlayVertices;       //!< Vertex array overlays are batched into.
+        std::vector<GLubyte> overlayColours;        //!< Colour array overlays are batched into, empty when an overlay has a single colour.
         /*!
           @brief Maps an image to a texture and loads it to the graphics card for display.
           @param image The image to be mapped.
           @param displayId The id of the display layer to which to draw the texture.
           */
         void createDrawTextureImage(const QImage& image, int displayId);
+        /*!
+          @brief Loads RGBA pixels to the graphics card as a texture for display.
+          @param rgba The pixels, 4 bytes each.
+          @param textureWidth The width of the texture.
+          @param textureHeight The height of the texture.
+          @param topRowFirst True if the pixels start at the top row of the image, false if they start at the bottom as OpenGL expects.
+          @param displayId The id of the display layer to which to draw the texture.
+          */
+        void createDrawTexture(const void* rgba, int textureWidth, int textureHeight, bool topRowFirst, int displayId);
+        /*!
+          @brief Starts recompiling the drawing instructions of a display, the display keeps its list id.
+          @param displayId The id of the display layer.
+          */
+        void beginDisplayList(int displayId);
+        /*!
+          @brief Finishes the drawing instructions started by beginDisplayList().
+          @param displayId The id of the display layer.
+          */
+        void endDisplayList(int displayId);
+        /*!
+          @brief Draws the batched overlay vertices, and their colours if there are any, in one call and clears them.
+          @param mode The primitive to draw the vertices as.
+          */
+        void drawOverlayArrays(GLenum mode);
+        /*!
+          @brief Adds the circumference of a circle to the batched overlay vertices as GL_LINES.
+          @param cx The x coordinate of the circles centre.
+          @param cy The y coordinate of the circles centre.
+          @param r The radius of the circle.
+          @param num_segments The Number of segments to use when constructing the circle.
+          */
+        void addHollowCircle(float cx, float cy, float r, int num_segments);
         /*!
           @brief Draw the circumference of a circle.
           @param cx The x coordinate of the circles centre.
@@ -145,8 +145,16 @@ void virtualNUbot::ProcessPacket(QByteArray* packet)
 
 void virtualNUbot::generateClassifiedImage()
 {
-    vision->classifyImage(classImage);
-    emit classifiedDisplayChanged(&classImage, GLDisplay::classifiedImage);
+    const NUImage* frame = vision->wrapper->getFrame();
+    if(frame == 0)
+        return;
+
+    //classified straight into display pixels, skipping the ClassifiedImage and QImage conversions
+    int width = frame->getWidth();
+    int height = frame->getHeight();
+    classifiedPixels.resize(width*height);
+    vision->classifyImageRGBA(&classifiedPixels[0]);
+    emit classifiedPixelsChanged(&classifiedPixels[0], width, height, GLDisplay::classifiedImage);
     return;
 }
 
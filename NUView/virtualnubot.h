@@ -80,6 +80,7 @@ public slots:
 signals:
     void imageDisplayChanged(const NUImage* updatedImage, GLDisplay::display displayId);
     void classifiedDisplayChanged(ClassifiedImage* updatedImage, GLDisplay::display displayId);
+    void classifiedPixelsChanged(const unsigned int* pixels, int width, int height, GLDisplay::display displayId);
     void lineDisplayChanged(Line* line, GLDisplay::display displayId);
     //void cornerPointsDisplayChanged(std::vector< CornerPoint> corners, GLDisplay::display displayId );
     void pointsDisplayChanged(std::vector<Point> updatedPoints, GLDisplay::display displayId);
@@ -119,6 +120,7 @@ private:
     const NUImage* rawImage;
 
     ClassifiedImage classImage, previewClassImage;
+    std::vector<unsigned int> classifiedPixels;     //!< The classified frame as RGBA pixels for display
     VisionControlWrapper* vision;
     FieldObjects* AllObjects;
     int cameraNumber;
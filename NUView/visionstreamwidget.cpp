@@ -87,12 +87,14 @@ visionStreamWidget::visionStreamWidget(QWidget *parent): QWidget(parent)
 
     image = new NUImage();
     sensors = new NUSensorsData();
+    profile = new ProfileSummary();
 }
 
 visionStreamWidget::~visionStreamWidget()
 {
     delete image;
     delete sensors;
+    delete profile;
 }
 
 //SLOTS:
@@ -179,7 +181,7 @@ void visionStreamWidget::updateRobotName(const QString name)
 
 void visionStreamWidget::readPendingData()
 {
-    int height,width, sizeOfSensors;
+    int height,width, sizeOfSensors, sizeOfProfile;
     if(netdata.isEmpty())
     {
         timeToRecievePacket = QTime();
@@ -218,7 +220,7 @@ void visionStreamWidget::readPendingData()
         buffer.read(reinterpret_cast<char*>(&height), sizeof(height));
 
 //        qDebug() << height << ", " << width;
-        imageSize = height*width*4+buffer.tellg()+sizeof(double)+sizeof(bool);
+        imageSize = height*width*4+buffer.tellg()+sizeof(double)+sizeof(bool);     // includes the size at the start of the packet
         sensorsSize = sizeOfSensors;
         datasize = imageSize + sensorsSize; // height*width*4+buffer.tellg()+sizeof(double)+ sizeof(NUSensorsData);
     }
@@ -234,17 +236,33 @@ void visionStreamWidget::readPendingData()
         netdata.append(tcpSocket->readAll());
     //}
 
+        // the profile summary follows the sensor data, preceded by its size. Robots that do not send it stop after the sensor data
+        bool complete = datasize == netdata.size();
+        bool hasProfile = false;
+        if(netdata.size() >= datasize + (int)sizeof(sizeOfProfile))
+        {
+            memcpy(&sizeOfProfile, netdata.data() + datasize, sizeof(sizeOfProfile));
+            hasProfile = complete = netdata.size() >= datasize + (int)sizeof(sizeOfProfile) + sizeOfProfile;
+        }
+
         //emit PacketReady(&datagram);
-        if(datasize == netdata.size())
+        if(complete)
         {
             std::stringstream buffer;
-            buffer.write(reinterpret_cast<char*>(netdata.data()+ sizeof(sizeOfSensors)), imageSize);
+            buffer.write(reinterpret_cast<char*>(netdata.data()+ sizeof(sizeOfSensors)), imageSize - sizeof(sizeOfSensors));
             buffer >> (*image);
             emit rawImageChanged(image);
-            buffer.write(reinterpret_cast<char*>(netdata.data()+ sizeof(sizeOfSensors) + imageSize), sensorsSize);
+            buffer.write(reinterpret_cast<char*>(netdata.data()+ imageSize), sensorsSize);
             buffer >> (*sensors);
             qDebug() << "Size of Data:" << sensorsSize;
             emit sensorsDataChanged(sensors);
+            if(hasProfile)
+            {
+                buffer.clear();     // reading the sensors runs into the end of the buffer
+                buffer.write(reinterpret_cast<char*>(netdata.data()+ datasize + sizeof(sizeOfProfile)), sizeOfProfile);
+                buffer >> (*profile);
+                emit profileSummaryChanged(profile);
+            }
 
             int mstime = timeToRecievePacket.elapsed();
             time.setInterval(0);
@@ -9,6 +9,7 @@
 #include <iostream>
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/Profiling/ProfileRecorder.h"
 #include <QTimer>
 #include <QTime>
 class QLabel;
@@ -64,6 +65,7 @@ signals:
     void rawImageChanged(const NUImage*);
     void sensorsDataChanged(NUSensorsData*);
     void sensorsDataChanged(const float* joint, const float* balance, const float* touch);
+    void profileSummaryChanged(const ProfileSummary*);
 
 private:
     QString robotName;
@@ -94,6 +96,7 @@ private:
     QTimer time;
     NUImage* image;
     NUSensorsData* sensors;
+    ProfileSummary* profile;
     QTime timeToRecievePacket;
 
 };
@@ -27,6 +27,7 @@
 #include "NUPlatform/NUAPI.h"
 #include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUSensorsData/SensorSnapshots.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
 #include "NUPlatform/NUActionators/NUSounds.h"
 #include "Infrastructure/FieldObjects/FieldObjects.h"
@@ -219,6 +220,7 @@ void NUbot::createBlackboard()
     
     m_blackboard = new NUBlackboard();
     m_blackboard->add(m_platform->getNUSensorsData());
+    m_blackboard->add(new SensorSnapshots());
     m_blackboard->add(m_platform->getNUActionatorsData());
     m_blackboard->add(new FieldObjects());
     m_blackboard->add(new JobList());
@@ -24,6 +24,7 @@
 #include "NUPlatform/NUPlatform.h"
 #include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUSensorsData/SensorSnapshots.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
 #include "NUPlatform/NUActionators/NUSounds.h"
 #include "NUPlatform/NUIO.h"
@@ -79,6 +80,12 @@ SeeThinkThread::SeeThinkThread(NUbot* nubot) : ConditionalThread(string("SeeThin
     #endif
     m_nubot = nubot;
     m_logrecorder = new LogRecorder(m_nubot->m_blackboard->GameInfo->getPlayerNumber());
+    m_image_snapshots.setSnapshots(m_nubot->m_blackboard->SensorHistory);
+    m_latest_snapshots.setSnapshots(m_nubot->m_blackboard->SensorHistory);
+    m_image_sensors = new NUSensorsData();
+    m_latest_sensors = new NUSensorsData();
+    m_localisation_sensors = m_nubot->m_blackboard->Sensors;
+    m_behaviour_sensors = m_nubot->m_blackboard->Sensors;
 #ifdef LOGGING_ENABLED
     m_logrecorder->SetLogging("sensor",true);
     m_logrecorder->SetLogging("gameinfo",true);
@@ -93,6 +100,26 @@ SeeThinkThread::~SeeThinkThread()
         debug << "SeeThinkThread::~SeeThinkThread()" << endl;
     #endif
     stop();
+    delete m_logrecorder;           // writes out the frames still queued
+    delete m_image_sensors;
+    delete m_latest_sensors;
+}
+
+/*! @brief Takes coherent copies of the sensors published by the SenseMoveThread for this frame.
+
+    Localisation gets the sensors published closest to the time the image was taken, so the odometry
+    and the joint angles match the objects vision found in it. Behaviour gets the latest sensors.
+    Until the SenseMoveThread has published anything both use the live Blackboard->Sensors.
+ */
+void SeeThinkThread::updateSensors()
+{
+    #ifdef USE_VISION
+        bool image_ok = m_image_snapshots.closest(Blackboard->Image->GetTimestamp(), *m_image_sensors);
+    #else
+        bool image_ok = m_image_snapshots.latest(*m_image_sensors);
+    #endif
+    m_localisation_sensors = image_ok ? m_image_sensors : Blackboard->Sensors;
+    m_behaviour_sensors = m_latest_snapshots.latest(*m_latest_sensors) ? m_latest_sensors : Blackboard->Sensors;
 }
 
 /*! @brief The sense->move main loop
@@ -142,6 +169,7 @@ void SeeThinkThread::run()
                 prof.start();
             #endif
             #ifdef USE_VISION
+                // when THREAD_SEETHINK_PIPELINED is defined the camera has already dequeued this frame while the last was processed
                 m_nubot->m_platform->updateImage();
                 *(m_nubot->m_io) << m_nubot;  //<! Raw IMAGE STREAMING (TCP)
             #endif
@@ -157,7 +185,8 @@ void SeeThinkThread::run()
                 #endif
             #endif
 
-            double current_time = Blackboard->Sensors->GetTimestamp();
+            updateSensors();
+            double current_time = m_behaviour_sensors->GetTimestamp();
             Blackboard->TeamInfo->UpdateTime(current_time);
             Blackboard->GameInfo->UpdateTime(current_time);
             m_logrecorder->WriteData(Blackboard);
@@ -167,18 +196,23 @@ void SeeThinkThread::run()
             #endif
 
             #ifdef USE_LOCALISATION
-                m_nubot->m_localisation->process(Blackboard->Sensors, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
+                m_nubot->m_localisation->process(m_localisation_sensors, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
                 #ifdef THREAD_SEETHINK_PROFILE
                     prof.split("localisation");
                 #endif
             #endif
             
             #if defined(USE_BEHAVIOUR)
-                m_nubot->m_behaviour->process(Blackboard->Jobs, Blackboard->Sensors, Blackboard->Actions, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
+                m_nubot->m_behaviour->process(Blackboard->Jobs, m_behaviour_sensors, Blackboard->Actions, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
                 #ifdef THREAD_SEETHINK_PROFILE
                     prof.split("behaviour");
                 #endif
             #endif
+
+            #if defined(USE_VISION) && defined(THREAD_SEETHINK_PROFILE)
+                // the end-to-end latency, from the image being captured to a decision being made on it
+                double image_latency = m_nubot->m_platform->getTime() - Blackboard->Image->GetTimestamp();
+            #endif
             
             #if DEBUG_VERBOSITY > 0
                 Blackboard->Jobs->summaryTo(debug);
@@ -213,6 +247,9 @@ void SeeThinkThread::run()
 
             #ifdef THREAD_SEETHINK_PROFILE
                 debug << prof;
+                #ifdef USE_VISION
+                    debug << "SeeThinkThread image to decision latency: " << image_latency << "ms" << endl;
+                #endif
             #endif
         }
         catch (std::exception& e)
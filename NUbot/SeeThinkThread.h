@@ -27,11 +27,13 @@
 
 #include "Tools/Threading/ConditionalThread.h"
 #include "Tools/FileFormats/LogRecorder.h"
+#include "Infrastructure/NUSensorsData/SensorSnapshots.h"
 #include <vector>
 #include <fstream>
 
 
 class NUbot;
+class NUSensorsData;
 
 /*! @brief The top-level class
  */
@@ -43,8 +45,16 @@ public:
 protected:
     void run();  
 private:
+    void updateSensors();
+
     NUbot* m_nubot;
     LogRecorder* m_logrecorder;
+    SensorSnapshotReader m_image_snapshots;     //!< reads m_image_sensors from the sensors published by the SenseMoveThread
+    SensorSnapshotReader m_latest_snapshots;    //!< reads m_latest_sensors from the sensors published by the SenseMoveThread
+    NUSensorsData* m_image_sensors;             //!< a copy of the sensors from when the image was taken, used by localisation
+    NUSensorsData* m_latest_sensors;            //!< a copy of the latest sensors, used by behaviour
+    NUSensorsData* m_localisation_sensors;      //!< the sensors given to localisation this frame
+    NUSensorsData* m_behaviour_sensors;         //!< the sensors given to behaviour this frame
 };
 
 #endif
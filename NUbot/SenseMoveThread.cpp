@@ -25,6 +25,7 @@
 #include "NUPlatform/NUPlatform.h"
 #include "Infrastructure/NUBlackboard.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUSensorsData/SensorSnapshots.h"
 #include "Infrastructure/NUActionatorsData/NUActionatorsData.h"
 #include "NUPlatform/NUActionators/NUSounds.h"
 #include "NUPlatform/NUIO.h"
@@ -123,6 +124,11 @@ void SenseMoveThread::run()
                     prof.split("motion");
                 #endif
             #endif
+            // publish once motion has added its sensors, so the other threads get a complete copy of this frame
+            Blackboard->SensorHistory->publish(*Blackboard->Sensors);
+            #ifdef THREAD_SENSEMOVE_PROFILE
+                prof.split("publish");
+            #endif
             #if defined(USE_BEHAVIOUR) and not defined(USE_VISION) and not defined(USE_LOCALISATION)        // This is a special clause. When there is no vision or localisation we reduce down to a single thread; ie the behaviour is no called from this thread.
                 m_nubot->m_behaviour->process(Blackboard->Jobs, Blackboard->Sensors, Blackboard->Actions, Blackboard->Objects, Blackboard->GameInfo, Blackboard->TeamInfo);
                 #ifdef THREAD_SENSEMOVE_PROFILE
@@ -6,16 +6,20 @@
 #include "Infrastructure/GameInformation/GameInformation.h"
 #include "Infrastructure/FieldObjects/FieldObjects.h"
 
-LogFileWriter::LogFileWriter(std::string data_type)
+#include <fcntl.h>
+
+LogFileWriter::LogFileWriter(std::string data_type, LogWriterThread* writer)
 {
     m_data_name = data_type;
     m_status = lf_UNKNOWN;
+    m_file_descriptor = -1;
+    m_writer = writer;
 }
 
 
 LogFileWriter::~LogFileWriter()
 {
-    m_file_stream.close();
+    Close();
 }
 
 std::string LogFileWriter::toString()
@@ -27,8 +31,10 @@ std::string LogFileWriter::toString()
 bool LogFileWriter::Open(std::string file_path)
 {
     debug << "LW:Opening log file: " << file_path << " - ";
-    m_file_stream.open(file_path.c_str(),std::ios_base::out | std::ios_base::trunc);
-    if(m_file_stream.is_open() && m_file_stream.good())
+    Close();
+    m_sensor_log.reset();
+    m_file_descriptor = open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if(m_file_descriptor >= 0)
     {
         m_file_name = file_path;
         m_status = lf_OPEN;
@@ -43,30 +49,37 @@ bool LogFileWriter::Open(std::string file_path)
     }
 }
 
+// Sensor frames are written as a binary sensor log, which is much smaller and quicker to load than the text.
+void LogFileWriter::Write(const NUSensorsData& data)
+{
+    LogBuffer* buffer = m_writer->acquire(m_file_descriptor);
+    if(buffer == NULL) return;
+    m_sensor_log.write(buffer->stream(), data);
+    m_writer->submit(buffer);
+}
+
+// The file is closed by the writer, after the frames already queued for it have been written.
 bool LogFileWriter::Close()
 {
-    m_file_stream.close();
-    if(!m_file_stream.is_open())
-    {
-        m_status = lf_CLOSED;
-        return true;
-    }
-    else
+    if(m_file_descriptor >= 0)
     {
-        m_status = lf_UNKNOWN;
-        return false;
+        m_writer->close(m_file_descriptor);
+        m_file_descriptor = -1;
     }
+    m_status = lf_CLOSED;
+    return true;
 }
 
 LogRecorder::LogRecorder(int playerNumber)
 {
     m_player_number = playerNumber;
-    m_log_writers.push_back(new LogFileWriter("sensor"));
-    m_log_writers.push_back(new LogFileWriter("locsensor"));
-    m_log_writers.push_back(new LogFileWriter("image"));
-    m_log_writers.push_back(new LogFileWriter("object"));
-    m_log_writers.push_back(new LogFileWriter("teaminfo"));
-    m_log_writers.push_back(new LogFileWriter("gameinfo"));
+    m_log_writers.push_back(new LogFileWriter("sensor", &m_writer));
+    m_log_writers.push_back(new LogFileWriter("locsensor", &m_writer));
+    m_log_writers.push_back(new LogFileWriter("image", &m_writer));
+    m_log_writers.push_back(new LogFileWriter("object", &m_writer));
+    m_log_writers.push_back(new LogFileWriter("teaminfo", &m_writer));
+    m_log_writers.push_back(new LogFileWriter("gameinfo", &m_writer));
+    m_writer.start();
 }
 
 LogRecorder::~LogRecorder()
@@ -77,6 +90,9 @@ LogRecorder::~LogRecorder()
         delete (*it);
     }
     m_log_writers.clear();
+    m_writer.finish();
+    if(m_writer.dropped() > 0 or m_writer.errors() > 0)
+        debug << "LogRecorder: " << m_writer.written() << " frames written, " << m_writer.dropped() << " dropped, " << m_writer.errors() << " failed" << std::endl;
     return;
 }
 
@@ -164,17 +180,17 @@ bool LogRecorder::WriteData(NUBlackboard* theBlackboard)
         {
             std::string data_type = (*it)->GetDataType();
             if(data_type == "sensor")
-                (*it)->GetFile() << *(theBlackboard->Sensors) << std::flush;
+                (*it)->Write(*(theBlackboard->Sensors));
             else if(data_type == "locsensor")
-                (*it)->GetFile() << theBlackboard->Sensors->getLocSensors() << std::flush;
+                (*it)->Write(theBlackboard->Sensors->getLocSensors());
             else if(data_type == "image")
-                (*it)->GetFile() << *(theBlackboard->Image) << std::flush;
+                (*it)->Write(*(theBlackboard->Image));
             else if(data_type == "object")
-                (*it)->GetFile() << *(theBlackboard->Objects) << std::flush;
+                (*it)->Write(*(theBlackboard->Objects));
             else if(data_type == "gameinfo")
-                (*it)->GetFile() << *(theBlackboard->GameInfo) << std::flush;
+                (*it)->Write(*(theBlackboard->GameInfo));
             else if(data_type == "teaminfo")
-                (*it)->GetFile() << *(theBlackboard->TeamInfo) << std::flush;
+                (*it)->Write(*(theBlackboard->TeamInfo));
         }
     }
     return true;
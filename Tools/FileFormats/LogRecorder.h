@@ -1,13 +1,14 @@
 #ifndef LOGRECORDER_H
 #define LOGRECORDER_H
 
-#include <fstream>
 #include <sstream>
 #include <string>
 #include <vector>
 #include "nubotdataconfig.h"
 #include "targetconfig.h"
 #include "Infrastructure/NUBlackboard.h"
+#include "LogWriterThread.h"
+#include "SensorLogFormat.h"
 
 enum LogFileStatus
 {
@@ -18,10 +19,11 @@ enum LogFileStatus
 };
 
 // Wrapper for log file writer class. One of these is required for each data type.
+// The frames are written to the file by the LogWriterThread, so Write never waits for the disk.
 class LogFileWriter
 {
 public:
-    LogFileWriter(std::string data_type);
+    LogFileWriter(std::string data_type, LogWriterThread* writer);
     ~LogFileWriter();
 
     bool Open(std::string log_path);
@@ -42,10 +44,17 @@ public:
         return m_status;
     }
 
-    std::fstream& GetFile()
+    // Serialises a frame into a pooled buffer, and queues it to be written.
+    // If the writer has fallen behind the frame is dropped, and counted by the writer.
+    template <typename T> void Write(const T& data)
     {
-        return m_file_stream;
+        LogBuffer* buffer = m_writer->acquire(m_file_descriptor);
+        if(buffer == NULL) return;
+        buffer->stream() << data;
+        m_writer->submit(buffer);
     }
+    // Sensor frames are written as a binary sensor log instead, see SensorLogFormat.h
+    void Write(const NUSensorsData& data);
 
     std::string toString();
 
@@ -53,7 +62,9 @@ private:
     std::string m_data_name;
     std::string m_file_name;
     LogFileStatus m_status;
-    std::fstream m_file_stream;
+    int m_file_descriptor;
+    LogWriterThread* m_writer;
+    SensorLogWriter m_sensor_log;
 
 };
 
@@ -65,6 +76,10 @@ public:
     ~LogRecorder();
     bool SetLogging(std::string dataType, bool enabled);
     bool WriteData(NUBlackboard* theBlackboard);
+    unsigned int DroppedFrames() const
+    {
+        return m_writer.dropped();
+    }
     static std::string GetLogPath(int robot_number, std::string data_name)
     {
         const std::string extension = "strm";
@@ -81,6 +96,7 @@ public:
 
 private:
     int m_player_number;
+    LogWriterThread m_writer;
     bool HasDataType(std::string dataType);
     LogFileWriter* GetDataWriter(std::string dataType);
     std::vector<LogFileWriter*> m_log_writers;
@@ -0,0 +1,246 @@
+/*! @file LogWriterThread.cpp
+    @brief Implementation of the LogWriterThread and LogBuffer classes.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "LogWriterThread.h"
+
+#include <algorithm>
+#include <errno.h>
+#include <sys/time.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+static const size_t c_initial_buffer_size = 4096;
+
+LogBuffer::LogBuffer() : m_data(c_initial_buffer_size), m_file(-1), m_close(false), m_stream(this)
+{
+    setp(&m_data[0], &m_data[0] + m_data.size());
+}
+
+/*! @brief Empties the buffer, keeping its storage, and sets the file the next frame is for
+    @param file the file descriptor
+    @param close true if the file is to be closed after this buffer is written
+ */
+void LogBuffer::reset(int file, bool close)
+{
+    m_file = file;
+    m_close = close;
+    setp(&m_data[0], &m_data[0] + m_data.size());
+    m_stream.clear();
+}
+
+/*! @brief Doubles the storage when the stream fills it */
+int LogBuffer::overflow(int c)
+{
+    const size_t used = size();
+    m_data.resize(2*m_data.size());
+    setp(&m_data[0], &m_data[0] + m_data.size());
+    pbump(static_cast<int>(used));
+    if (c != traits_type::eof())
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+LogWriterThread::LogWriterThread() : Thread("LogWriterThread", 0), m_stopping(false), m_dropped(0), m_written(0), m_errors(0)
+{
+    for (unsigned int i=0; i<c_pool_size; i++)
+        m_free.push(&m_buffers[i]);
+}
+
+LogWriterThread::~LogWriterThread()
+{
+    finish();
+}
+
+/*! @brief Writes every submitted frame, syncs the files and stops the writer thread.
+
+    The counters are final once this returns. Calling it again, or destroying the writer afterwards, does nothing more.
+ */
+void LogWriterThread::finish()
+{
+    m_stopping = true;
+    m_submitted_event.notify();
+    join();
+}
+
+/*! @brief Takes a buffer from the pool for a frame for the given file
+    @param file the file descriptor the frame is to be written to
+    @return the buffer, or NULL if none are free, in which case the frame is counted as dropped
+ */
+LogBuffer* LogWriterThread::acquire(int file)
+{
+    LogBuffer* buffer;
+    if (!m_free.pop(buffer))
+    {
+        m_dropped++;
+        return NULL;
+    }
+    buffer->reset(file, false);
+    return buffer;
+}
+
+/*! @brief Queues a buffer from acquire() to be written */
+void LogWriterThread::submit(LogBuffer* buffer)
+{
+    m_submitted.push(buffer);                   // there are only c_pool_size buffers, so this never fails
+    m_submitted_event.notify();
+}
+
+/*! @brief Closes a file after the frames already submitted for it have been written and synced.
+
+    This is never dropped, if the pool is empty it waits for the writer thread to return a buffer.
+    @param file the file descriptor
+ */
+void LogWriterThread::close(int file)
+{
+    LogBuffer* buffer;
+    while (!m_free.pop(buffer))
+    {
+        unsigned int key = m_free_event.prepareWait();
+        if (m_free.pop(buffer))
+        {
+            m_free_event.cancelWait();
+            break;
+        }
+        m_free_event.wait(key);
+    }
+    buffer->reset(file, true);
+    submit(buffer);
+}
+
+void LogWriterThread::run()
+{
+    LogBuffer* frames[c_pool_size];
+    timeval now;
+    gettimeofday(&now, NULL);
+    double last_sync = now.tv_sec*1e3 + now.tv_usec*1e-3;
+    while (true)
+    {
+        unsigned int count = 0;
+        while (count < c_pool_size && m_submitted.pop(frames[count]))
+            count++;
+        if (count > 0)
+            writeFrames(frames, count);
+
+        gettimeofday(&now, NULL);
+        double current_time = now.tv_sec*1e3 + now.tv_usec*1e-3;
+        if (current_time - last_sync >= c_sync_period)
+        {
+            syncFiles();
+            last_sync = current_time;
+        }
+
+        if (count == 0)
+        {
+            if (m_stopping)
+                break;
+            unsigned int key = m_submitted_event.prepareWait();
+            if (!m_submitted.empty() || m_stopping)
+                m_submitted_event.cancelWait();
+            else
+                m_submitted_event.wait(key, c_sync_period);
+        }
+    }
+    syncFiles();
+}
+
+/*! @brief Writes the frames in the order they were submitted, and returns their buffers to the pool.
+
+    Runs of frames for the same file are gathered into a single writev().
+ */
+void LogWriterThread::writeFrames(LogBuffer** frames, unsigned int count)
+{
+    iovec parts[c_pool_size];
+    unsigned int start = 0;
+    for (unsigned int i=0; i<count; i++)
+    {
+        parts[i].iov_base = const_cast<char*>(frames[i]->data());
+        parts[i].iov_len = frames[i]->size();
+        bool last_of_run = (i + 1 == count) || (frames[i + 1]->file() != frames[i]->file()) || frames[i]->closesFile();
+        if (last_of_run)
+        {
+            int file = frames[i]->file();
+            writeAll(file, &parts[start], i + 1 - start);
+            if (std::find(m_unsynced.begin(), m_unsynced.end(), file) == m_unsynced.end())
+                m_unsynced.push_back(file);
+            if (frames[i]->closesFile())
+            {
+                #ifdef __linux__
+                    fdatasync(file);
+                #else
+                    fsync(file);
+                #endif
+                ::close(file);
+                m_unsynced.erase(std::find(m_unsynced.begin(), m_unsynced.end(), file));
+            }
+            start = i + 1;
+        }
+    }
+    m_written += count;
+    for (unsigned int i=0; i<count; i++)
+        m_free.push(frames[i]);
+    m_free_event.notify();
+}
+
+/*! @brief Writes all of the parts to the file, retrying partial writes */
+void LogWriterThread::writeAll(int file, iovec* parts, unsigned int count)
+{
+    while (count > 0)
+    {
+        if (parts->iov_len == 0)
+        {
+            parts++;
+            count--;
+            continue;
+        }
+        ssize_t n = writev(file, parts, count);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+        {
+            m_errors += count;
+            return;
+        }
+        while (count > 0 && static_cast<size_t>(n) >= parts->iov_len)
+        {
+            n -= parts->iov_len;
+            parts++;
+            count--;
+        }
+        if (count > 0)
+        {
+            parts->iov_base = static_cast<char*>(parts->iov_base) + n;
+            parts->iov_len -= n;
+        }
+    }
+}
+
+/*! @brief Pushes the files written since the last sync to the disk */
+void LogWriterThread::syncFiles()
+{
+    for (unsigned int i=0; i<m_unsynced.size(); i++)
+    {
+        #ifdef __linux__
+            fdatasync(m_unsynced[i]);
+        #else
+            fsync(m_unsynced[i]);
+        #endif
+    }
+    m_unsynced.clear();
+}
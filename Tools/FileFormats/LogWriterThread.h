@@ -0,0 +1,106 @@
+/*! @file LogWriterThread.h
+    @brief Declaration of the LogWriterThread and LogBuffer classes.
+
+    @class LogWriterThread
+    @brief Writes log frames to disk on its own thread, so that the thread recording them never waits for the disk.
+
+    The recording thread takes a LogBuffer from a fixed pool with acquire(), serialises a frame into
+    its stream(), and hands it over with submit(). The pool and the queue of submitted frames are
+    SPSCRings, so neither side ever takes a lock. The writer thread gathers everything that has been
+    submitted, writes consecutive frames for the same file with a single writev(), returns the buffers
+    to the pool, and syncs the files it has written every c_sync_period ms.
+
+    When the disk falls behind the pool runs dry and acquire() returns NULL. The frame is then dropped
+    and counted instead of the recording thread blocking. Buffers keep their capacity when they return
+    to the pool, so once each has held a full frame recording a frame is only a copy into memory.
+
+    Only one thread may call acquire(), submit() and close().
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef LOG_WRITER_THREAD_H_DEFINED
+#define LOG_WRITER_THREAD_H_DEFINED
+
+#include "Tools/Threading/Thread.h"
+#include "Tools/Threading/EventCount.h"
+#include "Tools/Threading/SPSCRing.h"
+
+#include <ostream>
+#include <streambuf>
+#include <vector>
+
+/*! @brief A pooled buffer holding one frame for one file. The frame is written to stream(). */
+class LogBuffer : private std::streambuf
+{
+public:
+    LogBuffer();
+
+    std::ostream& stream() {return m_stream;}
+    const char* data() const {return pbase();}
+    size_t size() const {return pptr() - pbase();}
+    int file() const {return m_file;}
+    bool closesFile() const {return m_close;}
+
+    void reset(int file, bool close);
+
+private:
+    int overflow(int c);
+
+    std::vector<char> m_data;               //!< the storage, which only ever grows
+    int m_file;                             //!< the file descriptor the frame is written to
+    bool m_close;                           //!< true if the file is closed after this buffer is written
+    std::ostream m_stream;                  //!< the stream writing into m_data
+};
+
+class LogWriterThread : public Thread
+{
+public:
+    LogWriterThread();
+    ~LogWriterThread();
+
+    LogBuffer* acquire(int file);
+    void submit(LogBuffer* buffer);
+    void close(int file);
+    void finish();
+
+    unsigned int dropped() const {return m_dropped;}
+    unsigned int written() const {return m_written;}
+    unsigned int errors() const {return m_errors;}
+
+protected:
+    void run();
+
+private:
+    void writeFrames(LogBuffer** frames, unsigned int count);
+    void writeAll(int file, struct iovec* parts, unsigned int count);
+    void syncFiles();
+
+    enum {c_pool_size = 32};
+    static const unsigned int c_sync_period = 1000;     //!< the time in ms between syncs of the written files
+
+    LogBuffer m_buffers[c_pool_size];                   //!< the pool
+    SPSCRing<LogBuffer*, c_pool_size> m_free;           //!< the buffers waiting to be acquired, returned by the writer thread
+    SPSCRing<LogBuffer*, c_pool_size> m_submitted;      //!< the frames waiting to be written
+    EventCount m_submitted_event;                       //!< notified when a frame is submitted
+    EventCount m_free_event;                            //!< notified when buffers are returned, only waited on by close()
+    std::vector<int> m_unsynced;                        //!< the files written since the last sync, only used by the writer thread
+    volatile bool m_stopping;                           //!< set to make the writer thread finish the submitted frames and exit
+
+    volatile unsigned int m_dropped;                    //!< the number of frames dropped because no buffer was free
+    volatile unsigned int m_written;                    //!< the number of frames written
+    volatile unsigned int m_errors;                     //!< the number of frames that could not be written completely
+};
+
+#endif
@@ -0,0 +1,314 @@
+/*! @file SensorLogFormat.cpp
+    @brief Implementation of the binary sensor log format.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "SensorLogFormat.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/Math/StlVector.h"
+
+#include <cstring>
+#include <sstream>
+
+/*! @brief Returns true if the stream is at the start of a binary sensor log. The stream is left where it was. */
+bool SensorLog::isSensorLog(std::istream& input)
+{
+    std::istream::pos_type start = input.tellg();
+    char magic[sizeof(c_magic)];
+    input.read(magic, sizeof(magic));
+    bool result = input.gcount() == sizeof(magic) && memcmp(magic, c_magic, sizeof(magic)) == 0;
+    input.clear();
+    input.seekg(start);
+    return result;
+}
+
+template<typename T> static inline void writeRaw(std::ostream& output, const T& value)
+{
+    output.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T> static inline bool readRaw(std::istream& input, T& value)
+{
+    input.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return input.gcount() == sizeof(T);
+}
+
+// ------------------------------------------------------------------------------------------------------------------- SensorLogWriter
+
+SensorLogWriter::SensorLogWriter(bool delta) : m_delta(delta)
+{
+    reset();
+}
+
+/*! @brief Starts a new file; the next frame written will be preceded by the header */
+void SensorLogWriter::reset()
+{
+    m_frames = 0;
+    m_frames_since_key = 0;
+    m_num_sensors = 0;
+    m_previous = SensorFrame();
+}
+
+/*! @brief Writes a frame to the output, along with the header if it is the first
+    @param output the stream to write to
+    @param data the sensor data
+    @return true if the frame was written, false if the sensors do not match the schema
+ */
+bool SensorLogWriter::write(std::ostream& output, const NUSensorsData& data)
+{
+    if (m_frames == 0)
+        writeHeader(output, data);
+    else if (data.m_sensors.size() != m_num_sensors)
+        return false;
+
+    m_frame.capture(data);
+    const std::vector<uint32_t>& shape = m_frame.Shape;
+    const std::vector<uint32_t>& words = m_frame.Words;
+
+    SensorLogFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.timestamp = m_frame.Timestamp;
+
+    bool delta = m_delta && m_frames_since_key > 0 && m_frames_since_key < SensorLog::c_key_frame_interval && not words.empty() && shape == m_previous.Shape;
+    if (delta)
+    {
+        m_payload.resize(5*words.size());
+        unsigned char* p = reinterpret_cast<unsigned char*>(&m_payload[0]);
+        for (size_t i=0; i<words.size(); i++)
+        {
+            uint32_t value = words[i] ^ m_previous.Words[i];
+            while (value >= 0x80)
+            {
+                *p++ = static_cast<unsigned char>(value | 0x80);
+                value >>= 7;
+            }
+            *p++ = static_cast<unsigned char>(value);
+        }
+        header.type = SensorLog::DeltaFrame;
+        header.size = p - reinterpret_cast<unsigned char*>(&m_payload[0]);
+        writeRaw(output, header);
+        output.write(&m_payload[0], header.size);
+        m_frames_since_key++;
+    }
+    else
+    {
+        uint32_t shape_size = shape.size();
+        header.type = SensorLog::KeyFrame;
+        header.size = sizeof(uint32_t)*(1 + shape.size() + words.size());
+        writeRaw(output, header);
+        writeRaw(output, shape_size);
+        if (not shape.empty())
+            output.write(reinterpret_cast<const char*>(&shape[0]), sizeof(uint32_t)*shape.size());
+        if (not words.empty())
+            output.write(reinterpret_cast<const char*>(&words[0]), sizeof(uint32_t)*words.size());
+        m_frames_since_key = 1;
+    }
+
+    m_previous.swap(m_frame);
+    m_frames++;
+    return true;
+}
+
+/*! @brief Writes the file header, with the schema taken from data */
+void SensorLogWriter::writeHeader(std::ostream& output, const NUSensorsData& data)
+{
+    m_num_sensors = data.m_sensors.size();
+
+    // the id lists are stored as NUSensorsData's operator<< writes them, followed by an empty list of sensors,
+    // so that the reader can parse them with operator>>
+    std::stringstream schema;
+    schema << data.m_common_ids << std::endl;
+    schema << data.m_ids_copy << std::endl;
+    schema << data.m_id_to_indices << std::endl;
+    schema << data.m_available_ids << std::endl;
+    schema << 0 << std::endl;
+    schema << m_num_sensors << std::endl;
+    for (unsigned int i=0; i<m_num_sensors; i++)
+        schema << data.m_sensors[i].Name << std::endl;
+    std::string schema_text = schema.str();
+
+    uint16_t flags = m_delta ? SensorLog::Delta : 0;
+    uint32_t schema_size = schema_text.size();
+    output.write(SensorLog::c_magic, sizeof(SensorLog::c_magic));
+    writeRaw(output, SensorLog::c_version);
+    writeRaw(output, flags);
+    writeRaw(output, schema_size);
+    output.write(schema_text.data(), schema_size);
+}
+
+/*! @brief Converts a text sensor log, as written by NUSensorsData's operator<<, to a binary sensor log
+    @param text the text log
+    @param binary the stream to write the binary log to
+    @param delta true if delta frames are to be written
+    @return the number of frames converted
+ */
+unsigned int SensorLogWriter::convert(std::istream& text, std::ostream& binary, bool delta)
+{
+    NUSensorsData data;
+    SensorLogWriter writer(delta);
+    while (text.good())
+    {
+        text >> std::ws;
+        if (text.eof())
+            break;
+        try
+        {
+            text >> data;
+        }
+        catch (...)
+        {
+            break;
+        }
+        if (text.fail())
+            break;
+        writer.write(binary, data);
+    }
+    return writer.frames();
+}
+
+// ------------------------------------------------------------------------------------------------------------------- SensorLogReader
+
+SensorLogReader::SensorLogReader() : m_have_frame(false)
+{
+}
+
+/*! @brief Reads the file header, and sets up data with the schema
+    @param input the stream, at the start of the file
+    @param data the sensor data the frames will be read into
+    @return true if the header was read, false if the stream is not a sensor log
+ */
+bool SensorLogReader::readHeader(std::istream& input, NUSensorsData& data)
+{
+    m_have_frame = false;
+    m_names.clear();
+
+    char magic[sizeof(SensorLog::c_magic)];
+    uint16_t version, flags;
+    uint32_t schema_size;
+    input.read(magic, sizeof(magic));
+    if (input.gcount() != sizeof(magic) || memcmp(magic, SensorLog::c_magic, sizeof(magic)) != 0)
+        return false;
+    if (not readRaw(input, version) || version != SensorLog::c_version)
+        return false;
+    if (not readRaw(input, flags) || not readRaw(input, schema_size))
+        return false;
+    std::string schema_text(schema_size, '\0');
+    input.read(&schema_text[0], schema_size);
+    if (static_cast<uint32_t>(input.gcount()) != schema_size)
+        return false;
+
+    std::stringstream schema(schema_text);
+    schema >> data;
+    unsigned int num_sensors = 0;
+    schema >> num_sensors;
+    schema.ignore(128, '\n');
+    for (unsigned int i=0; i<num_sensors && schema.good(); i++)
+    {
+        std::string name;
+        std::getline(schema, name);
+        m_names.push_back(name);
+    }
+    if (m_names.size() != num_sensors)
+        return false;
+
+    m_frame.setNumSensors(num_sensors);
+    data.m_sensors.clear();
+    for (unsigned int i=0; i<num_sensors; i++)
+        data.m_sensors.push_back(Sensor(m_names[i]));
+    return true;
+}
+
+/*! @brief Reads a frame header, leaving the stream at the start of the payload */
+bool SensorLogReader::readFrameHeader(std::istream& input, SensorLogFrameHeader& header)
+{
+    return readRaw(input, header);
+}
+
+/*! @brief Reads the next frame into data.
+
+    A delta frame can only be read straight after the frame before it.
+    @return true if the frame was read
+ */
+bool SensorLogReader::readFrame(std::istream& input, NUSensorsData& data)
+{
+    SensorLogFrameHeader header;
+    if (not readFrameHeader(input, header))
+        return false;
+    m_payload.resize(header.size);
+    if (header.size > 0)
+    {
+        input.read(&m_payload[0], header.size);
+        if (static_cast<uint32_t>(input.gcount()) != header.size)
+            return false;
+    }
+
+    if (header.type == SensorLog::KeyFrame)
+    {
+        uint32_t shape_size;
+        if (header.size < sizeof(shape_size))
+            return false;
+        memcpy(&shape_size, &m_payload[0], sizeof(shape_size));
+        if (sizeof(uint32_t)*(1 + static_cast<size_t>(shape_size)) > header.size)
+            return false;
+        std::vector<uint32_t>& shape = m_frame.Shape;
+        std::vector<uint32_t>& words = m_frame.Words;
+        shape.resize(shape_size);
+        if (shape_size > 0)
+            memcpy(&shape[0], &m_payload[sizeof(uint32_t)], sizeof(uint32_t)*shape_size);
+        words.resize(header.size/sizeof(uint32_t) - 1 - shape_size);
+        if (not words.empty())
+            memcpy(&words[0], &m_payload[sizeof(uint32_t)*(1 + shape_size)], sizeof(uint32_t)*words.size());
+        if (not m_frame.valid())
+        {
+            m_have_frame = false;
+            return false;
+        }
+    }
+    else if (header.type == SensorLog::DeltaFrame && m_have_frame)
+    {
+        const unsigned char* p = reinterpret_cast<const unsigned char*>(m_payload.empty() ? NULL : &m_payload[0]);
+        const unsigned char* end = p + m_payload.size();
+        std::vector<uint32_t>& words = m_frame.Words;
+        for (size_t i=0; i<words.size(); i++)
+        {
+            uint32_t value = 0;
+            unsigned int shift = 0;
+            while (p != end && (*p & 0x80) && shift < 28)
+            {
+                value |= static_cast<uint32_t>(*p++ & 0x7f) << shift;
+                shift += 7;
+            }
+            if (p == end)
+            {
+                m_have_frame = false;
+                return false;
+            }
+            value |= static_cast<uint32_t>(*p++) << shift;
+            words[i] ^= value;
+        }
+    }
+    else
+        return false;
+
+    m_have_frame = true;
+    m_frame.Timestamp = header.timestamp;
+    if (data.m_sensors.size() != m_names.size())
+    {
+        data.m_sensors.clear();
+        for (unsigned int i=0; i<m_names.size(); i++)
+            data.m_sensors.push_back(Sensor(m_names[i]));
+    }
+    return m_frame.restore(data);
+}
@@ -0,0 +1,129 @@
+/*! @file SensorLogFormat.h
+    @brief Declaration of the binary sensor log format, and its SensorLogWriter and SensorLogReader.
+
+    A sensor log is a header followed by one frame per NUSensorsData.
+
+    The header is the magic "NUSL", a version, the flags the file was written with and the schema.
+    The schema holds the id lists of the NUSensorsData and the names of its sensors, so they are
+    stored once per file instead of once per frame.
+
+    Each frame starts with a fixed size SensorLogFrameHeader holding its type, the size of its
+    payload and its timestamp, so a file can be indexed without decoding any of the frames.
+    The payload is the shape and the words of the SensorFrame of the NUSensorsData.
+
+    A key frame stores the shape and the words as they are. When the file is written with
+    SensorLog::Delta, a frame with the same shape as the one before it is instead a delta frame,
+    which stores only the words, each xor'ed with the same word in the previous frame and written
+    as a varint. Readings that have not changed cost one byte, and readings that have changed a
+    little only lose their high bits. A key frame is written at least every c_key_frame_interval
+    frames, so reading an arbitrary frame never decodes more than that many frames.
+
+    The words are written in the byte order of the machine writing the log; the robots and the
+    desktops we use are all little endian.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SENSOR_LOG_FORMAT_H_DEFINED
+#define SENSOR_LOG_FORMAT_H_DEFINED
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <stdint.h>
+
+#include "Infrastructure/NUSensorsData/SensorFrame.h"
+class NUSensorsData;
+
+namespace SensorLog
+{
+    static const char c_magic[4] = {'N', 'U', 'S', 'L'};
+    static const uint16_t c_version = 1;
+    static const unsigned int c_key_frame_interval = 64;
+
+    //! The flags in the file header
+    enum Flags
+    {
+        Delta = 0x0001                  //!< the file contains delta frames
+    };
+
+    //! The types of frame
+    enum FrameType
+    {
+        KeyFrame = 0,
+        DeltaFrame = 1
+    };
+
+    bool isSensorLog(std::istream& input);
+}
+
+//! The fixed size header of each frame
+struct SensorLogFrameHeader
+{
+    uint8_t type;                       //!< the SensorLog::FrameType
+    uint8_t reserved[3];
+    uint32_t size;                      //!< the size of the payload in bytes
+    double timestamp;                   //!< the timestamp of the NUSensorsData
+};
+
+/*! @brief Writes NUSensorsData to a binary sensor log.
+
+    The header is written with the first frame, and the schema is taken from that frame.
+    A frame that does not have the same number of sensors as the schema is not written.
+ */
+class SensorLogWriter
+{
+public:
+    SensorLogWriter(bool delta = true);
+
+    void reset();
+    bool write(std::ostream& output, const NUSensorsData& data);
+    unsigned int frames() const {return m_frames;}
+
+    static unsigned int convert(std::istream& text, std::ostream& binary, bool delta = true);
+
+private:
+    void writeHeader(std::ostream& output, const NUSensorsData& data);
+
+    bool m_delta;                       //!< true if delta frames are to be written
+    unsigned int m_frames;              //!< the number of frames written since the header
+    unsigned int m_frames_since_key;    //!< the number of frames written since the last key frame
+    unsigned int m_num_sensors;         //!< the number of sensors in the schema
+    SensorFrame m_frame;                //!< the frame being written
+    SensorFrame m_previous;             //!< the frame written before it
+    std::vector<char> m_payload;        //!< the encoded payload, kept to avoid allocating each frame
+};
+
+/*! @brief Reads NUSensorsData from a binary sensor log.
+
+    Frames are read in order with readFrame(). To start reading somewhere else seek to a key frame.
+ */
+class SensorLogReader
+{
+public:
+    SensorLogReader();
+
+    bool readHeader(std::istream& input, NUSensorsData& data);
+    bool readFrame(std::istream& input, NUSensorsData& data);
+    static bool readFrameHeader(std::istream& input, SensorLogFrameHeader& header);
+
+private:
+    std::vector<std::string> m_names;   //!< the sensor names from the schema
+    SensorFrame m_frame;                //!< the last frame read
+    std::vector<char> m_payload;
+    bool m_have_frame;                  //!< true if m_frame holds a frame, so a delta frame can be read
+};
+
+#endif
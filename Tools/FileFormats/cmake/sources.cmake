@@ -26,6 +26,10 @@ NUbotImage.cpp
 Parse.cpp
 LogRecorder.cpp
 LogRecorder.h
+LogWriterThread.cpp
+LogWriterThread.h
+SensorLogFormat.cpp
+SensorLogFormat.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
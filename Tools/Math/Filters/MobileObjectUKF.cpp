@@ -2,7 +2,7 @@
 #include <assert.h>
 #include <iostream>
 
-MobileObjectUKF::MobileObjectUKF(): UKF(total_states)
+MobileObjectUKF::MobileObjectUKF(): UKF<total_states>()
 {
     m_velocity_decay = 0.96;    // Randomly guessed decay -- may not represent the real world.
 }
@@ -19,9 +19,9 @@ MobileObjectUKF::~MobileObjectUKF()
  * @param measurement The measurement of the odometry used to update the objects new relative position.
  * @return The new estimated system state.
  */
-Matrix MobileObjectUKF::processEquation(const Matrix& sigma_point, double deltaT, const Matrix& measurement)
+MobileObjectUKF::StateVector MobileObjectUKF::processEquation(const StateVector& sigma_point, double deltaT, const Matrix& measurement)
 {
-    Matrix result(sigma_point); // Start at original state.
+    StateVector result(sigma_point); // Start at original state.
     double tempx, tempy;
 
     assert(measurement.getm()==3); // Check the correct number of measurements have been given.
@@ -75,7 +75,7 @@ Matrix MobileObjectUKF::processEquation(const Matrix& sigma_point, double deltaT
  * @param measurementArgs Additional arguments used to calculate the measurement. In this implementation it is unused.
  * @return The expected measurement for the given states.
  */
-Matrix MobileObjectUKF::measurementEquation(const Matrix& sigma_point, const Matrix& measurementArgs)
+MobileObjectUKF::MeasurementVector MobileObjectUKF::measurementEquation(const StateVector& sigma_point, const Matrix& measurementArgs)
 {
     // measurementArgs not required, since the measurements are only reliant on the current state.
     // Measurement is to be in polar coordinates (distance, theta).
@@ -89,7 +89,7 @@ Matrix MobileObjectUKF::measurementEquation(const Matrix& sigma_point, const Mat
     double angle = atan2(y, x);
 
     // Write to matrix for return.
-    Matrix expected_measurement(2,1,false);
+    MeasurementVector expected_measurement;
     expected_measurement[0][0] = distance;
     expected_measurement[1][0] = angle;
 
@@ -98,57 +98,39 @@ Matrix MobileObjectUKF::measurementEquation(const Matrix& sigma_point, const Mat
 
 bool MobileObjectUKF::directUpdate(const Matrix& position, const Matrix& cov)
 {
-    const unsigned int totalPoints = totalSigmaPoints();
-    const unsigned int numStates = totalStates();
-    const unsigned int totalMeasurements = position.getm();
-    Matrix currentPoint; // temporary storage.
-    Matrix prop_y(totalMeasurements,1);
-    Matrix Yprop(totalMeasurements, totalPoints);
+    assert(position.getm() == 2);
+    const MeasurementVector measurement(position);
+    MeasurementSigmaPoints Yprop;
 
     // First step is to calculate the expected measurmenent for each sigma point.
-    for (unsigned int i = 0; i < totalPoints; ++i)
+    for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
     {
-        currentPoint = m_sigma_points.getCol(i);    // Get the sigma point.
-        prop_y[0][0] = currentPoint[0][0];
-        prop_y[1][0] = currentPoint[1][0];
-        Yprop.setCol(i, prop_y);
+        Yprop[0][i] = m_sigma_points[x_pos][i];
+        Yprop[1][i] = m_sigma_points[y_pos][i];
     }
 
     // Now calculate the mean of these measurement sigmas.
-    Matrix Ymean = CalculateMeanFromSigmas(Yprop);
+    const MeasurementVector Ymean = CalculateMeanFromSigmas(Yprop);
 
-    Matrix Pyy(cov);   // measurement noise is added, so just use as the beginning value of the sum.
-    Matrix Pxy(numStates, totalMeasurements, false);
+    MeasurementMatrix Pyy(cov);   // measurement noise is added, so just use as the beginning value of the sum.
+    Gain Pxy;
 
     // Calculate the Pyy and Pxy variance matrices.
-    for(unsigned int i = 0; i < totalPoints; ++i)
+    for(unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
     {
-        double weight = m_covariance_weights[0][i];
+        const double weight = m_covariance_weights[0][i];
         // store difference between prediction and measurement.
-        currentPoint = Yprop.getCol(i) - Ymean;
+        const MeasurementVector currentPoint = Yprop.getCol(i) - Ymean;
         // Innovation covariance - Add Measurement noise
-        Pyy = Pyy + weight * currentPoint * currentPoint.transp();
+        Pyy += weight * currentPoint * currentPoint.transp();
         // Cross correlation matrix
-        Pxy = Pxy + weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint.transp();    // Important: Use mean from estimate, not current mean.
+        Pxy += weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint.transp();    // Important: Use mean from estimate, not current mean.
     }
 
     // Calculate the Kalman filter gain
-    Matrix K;
-    // If we have a 2 dimensional measurement, use the faster shortcut function.
-    if(totalMeasurements == 2)
-    {
-        K = Pxy * Invert22(Pyy);
-    }
-    else
-    {
-        K = Pxy * InverseMatrix(Pyy);
-    }
-
-    Matrix newMean = mean() + K * (position - Ymean);
-    Matrix newCovariance = covariance() - K*Pyy*K.transp();
+    const Gain K = Pxy * Invert22(Pyy);
 
-    setMean(newMean);
-    setCovariance(newCovariance);
+    setState(StateVector(m_mean) + K * (measurement - Ymean), StateMatrix(m_covariance) - K*Pyy*K.transp());
     return true;
 }
 
@@ -29,7 +29,7 @@
 
 #include "UKF.h"
 
-class MobileObjectUKF : public UKF
+class MobileObjectUKF : public UKF<4>   // the four states below
 {
 public:
     enum State
@@ -46,8 +46,8 @@ public:
     bool directUpdate(const Matrix& position, const Matrix& covariance);
     void initialiseModel(const Matrix& mean, const Matrix& covariance);
 protected:
-    Matrix processEquation(const Matrix& sigma_point, double deltaT, const Matrix& measurement);
-    Matrix measurementEquation(const Matrix& sigma_point, const Matrix& measurementArgs);
+    StateVector processEquation(const StateVector& sigma_point, double deltaT, const Matrix& measurement);
+    MeasurementVector measurementEquation(const StateVector& sigma_point, const Matrix& measurementArgs);
 
     float m_velocity_decay; //! The velocity decay rate, should be <1 and >0. Velocity becomes m_velocity_decay*current velocity.
 };
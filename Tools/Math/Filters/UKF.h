@@ -1,5 +1,5 @@
 /*! @file UKF.h
- @brief Declaration of general UKF class
+ @brief Declaration and implementation of general UKF class
 
  @class UKF
  @brief This class is a template to create a custom UKF specific for an application.
@@ -7,6 +7,11 @@
  The processEquation and measurementEquation virtual functions must be defined for each application,
  the remainder of the algorithm is otherwise identical.
 
+ The number of states and the number of measurements are template parameters, so the sigma points,
+ weights and all of the temporaries in the updates are FixedMatrix on the stack and an update never
+ allocates. The mean and covariance are still kept in the Moment so the filter can be used through
+ the Matrix interface.
+
  @author Steven Nicklin
 
  Copyright (c) 2012 Steven Nicklin
@@ -28,20 +33,34 @@
 #pragma once
 #include "Tools/Math/Moment.h"
 #include "Tools/Math/Matrix.h"
+#include "Tools/Math/FixedMatrix.h"
 #include "UnscentedTransform.h"
 
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS = 2>
 class UKF: public UnscentedTransform, public Moment
 {
 public:
+    enum {NUM_SIGMA_POINTS = 2*NUM_STATES + 1};
+    typedef FixedMatrix<NUM_STATES,1> StateVector;
+    typedef FixedMatrix<NUM_STATES,NUM_STATES> StateMatrix;
+    typedef FixedMatrix<NUM_MEASUREMENTS,1> MeasurementVector;
+    typedef FixedMatrix<NUM_MEASUREMENTS,NUM_MEASUREMENTS> MeasurementMatrix;
+    typedef FixedMatrix<NUM_STATES,NUM_SIGMA_POINTS> SigmaPoints;
+    typedef FixedMatrix<NUM_MEASUREMENTS,NUM_SIGMA_POINTS> MeasurementSigmaPoints;
+    typedef FixedMatrix<NUM_STATES,NUM_MEASUREMENTS> Gain;
+
     UKF();
-    UKF(unsigned int numStates);
     UKF(const UKF& source);
     virtual ~UKF();
 
     // Public functions, these are the only two functions that should need to be called externally.
     // They are virtual in case the need to be redefined, but the default functions should work in most cases.
-    virtual bool timeUpdate(double deltaT, const Matrix& measurment, const Matrix& linearProcessNoise, const Matrix& measurementNoise);
-    virtual bool measurementUpdate(const Matrix& measurement, const Matrix& measurementNoise, const Matrix& measurementArgs = Matrix());
+    virtual bool timeUpdate(double deltaT, const Matrix& measurement, const StateMatrix& linearProcessNoise);
+    virtual bool measurementUpdate(const MeasurementVector& measurement, const MeasurementMatrix& measurementNoise, const Matrix& measurementArgs = Matrix());
+
+    // Matrix versions of the above, these copy the arguments to the stack and call the fixed size versions.
+    bool timeUpdate(double deltaT, const Matrix& measurment, const Matrix& linearProcessNoise, const Matrix& measurementNoise);
+    bool measurementUpdate(const Matrix& measurement, const Matrix& measurementNoise, const Matrix& measurementArgs = Matrix());
 
     bool operator ==(const UKF& b) const;
     bool operator !=(const UKF& b) const
@@ -62,19 +81,275 @@ public:
     std::istream& readStreamBinary (std::istream& input);
 
 protected:
-   Matrix m_mean_weights;
-   Matrix m_covariance_weights;
-   Matrix m_sigma_points;
-   Matrix m_sigma_mean;
+   FixedMatrix<1,NUM_SIGMA_POINTS> m_mean_weights;
+   FixedMatrix<1,NUM_SIGMA_POINTS> m_covariance_weights;
+   SigmaPoints m_sigma_points;
+   StateVector m_sigma_mean;
 
    // Functions for performing steps of the UKF algorithm.
    void CalculateWeights();
-   Matrix GenerateSigmaPoints() const;
-   Matrix CalculateMeanFromSigmas(const Matrix& sigmaPoints) const;
-   Matrix CalculateCovarianceFromSigmas(const Matrix& sigmaPoints, const Matrix& mean) const;
+   SigmaPoints GenerateSigmaPoints() const;
+   template <unsigned int ROWS>
+   FixedMatrix<ROWS,1> CalculateMeanFromSigmas(const FixedMatrix<ROWS,NUM_SIGMA_POINTS>& sigmaPoints) const;
+   StateMatrix CalculateCovarianceFromSigmas(const SigmaPoints& sigmaPoints, const StateVector& mean) const;
+
+   // Writes a new mean and covariance into the Moment, without allocating.
+   void setState(StateVector newMean, const StateMatrix& newCovariance);
+
+   // Applied to every new mean, for example to normalise angles. The default does nothing.
+   virtual void constrainMean(StateVector& /*mean*/) const {}
 
    // These functions need to be defined for each implementation of a filter, as they are dependent on the specific application.
-   virtual Matrix processEquation(const Matrix& sigma_point, double deltaT, const Matrix& measurement) = 0;
-   virtual Matrix measurementEquation(const Matrix& sigma_point, const Matrix& measurementArgs) = 0;
+   virtual StateVector processEquation(const StateVector& sigma_point, double deltaT, const Matrix& measurement) = 0;
+   virtual MeasurementVector measurementEquation(const StateVector& sigma_point, const Matrix& measurementArgs) = 0;
 
 };
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+UKF<NUM_STATES, NUM_MEASUREMENTS>::UKF(): UnscentedTransform(NUM_STATES), Moment(NUM_STATES)
+{
+    CalculateWeights();
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+UKF<NUM_STATES, NUM_MEASUREMENTS>::UKF(const UKF& source): UnscentedTransform(source), Moment(source),
+    m_sigma_points(source.m_sigma_points), m_sigma_mean(source.m_sigma_mean)
+{
+    CalculateWeights();
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+UKF<NUM_STATES, NUM_MEASUREMENTS>::~UKF()
+{
+}
+
+/*!
+ * @brief Pre-calculate the sigma point weightings, based on the current unscented transform parameters.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+void UKF<NUM_STATES, NUM_MEASUREMENTS>::CalculateWeights()
+{
+    // Calculate the weights. These are row vectors.
+    for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
+    {
+        m_mean_weights[0][i] = Wm(i);
+        m_covariance_weights[0][i] = Wc(i);
+    }
+    return;
+}
+
+/*!
+ * @brief Calculates the sigma points from the current mean an covariance of the filter.
+ * @return The sigma points that describe the current mean and covariance.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+typename UKF<NUM_STATES, NUM_MEASUREMENTS>::SigmaPoints UKF<NUM_STATES, NUM_MEASUREMENTS>::GenerateSigmaPoints() const
+{
+    const StateVector current_mean(m_mean);
+    SigmaPoints points;
+
+    points.setCol(0, current_mean); // First sigma point is the current mean with no deviation
+    const StateMatrix sqtCovariance = cholesky(covarianceSigmaWeight() * StateMatrix(m_covariance));
+
+    for(unsigned int i = 1; i < NUM_STATES + 1; i++){
+        int negIndex = i+NUM_STATES;
+        const StateVector deviation = sqtCovariance.getCol(i - 1);      // Get deviation from weighted covariance
+        points.setCol(i, (current_mean + deviation));                   // Add mean + deviation
+        points.setCol(negIndex, (current_mean - deviation));            // Add mean - deviation
+    }
+    return points;
+}
+
+/*!
+ * @brief Calculate the mean from a set of sigma points.
+ * @param sigmaPoints The sigma points.
+ * @return The mean of the given sigma points.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+template <unsigned int ROWS>
+FixedMatrix<ROWS,1> UKF<NUM_STATES, NUM_MEASUREMENTS>::CalculateMeanFromSigmas(const FixedMatrix<ROWS,NUM_SIGMA_POINTS>& sigmaPoints) const
+{
+    return sigmaPoints * m_mean_weights.transp();
+}
+
+/*!
+ * @brief Calculate the mean from a set of sigma points, given the mean of these points.
+ * @param sigmaPoints The sigma points.
+ * @param mean The mean of the sigma points.
+ * @return The covariance of the given sigma points.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+typename UKF<NUM_STATES, NUM_MEASUREMENTS>::StateMatrix UKF<NUM_STATES, NUM_MEASUREMENTS>::CalculateCovarianceFromSigmas(const SigmaPoints& sigmaPoints, const StateVector& mean) const
+{
+    StateMatrix covariance;  // Blank covariance matrix.
+    for(unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
+    {
+        const double weight = m_covariance_weights[0][i];
+        const StateVector diff = sigmaPoints.getCol(i) - mean;
+        covariance += weight*diff*diff.transp();
+    }
+    return covariance;
+}
+
+/*!
+ * @brief Sets the mean and covariance of the filter. Like Moment::setMean and Moment::setCovariance,
+ *        a mean or covariance containing a NaN is ignored.
+ * @param newMean The new mean, which is passed through constrainMean first.
+ * @param newCovariance The new covariance.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+void UKF<NUM_STATES, NUM_MEASUREMENTS>::setState(StateVector newMean, const StateMatrix& newCovariance)
+{
+    constrainMean(newMean);
+    assert(newMean.isValid());
+    assert(newCovariance.isValid());
+    if(newMean.isValid())
+        newMean.copyTo(m_mean);
+    if(newCovariance.isValid())
+        newCovariance.copyTo(m_covariance);
+}
+
+/*!
+ * @brief Performs the time update of the filter.
+ * @param deltaT The time that has passed since the previous update.
+ * @param measurement The measurement/s (if any) that can be used to measure a change in the system.
+ * @param linearProcessNoise The linear process noise that will be added.
+ * @return True if the time update was performed successfully. False if it was not.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+bool UKF<NUM_STATES, NUM_MEASUREMENTS>::timeUpdate(double deltaT, const Matrix& measurement, const StateMatrix& linearProcessNoise)
+{
+    // Calculate the current sigma points, and write to member variable.
+    m_sigma_points = GenerateSigmaPoints();
+
+    // update each sigma point.
+    for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
+    {
+        // Write the propagated version of each sigma point.
+        m_sigma_points.setCol(i, processEquation(m_sigma_points.getCol(i), deltaT, measurement));
+    }
+
+    // Calculate the new mean and covariance values.
+    const StateVector predictedMean = CalculateMeanFromSigmas(m_sigma_points);
+    const StateMatrix predictedCovariance = CalculateCovarianceFromSigmas(m_sigma_points, predictedMean) + linearProcessNoise;
+
+    // Set the new mean and covariance values.
+    m_sigma_mean = predictedMean;
+    setState(predictedMean, predictedCovariance);
+
+    // Redraw sigma point to include process noise.
+    m_sigma_points = GenerateSigmaPoints();
+
+    return true;
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+bool UKF<NUM_STATES, NUM_MEASUREMENTS>::timeUpdate(double deltaT, const Matrix& measurement, const Matrix& linearProcessNoise, const Matrix& measurementNoise)
+{
+    return timeUpdate(deltaT, measurement, StateMatrix(linearProcessNoise));
+}
+
+/*!
+ * @brief Performs the measurement update of the filter.
+ * @param measurement The measurement to be used for the update.
+ * @param measurementNoise The linear measurement noise that will be added.
+ * @param measurementArgs Any additional information about the measurement, if required.
+ * @return True if the measurement update was performed successfully. False if it was not.
+ */
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+bool UKF<NUM_STATES, NUM_MEASUREMENTS>::measurementUpdate(const MeasurementVector& measurement, const MeasurementMatrix& measurementNoise, const Matrix& measurementArgs)
+{
+    MeasurementSigmaPoints Yprop;
+
+    // First step is to calculate the expected measurmenent for each sigma point.
+    for (unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
+    {
+        Yprop.setCol(i, measurementEquation(m_sigma_points.getCol(i), measurementArgs));
+    }
+
+    // Now calculate the mean of these measurement sigmas.
+    const MeasurementVector Ymean = CalculateMeanFromSigmas(Yprop);
+
+    MeasurementMatrix Pyy(measurementNoise);   // measurement noise is added, so just use as the beginning value of the sum.
+    Gain Pxy;
+
+    // Calculate the Pyy and Pxy variance matrices.
+    for(unsigned int i = 0; i < NUM_SIGMA_POINTS; ++i)
+    {
+        const double weight = m_covariance_weights[0][i];
+        // store difference between prediction and measurement.
+        const MeasurementVector currentPoint = Yprop.getCol(i) - Ymean;
+        // Innovation covariance - Add Measurement noise
+        Pyy += weight * currentPoint * currentPoint.transp();
+        // Cross correlation matrix
+        Pxy += weight * (m_sigma_points.getCol(i) - m_sigma_mean) * currentPoint.transp();    // Important: Use mean from estimate, not current mean.
+    }
+
+    // Calculate the Kalman filter gain. A 2 dimensional measurement uses the faster Invert22.
+    const Gain K = Pxy * InverseMatrix(Pyy);
+
+    setState(StateVector(m_mean) + K * (measurement - Ymean), StateMatrix(m_covariance) - K*Pyy*K.transp());
+    return true;
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+bool UKF<NUM_STATES, NUM_MEASUREMENTS>::measurementUpdate(const Matrix& measurement, const Matrix& measurementNoise, const Matrix& measurementArgs)
+{
+    assert(measurement.getm() == NUM_MEASUREMENTS);
+    if(measurement.getm() != NUM_MEASUREMENTS)
+        return false;
+    return measurementUpdate(MeasurementVector(measurement), MeasurementMatrix(measurementNoise), measurementArgs);
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+bool UKF<NUM_STATES, NUM_MEASUREMENTS>::operator ==(const UKF& b) const
+{
+    // Check Moment portions are equal
+    const Moment* this_moment = this;
+    const Moment* other_moment = &b;
+    if(*this_moment != *other_moment)
+    {
+        return false;
+    }
+
+    // Check UnscentedTransform portions are equal
+    const UnscentedTransform* this_ut = this;
+    const UnscentedTransform* other_ut = &b;
+    if(*this_ut != *other_ut)
+    {
+        return false;
+    }
+
+    // Check other memebr variables.
+   if(m_mean_weights != b.m_mean_weights) return false;
+   if(m_covariance_weights != b.m_covariance_weights) return false;
+   if(m_sigma_points != b.m_sigma_points) return false;
+   if(m_sigma_mean != b.m_sigma_mean) return false;
+    return true;
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+std::ostream& UKF<NUM_STATES, NUM_MEASUREMENTS>::writeStreamBinary (std::ostream& output) const
+{
+    UnscentedTransform::writeStreamBinary(output);
+    Moment::writeStreamBinary(output);
+    WriteMatrix(output, m_sigma_points);
+    return output;
+}
+
+template <unsigned int NUM_STATES, unsigned int NUM_MEASUREMENTS>
+std::istream& UKF<NUM_STATES, NUM_MEASUREMENTS>::readStreamBinary (std::istream& input)
+{
+    UnscentedTransform::readStreamBinary(input);
+    Moment::readStreamBinary(input);
+    CalculateWeights();
+
+    Matrix sigma_points = ReadMatrix(input);
+    // make sure that the sigma points are the right size
+    if((sigma_points.getm() == NUM_STATES) and (sigma_points.getn() == NUM_SIGMA_POINTS))
+    {
+        m_sigma_points = sigma_points;
+        m_sigma_mean = CalculateMeanFromSigmas(m_sigma_points);
+    }
+    return input;
+}
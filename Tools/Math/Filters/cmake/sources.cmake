@@ -22,7 +22,7 @@ ENDIF()
 ########## List your source files here! ############################################
 SET (YOUR_SRCS
 MobileObjectUKF.cpp MobileObjectUKF.h
-UKF.cpp UKF.h
+UKF.h
 UnscentedTransform.h
 )
 ####################################################################################
@@ -0,0 +1,378 @@
+/*! @file FixedMatrix.h
+ @brief Declaration and implementation of the FixedMatrix class
+
+ @class FixedMatrix
+ @brief A matrix whose size is fixed at compile time, so that its elements can live on the stack.
+
+ The interface follows Matrix; elements are accessed with [row][col], and the usual arithmetic,
+ transp(), getCol(), setCol(), cholesky(), Invert22(), HT() and InverseMatrix() are provided.
+ Because the sizes are template parameters, the loops have constant bounds which the compiler
+ unrolls for the small matrices used in the filters, and no operation ever calls new.
+
+ A FixedMatrix converts to a Matrix, and can be assigned from a Matrix of the same size, so that
+ it can be used where the rest of the code still expects a Matrix. Each conversion to a Matrix
+ allocates, so keep conversions out of the inner loops.
+
+ This file is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This file is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FIXED_MATRIX_H
+#define FIXED_MATRIX_H
+
+#include "Matrix.h"
+#include <assert.h>
+#include <math.h>
+
+template <unsigned int M, unsigned int N>
+class FixedMatrix
+{
+public:
+    /*! @brief Creates a matrix of zeros, or the identity if I is true and the matrix is square. */
+    explicit FixedMatrix(bool I = false)
+    {
+        for (unsigned int i = 0; i < M*N; ++i)
+            X[i] = 0.0;
+        if (I && M == N)
+        {
+            for (unsigned int i = 0; i < M; ++i)
+                X[i*N + i] = 1.0;
+        }
+    }
+
+    /*! @brief Copies a Matrix, which must be M by N. */
+    explicit FixedMatrix(const Matrix& a)
+    {
+        *this = a;
+    }
+
+    FixedMatrix& operator= (const Matrix& a)
+    {
+        assert(a.getm() == static_cast<int>(M) && a.getn() == static_cast<int>(N));
+        const double* source = a.getx();
+        for (unsigned int i = 0; i < M*N; ++i)
+            X[i] = source[i];
+        return *this;
+    }
+
+    /*! @brief Converts to a Matrix. This allocates. */
+    operator Matrix() const
+    {
+        Matrix result(M, N, false);
+        copyTo(result);
+        return result;
+    }
+
+    /*! @brief Copies into a Matrix. This only allocates if the Matrix is not already M by N. */
+    void copyTo(Matrix& a) const
+    {
+        if (a.getm() != static_cast<int>(M) || a.getn() != static_cast<int>(N))
+            a = Matrix(M, N, false);
+        double* destination = a.getx();
+        for (unsigned int i = 0; i < M*N; ++i)
+            destination[i] = X[i];
+    }
+
+    int getm() const {return M;}
+    int getn() const {return N;}
+    double* getx() {return X;}
+    const double* getx() const {return X;}
+
+    inline double* operator[] (unsigned int i) {return &X[i*N];}
+    inline const double* operator[] (unsigned int i) const {return &X[i*N];}
+
+    FixedMatrix<N,M> transp() const
+    {
+        FixedMatrix<N,M> result;
+        for (unsigned int i = 0; i < M; ++i)
+            for (unsigned int j = 0; j < N; ++j)
+                result[j][i] = X[i*N + j];
+        return result;
+    }
+
+    FixedMatrix<1,N> getRow(unsigned int index) const
+    {
+        FixedMatrix<1,N> result;
+        for (unsigned int j = 0; j < N; ++j)
+            result[0][j] = X[index*N + j];
+        return result;
+    }
+
+    FixedMatrix<M,1> getCol(unsigned int index) const
+    {
+        FixedMatrix<M,1> result;
+        for (unsigned int i = 0; i < M; ++i)
+            result[i][0] = X[i*N + index];
+        return result;
+    }
+
+    void setRow(unsigned int index, const FixedMatrix<1,N>& in)
+    {
+        for (unsigned int j = 0; j < N; ++j)
+            X[index*N + j] = in[0][j];
+    }
+
+    void setCol(unsigned int index, const FixedMatrix<M,1>& in)
+    {
+        for (unsigned int i = 0; i < M; ++i)
+            X[i*N + index] = in[i][0];
+    }
+
+    FixedMatrix& operator+= (const FixedMatrix& a)
+    {
+        for (unsigned int i = 0; i < M*N; ++i)
+            X[i] += a.X[i];
+        return *this;
+    }
+
+    FixedMatrix& operator-= (const FixedMatrix& a)
+    {
+        for (unsigned int i = 0; i < M*N; ++i)
+            X[i] -= a.X[i];
+        return *this;
+    }
+
+    FixedMatrix& operator*= (double a)
+    {
+        for (unsigned int i = 0; i < M*N; ++i)
+            X[i] *= a;
+        return *this;
+    }
+
+    /*! @brief Returns false if any element is NaN. */
+    bool isValid() const
+    {
+        for (unsigned int i = 0; i < M*N; ++i)
+            if (X[i] != X[i])
+                return false;
+        return true;
+    }
+
+    bool operator ==(const FixedMatrix& b) const
+    {
+        for (unsigned int i = 0; i < M*N; ++i)
+            if (X[i] != b.X[i])
+                return false;
+        return true;
+    }
+    bool operator !=(const FixedMatrix& b) const {return (!((*this) == b));}
+
+private:
+    double X[M*N];          //!< the elements, stored row by row like Matrix
+};
+
+// Overloaded Operators
+template <unsigned int M, unsigned int N>
+inline FixedMatrix<M,N> operator + (const FixedMatrix<M,N>& a, const FixedMatrix<M,N>& b)
+{
+    FixedMatrix<M,N> result(a);
+    result += b;
+    return result;
+}
+
+template <unsigned int M, unsigned int N>
+inline FixedMatrix<M,N> operator - (const FixedMatrix<M,N>& a, const FixedMatrix<M,N>& b)
+{
+    FixedMatrix<M,N> result(a);
+    result -= b;
+    return result;
+}
+
+template <unsigned int M, unsigned int K, unsigned int N>
+inline FixedMatrix<M,N> operator * (const FixedMatrix<M,K>& a, const FixedMatrix<K,N>& b)
+{
+    FixedMatrix<M,N> result;
+    for (unsigned int i = 0; i < M; ++i)
+    {
+        for (unsigned int j = 0; j < N; ++j)
+        {
+            double sum = 0;
+            for (unsigned int k = 0; k < K; ++k)
+                sum += a[i][k]*b[k][j];
+            result[i][j] = sum;
+        }
+    }
+    return result;
+}
+
+template <unsigned int M, unsigned int N>
+inline FixedMatrix<M,N> operator * (double a, const FixedMatrix<M,N>& b)
+{
+    FixedMatrix<M,N> result(b);
+    result *= a;
+    return result;
+}
+
+template <unsigned int M, unsigned int N>
+inline FixedMatrix<M,N> operator * (const FixedMatrix<M,N>& a, double b)
+{
+    FixedMatrix<M,N> result(a);
+    result *= b;
+    return result;
+}
+
+template <unsigned int M, unsigned int N>
+inline FixedMatrix<M,N> operator / (const FixedMatrix<M,N>& a, double b)
+{
+    FixedMatrix<M,N> result;
+    for (unsigned int i = 0; i < M; ++i)
+        for (unsigned int j = 0; j < N; ++j)
+            result[i][j] = a[i][j]/b;
+    return result;
+}
+
+// Convert 1x1 matrix to Double
+inline double convDble(const FixedMatrix<1,1>& a) {return a[0][0];}
+
+// 2x2 Matrix Inversion
+inline FixedMatrix<2,2> Invert22(const FixedMatrix<2,2>& a)
+{
+    FixedMatrix<2,2> result;
+    const double divisor = a[0][0]*a[1][1] - a[0][1]*a[1][0];
+    result[0][0] = a[1][1]/divisor;
+    result[0][1] = -a[0][1]/divisor;
+    result[1][0] = -a[1][0]/divisor;
+    result[1][1] = a[0][0]/divisor;
+    return result;
+}
+
+/*! @brief Inverts a square matrix with Gauss-Jordan elimination and partial pivoting. */
+template <unsigned int N>
+FixedMatrix<N,N> InverseMatrix(const FixedMatrix<N,N>& mat)
+{
+    FixedMatrix<N,N> A(mat);
+    FixedMatrix<N,N> result(true);
+    for (unsigned int k = 0; k < N; ++k)
+    {
+        // find max pivot.
+        unsigned int i_max = k;
+        for (unsigned int i = k+1; i < N; ++i)
+            if (fabs(A[i_max][k]) < fabs(A[i][k]))
+                i_max = i;
+        if (i_max != k)
+        {
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                double temp = A[k][j]; A[k][j] = A[i_max][j]; A[i_max][j] = temp;
+                temp = result[k][j]; result[k][j] = result[i_max][j]; result[i_max][j] = temp;
+            }
+        }
+        const double pivot = 1.0/A[k][k];
+        for (unsigned int j = 0; j < N; ++j)
+        {
+            A[k][j] *= pivot;
+            result[k][j] *= pivot;
+        }
+        for (unsigned int i = 0; i < N; ++i)
+        {
+            if (i == k)
+                continue;
+            const double C = A[i][k];
+            for (unsigned int j = 0; j < N; ++j)
+            {
+                A[i][j] -= C*A[k][j];
+                result[i][j] -= C*result[k][j];
+            }
+        }
+    }
+    return result;
+}
+
+inline FixedMatrix<1,1> InverseMatrix(const FixedMatrix<1,1>& mat)
+{
+    FixedMatrix<1,1> result;
+    result[0][0] = 1.0/mat[0][0];
+    return result;
+}
+
+inline FixedMatrix<2,2> InverseMatrix(const FixedMatrix<2,2>& mat)
+{
+    return Invert22(mat);
+}
+
+/*! @brief The lower triangular cholesky factor L of P, where P = L*L'. */
+template <unsigned int N>
+FixedMatrix<N,N> cholesky(const FixedMatrix<N,N>& P)
+{
+    FixedMatrix<N,N> L;
+    for (unsigned int i = 0; i < N; ++i)
+    {
+        for (unsigned int j = 0; j < i; ++j)
+        {
+            double a = P[i][j];
+            for (unsigned int k = 0; k < j; ++k)
+                a -= L[i][k]*L[j][k];
+            L[i][j] = a/L[j][j];
+        }
+        double a = P[i][i];
+        for (unsigned int k = 0; k < i; ++k)
+            a -= L[i][k]*L[i][k];
+        L[i][i] = sqrt(a);
+    }
+    return L;
+}
+
+// concatenation
+template <unsigned int M, unsigned int N1, unsigned int N2>
+FixedMatrix<M,N1+N2> horzcat(const FixedMatrix<M,N1>& a, const FixedMatrix<M,N2>& b)
+{
+    FixedMatrix<M,N1+N2> result;
+    for (unsigned int i = 0; i < M; ++i)
+    {
+        for (unsigned int j = 0; j < N1; ++j)
+            result[i][j] = a[i][j];
+        for (unsigned int j = 0; j < N2; ++j)
+            result[i][N1 + j] = b[i][j];
+    }
+    return result;
+}
+
+/*! @brief Householder triangularisation of a wide matrix A, giving the square B with B*B' = A*A'.
+    This is the same algorithm as HT(Matrix), working on a copy of A on the stack.
+ */
+template <unsigned int M, unsigned int N>
+FixedMatrix<M,M> HT(FixedMatrix<M,N> A)
+{
+    const unsigned int r = N - M;
+    double v[N];
+    for (int k = M-1; k >= 0; k--)
+    {
+        double sigma = 0.0;
+        for (unsigned int j = 0; j <= r+k; j++)
+            sigma += A[k][j]*A[k][j];
+        double a = sqrt(sigma);
+        sigma = 0.0;
+        for (unsigned int j = 0; j <= r+k; j++)
+        {
+            v[j] = (j == r+k) ? A[k][j] - a : A[k][j];
+            sigma += v[j]*v[j];
+        }
+        a = 2.0/(sigma + 1e-15);
+        for (int i = 0; i <= k; i++)
+        {
+            sigma = 0.0;
+            for (unsigned int j = 0; j <= r+k; j++)
+                sigma += A[i][j]*v[j];
+            const double b = a*sigma;
+            for (unsigned int j = 0; j <= r+k; j++)
+                A[i][j] -= b*v[j];
+        }
+    }
+    FixedMatrix<M,M> B;
+    for (unsigned int i = 0; i < M; i++)
+        for (unsigned int j = 0; j < M; j++)
+            B[i][j] = A[i][r + j];
+    return B;
+}
+
+#endif
@@ -206,11 +206,15 @@ Matrix	operator / (const Matrix& a, const double& b)
 // Matrix Equality
 Matrix& Matrix::operator =  (const Matrix& a)
 {
-	if (X!=0)
+	if (this == &a)
+		return *this;
+	if (X==0 || M*N!=a.M*a.N)
+	{	// only reallocate when the number of elements changes
 		delete [] X;
+		X=new double [a.M*a.N];
+	}
 	M=a.M;
 	N=a.N;
-	X=new double [M*N];
 	memcpy(X,a.X,sizeof(double)*M*N);
 	return *this;
 }
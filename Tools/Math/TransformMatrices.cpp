@@ -132,3 +132,39 @@ Matrix TransformMatrices::ModifiedDH(const DHParameters& parameters, double thet
     result[3][3] = 1.0;
     return result;
 }
+
+/*! @brief Multiplies two homogeneous transforms, result = a*b.
+
+    The bottom row of both transforms must be [0 0 0 1], so only the top three rows are multiplied.
+    The result is the same as a*b with Matrix, since the skipped terms are all exactly zero.
+    @param result must not be a or b
+ */
+void TransformMatrices::MultiplyTransforms(const FixedMatrix<4,4>& a, const FixedMatrix<4,4>& b, FixedMatrix<4,4>& result)
+{
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        const double* row = a[i];
+        for (unsigned int j = 0; j < 3; ++j)
+            result[i][j] = row[0]*b[0][j] + row[1]*b[1][j] + row[2]*b[2][j];
+        result[i][3] = row[0]*b[0][3] + row[1]*b[1][3] + row[2]*b[2][3] + row[3];
+    }
+    result[3][0] = 0.0;
+    result[3][1] = 0.0;
+    result[3][2] = 0.0;
+    result[3][3] = 1.0;
+}
+
+/*! @brief Inverts a homogeneous transform made of a rotation and a translation, using R' and -R'*t.
+ */
+FixedMatrix<4,4> TransformMatrices::InverseTransform(const FixedMatrix<4,4>& transform)
+{
+    FixedMatrix<4,4> result;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+        for (unsigned int j = 0; j < 3; ++j)
+            result[i][j] = transform[j][i];
+        result[i][3] = -(transform[0][i]*transform[0][3] + transform[1][i]*transform[1][3] + transform[2][i]*transform[2][3]);
+    }
+    result[3][3] = 1.0;
+    return result;
+}
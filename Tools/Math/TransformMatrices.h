@@ -2,6 +2,7 @@
 #define TRANSFORM_MATRICIES_H
 
 #include "Matrix.h"
+#include "FixedMatrix.h"
 
 namespace TransformMatrices
 {
@@ -20,6 +21,10 @@ struct DHParameters
 
 Matrix ModifiedDH(double alpha, double a, double theta, double d);
 Matrix ModifiedDH(const DHParameters& paramteters, double theta);
+
+// Fixed size versions of the above for the homogeneous transforms of the kinematic chains; these never allocate.
+void MultiplyTransforms(const FixedMatrix<4,4>& a, const FixedMatrix<4,4>& b, FixedMatrix<4,4>& result);
+FixedMatrix<4,4> InverseTransform(const FixedMatrix<4,4>& transform);
 }
 
 #endif // TRANSFORM_MATRICIES_H
@@ -25,6 +25,7 @@ Line.cpp
 Circle.cpp
 LSFittedLine.cpp
 Matrix.cpp  
+FixedMatrix.h
 TransformMatrices.cpp
 depUKF.cpp
 Rectangle.cpp
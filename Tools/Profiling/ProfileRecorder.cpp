@@ -0,0 +1,418 @@
+/*! @file ProfileRecorder.cpp
+    @brief Implementation of the ProfileRecorder, ProfileScope and ProfileSummary classes
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "ProfileRecorder.h"
+#include "Tools/Threading/SPSCRing.h"
+
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+const unsigned int ProfileRecorder::c_max_modules;
+const unsigned int ProfileRecorder::c_max_threads;
+const unsigned int ProfileRecorder::c_ring_size;
+const unsigned int ProfileRecorder::c_trace_size;
+
+//! A single timed section
+struct ProfileEvent
+{
+    unsigned short Module;
+    unsigned short Thread;
+    uint64_t Start;
+    uint64_t End;
+};
+
+//! The events recorded by a single thread. Only that thread pushes, and only collect() pops.
+struct ProfileThreadBuffer
+{
+    SPSCRing<ProfileEvent, ProfileRecorder::c_ring_size> Events;
+    volatile unsigned int Dropped;
+};
+
+// The histogram buckets are exact below 16ns, and then eight to an octave up to 2^40ns
+static const unsigned int c_exact_buckets = 16;
+static const unsigned int c_sub_buckets = 8;
+static const unsigned int c_num_buckets = c_exact_buckets + (40 - 4)*c_sub_buckets;
+
+//! The times of a module, in the current and previous windows
+struct ProfileHistogram
+{
+    unsigned int Counts[2][c_num_buckets];
+    unsigned int Total[2];
+    uint64_t Max[2];
+};
+
+//! The state shared by all threads. Registration is protected by a spin lock, collecting by another.
+static struct ProfileState
+{
+    volatile int RegisterLock;
+    volatile int CollectLock;
+
+    std::string Names[ProfileRecorder::c_max_modules];
+    volatile unsigned int NumModules;               //!< the number of modules registered, only written after the name is set
+
+    ProfileThreadBuffer* Threads[ProfileRecorder::c_max_threads];
+    volatile unsigned int NumThreads;               //!< the number of threads registered, only written after the buffer is set
+    volatile unsigned int Generation;               //!< the number of times the buffers have been released
+
+    ProfileHistogram Histograms[ProfileRecorder::c_max_modules];
+    unsigned int Window;                            //!< the index of the current window in the histograms
+
+    ProfileEvent Trace[ProfileRecorder::c_trace_size];
+    unsigned int TraceCount;                        //!< the number of events ever added to the trace
+
+    uint64_t StartTicks;                            //!< the ticks when the first module was registered
+    uint64_t StartNanoseconds;                      //!< the monotonic time when the first module was registered
+    double NanosecondsPerTick;
+} s_state;
+
+static __thread ProfileThreadBuffer* t_buffer = 0;
+static __thread unsigned int t_generation = 0;      //!< one more than the Generation the thread registered in, 0 if it has not
+
+static void lock(volatile int& spin_lock)
+{
+    while (__sync_lock_test_and_set(&spin_lock, 1))
+        while (spin_lock)
+            ;
+}
+
+static void unlock(volatile int& spin_lock)
+{
+    __sync_lock_release(&spin_lock);
+}
+
+static uint64_t monotonicNanoseconds()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<uint64_t>(t.tv_sec)*1000000000ull + t.tv_nsec;
+}
+
+/*! @brief Measures the length of a tick. With rdtsc this spins for 10ms the first time a module is registered */
+static void calibrate()
+{
+    s_state.StartNanoseconds = monotonicNanoseconds();
+    s_state.StartTicks = ProfileRecorder::now();
+#if defined(__i386__) || defined(__x86_64__)
+    uint64_t nanoseconds;
+    do
+        nanoseconds = monotonicNanoseconds();
+    while (nanoseconds - s_state.StartNanoseconds < 10000000);
+    s_state.NanosecondsPerTick = static_cast<double>(nanoseconds - s_state.StartNanoseconds)/(ProfileRecorder::now() - s_state.StartTicks);
+#else
+    s_state.NanosecondsPerTick = 1;
+#endif
+}
+
+/*! @brief Returns the index of the histogram bucket for a time in nanoseconds */
+static inline unsigned int bucket(uint64_t nanoseconds)
+{
+    if (nanoseconds < c_exact_buckets)
+        return nanoseconds;
+    unsigned int octave = 63 - __builtin_clzll(nanoseconds);
+    unsigned int index = c_exact_buckets + (octave - 4)*c_sub_buckets + ((nanoseconds >> (octave - 3)) & (c_sub_buckets - 1));
+    return index < c_num_buckets ? index : c_num_buckets - 1;
+}
+
+/*! @brief Returns the largest time in nanoseconds that falls in a bucket */
+static inline uint64_t bucketLimit(unsigned int index)
+{
+    if (index < c_exact_buckets)
+        return index;
+    unsigned int octave = (index - c_exact_buckets)/c_sub_buckets + 4;
+    uint64_t sub = (index - c_exact_buckets) % c_sub_buckets;
+    return ((c_sub_buckets + sub + 1) << (octave - 3)) - 1;
+}
+
+/*! @brief Registers a module and returns its id. Registering a name twice returns the same id.
+
+    This can be called from any thread, but it searches the names so keep the id rather than calling it for each event.
+    @param name the name of the module, as it will appear in the summary and the trace
+    @return the id of the module, or c_max_modules - 1 if there are too many modules
+ */
+unsigned int ProfileRecorder::module(const std::string& name)
+{
+    lock(s_state.RegisterLock);
+    if (s_state.NumModules == 0)
+        calibrate();
+    unsigned int id = 0;
+    while (id < s_state.NumModules and s_state.Names[id] != name)
+        id++;
+    if (id == s_state.NumModules)
+    {
+        if (id < c_max_modules - 1)
+        {
+            s_state.Names[id] = name;
+            __sync_synchronize();
+            s_state.NumModules = id + 1;
+        }
+        else
+        {   // the last module collects everything that did not fit
+            id = c_max_modules - 1;
+            if (s_state.NumModules < c_max_modules)
+            {
+                s_state.Names[id] = "Other";
+                __sync_synchronize();
+                s_state.NumModules = c_max_modules;
+            }
+        }
+    }
+    unlock(s_state.RegisterLock);
+    return id;
+}
+
+/*! @brief Gives the calling thread a ring buffer, the first time it records an event */
+static ProfileThreadBuffer* registerThread()
+{
+    lock(s_state.RegisterLock);
+    t_generation = s_state.Generation + 1;
+    t_buffer = 0;
+    if (s_state.NumThreads < ProfileRecorder::c_max_threads)
+    {
+        t_buffer = new ProfileThreadBuffer();
+        t_buffer->Dropped = 0;
+        s_state.Threads[s_state.NumThreads] = t_buffer;
+        __sync_synchronize();
+        s_state.NumThreads = s_state.NumThreads + 1;
+    }
+    unlock(s_state.RegisterLock);
+    return t_buffer;
+}
+
+/*! @brief Records a timed section against a module, without locking or allocating. Can be called from any thread.
+
+    The buffers of threads that have finished are kept until release(), so the events of short lived threads are not lost.
+    @param module the id of the module from module()
+    @param start the ticks from now() at the start of the section
+    @param end the ticks from now() at the end of the section
+ */
+void ProfileRecorder::record(unsigned int module, uint64_t start, uint64_t end)
+{
+    ProfileThreadBuffer* buffer = t_buffer;
+    if (t_generation != s_state.Generation + 1)
+        buffer = registerThread();
+    if (buffer == 0)
+        return;                 // there were too many threads
+
+    ProfileEvent event;
+    event.Module = module;
+    event.Thread = 0;
+    event.Start = start;
+    event.End = end;
+    if (not buffer->Events.push(event))
+        buffer->Dropped = buffer->Dropped + 1;
+}
+
+/*! @brief Moves the events of every thread into the histograms and the trace. Only one thread collects at a time. */
+void ProfileRecorder::collect()
+{
+    lock(s_state.CollectLock);
+    const unsigned int num_threads = s_state.NumThreads;
+    __sync_synchronize();
+    const double scale = s_state.NanosecondsPerTick;
+    const unsigned int window = s_state.Window;
+    ProfileEvent event;
+    for (unsigned int t=0; t<num_threads; t++)
+    {
+        SPSCRing<ProfileEvent, c_ring_size>& events = s_state.Threads[t]->Events;
+        while (events.pop(event))
+        {
+            if (event.Module >= c_max_modules)
+                continue;
+            event.Thread = t + 1;
+            uint64_t nanoseconds = event.End > event.Start ? static_cast<uint64_t>((event.End - event.Start)*scale) : 0;
+            ProfileHistogram& histogram = s_state.Histograms[event.Module];
+            histogram.Counts[window][bucket(nanoseconds)]++;
+            histogram.Total[window]++;
+            if (nanoseconds > histogram.Max[window])
+                histogram.Max[window] = nanoseconds;
+
+            s_state.Trace[s_state.TraceCount % c_trace_size] = event;
+            s_state.TraceCount++;
+        }
+    }
+    unlock(s_state.CollectLock);
+}
+
+/*! @brief Frees the ring buffer of every thread, eg. at shutdown. Events not yet collected are lost.
+
+    No thread may be recording while the buffers are freed. A thread that records afterwards is given a new buffer.
+    The histograms and the trace are kept, so summary() and writeChromeTrace() still report everything collected.
+ */
+void ProfileRecorder::release()
+{
+    lock(s_state.RegisterLock);
+    lock(s_state.CollectLock);
+    for (unsigned int t=0; t<s_state.NumThreads; t++)
+    {
+        delete s_state.Threads[t];
+        s_state.Threads[t] = 0;
+    }
+    s_state.NumThreads = 0;
+    s_state.Generation = s_state.Generation + 1;
+    unlock(s_state.CollectLock);
+    unlock(s_state.RegisterLock);
+}
+
+/*! @brief Starts a new window. The summary will cover the window just finished and the new one. */
+void ProfileRecorder::roll()
+{
+    lock(s_state.CollectLock);
+    const unsigned int window = 1 - s_state.Window;
+    for (unsigned int m=0; m<c_max_modules; m++)
+    {
+        ProfileHistogram& histogram = s_state.Histograms[m];
+        memset(histogram.Counts[window], 0, sizeof(histogram.Counts[window]));
+        histogram.Total[window] = 0;
+        histogram.Max[window] = 0;
+    }
+    s_state.Window = window;
+    unlock(s_state.CollectLock);
+}
+
+/*! @brief Returns the time in milliseconds below which a fraction of the events in both windows fall */
+static float percentile(const ProfileHistogram& histogram, unsigned int total, uint64_t max, double fraction)
+{
+    unsigned int target = static_cast<unsigned int>(fraction*total + 0.999);
+    if (target == 0)
+        target = 1;
+    unsigned int count = 0;
+    for (unsigned int b=0; b<c_num_buckets; b++)
+    {
+        count += histogram.Counts[0][b] + histogram.Counts[1][b];
+        if (count >= target)
+        {
+            uint64_t limit = bucketLimit(b);
+            return 1e-6*(limit < max ? limit : max);
+        }
+    }
+    return 1e-6*max;
+}
+
+/*! @brief Returns the percentiles of each module that has events in the current or the previous window */
+ProfileSummary ProfileRecorder::summary()
+{
+    ProfileSummary summary;
+    lock(s_state.CollectLock);
+    const unsigned int num_modules = s_state.NumModules;
+    __sync_synchronize();
+    for (unsigned int m=0; m<num_modules; m++)
+    {
+        const ProfileHistogram& histogram = s_state.Histograms[m];
+        unsigned int total = histogram.Total[0] + histogram.Total[1];
+        if (total == 0)
+            continue;
+        uint64_t max = histogram.Max[0] > histogram.Max[1] ? histogram.Max[0] : histogram.Max[1];
+
+        ProfileStatistics statistics;
+        statistics.Name = s_state.Names[m];
+        statistics.Count = total;
+        statistics.Median = percentile(histogram, total, max, 0.5);
+        statistics.P95 = percentile(histogram, total, max, 0.95);
+        statistics.P99 = percentile(histogram, total, max, 0.99);
+        statistics.Max = 1e-6*max;
+        summary.Modules.push_back(statistics);
+    }
+    const unsigned int num_threads = s_state.NumThreads;
+    __sync_synchronize();
+    for (unsigned int t=0; t<num_threads; t++)
+        summary.Dropped += s_state.Threads[t]->Dropped;
+    unlock(s_state.CollectLock);
+    return summary;
+}
+
+/*! @brief Writes a name as a json string */
+static void writeJsonString(std::ostream& output, const std::string& name)
+{
+    output << '"';
+    for (size_t i=0; i<name.size(); i++)
+    {
+        if (name[i] == '"' or name[i] == '\\')
+            output << '\\';
+        output << name[i];
+    }
+    output << '"';
+}
+
+/*! @brief Writes the most recent collected events in the Chrome trace event format.
+
+    Each event is a complete ("X") event with its start and duration in microseconds, on a thread numbered
+    in the order the threads first recorded an event. The times start at the oldest event in the trace.
+ */
+void ProfileRecorder::writeChromeTrace(std::ostream& output)
+{
+    lock(s_state.CollectLock);
+    const unsigned int count = s_state.TraceCount < c_trace_size ? s_state.TraceCount : c_trace_size;
+    const unsigned int first = s_state.TraceCount - count;
+    const double scale = 1e-3*s_state.NanosecondsPerTick;
+
+    uint64_t origin = count > 0 ? s_state.Trace[first % c_trace_size].Start : 0;
+    for (unsigned int i=0; i<count; i++)
+    {
+        const ProfileEvent& event = s_state.Trace[(first + i) % c_trace_size];
+        if (event.Start < origin)
+            origin = event.Start;
+    }
+
+    std::ios::fmtflags flags = output.flags();
+    std::streamsize precision = output.precision();
+    output << std::fixed << std::setprecision(3);
+    output << "{\"traceEvents\":[" << std::endl;
+    for (unsigned int i=0; i<count; i++)
+    {
+        const ProfileEvent& event = s_state.Trace[(first + i) % c_trace_size];
+        uint64_t duration = event.End > event.Start ? event.End - event.Start : 0;
+        output << "{\"name\":";
+        writeJsonString(output, s_state.Names[event.Module]);
+        output << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.Thread;
+        output << ",\"ts\":" << (event.Start - origin)*scale << ",\"dur\":" << duration*scale << "}";
+        output << (i + 1 < count ? "," : "") << std::endl;
+    }
+    output << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+    output.flags(flags);
+    output.precision(precision);
+    unlock(s_state.CollectLock);
+}
+
+/*! @brief Writes the summary as text, with one line per module; the count, the median, p95, p99 and max in ms, then the name */
+std::ostream& operator<<(std::ostream& output, const ProfileSummary& summary)
+{
+    output << summary.Modules.size() << " " << summary.Dropped << std::endl;
+    for (size_t i=0; i<summary.Modules.size(); i++)
+    {
+        const ProfileStatistics& statistics = summary.Modules[i];
+        output << statistics.Count << " " << statistics.Median << " " << statistics.P95 << " " << statistics.P99 << " " << statistics.Max << " " << statistics.Name << std::endl;
+    }
+    return output;
+}
+
+/*! @brief Reads a summary written by operator<< */
+std::istream& operator>>(std::istream& input, ProfileSummary& summary)
+{
+    size_t size = 0;
+    input >> size >> summary.Dropped;
+    summary.Modules.resize(size);
+    for (size_t i=0; i<size and input.good(); i++)
+    {
+        ProfileStatistics& statistics = summary.Modules[i];
+        input >> statistics.Count >> statistics.Median >> statistics.P95 >> statistics.P99 >> statistics.Max;
+        input >> std::ws;
+        std::getline(input, statistics.Name);
+    }
+    return input;
+}
+
@@ -0,0 +1,119 @@
+/*! @file ProfileRecorder.h
+    @brief Declaration of the ProfileRecorder, ProfileScope and ProfileSummary classes
+
+    @class ProfileRecorder
+    @brief Always on timing of named code sections on any thread, with percentiles and a Chrome trace
+
+    The Profiler is for a one off look at where the time goes in a single frame. The ProfileRecorder
+    is cheap enough to leave on in a match, so that the tail latency of each module can be seen:
+        - Each section is a module, registered once by name with module().
+        - A ProfileScope, or a pair of now() calls and record(), times a section. The event is pushed
+          onto a ring buffer belonging to the calling thread, so recording never locks or allocates.
+          If the ring is full the event is dropped and counted.
+        - collect() drains every thread's ring into a histogram for each module, and into a trace of
+          the most recent events. Call it regularly, eg. once per frame, from one thread.
+        - summary() gives the p50, p95, p99 and max of each module from the histograms. They cover
+          the current and the previous window, and roll() starts a new window.
+        - writeChromeTrace() writes the recent events as a Chrome trace (chrome://tracing or Perfetto).
+        - release() frees the threads' ring buffers once nothing is recording, eg. at shutdown.
+
+    Times are taken with rdtsc on x86, calibrated against CLOCK_MONOTONIC, and with clock_gettime
+    elsewhere. The histogram buckets are an eighth of an octave wide, so the percentiles are within
+    12.5% of the true values.
+
+    @class ProfileScope
+    @brief Records the time from its construction to its destruction against a module
+
+    @class ProfileSummary
+    @brief The percentiles of each module, which can be streamed like the other data NUView reads
+
+    This file is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    This file is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with NUbot.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef PROFILERECORDER_H
+#define PROFILERECORDER_H
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <stdint.h>
+#include <time.h>
+
+//! The statistics of a single module, in milliseconds
+struct ProfileStatistics
+{
+    std::string Name;               //!< the name of the module
+    unsigned int Count;             //!< the number of times the module was recorded in the window
+    float Median;                   //!< the 50th percentile
+    float P95;                      //!< the 95th percentile
+    float P99;                      //!< the 99th percentile
+    float Max;                      //!< the longest time
+};
+
+class ProfileSummary
+{
+public:
+    ProfileSummary() : Dropped(0) {}
+
+    std::vector<ProfileStatistics> Modules;     //!< the statistics of each module that has been recorded
+    unsigned int Dropped;                       //!< the number of events dropped because a thread's ring was full
+
+    friend std::ostream& operator<<(std::ostream& output, const ProfileSummary& summary);
+    friend std::istream& operator>>(std::istream& input, ProfileSummary& summary);
+};
+
+class ProfileRecorder
+{
+public:
+    static const unsigned int c_max_modules = 64;       //!< the most modules that can be registered
+    static const unsigned int c_max_threads = 32;       //!< the most threads that can record events
+    static const unsigned int c_ring_size = 1024;       //!< the events each thread can record between collects
+    static const unsigned int c_trace_size = 16384;     //!< the number of recent events kept for the trace
+
+    static unsigned int module(const std::string& name);
+    static void record(unsigned int module, uint64_t start, uint64_t end);
+
+    /*! @brief Returns the current time in ticks, only for use with record() */
+    static inline uint64_t now()
+    {
+#if defined(__i386__) || defined(__x86_64__)
+        unsigned int low, high;
+        __asm__ __volatile__("rdtsc" : "=a"(low), "=d"(high));
+        return (static_cast<uint64_t>(high) << 32) | low;
+#else
+        timespec t;
+        clock_gettime(CLOCK_MONOTONIC, &t);
+        return static_cast<uint64_t>(t.tv_sec)*1000000000ull + t.tv_nsec;
+#endif
+    }
+
+    static void collect();
+    static void roll();
+    static ProfileSummary summary();
+    static void writeChromeTrace(std::ostream& output);
+    static void release();
+};
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(unsigned int module) : m_module(module), m_start(ProfileRecorder::now()) {}
+    ~ProfileScope() {ProfileRecorder::record(m_module, m_start, ProfileRecorder::now());}
+private:
+    unsigned int m_module;
+    uint64_t m_start;
+};
+
+#endif
+
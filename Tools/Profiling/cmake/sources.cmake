@@ -21,6 +21,7 @@ ENDIF()
 
 ########## List your source files here! ############################################
 SET (YOUR_SRCS  Profiler.cpp Profiler.h
+               ProfileRecorder.cpp ProfileRecorder.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
@@ -0,0 +1,164 @@
+/*! @file EventCount.h
+    @brief Declaration and implementation of the EventCount class.
+
+    @class EventCount
+    @brief Lets a thread sleep until a lock-free structure it is polling changes.
+
+    The waiting side is:
+    @code
+    while (!ring.pop(item))
+    {
+        unsigned int key = event.prepareWait();
+        if (ring.pop(item))
+        {
+            event.cancelWait();
+            break;
+        }
+        event.wait(key);
+    }
+    @endcode
+    and the notifying side calls notify() after each change. notify() is a single barrier and
+    a load when nobody is waiting; the kernel is only entered once to wake sleeping threads.
+
+    On Linux waiting is done directly on a futex, elsewhere a mutex and condition are used.
+    A thread that must also wake up periodically, to do housekeeping, can wait with a timeout.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef EVENT_COUNT_H_DEFINED
+#define EVENT_COUNT_H_DEFINED
+
+#ifdef __linux__
+    #include <unistd.h>
+    #include <sys/syscall.h>
+    #include <linux/futex.h>
+    #include <limits.h>
+    #ifndef FUTEX_WAIT_PRIVATE
+        #define FUTEX_WAIT_PRIVATE FUTEX_WAIT
+        #define FUTEX_WAKE_PRIVATE FUTEX_WAKE
+    #endif
+#else
+    #include <pthread.h>
+    #include <sys/time.h>
+#endif
+#include <time.h>
+
+class EventCount
+{
+    public:
+        EventCount() : m_epoch(0), m_waiters(0), m_signalled(0)
+        {
+            #ifndef __linux__
+                pthread_mutex_init(&m_mutex, NULL);
+                pthread_cond_init(&m_condition, NULL);
+            #endif
+        };
+
+        ~EventCount()
+        {
+            #ifndef __linux__
+                pthread_cond_destroy(&m_condition);
+                pthread_mutex_destroy(&m_mutex);
+            #endif
+        };
+
+        /*! @brief Registers the calling thread as about to wait. The condition must be checked again before calling wait().
+            @return the key to pass to wait()
+         */
+        unsigned int prepareWait()
+        {
+            __sync_fetch_and_add(&m_waiters, 1);
+            __sync_fetch_and_and(&m_signalled, 0);          // full barrier, so the re-check can not be moved before this
+            return m_epoch;
+        }
+
+        /*! @brief Unregisters the calling thread, when the re-check after prepareWait() succeeded */
+        void cancelWait()
+        {
+            __sync_fetch_and_sub(&m_waiters, 1);
+        }
+
+        /*! @brief Sleeps until notify() is called after prepareWait() returned key. This may return early. */
+        void wait(unsigned int key)
+        {
+            #ifdef __linux__
+                syscall(SYS_futex, &m_epoch, FUTEX_WAIT_PRIVATE, key, NULL, NULL, 0);
+            #else
+                pthread_mutex_lock(&m_mutex);
+                while (static_cast<unsigned int>(m_epoch) == key)
+                    pthread_cond_wait(&m_condition, &m_mutex);
+                pthread_mutex_unlock(&m_mutex);
+            #endif
+            __sync_fetch_and_sub(&m_waiters, 1);
+        }
+
+        /*! @brief Sleeps until notify() is called after prepareWait() returned key, or until timeout_ms has passed.
+            This may return early.
+         */
+        void wait(unsigned int key, unsigned int timeout_ms)
+        {
+            #ifdef __linux__
+                timespec timeout;
+                timeout.tv_sec = timeout_ms/1000;
+                timeout.tv_nsec = (timeout_ms%1000)*1000000;
+                syscall(SYS_futex, &m_epoch, FUTEX_WAIT_PRIVATE, key, &timeout, NULL, 0);
+            #else
+                timeval now;
+                gettimeofday(&now, NULL);
+                long nanoseconds = now.tv_usec*1000 + (timeout_ms%1000)*1000000L;
+                timespec deadline;
+                deadline.tv_sec = now.tv_sec + timeout_ms/1000 + nanoseconds/1000000000L;
+                deadline.tv_nsec = nanoseconds%1000000000L;
+                pthread_mutex_lock(&m_mutex);
+                int err = 0;
+                while (static_cast<unsigned int>(m_epoch) == key && err == 0)
+                    err = pthread_cond_timedwait(&m_condition, &m_mutex, &deadline);
+                pthread_mutex_unlock(&m_mutex);
+            #endif
+            __sync_fetch_and_sub(&m_waiters, 1);
+        }
+
+        /*! @brief Wakes every waiting thread. Call this after making the change the waiters are polling for.
+
+            Only the first notify() after a prepareWait() wakes anything, the rest return without a system
+            call while the woken threads are still being scheduled.
+         */
+        void notify()
+        {
+            __sync_synchronize();                           // the change must be visible before the waiters are checked
+            if (m_waiters == 0 || !__sync_bool_compare_and_swap(&m_signalled, 0, 1))
+                return;
+            #ifdef __linux__
+                __sync_fetch_and_add(&m_epoch, 1);
+                syscall(SYS_futex, &m_epoch, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+            #else
+                pthread_mutex_lock(&m_mutex);
+                m_epoch++;
+                pthread_cond_broadcast(&m_condition);
+                pthread_mutex_unlock(&m_mutex);
+            #endif
+        }
+
+    private:
+        volatile int m_epoch;                   //!< incremented by each notify() that had waiters, this is the futex word
+        volatile int m_waiters;                 //!< the number of threads between prepareWait() and the end of wait() or cancelWait()
+        volatile int m_signalled;               //!< set by the notify() that wakes the waiters, cleared by prepareWait()
+        #ifndef __linux__
+            pthread_mutex_t m_mutex;            //!< lock for m_condition
+            pthread_cond_t m_condition;         //!< signalled when m_epoch changes
+        #endif
+};
+
+#endif
@@ -0,0 +1,116 @@
+/*! @file MPSCRing.h
+    @brief Declaration and implementation of the MPSCRing class.
+
+    @class MPSCRing
+    @brief A lock-free, fixed size ring buffer for any number of producer threads and one consumer thread.
+
+    Each slot carries a sequence number which says whether it is free for the producer claiming
+    that position, or holds an item for the consumer. Producers claim positions with a compare and
+    swap on the tail; the consumer never needs an atomic operation. Neither call blocks; push()
+    fails when the ring is full and pop() fails when the next item has not been completely written.
+
+    Use SPSCRing when there is only ever one producer, it is cheaper. SIZE must be a power of two.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef MPSC_RING_H_DEFINED
+#define MPSC_RING_H_DEFINED
+
+template<typename T, unsigned int SIZE>
+class MPSCRing
+{
+    public:
+        MPSCRing() : m_head(0), m_tail(0)
+        {
+            for (unsigned int i=0; i<SIZE; i++)
+                m_slots[i].sequence = i;
+        };
+
+        /*! @brief Adds an item to the back of the ring. This can be called from any thread.
+            @param item the item to add
+            @return false if the ring was full, and the item was not added
+         */
+        bool push(const T& item)
+        {
+            Slot* slot;
+            unsigned int position = m_tail;
+            while (true)
+            {
+                slot = &m_slots[position & MASK];
+                int difference = static_cast<int>(load(slot->sequence) - position);
+                if (difference == 0)
+                {   // the slot is free for this position, try to claim it
+                    if (__sync_bool_compare_and_swap(&m_tail, position, position + 1))
+                        break;
+                }
+                else if (difference < 0)
+                    return false;           // the slot still holds an item from the last lap
+                position = m_tail;
+            }
+            slot->item = item;
+            store(slot->sequence, position + 1);
+            return true;
+        }
+
+        /*! @brief Removes the item at the front of the ring. Only call this from the consumer.
+            @param item will be set to the removed item
+            @return false if the ring was empty, and item was not set
+         */
+        bool pop(T& item)
+        {
+            Slot& slot = m_slots[m_head & MASK];
+            if (load(slot.sequence) != m_head + 1)
+                return false;
+            item = slot.item;
+            store(slot.sequence, m_head + SIZE);
+            m_head++;
+            return true;
+        }
+
+        /*! @brief Returns the number of items claimed by producers and not yet popped. This is only a snapshot. */
+        unsigned int size() const {return load(m_tail) - m_head;};
+        bool empty() const {return size() == 0;};
+        unsigned int capacity() const {return SIZE;};
+
+    private:
+        enum {MASK = SIZE - 1, CACHE_LINE = 64};
+        typedef char size_must_be_a_power_of_two[(SIZE & MASK) == 0 ? 1 : -1];
+
+        struct Slot
+        {
+            volatile unsigned int sequence;     //!< the position this slot is free for, or that position + 1 when it holds its item
+            T item;
+        };
+
+        static unsigned int load(const volatile unsigned int& index)
+        {
+            unsigned int value = index;
+            __sync_synchronize();
+            return value;
+        }
+        static void store(volatile unsigned int& index, unsigned int value)
+        {
+            __sync_synchronize();
+            index = value;
+        }
+
+        unsigned int m_head;                                        //!< the number of items popped, only used by the consumer
+        char m_head_padding[CACHE_LINE - sizeof(unsigned int)];     //!< keeps the indices and the slots on separate cache lines
+        volatile unsigned int m_tail;                               //!< the number of positions claimed by producers
+        char m_tail_padding[CACHE_LINE - sizeof(unsigned int)];
+        Slot m_slots[SIZE];                                         //!< the storage for the ring
+};
+
+#endif
@@ -0,0 +1,242 @@
+/*! @file QueueBenchmark.cpp
+    @brief Implementation of the QueueThread benchmark.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "QueueBenchmark.h"
+#include "QueueThread.h"
+
+#include <algorithm>
+#include <deque>
+#include <iostream>
+#include <vector>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+using namespace std;
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+/*! @brief The data pushed through the queues */
+struct Sample
+{
+    unsigned int producer;              //!< the producer that pushed the sample
+    unsigned int sequence;              //!< the number of samples that producer pushed before this one
+    double time;                        //!< the time the sample was pushed, or 0 if it is not being timed
+};
+
+ostream& operator<<(ostream& output, const Sample& sample)
+{
+    return output << sample.producer << ":" << sample.sequence;
+}
+
+/*! @brief What a consumer received */
+class ConsumerRecord
+{
+public:
+    ConsumerRecord() : m_in_order(true), m_received(0), m_next(2, 0) {}
+
+    void record(const Sample& sample)
+    {
+        if (sample.producer >= m_next.size() || sample.sequence != m_next[sample.producer])
+            m_in_order = false;
+        else
+            m_next[sample.producer]++;
+        if (sample.time > 0)
+            m_latencies.push_back(benchmarkTime() - sample.time);
+        m_received++;
+    }
+
+    bool m_in_order;
+    unsigned int m_received;
+    vector<unsigned int> m_next;
+    vector<double> m_latencies;
+};
+
+/*! @brief A consumer on the current QueueThread */
+template <typename Queue>
+class RingConsumer : public QueueThread<Sample, Queue>
+{
+public:
+    RingConsumer(unsigned int count) : QueueThread<Sample, Queue>("RingConsumer", 0), m_count(count) {}
+    ConsumerRecord m_record;
+protected:
+    void run()
+    {
+        Sample sample;
+        for (unsigned int i=0; i<m_count; i++)
+        {
+            this->waitForData(sample);
+            m_record.record(sample);
+        }
+    }
+private:
+    unsigned int m_count;
+};
+
+/*! @brief A consumer on the previous QueueThread; a deque under a mutex, with a condition signalled on every push */
+class LockedConsumer : public Thread
+{
+public:
+    LockedConsumer(unsigned int count) : Thread("LockedConsumer", 0), m_count(count)
+    {
+        pthread_mutex_init(&m_condition_mutex, NULL);
+        pthread_cond_init(&m_condition, NULL);
+    }
+    ~LockedConsumer()
+    {
+        pthread_cond_destroy(&m_condition);
+        pthread_mutex_destroy(&m_condition_mutex);
+    }
+
+    bool pushBack(const Sample& newdata)
+    {
+        pthread_mutex_lock(&m_condition_mutex);
+        m_queue.push_back(newdata);
+        pthread_cond_signal(&m_condition);
+        pthread_mutex_unlock(&m_condition_mutex);
+        return true;
+    }
+
+    ConsumerRecord m_record;
+protected:
+    void run()
+    {
+        for (unsigned int i=0; i<m_count; i++)
+        {
+            pthread_mutex_lock(&m_condition_mutex);
+            while (m_queue.empty())
+                pthread_cond_wait(&m_condition, &m_condition_mutex);
+            Sample sample = m_queue.front();
+            m_queue.pop_front();
+            pthread_mutex_unlock(&m_condition_mutex);
+            m_record.record(sample);
+        }
+    }
+private:
+    unsigned int m_count;
+    pthread_mutex_t m_condition_mutex;
+    pthread_cond_t m_condition;
+    deque<Sample> m_queue;
+};
+
+template <typename Consumer>
+struct Producer
+{
+    Consumer* consumer;
+    unsigned int id;
+    unsigned int count;
+};
+
+//! Pushes count untimed samples, yielding whenever the queue is full.
+template <typename Consumer>
+static void* produce(void* arg)
+{
+    Producer<Consumer>* producer = static_cast<Producer<Consumer>*>(arg);
+    for (unsigned int i=0; i<producer->count; i++)
+    {
+        Sample sample = {producer->id, i, 0};
+        while (!producer->consumer->pushBack(sample))
+            sched_yield();
+    }
+    return NULL;
+}
+
+//! Pushes items from num_producers threads and prints the items per second received by the consumer.
+template <typename Consumer>
+static bool runThroughput(const string& name, unsigned int num_producers, unsigned int items)
+{
+    unsigned int per_producer = items/num_producers;
+    Consumer consumer(per_producer*num_producers);
+    vector<Producer<Consumer> > producers(num_producers);
+    vector<pthread_t> threads(num_producers);
+
+    consumer.start();
+    double start = benchmarkTime();
+    for (unsigned int i=0; i<num_producers; i++)
+    {
+        producers[i].consumer = &consumer;
+        producers[i].id = i;
+        producers[i].count = per_producer;
+        pthread_create(&threads[i], NULL, produce<Consumer>, &producers[i]);
+    }
+    for (unsigned int i=0; i<num_producers; i++)
+        pthread_join(threads[i], NULL);
+    consumer.join();
+    double elapsed = benchmarkTime() - start;
+
+    bool ok = consumer.m_record.m_in_order && consumer.m_record.m_received == per_producer*num_producers;
+    cout << "  " << name << " " << num_producers << " producer(s): " << per_producer*num_producers/elapsed/1000 << " Mitems/s" << (ok ? "" : " FAILED") << endl;
+    return ok;
+}
+
+//! Pushes a timed sample into an empty queue after the consumer has had time to fall asleep, and prints the wake-up latencies.
+template <typename Consumer>
+static bool runLatency(const string& name, unsigned int wakeups)
+{
+    Consumer consumer(wakeups);
+    consumer.start();
+    for (unsigned int i=0; i<wakeups; i++)
+    {
+        usleep(200);
+        Sample sample = {0, i, benchmarkTime()};
+        consumer.pushBack(sample);
+    }
+    consumer.join();
+
+    vector<double>& latencies = consumer.m_record.m_latencies;
+    bool ok = consumer.m_record.m_in_order && latencies.size() == wakeups;
+    if (ok)
+    {
+        sort(latencies.begin(), latencies.end());
+        double total = 0;
+        for (unsigned int i=0; i<latencies.size(); i++)
+            total += latencies[i];
+        cout << "  " << name << " wake-up: mean " << 1000*total/latencies.size() << "us";
+        cout << " median " << 1000*latencies[latencies.size()/2] << "us";
+        cout << " 99% " << 1000*latencies[(99*latencies.size())/100] << "us";
+        cout << " max " << 1000*latencies.back() << "us" << endl;
+    }
+    else
+        cout << "  " << name << " wake-up: FAILED" << endl;
+    return ok;
+}
+
+bool QueueThreadBenchmark(unsigned int items, unsigned int wakeups)
+{
+    typedef RingConsumer<SPSCRing<Sample, 1024> > SPSCConsumer;
+    typedef RingConsumer<MPSCRing<Sample, 1024> > MPSCConsumer;
+    bool ok = true;
+
+    cout << "QueueThreadBenchmark: throughput" << endl;
+    ok &= runThroughput<LockedConsumer>("mutex/deque", 1, items);
+    ok &= runThroughput<SPSCConsumer>("SPSCRing   ", 1, items);
+    ok &= runThroughput<MPSCConsumer>("MPSCRing   ", 1, items);
+    ok &= runThroughput<LockedConsumer>("mutex/deque", 2, items);
+    ok &= runThroughput<MPSCConsumer>("MPSCRing   ", 2, items);
+
+    cout << "QueueThreadBenchmark: latency" << endl;
+    ok &= runLatency<LockedConsumer>("mutex/deque", wakeups);
+    ok &= runLatency<SPSCConsumer>("SPSCRing   ", wakeups);
+    ok &= runLatency<MPSCConsumer>("MPSCRing   ", wakeups);
+    return ok;
+}
@@ -0,0 +1,33 @@
+/*! @file QueueBenchmark.h
+    @brief Compares the lock-free QueueThread queues with the previous mutex and condition queue.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef QUEUE_BENCHMARK_H_DEFINED
+#define QUEUE_BENCHMARK_H_DEFINED
+
+/*! @brief Measures QueueThread throughput and wake-up latency.
+
+    The previous implementation, a std::deque with a mutex and a condition signalled on every item,
+    is compared with QueueThread on an SPSCRing and on an MPSCRing. Throughput is measured with
+    producers pushing as fast as they can, with one producer and with two. Wake-up latency is the
+    time from pushing a single item into an empty queue to the sleeping consumer having it.
+    @param items the number of items pushed in each throughput run
+    @param wakeups the number of wake-ups timed in each latency run
+    @return whether every queue delivered every item, in order for each producer
+ */
+bool QueueThreadBenchmark(unsigned int items = 2000000, unsigned int wakeups = 2000);
+
+#endif
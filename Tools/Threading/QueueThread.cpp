@@ -29,60 +29,55 @@ using namespace std;
     @param name the name of the thread (used entirely for debug purposes)
     @param priority the priority of the thread. If non-zero the thread will be a bona fide real-time thread.
  */
-template <typename T>
-QueueThread<T>::QueueThread(string name, unsigned char priority) : Thread(name, priority)
+template <typename T, typename Queue>
+QueueThread<T, Queue>::QueueThread(string name, unsigned char priority) : Thread(name, priority)
 {
     #if DEBUG_THREADING_VERBOSITY > 1
         debug << "QueueThread::QueueThread(" << m_name << ", " << static_cast<int>(m_priority) << ")" << endl;
     #endif
-    int err;
-    err = pthread_mutex_init(&m_condition_mutex, NULL);
-    if (err != 0)
-        errorlog << "QueueThread::QueueThread(" << m_name << ") Failed to create m_condition_mutex." << endl;
-    
-    err = pthread_cond_init(&m_condition, NULL);
-    if (err != 0)
-        errorlog << "QueueThread::QueueThread(" << m_name << ") Failed to create m_condition." << endl;
 }
 
 /*! @brief Stops the thread
  */
-template <typename T>
-QueueThread<T>::~QueueThread()
+template <typename T, typename Queue>
+QueueThread<T, Queue>::~QueueThread()
 {
     #if DEBUG_THREADING_VERBOSITY > 1
         debug << "QueueThread::~QueueThread() " << m_name << endl;
     #endif
     stop();
-    pthread_cond_destroy(&m_condition);
-    pthread_mutex_destroy(&m_condition_mutex);
 }
 
 /*! @brief Adds new data to the thread's queue. This also increments the number of required loops
     @param newdata the data to add to the queue
+    @return false if the queue was full, in which case the data was not added
  */
-template <typename T>
-void QueueThread<T>::pushBack(T newdata)
+template <typename T, typename Queue>
+bool QueueThread<T, Queue>::pushBack(const T& newdata)
 {
     #if DEBUG_THREADING_VERBOSITY > 2
         debug << "QueueThread::pushBack(" << newdata << ") " << m_name << endl;
     #endif
-    m_queue.push_back(newdata);
-    
-    pthread_mutex_lock(&m_condition_mutex);
-    pthread_cond_signal(&m_condition);
-    pthread_mutex_unlock(&m_condition_mutex);
+    if (!m_queue.push(newdata))
+        return false;
+    m_data_available.notify();
+    return true;
 }
 
-/*! @brief Blocks this thread until the condition is signalled
+/*! @brief Takes the data at the front of the queue, blocking this thread while the queue is empty
+    @param data will be set to the data taken from the queue
  */
-template <typename T>
-void QueueThread<T>::waitForCondition()
+template <typename T, typename Queue>
+void QueueThread<T, Queue>::waitForData(T& data)
 {
-    if (m_queue.size() == 0)
+    while (!m_queue.pop(data))
     {   // if there is no data in the queue to be processed then wait until new data is added
-        pthread_mutex_lock(&m_condition_mutex);
-        pthread_cond_wait(&m_condition, &m_condition_mutex);
-        pthread_mutex_unlock(&m_condition_mutex);
+        unsigned int key = m_data_available.prepareWait();
+        if (m_queue.pop(data))
+        {
+            m_data_available.cancelWait();
+            return;
+        }
+        m_data_available.wait(key);
     }
 }
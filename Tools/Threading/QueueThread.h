@@ -12,8 +12,11 @@
     in quick succession the main loop will run exactly three times. A queue is provided
     which stores data for each execution.
  
-    The QueueThread is a template, the template parameter selects the type of data
-    in the queue.
+    The QueueThread is a template, the first template parameter selects the type of data
+    in the queue. The second selects the queue, which is a bounded lock-free ring; an
+    MPSCRing by default, or an SPSCRing when only one thread ever calls pushBack(). The
+    thread only sleeps when the queue is empty, and producers only enter the kernel when
+    they have to wake it.
 
     @author Jason Kulk
  
@@ -37,29 +40,29 @@
 #define QUEUE_THREAD_H_DEFINED
 
 #include "Thread.h"
+#include "EventCount.h"
+#include "MPSCRing.h"
+#include "SPSCRing.h"
 
 #include <string>
-#include <deque>
 #include <pthread.h>
 
-template <typename T>
+template <typename T, typename Queue = MPSCRing<T, 64> >
 class QueueThread : public Thread
 {
 	public:
 		QueueThread(std::string name, unsigned char priority);
         virtual ~QueueThread();
     
-        void pushBack(T newdata);
+        bool pushBack(const T& newdata);
     
     protected:
         virtual void run() = 0;                // To be overridden by code to run.
-        void waitForCondition();              
+        void waitForData(T& data);
 
     protected:
-        pthread_mutex_t m_condition_mutex;     //!< lock for new data signal
-        pthread_cond_t m_condition;            //!< signal for new data
-    
-        std::deque<T> m_queue;                 //!< the queue of the data for the thread
+        Queue m_queue;                         //!< the queue of the data for the thread
+        EventCount m_data_available;           //!< notified when data is added to the queue
 };
 
 #include "QueueThread.cpp"                      // this is the standard way to do template classes if when you separate declaration and implementation.
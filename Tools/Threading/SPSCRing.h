@@ -0,0 +1,93 @@
+/*! @file SPSCRing.h
+    @brief Declaration and implementation of the SPSCRing class.
+
+    @class SPSCRing
+    @brief A lock-free, fixed size ring buffer for exactly one producer thread and one consumer thread.
+
+    push() is only ever called by the producer, and pop() only ever by the consumer. Neither call
+    blocks; push() fails when the ring is full and pop() fails when it is empty. Threads that need to
+    sleep until there is something to pop should pair the ring with a semaphore or condition.
+
+    SIZE must be a power of two. MPSCRing is the variant for several producers.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef SPSC_RING_H_DEFINED
+#define SPSC_RING_H_DEFINED
+
+template<typename T, unsigned int SIZE>
+class SPSCRing
+{
+    public:
+        SPSCRing() : m_head(0), m_tail(0) {};
+
+        /*! @brief Adds an item to the back of the ring. Only call this from the producer.
+            @param item the item to add
+            @return false if the ring was full, and the item was not added
+         */
+        bool push(const T& item)
+        {
+            unsigned int tail = m_tail;
+            if (tail - load(m_head) == SIZE)
+                return false;
+            m_items[tail & MASK] = item;
+            store(m_tail, tail + 1);
+            return true;
+        }
+
+        /*! @brief Removes the item at the front of the ring. Only call this from the consumer.
+            @param item will be set to the removed item
+            @return false if the ring was empty, and item was not set
+         */
+        bool pop(T& item)
+        {
+            unsigned int head = m_head;
+            if (load(m_tail) == head)
+                return false;
+            item = m_items[head & MASK];
+            store(m_head, head + 1);
+            return true;
+        }
+
+        /*! @brief Returns the number of items in the ring. This is only a snapshot if the other thread is active. */
+        unsigned int size() const {return load(m_tail) - load(m_head);};
+        bool empty() const {return size() == 0;};
+        unsigned int capacity() const {return SIZE;};
+
+    private:
+        enum {MASK = SIZE - 1, CACHE_LINE = 64};
+        typedef char size_must_be_a_power_of_two[(SIZE & MASK) == 0 ? 1 : -1];
+
+        // the barriers make the item written before the index is published, and read before it is released
+        static unsigned int load(const volatile unsigned int& index)
+        {
+            unsigned int value = index;
+            __sync_synchronize();
+            return value;
+        }
+        static void store(volatile unsigned int& index, unsigned int value)
+        {
+            __sync_synchronize();
+            index = value;
+        }
+
+        volatile unsigned int m_head;                               //!< the number of items popped, only written by the consumer
+        char m_head_padding[CACHE_LINE - sizeof(unsigned int)];     //!< keeps the indices and the items on separate cache lines
+        volatile unsigned int m_tail;                               //!< the number of items pushed, only written by the producer
+        char m_tail_padding[CACHE_LINE - sizeof(unsigned int)];
+        T m_items[SIZE];                                            //!< the storage for the ring
+};
+
+#endif
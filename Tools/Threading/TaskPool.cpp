@@ -0,0 +1,158 @@
+/*! @file TaskPool.cpp
+    @brief Implementation of the TaskPool class.
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "TaskPool.h"
+#include "Thread.h"
+#include "debug.h"
+#include "debugverbositythreading.h"
+
+#include <sstream>
+
+using namespace std;
+
+/*! @brief A thread that takes tasks from its pool until the pool is stopped
+ */
+class TaskPool::Worker : public Thread
+{
+    public:
+        Worker(string name, unsigned char priority, TaskPool* pool) : Thread(name, priority), m_pool(pool) {};
+    protected:
+        void run()
+        {
+            Task* task;
+            while ((task = m_pool->take()) != 0)
+            {
+                task->run();
+                m_pool->finished();
+            }
+        }
+    private:
+        TaskPool* m_pool;
+};
+
+/*! @brief Creates a task pool and starts its workers
+    @param name the name of the pool (used entirely for debug purposes)
+    @param num_workers the number of worker threads. With zero workers tasks are run by the thread that calls waitForAll()
+    @param priority the priority of the worker threads, see Thread::Thread
+ */
+TaskPool::TaskPool(string name, unsigned int num_workers, unsigned char priority) : m_name(name), m_outstanding(0), m_stopping(false)
+{
+    #if DEBUG_THREADING_VERBOSITY > 2
+        debug << "TaskPool::TaskPool(" << m_name << ", " << num_workers << ", " << static_cast<int>(priority) << ")" << endl;
+    #endif
+    pthread_mutex_init(&m_mutex, NULL);
+    pthread_cond_init(&m_task_available, NULL);
+    pthread_cond_init(&m_all_done, NULL);
+
+    for (unsigned int i=0; i<num_workers; i++)
+    {
+        stringstream worker_name;
+        worker_name << m_name << "Worker" << i;
+        Worker* worker = new Worker(worker_name.str(), priority, this);
+        if (worker->start() == 0)
+            m_workers.push_back(worker);
+        else
+            delete worker;
+    }
+}
+
+/*! @brief Stops and joins the workers. Tasks still in the queue are not run.
+ */
+TaskPool::~TaskPool()
+{
+    #if DEBUG_THREADING_VERBOSITY > 2
+        debug << "TaskPool::~TaskPool(): " << m_name << endl;
+    #endif
+    pthread_mutex_lock(&m_mutex);
+    m_stopping = true;
+    pthread_cond_broadcast(&m_task_available);
+    pthread_mutex_unlock(&m_mutex);
+
+    for (size_t i=0; i<m_workers.size(); i++)
+    {
+        m_workers[i]->join();
+        delete m_workers[i];
+    }
+
+    pthread_cond_destroy(&m_all_done);
+    pthread_cond_destroy(&m_task_available);
+    pthread_mutex_destroy(&m_mutex);
+}
+
+/*! @brief Queues a task to be run by the next free worker
+    @param task the task, it must stay valid until waitForAll() returns
+ */
+void TaskPool::add(Task* task)
+{
+    pthread_mutex_lock(&m_mutex);
+    m_queue.push_back(task);
+    m_outstanding++;
+    pthread_cond_signal(&m_task_available);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Blocks until every added task has finished. The calling thread runs queued tasks while it waits.
+ */
+void TaskPool::waitForAll()
+{
+    while (true)
+    {
+        pthread_mutex_lock(&m_mutex);
+        if (m_queue.empty())
+            break;
+        Task* task = m_queue.front();
+        m_queue.pop_front();
+        pthread_mutex_unlock(&m_mutex);
+
+        task->run();
+        finished();
+    }
+
+    while (m_outstanding > 0)
+        pthread_cond_wait(&m_all_done, &m_mutex);
+    pthread_mutex_unlock(&m_mutex);
+}
+
+/*! @brief Blocks a worker until there is a task to run
+    @return the next task, or 0 if the pool is stopping
+ */
+Task* TaskPool::take()
+{
+    pthread_mutex_lock(&m_mutex);
+    while (m_queue.empty() && !m_stopping)
+        pthread_cond_wait(&m_task_available, &m_mutex);
+
+    Task* task = 0;
+    if (!m_stopping)
+    {
+        task = m_queue.front();
+        m_queue.pop_front();
+    }
+    pthread_mutex_unlock(&m_mutex);
+    return task;
+}
+
+/*! @brief Marks a taken task as finished, waking waitForAll() when it was the last one
+ */
+void TaskPool::finished()
+{
+    pthread_mutex_lock(&m_mutex);
+    m_outstanding--;
+    if (m_outstanding == 0)
+        pthread_cond_broadcast(&m_all_done);
+    pthread_mutex_unlock(&m_mutex);
+}
@@ -0,0 +1,75 @@
+/*! @file TaskPool.h
+    @brief Declaration of the Task and TaskPool classes.
+
+    @class Task
+    @brief A unit of work that can be handed to a TaskPool.
+
+    @class TaskPool
+    @brief A fixed number of worker threads that run queued tasks.
+
+    Tasks are added with add() and the caller then blocks in waitForAll() until every added
+    task has run. While waiting the caller runs queued tasks itself, so a pool with zero
+    workers runs each task inline, in the order they were added. The pool never owns its
+    tasks; they must outlive the call to waitForAll().
+
+ This program is free software: you can redistribute it and/or modify
+ it under the terms of the GNU General Public License as published by
+ the Free Software Foundation, either version 3 of the License, or
+ (at your option) any later version.
+
+ This program is distributed in the hope that it will be useful,
+ but WITHOUT ANY WARRANTY; without even the implied warranty of
+ MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ GNU General Public License for more details.
+
+ You should have received a copy of the GNU General Public License
+ along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef TASK_POOL_H_DEFINED
+#define TASK_POOL_H_DEFINED
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <pthread.h>
+
+class Task
+{
+    public:
+        virtual ~Task() {};
+        virtual void run() = 0;                 // To be overridden by the work to be done.
+};
+
+class TaskPool
+{
+    public:
+        TaskPool(std::string name, unsigned int num_workers, unsigned char priority);
+        ~TaskPool();
+
+        void add(Task* task);
+        void waitForAll();
+
+        unsigned int getNumWorkers() const {return m_workers.size();};
+
+    private:
+        class Worker;
+        friend class Worker;
+
+        Task* take();
+        void finished();
+
+    public:
+        const std::string m_name;               //!< the name of the pool (used entirely for debug purposes)
+
+    private:
+        pthread_mutex_t m_mutex;                //!< lock for the queue and the counters
+        pthread_cond_t m_task_available;        //!< signalled when a task is queued, or the pool is stopping
+        pthread_cond_t m_all_done;              //!< signalled when the last outstanding task has finished
+        std::deque<Task*> m_queue;              //!< the tasks that have been added but not yet taken
+        unsigned int m_outstanding;             //!< the number of tasks that have been added but not yet finished
+        bool m_stopping;                        //!< true once the pool is being destroyed
+        std::vector<Worker*> m_workers;         //!< the worker threads
+};
+
+#endif
@@ -86,6 +86,7 @@ int Thread::start()
             debug << "Thread::start(). " << m_name << ". Warning your thread does not have the correct priority." << endl;
     }
 
+    running = true;
 	return 0;
 }
 
@@ -93,18 +94,23 @@ int Thread::start()
  */
 int Thread::join()
 {
-    return pthread_join(m_pthread, NULL); 
+    if (!running)
+        return -1;
+    int err = pthread_join(m_pthread, NULL);
+    running = false;
+    return err;
 }
 
-/*! @brief Cancels the threads execution, and sets the running flag to false
+/*! @brief Cancels the threads execution, and sets the running flag to false. Threads that were never started, or have been joined, are not cancelled.
  */
 void Thread::stop()
 {
     #if DEBUG_THREADING_VERBOSITY > 0
         debug << "Thread::stop(): " << m_name << endl;
     #endif
-    pthread_cancel(m_pthread);
-	running = false;
+    if (running)
+        pthread_cancel(m_pthread);
+    running = false;
 }
 
 /*! @brief The static wrapper function to call the underlying run function.
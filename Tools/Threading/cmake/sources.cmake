@@ -26,6 +26,8 @@ ConditionalThread.h ConditionalThread.cpp
 PeriodicSignalerThread.h PeriodicSignalerThread.cpp
 PeriodicThread.h PeriodicThread.cpp
 QueueThread.h
+TaskPool.h TaskPool.cpp
+SPSCRing.h MPSCRing.h EventCount.h
 )
 ####################################################################################
 ########## List your subdirectories here! ##########################################
@@ -0,0 +1,6 @@
+#ifndef DEBUGVERBOSITYTHREADING_H
+#define DEBUGVERBOSITYTHREADING_H
+
+#define DEBUG_THREADING_VERBOSITY 0
+
+#endif // DEBUGVERBOSITYTHREADING_H
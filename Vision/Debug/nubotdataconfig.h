@@ -1,5 +1,9 @@
 #ifndef NUBOTDATACONFIG_H
 #define NUBOTDATACONFIG_H
+
+#include <stdlib.h>
+#include <string>
+
 #define DATA_DIR (std::string(getenv("HOME")) + std::string("/nubot/"))
 #define CONFIG_DIR (DATA_DIR + std::string("Config/Darwin/"))
 #define RULE_DIR (CONFIG_DIR + std::string("Rules/"))
@@ -1,3 +1,6 @@
+#ifndef RANSAC_H
+#define RANSAC_H
+
 #include <vector>
 //#include "Tools/Math/LSFittedLine.h"
 
@@ -11,6 +14,75 @@ namespace RANSAC
         BestFittingConsensus
     };
 
+    enum SAMPLING_METHOD {
+        UniformSampling,        //! Samples are drawn from all the remaining points.
+        ProgressiveSampling     //! PROSAC style - the points are ordered best first and samples are drawn from a growing prefix of them.
+    };
+
+    /**
+      * Finds models in a set of points without copying them. The points are referred to by an
+      * index array, the points that have not been fitted yet are at its front and the consensus
+      * of each model found is moved behind them, keeping the original order in both parts.
+      *
+      * The number of hypotheses tried per model is k at most, with a confidence below 1 it stops
+      * once a sample free of outliers has been drawn with that probability given the largest
+      * consensus seen. Hypotheses are scored a block at a time, and under LargestConsensus one
+      * is abandoned as soon as it cannot beat the best. With a confidence of 1 and uniform
+      * sampling the models are the same as scoring all k hypotheses in full.
+      *
+      * Model must provide minPointsForFit(), regenerate(const vector<DataPoint>&) and
+      * calculateError(const DataPoint&).
+      */
+    template<class Model, typename DataPoint>
+    class Engine
+    {
+    public:
+        Engine(double e, unsigned int n, unsigned int k, SELECTION_METHOD method,
+               double confidence = 1.0, SAMPLING_METHOD sampling = UniformSampling);
+
+        //! Starts on a new set of points, which must outlive the search.
+        void reset(const vector<DataPoint>& points);
+
+        /**
+          * Finds the next model in the remaining points, and removes its consensus from them.
+          * @param result the model found.
+          * @param variance the mean error of the consensus (of the best fitting, or largest, consensus).
+          * @return whether a model with a consensus of at least n points was found.
+          */
+        bool findNext(Model& result, double& variance);
+
+        //! Copies the consensus of the last model found.
+        void getConsensus(vector<DataPoint>& consensus) const;
+        //! Copies the points that are not in the consensus of any model found.
+        void getRemainder(vector<DataPoint>& remainder) const;
+
+        //! The number of hypotheses tried by the last findNext.
+        unsigned int getHypotheses() const {return m_hypotheses;}
+
+    private:
+        bool sampleModel(Model& model, size_t available);
+        size_t countConsensus(const Model& model, size_t stop_below, double& error_sum) const;
+        void removeConsensus(const Model& model);
+
+    private:
+        static const size_t BLOCK_SIZE = 64;    //! @variable The number of points scored between checks for preemption.
+
+        double m_e;                         //! @variable The consensus margin.
+        unsigned int m_n;                   //! @variable The minimum consensus size.
+        unsigned int m_k;                   //! @variable The maximum number of hypotheses per model.
+        SELECTION_METHOD m_method;
+        double m_confidence;                //! @variable The probability of having drawn an outlier free sample before stopping early.
+        SAMPLING_METHOD m_sampling;
+
+        const vector<DataPoint>* m_points;  //! @variable The points being fitted.
+        vector<unsigned int> m_indices;     //! @variable The remaining points, then the consensus of each model found.
+        vector<unsigned int> m_scratch;     //! @variable Holds a consensus while it is moved behind the remaining points.
+        size_t m_remaining;                 //! @variable The number of points not in any consensus.
+        size_t m_consensus_end;             //! @variable The end of the last model's consensus in m_indices.
+        vector<DataPoint> m_sample;         //! @variable The points a hypothesis is generated from.
+        unsigned int m_hypotheses;
+    };
+
     //Model must provide several features
     template<class Model, typename DataPoint>
     vector<pair<Model, vector<DataPoint> > > findMultipleModels(const vector<DataPoint>& line_points,
@@ -18,10 +90,12 @@ namespace RANSAC
                                                                 unsigned int n,
                                                                 unsigned int k,
                                                                 unsigned int max_iterations,
-                                                                SELECTION_METHOD method);
+                                                                SELECTION_METHOD method,
+                                                                double confidence = 1.0,
+                                                                SAMPLING_METHOD sampling = UniformSampling);
 
     template<class Model, typename DataPoint>
-    bool findModel(vector<DataPoint> points,
+    bool findModel(const vector<DataPoint>& points,
                    Model& result,
                    vector<DataPoint>& consensus,
                    vector<DataPoint>& remainder,
@@ -29,10 +103,38 @@ namespace RANSAC
                    double e,
                    unsigned int n,
                    unsigned int k,
-                   SELECTION_METHOD method);
+                   SELECTION_METHOD method,
+                   double confidence = 1.0,
+                   SAMPLING_METHOD sampling = UniformSampling);
 
     template<class Model, typename DataPoint>
     Model generateRandomModel(const vector<DataPoint>& points);
+
+    //! The number of hypotheses that draw an outlier free sample of sample_size points with the given confidence.
+    inline unsigned int requiredHypotheses(double inlier_ratio, unsigned int sample_size, double confidence, unsigned int max_hypotheses);
+
+    //! Per thread generator state, so detectors running on different threads neither share nor race on rand().
+    inline unsigned int& randomState()
+    {
+        static __thread unsigned int state = 1;
+        return state;
+    }
+
+    //! Seeds the calling thread's generator, making the sampled models reproducible.
+    inline void seed(unsigned int s)
+    {
+        randomState() = s;
+    }
+
+    //! Returns the next number in [0, 32767] from the calling thread's generator.
+    inline unsigned int nextRandom()
+    {
+        unsigned int& state = randomState();
+        state = state*1103515245 + 12345;
+        return (state >> 16) & 0x7fff;
+    }
 }
 
 #include "ransac.template"
+
+#endif // RANSAC_H
@@ -0,0 +1,101 @@
+#include "ransacbenchmark.h"
+#include "ransac.h"
+#include "Vision/VisionTypes/fieldpointset.h"
+#include "Vision/VisionTypes/RANSACTypes/ransacline.h"
+
+#include <fstream>
+#include <algorithm>
+#include <time.h>
+
+using namespace std;
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+static bool nearerToRobot(const GroundPoint& a, const GroundPoint& b)
+{
+    return a.ground.squareAbs() < b.ground.squareAbs();
+}
+
+struct RANSACBenchmarkMode
+{
+    const char* name;
+    double confidence;
+    RANSAC::SAMPLING_METHOD sampling;
+    double time;
+    size_t lines;
+    size_t hypotheses;
+};
+
+bool RANSACBenchmark(const string& point_file, unsigned int repetitions)
+{
+    ifstream input(point_file.c_str());
+    if(!input.is_open()) {
+        cout << "RANSACBenchmark - unable to open " << point_file << endl;
+        return false;
+    }
+
+    vector< vector<GroundPoint> > sets;
+    vector<GroundPoint> points;
+    size_t total_points = 0;
+    while(readFieldPointSet(input, points)) {
+        //the nearest points first in every mode, as LineDetectorRANSAC orders them for progressive sampling
+        stable_sort(points.begin(), points.end(), nearerToRobot);
+        sets.push_back(points);
+        total_points += points.size();
+    }
+    if(sets.empty()) {
+        cout << "RANSACBenchmark - no point sets in " << point_file << endl;
+        return false;
+    }
+
+    //the LineDetectorRANSAC parameters
+    const double e = 4.0;
+    const unsigned int n = 15,
+                       k = 40,
+                       max_lines = 10;
+
+    RANSACBenchmarkMode modes[] = {
+        {"all hypotheses", 1.0, RANSAC::UniformSampling, 0, 0, 0},
+        {"adaptive", 0.99, RANSAC::UniformSampling, 0, 0, 0},
+        {"adaptive progressive", 0.99, RANSAC::ProgressiveSampling, 0, 0, 0}
+    };
+    const size_t num_modes = sizeof(modes)/sizeof(modes[0]);
+
+    for(size_t m=0; m<num_modes; m++) {
+        RANSACBenchmarkMode& mode = modes[m];
+        RANSAC::Engine<RANSACLine<GroundPoint>, GroundPoint> engine(e, n, k, RANSAC::BestFittingConsensus, mode.confidence, mode.sampling);
+        RANSACLine<GroundPoint> line;
+        double variance;
+
+        double start = benchmarkTime();
+        for(unsigned int r=0; r<repetitions; r++) {
+            for(size_t s=0; s<sets.size(); s++) {
+                RANSAC::seed(s + 1);
+                engine.reset(sets[s]);
+                for(unsigned int l=0; l<max_lines; l++) {
+                    bool found = engine.findNext(line, variance);
+                    mode.hypotheses += engine.getHypotheses();
+                    if(!found)
+                        break;
+                    mode.lines++;
+                }
+            }
+        }
+        mode.time = benchmarkTime() - start;
+    }
+
+    cout << "RANSACBenchmark - " << sets.size() << " point sets, " << double(total_points)/sets.size() << " points per set" << endl;
+    for(size_t m=0; m<num_modes; m++) {
+        const RANSACBenchmarkMode& mode = modes[m];
+        cout << "\t" << mode.name << ": " << 1e3*mode.lines/mode.time << " lines/sec, "
+             << mode.time/(repetitions*sets.size()) << " ms/set, "
+             << double(mode.lines)/(repetitions*sets.size()) << " lines/set, "
+             << (mode.lines > 0 ? double(mode.hypotheses)/mode.lines : 0) << " hypotheses/line" << endl;
+    }
+    return true;
+}
@@ -0,0 +1,28 @@
+/**
+*   @name   RANSACBenchmark
+*   @file   ransacbenchmark.h
+*   @brief  Times the field line RANSAC on recorded sets of field points.
+*
+*   The point files are read with readFieldPointSet (see fieldpointset.h). FieldPointDetector
+*   writes them to fieldpoints.txt when VISION_FIELDPOINT_VERBOSITY is above 2.
+*
+*   The benchmark is built into the benchmark target, run it with "Vision --ransac <point file> [repetitions]".
+*/
+
+#ifndef RANSACBENCHMARK_H
+#define RANSACBENCHMARK_H
+
+#include <string>
+
+/**
+*   @brief  runs the LineDetectorRANSAC search over every set in a point file.
+*   Each set is searched with all the hypotheses, with the adaptive hypothesis count, and with
+*   the adaptive count and progressive sampling, and the lines found per second of each are printed.
+*   Every set is searched with the same seed in each mode, so runs are reproducible.
+*   @param point_file The recorded field points.
+*   @param repetitions The number of times each set is searched in each mode.
+*   @return Whether any sets were read.
+*/
+bool RANSACBenchmark(const std::string& point_file, unsigned int repetitions = 20);
+
+#endif // RANSACBENCHMARK_H
@@ -15,8 +15,8 @@ GoalDetectorHistogram::~GoalDetectorHistogram() {}
 vector<Goal> GoalDetectorHistogram::run()
 {
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
-    const vector<ColourSegment>& h_segments = vbb->getHorizontalTransitions(GOAL_COLOUR);
-    const vector<ColourSegment>& v_segments = vbb->getVerticalTransitions(GOAL_COLOUR);
+    const SegmentScan& h_segments = vbb->getHorizontalTransitions(GOAL_COLOUR);
+    const SegmentScan& v_segments = vbb->getVerticalTransitions(GOAL_COLOUR);
 
     list<Quad> quads = detectQuads(h_segments, v_segments);
     vector<Goal> posts;
@@ -39,7 +39,7 @@ vector<Goal> GoalDetectorHistogram::run()
     return posts;
 }
 
-list<Quad> GoalDetectorHistogram::detectQuads(const vector<ColourSegment>& h_segments, const vector<ColourSegment>& v_segments)
+list<Quad> GoalDetectorHistogram::detectQuads(const SegmentScan& h_segments, const SegmentScan& v_segments)
 {
     const size_t BINS = 20;
     const double STDDEV_THRESHOLD = 1.5;
@@ -78,7 +78,7 @@ Histogram1D GoalDetectorHistogram::mergePeaks(Histogram1D hist, int minimum_size
     return hist;
 }
 
-list<Quad> GoalDetectorHistogram::generateCandidates(const Histogram1D& hist, const vector<ColourSegment>& h_segments, const vector<ColourSegment>& v_segments, int peak_threshold)
+list<Quad> GoalDetectorHistogram::generateCandidates(const Histogram1D& hist, const SegmentScan& h_segments, const SegmentScan& v_segments, int peak_threshold)
 {
     list<Quad> candidates;
     vector<Bin>::const_iterator b_it;
@@ -101,7 +101,7 @@ bool GoalDetectorHistogram::checkBinSimilarity(Bin b1, Bin b2, float allowed_dis
 
 
 // BETTER EDGE FITTING METHOD
-Quad GoalDetectorHistogram::makeQuad(Bin bin, const vector<ColourSegment>& h_segments, const vector<ColourSegment>& v_segments)
+Quad GoalDetectorHistogram::makeQuad(Bin bin, const SegmentScan& h_segments, const SegmentScan& v_segments)
 {
     // find bounding box from histogram
     int    left = bin.start,
@@ -17,12 +17,12 @@ public:
     ~GoalDetectorHistogram();
     virtual vector<Goal> run();
 private:
-    list<Quad> detectQuads(const vector<ColourSegment>& h_segments, const vector<ColourSegment>& v_segments);
+    list<Quad> detectQuads(const SegmentScan& h_segments, const SegmentScan& v_segments);
     Histogram1D mergePeaks(Histogram1D hist, int minimum_threshold);
     list<Quad> generateCandidates(const Histogram1D& hist,
-                                  const vector<ColourSegment>& h_segments, const vector<ColourSegment>& v_segments,
+                                  const SegmentScan& h_segments, const SegmentScan& v_segments,
                                   int peak_threshold);
-    Quad makeQuad(Bin bin, const vector<ColourSegment>& h_segments, const vector<ColourSegment>& v_segments);
+    Quad makeQuad(Bin bin, const SegmentScan& h_segments, const SegmentScan& v_segments);
 
     //minor methods
     bool checkBinSimilarity(Bin b1, Bin b2, float allowed_dissimilarity);
@@ -26,8 +26,8 @@ vector<Goal> GoalDetectorRANSACEdges::run()
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
     const Horizon& khorizon = vbb->getKinematicsHorizon();
     //get transitions associated with goals
-    vector<ColourSegment> hsegments = vbb->getHorizontalTransitions(GOAL_COLOUR),
-                          vsegments = vbb->getVerticalTransitions(GOAL_COLOUR);
+    const SegmentScan& hsegments = vbb->getHorizontalTransitions(GOAL_COLOUR);
+    const SegmentScan& vsegments = vbb->getVerticalTransitions(GOAL_COLOUR);
     list<Quad> quads,
                post_candidates;
     pair<bool, Quad> crossbar(false, Quad());
@@ -44,13 +44,13 @@ vector<Goal> GoalDetectorRANSACEdges::run()
     }
 
     //use generic ransac implementation to find start lines (left edges)
-    ransac_results = RANSAC::findMultipleModels<RANSACLine<Point>, Point>(start_points, m_e, m_n, m_k, m_max_iterations, ransac_method);
+    ransac_results = RANSAC::findMultipleModels<RANSACLine<Point>, Point>(start_points, m_e, m_n, m_k, m_max_iterations, ransac_method, VisionConstants::RANSAC_CONFIDENCE);
     for(size_t i=0; i<ransac_results.size(); i++) {
         start_lines.push_back(LSFittedLine(ransac_results.at(i).second));
     }
 
     //use generic ransac implementation to find end lines (right edges)
-    ransac_results = RANSAC::findMultipleModels<RANSACLine<Point>, Point>(end_points, m_e, m_n, m_k, m_max_iterations, ransac_method);
+    ransac_results = RANSAC::findMultipleModels<RANSACLine<Point>, Point>(end_points, m_e, m_n, m_k, m_max_iterations, ransac_method, VisionConstants::RANSAC_CONFIDENCE);
     for(size_t i=0; i<ransac_results.size(); i++) {
         end_lines.push_back(LSFittedLine(ransac_results.at(i).second));
     }
@@ -6,9 +6,15 @@
 #include "debugverbosityvision.h"
 
 #include <limits>
+#include <algorithm>
 #include <stdlib.h>
 #include <boost/foreach.hpp>
 
+static bool nearerToRobot(const GroundPoint& a, const GroundPoint& b)
+{
+    return a.ground.squareAbs() < b.ground.squareAbs();
+}
+
 LineDetectorRANSAC::LineDetectorRANSAC()
 {
     m_n = 15;               //min pts to line essentially
@@ -24,7 +30,17 @@ vector<FieldLine> LineDetectorRANSAC::run(const vector<GroundPoint>& points)
     vector<FieldLine> finalLines;
 
     // find possible line candidates using RANSAC in the ground plane
-    candidates = RANSAC::findMultipleModels<RANSACLine<GroundPoint>, GroundPoint>(points, m_e, m_n, m_k, m_max_iterations, RANSAC::BestFittingConsensus);
+    if(VisionConstants::RANSAC_PROGRESSIVE_SAMPLING) {
+        // the nearest points are projected most accurately, so they are sampled first
+        vector<GroundPoint> sorted_points = points;
+        std::stable_sort(sorted_points.begin(), sorted_points.end(), nearerToRobot);
+        candidates = RANSAC::findMultipleModels<RANSACLine<GroundPoint>, GroundPoint>(sorted_points, m_e, m_n, m_k, m_max_iterations, RANSAC::BestFittingConsensus,
+                                                                                      VisionConstants::RANSAC_CONFIDENCE, RANSAC::ProgressiveSampling);
+    }
+    else {
+        candidates = RANSAC::findMultipleModels<RANSACLine<GroundPoint>, GroundPoint>(points, m_e, m_n, m_k, m_max_iterations, RANSAC::BestFittingConsensus,
+                                                                                      VisionConstants::RANSAC_CONFIDENCE);
+    }
 
     /// @todo perhaps find amount of green along line and remove based on threshold?
 
@@ -10,12 +10,12 @@ BallDetector::~BallDetector() {}
 vector<Ball> BallDetector::run()
 {
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
-    NUImage img = vbb->getOriginalImage();
+    const NUImageView& img = vbb->getImageView();
     const LookUpTable& lut = vbb->getLUT();
     // BEGIN BALL DETECTION -----------------------------------------------------------------
 
-    vector<ColourSegment> v_segments = vbb->getVerticalTransitions(BALL_COLOUR);
-    vector<ColourSegment> h_segments = vbb->getHorizontalTransitions(BALL_COLOUR);
+    const SegmentScan& v_segments = vbb->getVerticalTransitions(BALL_COLOUR);
+    const SegmentScan& h_segments = vbb->getHorizontalTransitions(BALL_COLOUR);
     vector<Point> edges;
     vector<Ball> balls; //will only ever hold one
 
@@ -294,9 +294,9 @@ vector<Ball> BallDetector::run()
     return balls;
 }
 
-void BallDetector::appendEdgesFromSegments(const vector<ColourSegment> &segments, vector< Point > &pointlist)
+void BallDetector::appendEdgesFromSegments(const SegmentScan &segments, vector< Point > &pointlist)
 {
-    vector<ColourSegment>::const_iterator it;
+    SegmentScan::const_iterator it;
     for(it = segments.begin(); it < segments.end(); it++) {
         pointlist.push_back(it->getStart());
         pointlist.push_back(it->getEnd());
@@ -23,7 +23,7 @@ public:
     virtual vector<Ball> run();
 
 protected:
-    void appendEdgesFromSegments(const vector<ColourSegment>& segments, vector<Point> &pointlist);
+    void appendEdgesFromSegments(const SegmentScan& segments, vector<Point> &pointlist);
 };
 
 #endif // BALLDETECTION_H
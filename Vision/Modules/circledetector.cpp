@@ -38,7 +38,7 @@ bool CircleDetector::run(vector<GroundPoint> &points, CentreCircle &result)
     // attemp multiple RANSAC fits
 
     // run first iterations
-    modelfound = RANSAC::findModel<RANSACCircle<GroundPoint>, GroundPoint>(points, candidate, consensus, remainder, variance, m_e, m_n, m_k, RANSAC::LargestConsensus);
+    modelfound = RANSAC::findModel<RANSACCircle<GroundPoint>, GroundPoint>(points, candidate, consensus, remainder, variance, m_e, m_n, m_k, RANSAC::LargestConsensus, VisionConstants::RANSAC_CONFIDENCE);
 
     //continue while models are found but not a final version
     while(modelfound && i < m_max_iterations) {
@@ -65,7 +65,7 @@ bool CircleDetector::run(vector<GroundPoint> &points, CentreCircle &result)
         }
         else {
             // model isn't good enough, reattempt with remainder
-            modelfound = RANSAC::findModel<RANSACCircle<GroundPoint>, GroundPoint>(remainder, candidate, consensus, remainder, variance, m_e, m_n, m_k, RANSAC::LargestConsensus);
+            modelfound = RANSAC::findModel<RANSACCircle<GroundPoint>, GroundPoint>(remainder, candidate, consensus, remainder, variance, m_e, m_n, m_k, RANSAC::LargestConsensus, VisionConstants::RANSAC_CONFIDENCE);
         }
 
         i++;
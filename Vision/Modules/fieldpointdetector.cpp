@@ -2,7 +2,9 @@
 #include "Vision/VisionTypes/coloursegment.h"
 #include "Vision/VisionTypes/greenhorizon.h"
 #include "Vision/visionblackboard.h"
+#include "Vision/VisionTypes/fieldpointset.h"
 #include <boost/foreach.hpp>
+#include <fstream>
 #include "debug.h"
 #include "debugverbosityvision.h"
 
@@ -51,7 +53,13 @@ void FieldPointDetector::run(bool find_circle, bool find_lines, bool find_corner
             DataWrapper::getInstance()->plotCurve("Screen coords", plotpts);
             #endif
             //map those points to the ground plane
-            transformer.screenToGroundCartesian(points);
+            transformer.screenToGroundCartesianBatch(points);
+
+            #if VISION_FIELDPOINT_VERBOSITY > 2
+            //record the point sets for RANSACBenchmark
+            static ofstream point_file("fieldpoints.txt");
+            writeFieldPointSet(point_file, points);
+            #endif
 
             #if VISION_FIELDPOINT_VERBOSITY > 1
             plotpts.clear();
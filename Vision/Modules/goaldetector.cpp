@@ -53,7 +53,7 @@ void GoalDetector::mergeClose(list<Quad> &posts, double width_multiple_to_merge)
     }
 }
 
-Vector2<double> GoalDetector::calculateSegmentLengthStatistics(const vector<ColourSegment> segments)
+Vector2<double> GoalDetector::calculateSegmentLengthStatistics(const SegmentScan& segments)
 {
     accumulator_set<double, stats<tag::mean, tag::variance> > acc;
 
@@ -27,7 +27,7 @@ protected:
     void mergeClose(list<Quad> &posts, double width_multiple_to_merge);
 
     //generic
-    Vector2<double> calculateSegmentLengthStatistics(const vector<ColourSegment> segments);
+    Vector2<double> calculateSegmentLengthStatistics(const SegmentScan& segments);
 
     vector<Goal> assignGoals(const list<Quad>& candidates) const;
 };
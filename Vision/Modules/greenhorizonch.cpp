@@ -7,12 +7,12 @@
 */
 
 #include "greenhorizonch.h"
-#include "Kinematics/Horizon.h"
 #include "debug.h"
 #include "debugverbosityvision.h"
 #include "Vision/visionconstants.h"
 
 #include <boost/foreach.hpp>
+#include <cmath>
 
 //for stat
 #include <boost/accumulators/accumulators.hpp>
@@ -22,6 +22,15 @@
 
 using namespace boost::accumulators;
 
+vector<int> GreenHorizonCH::previous_tops;
+Horizon GreenHorizonCH::previous_kin_hor;
+double GreenHorizonCH::previous_yaw = 0;
+bool GreenHorizonCH::previous_yaw_valid = false;
+int GreenHorizonCH::previous_width = 0;
+int GreenHorizonCH::previous_height = 0;
+int GreenHorizonCH::previous_spacing = 0;
+unsigned int GreenHorizonCH::frames_since_full_scan = 0;
+
 void GreenHorizonCH::calculateHorizon()
 {
     #if VISION_HORIZON_VERBOSITY > 1
@@ -29,7 +38,8 @@ void GreenHorizonCH::calculateHorizon()
     #endif
     // get blackboard instance
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
-    const NUImage& img = vbb->getOriginalImage();
+    const NUImageView& img = vbb->getImageView();
+    const LookUpTable& lut = vbb->getLUT();
     int width = img.getWidth(),
         height = img.getHeight();
 
@@ -51,43 +61,61 @@ void GreenHorizonCH::calculateHorizon()
     debug << "GreenHorizonCH::calculateHorizon() - (if seg fault occurs camera or camera cable may be faulty)" << endl;
 #endif
 
-    for (int x = 0; x < width; x+=SPACING) {
-
-        unsigned int green_top = 0;
-        unsigned int green_count = 0;
+    //the previous frame can only seed this one if it was scanned the same way
+    const Transformer& transformer = vbb->getTransformer();
+    bool incremental = VisionConstants::GREEN_HORIZON_INCREMENTAL &&
+                       width == previous_width && height == previous_height && SPACING == previous_spacing &&
+                       frames_since_full_scan < VisionConstants::GREEN_HORIZON_FULL_SCAN_PERIOD;
+    //turning the head left moves the previous frame's columns right by the yaw change times the focal length
+    double yaw_offset = 0;
+    if(incremental && transformer.isCameraYawValid() && previous_yaw_valid)
+        yaw_offset = (transformer.getCameraYaw() - previous_yaw)*transformer.getCameraDistanceInPixels();
+
+    const SubsampledImage& coarse = vbb->getSubsampledImage();
+    const int FACTOR = coarse.getFactor();
+    vector<int> tops;
+    tops.reserve(width/SPACING + 1);
+    unsigned int full_scans = 0;
 
+    for (int x = 0; x < width; x+=SPACING) {
 
         kin_hor_y = kin_hor.findYFromX(x);
         //clamp green horizon values
         kin_hor_y = max(0, kin_hor_y);
         kin_hor_y = min(height-1, kin_hor_y);
 
-
-        for (int y = kin_hor_y; y < height; y++) {
-
-            if (isPixelGreen(img, x, y)) {
-                if (green_count == 0) {
-                    green_top = y;
-                }
-                green_count++;
-                // if VER_THRESHOLD green pixels found, add point
-                if (green_count == VisionConstants::GREEN_HORIZON_MIN_GREEN_PIXELS) {
-                    horizon_points.push_back(Vector2<double>(x, green_top));
-                    break;
-                }
-            }
-            else {
-                // not green - reset
-                green_count = 0;
-            }
-            // if no green found, add bottom pixel
-            if (y == height-1) {
-                horizon_points.push_back(Vector2<double>(x, height-1));
-            }
+        int predicted = incremental ? predictHorizon(x, yaw_offset, kin_hor) : -1;
+        int green_top;
+        if (coarse.valid()) {
+            //walk down the coarse column from the first coarse row below the horizon
+            green_top = findHorizon(lut, coarse.getColumn(x, kin_hor_y), coarse.ceilToCoarse(kin_hor_y)*FACTOR, FACTOR, predicted, full_scans);
+        }
+        else {
+            //walk down the column from the horizon, the flip is resolved once by the span
+            green_top = findHorizon(lut, img->getColumnSpan(x, kin_hor_y), kin_hor_y, 1, predicted, full_scans);
         }
 
+        // if no green found, add bottom pixel
+        if (green_top < 0)
+            green_top = height-1;
+        horizon_points.push_back(Vector2<double>(x, green_top));
+        tops.push_back(green_top);
     }
 
+    //keep this frame to seed the next
+    previous_tops.swap(tops);
+    previous_kin_hor = kin_hor;
+    previous_yaw_valid = transformer.isCameraYawValid();
+    previous_yaw = transformer.getCameraYaw();
+    previous_width = width;
+    previous_height = height;
+    previous_spacing = SPACING;
+    frames_since_full_scan = incremental ? frames_since_full_scan + 1 : 0;
+
+#if VISION_HORIZON_VERBOSITY > 2
+    debug << "GreenHorizonCH::calculateHorizon() - " << (incremental ? "incremental" : "full") << " search, " << full_scans << " columns fully scanned" << endl;
+#endif
+
 #if VISION_HORIZON_VERBOSITY > 2
     debug << "GreenHorizonCH::calculateHorizon() - Green scans done" << endl;
 #endif
@@ -142,11 +170,70 @@ void GreenHorizonCH::calculateHorizon()
     vbb->setGreenHullPoints(horizon_points);
 }
 
+template <typename Column>
+int GreenHorizonCH::findHorizon(const LookUpTable& lut, const Column& column, int origin, int unit, int predicted, unsigned int& full_scans)
+{
+    //the thresholds are in pixels, a coarse column has unit pixels per element
+    const int MIN_GREEN = (VisionConstants::GREEN_HORIZON_MIN_GREEN_PIXELS + unit - 1)/unit;
+    const int WINDOW = (VisionConstants::GREEN_HORIZON_SEARCH_WINDOW + unit - 1)/unit;
+    int run = -1;
+
+    if (predicted >= 0) {
+        //search the window around the prediction, then walk up to where the run really starts
+        int centre = (predicted - origin)/unit;
+        int begin = max(0, centre - WINDOW);
+        int end = min(column.length, centre + WINDOW + MIN_GREEN);
+        run = findGreenRun(lut, column, begin, end, MIN_GREEN);
+        while (run > 0 && isPixelGreen(lut, column[run-1]))
+            run--;
+    }
+    if (run < 0) {
+        run = findGreenRun(lut, column, 0, column.length, MIN_GREEN);
+        full_scans++;
+    }
+    return run < 0 ? -1 : origin + run*unit;
+}
+
+template <typename Column>
+int GreenHorizonCH::findGreenRun(const LookUpTable& lut, const Column& column, int begin, int end, int min_green)
+{
+    int green_top = begin;
+    int green_count = 0;
+    for (int i = begin; i < end; i++) {
+        if (isPixelGreen(lut, column[i])) {
+            if (green_count == 0) {
+                green_top = i;
+            }
+            green_count++;
+            // if VER_THRESHOLD green pixels found, the run starts at green_top
+            if (green_count >= min_green) {
+                return green_top;
+            }
+        }
+        else {
+            // not green - reset
+            green_count = 0;
+        }
+    }
+    return -1;
+}
+
+int GreenHorizonCH::predictHorizon(int x, double yaw_offset, const Horizon& kin_hor)
+{
+    //the previous frame's column nearest to where this one was
+    double previous_x = x - yaw_offset;
+    int i = static_cast<int>(floor(previous_x/previous_spacing + 0.5));
+    if (i < 0 || i >= static_cast<int>(previous_tops.size()) || previous_tops[i] >= previous_height-1)
+        return -1;
+
+    //pitch and roll move the field by as much as they move the kinematics horizon
+    int shift = kin_hor.findYFromX(x) - previous_kin_hor.findYFromX(i*previous_spacing);
+    return previous_tops[i] + shift;
+}
 
-bool GreenHorizonCH::isPixelGreen(const NUImage& img, int x, int y)
+bool GreenHorizonCH::isPixelGreen(const LookUpTable& lut, const Pixel& p)
 {
-    const LookUpTable& LUT = VisionBlackboard::getInstance()->getLUT();
-    return getColourFromIndex(LUT.classifyPixel(img(x,y))) == green;
+    return getColourFromIndex(lut.classifyPixel(p)) == green;
 }
 
 // Returns a list of points on the upper convex hull in clockwise order.
@@ -13,6 +13,7 @@
 #include <iostream>
 
 #include "Tools/Math/Line.h"
+#include "Kinematics/Horizon.h"
 
 #include "Vision/visionblackboard.h"
 #include "Vision/VisionTools/classificationcolours.h"
@@ -25,9 +26,49 @@ public:
     /**
     *   @brief  calculate green horzion.    
     *   @note   updates blackboard with horizon points.
+    *
+    *   When the image is subsampled only the coarse columns and rows are searched.
+    *   When VisionConstants::GREEN_HORIZON_INCREMENTAL is set each column is first searched within
+    *   GREEN_HORIZON_SEARCH_WINDOW rows of where the previous frame's horizon is predicted to be, and
+    *   the whole column is only scanned if no green is found there. The prediction shifts the previous
+    *   columns by the change in camera yaw, and their rows by the change in the kinematics horizon.
     */
     static void calculateHorizon();
 private:
+    /**
+    *   @brief  find the green horizon in a column, searching near the prediction first.
+    *   @param  lut The colour look up table.
+    *   @param  column The column, an NUImage::Span or a SubsampledImage::Column.
+    *   @param  origin The row of the first element of the column.
+    *   @param  unit The number of rows between elements of the column.
+    *   @param  predicted The predicted row, or -1 to scan the whole column.
+    *   @param  full_scans Incremented if the whole column is scanned.
+    *   @return the row the green starts at, or -1 if there is none.
+    */
+    template <typename Column>
+    static int findHorizon(const LookUpTable& lut, const Column& column, int origin, int unit, int predicted, unsigned int& full_scans);
+
+    /**
+    *   @brief  find the first run of green elements in part of a column.
+    *   @param  lut The colour look up table.
+    *   @param  column The column.
+    *   @param  begin The index in the column to start the search.
+    *   @param  end One past the last index in the column the run may use.
+    *   @param  min_green The number of consecutive green elements needed.
+    *   @return the index the run starts at, or -1 if there is none.
+    */
+    template <typename Column>
+    static int findGreenRun(const LookUpTable& lut, const Column& column, int begin, int end, int min_green);
+
+    /**
+    *   @brief  predict the green horizon in a column from the previous frame.
+    *   @param  x The column.
+    *   @param  yaw_offset The number of pixels the previous frame's columns have moved right.
+    *   @param  kin_hor The kinematics horizon of the current frame.
+    *   @return the predicted row, or -1 if the previous frame has no green horizon near the column.
+    */
+    static int predictHorizon(int x, double yaw_offset, const Horizon& kin_hor);
+
     /**
     *   @brief  determine whether pixel is green.
     *   @param  img The original image.
@@ -35,7 +76,9 @@ private:
     *   @param  y The pixel y coordinate.
     *   @return whether the pixel is green
     */
-    static bool isPixelGreen(const NUImage& img, int x, int y);
+    static bool isPixelGreen(const LookUpTable& lut, const Pixel& p);
+    //! @brief  determine whether a colour index from the subsampled image is green.
+    static bool isPixelGreen(const LookUpTable& /*lut*/, unsigned char index) {return getColourFromIndex(index) == green;}
 
     // 2D cross product of OA and OB vectors, i.e. z-component of their 3D cross product.
     // Returns a positive value, if OAB makes a counter-clockwise turn,
@@ -48,6 +91,15 @@ private:
     // Returns a list of points on the convex hull in counter-clockwise order.
     // Note: the last point in the returned list is the same as the first one.
     static vector< Vector2<double> > upperConvexHull(const vector< Vector2<double> >& points);
+
+    //! STATE FOR THE INCREMENTAL SEARCH
+    static vector<int> previous_tops;               //! @variable the green horizon row of each column scanned in the previous frame.
+    static Horizon previous_kin_hor;                //! @variable the kinematics horizon of the previous frame.
+    static double previous_yaw;                     //! @variable the camera yaw of the previous frame.
+    static bool previous_yaw_valid;                 //! @variable whether the camera yaw of the previous frame was valid.
+    static int previous_width, previous_height;     //! @variable the image size of the previous frame.
+    static int previous_spacing;                    //! @variable the scan spacing of the previous frame.
+    static unsigned int frames_since_full_scan;     //! @variable the number of frames searched incrementally since the last full scan.
     //! CONSTANTS
     //static const unsigned int VER_SEGMENTS = 30;            //! @variable number of vertical scan segments.
     //static const unsigned int VER_THRESHOLD = 5;            //! @variable number of consecutive green pixels required.
@@ -27,9 +27,11 @@ void ObjectDetectionCH::detectObjects()
     #endif
     // get blackboard instance
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
-    const NUImage& img = vbb->getOriginalImage();
+    const NUImageView& img = vbb->getImageView();
+    const LookUpTable& lut = vbb->getLUT();
     unsigned int height = img.getHeight();
     const GreenHorizon& green_horizon = vbb->getGreenHorizon();
+    const SubsampledImage& coarse = vbb->getSubsampledImage();
     vector< Vector2<double> > horizon_points;
     vector<Point> object_points;
     double mean_y,
@@ -57,10 +59,43 @@ void ObjectDetectionCH::detectObjects()
         if (static_cast<unsigned int>(horizon_points.at(x).y) == height-1) {
             object_points.push_back(Point(horizon_points.at(x).x, height-1));
         }
+        else if (coarse.valid()) {
+            // scan the coarse column from the first coarse row below the point, VER_THRESHOLD is in pixels
+            SubsampledImage::Column column = coarse.getColumn(horizon_points.at(x).x, horizon_points.at(x).y);
+            int factor = coarse.getFactor();
+            int first_row = coarse.ceilToCoarse(horizon_points.at(x).y)*factor;
+            int threshold = max(1, (static_cast<int>(VER_THRESHOLD) + factor - 1)/factor);
+            int green_top = 0;
+            int green_count = 0;
+            int i = 0;
+            for (; i < column.length; i++) {
+                if (getColourFromIndex(column[i]) == green) {
+                    if (green_count == 0) {
+                        green_top = first_row + i*factor;
+                    }
+                    green_count++;
+                    if (green_count == threshold) {
+                        if (green_top > mean_y + OBJECT_THRESHOLD_MULT*std_dev_y + 1) {
+                            object_points.push_back(Point(horizon_points.at(x).x, first_row + i*factor));
+                        }
+                        break;
+                    }
+                }
+                else {
+                    green_count = 0;
+                }
+            }
+            // if bottom reached without green, add bottom point
+            if (i == column.length) {
+                object_points.push_back(Point(horizon_points.at(x).x, height-1));
+            }
+        }
         else {
             // scan from point to bottom of image
-            for (unsigned int y = horizon_points.at(x).y; y < height; y++) {
-                if (isPixelGreen(img, horizon_points.at(x).x, y)){
+            NUImage::Span column = img->getColumnSpan(horizon_points.at(x).x, horizon_points.at(x).y);
+            const Pixel* px = column.first;
+            for (unsigned int y = horizon_points.at(x).y; y < height; y++, px += column.step) {
+                if (isPixelGreen(lut, *px)){
                     if (green_count == 1) {
                         green_top = y;
                     }
@@ -137,8 +172,7 @@ void ObjectDetectionCH::detectObjects()
 }
 
 
-bool ObjectDetectionCH::isPixelGreen(const NUImage& img, int x, int y)
+bool ObjectDetectionCH::isPixelGreen(const LookUpTable& lut, const Pixel& p)
 {
-    const LookUpTable& LUT = VisionBlackboard::getInstance()->getLUT();
-    return getColourFromIndex(LUT.classifyPixel(img(x,y))) == green;
+    return getColourFromIndex(lut.classifyPixel(p)) == green;
 }
@@ -29,7 +29,7 @@ private:
     *   @param  y The pixel y coordinate.
     *   @return whether the pixel is green
     */
-    static bool isPixelGreen(const NUImage& img, int x, int y);
+    static bool isPixelGreen(const LookUpTable& lut, const Pixel& p);
 
     //! CONSTANTS
     static const unsigned int VER_THRESHOLD = 2;                //! @variable number of consecutive green pixels required.
@@ -8,6 +8,7 @@
 #include "scanlines.h"
 #include "debug.h"
 #include "Vision/visionconstants.h"
+#include "Vision/VisionTools/scanlineclassifier.h"
 #include <boost/foreach.hpp>
 
 void ScanLines::generateScanLines()
@@ -34,10 +35,14 @@ void ScanLines::generateScanLines()
     if(bottom_horizontal_scan >= vbb->getImageHeight())
         errorlog << "avg: " << bottom_horizontal_scan << endl;
 
+    //when subsampling the scans are moved up onto the coarse rows, so they can be read coarse first
+    int factor = vbb->getSubsampledImage().getFactor();
     for (int y = bottom_horizontal_scan; y >= 0; y -= VisionConstants::HORIZONTAL_SCANLINE_SPACING) {
         if(y >= vbb->getImageHeight())
             errorlog << " y: " << y << endl;
-        horizontal_scan_lines.push_back(y);
+        int scan_y = y - y % factor;
+        if(horizontal_scan_lines.empty() || horizontal_scan_lines.back() != scan_y)
+            horizontal_scan_lines.push_back(scan_y);
     }
     
     vbb->setHorizontalScanlines(horizontal_scan_lines);
@@ -46,12 +51,13 @@ void ScanLines::generateScanLines()
 void ScanLines::classifyHorizontalScanLines()
 {
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
-    const NUImage& img = vbb->getOriginalImage();
+    const NUImage& img = vbb->getImageView().image();
     const vector<int>& horizontal_scan_lines = vbb->getHorizontalScanlines();
-    vector< vector<ColourSegment> > classifications;
+    SegmentScans classifications;
 
+    classifications.reserve(horizontal_scan_lines.size());
     BOOST_FOREACH(int y, horizontal_scan_lines) {
-        classifications.push_back(classifyHorizontalScan(vbb->getLUT(), img, y));
+        classifications.push_back(classifyHorizontalScan(vbb->getLUT(), img, vbb->getSubsampledImage(), y));
     }
     
     vbb->setHorizontalSegments(classifications);
@@ -60,46 +66,27 @@ void ScanLines::classifyHorizontalScanLines()
 void ScanLines::classifyVerticalScanLines()
 {
     VisionBlackboard* vbb = VisionBlackboard::getInstance();
-    const NUImage& img = vbb->getOriginalImage();
+    const NUImage& img = vbb->getImageView().image();
     const vector<Vector2<double> >& vertical_start_points = vbb->getGreenHorizon().getInterpolatedSubset(VisionConstants::VERTICAL_SCANLINE_SPACING);
-    vector< vector<ColourSegment> > classifications;
+    SegmentScans classifications;
 
+    classifications.reserve(vertical_start_points.size());
     for(unsigned int i=0; i<vertical_start_points.size(); i++) {
-        classifications.push_back(classifyVerticalScan(vbb->getLUT(), img, vertical_start_points.at(i)));
+        classifications.push_back(classifyVerticalScan(vbb->getLUT(), img, vbb->getSubsampledImage(), vertical_start_points.at(i)));
     }
     
     vbb->setVerticalSegments(classifications);
 }
 
-vector<ColourSegment> ScanLines::classifyHorizontalScan(const LookUpTable& lut, const NUImage& img, unsigned int y)
+SegmentScan ScanLines::classifyHorizontalScan(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, unsigned int y)
 {
-    vector<ColourSegment> result;
+    SegmentScan result;
 	if(y < 0 || y >= img.getHeight()) {
 		errorlog << "ScanLines::classifyHorizontalScan invalid y: " << y << endl;
 		return result;
 	}
-    //simple and nasty first
-    //Colour previous, current, next
-    int     start_pos = 0,
-            x;
-    Colour start_colour = getColourFromIndex(lut.classifyPixel(img(0,y)));
-    Colour current_colour;
-    ColourSegment segment;
 
-    for(x = 0; x < img.getWidth(); x++) {
-        current_colour = getColourFromIndex(lut.classifyPixel(img(x,y)));
-        if(current_colour != start_colour) {
-            //start of new segment
-            //make new segment and push onto vector
-            segment.set(Point(start_pos, y), Point(x, y), start_colour);
-            result.push_back(segment);
-            //start new segment
-            start_colour = current_colour;
-            start_pos = x;
-        }
-    }
-    segment.set(Point(start_pos, y), Point(x-1, y), start_colour);
-    result.push_back(segment);
+    ScanLineClassifier::classifyHorizontal(lut, img, coarse, y, result);
     
     #if VISION_SCANLINE_VERBOSITY > 1
         Point end;
@@ -111,36 +98,17 @@ vector<ColourSegment> ScanLines::classifyHorizontalScan(const LookUpTable& lut,
     return result;
 }
 
-vector<ColourSegment> ScanLines::classifyVerticalScan(const LookUpTable& lut, const NUImage& img, const Vector2<double> &start)
+SegmentScan ScanLines::classifyVerticalScan(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, const Vector2<double> &start)
 {
-    vector<ColourSegment> result;
+    SegmentScan result;
     if(start.y >= img.getHeight() || start.y < 0 || start.x >= img.getWidth() || start.x < 0) {
 		errorlog << "ScanLines::classifyVerticalScan invalid start position: " << start << endl; 
 		return result;
     }
-    //simple and nasty first
-    //Colour previous, current, next
-    Colour start_colour = getColourFromIndex(lut.classifyPixel(img(start.x,start.y))),
-                        current_colour;
-    ColourSegment segment;
-    int     start_pos = start.y,
-            x = start.x,
-            y;
-            
-    for(y = start.y; y < img.getHeight(); y++) {
-        current_colour = getColourFromIndex(lut.classifyPixel(img(x,y)));
-        if(current_colour != start_colour) {
-            //start of new segment
-            //make new segment and push onto vector
-            segment.set(Point(x, start_pos), Point(x, y), start_colour);
-            result.push_back(segment);
-            //start new segment
-            start_colour = current_colour;
-            start_pos = y;
-        }
-    }
-    segment.set(Point(x, start_pos), Point(x, y), start_colour);
-    result.push_back(segment);
+
+    //when subsampling the scan is moved left onto the nearest coarse column, so it can be read coarse first
+    int x = start.x;
+    ScanLineClassifier::classifyVertical(lut, img, coarse, x - x % coarse.getFactor(), start.y, result);
     
     return result;
 }
@@ -38,13 +38,13 @@ public:
     
 private:
     /**
-    *   @brief  classifies a single horizontal scanline.
+    *   @brief  classifies a single horizontal scanline, coarse first if the image is being subsampled.
     */
-    static vector<ColourSegment> classifyHorizontalScan(const LookUpTable& lut, const NUImage& img, unsigned int y);
+    static SegmentScan classifyHorizontalScan(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, unsigned int y);
     /**
-    *   @brief  classifies a single vertical scanline.
+    *   @brief  classifies a single vertical scanline, coarse first if the image is being subsampled.
     */
-    static vector<ColourSegment> classifyVerticalScan(const LookUpTable& lut, const NUImage& img, const Vector2<double>& start);
+    static SegmentScan classifyVerticalScan(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, const Vector2<double>& start);
     
     
 };
@@ -15,9 +15,9 @@ SegmentFilter::SegmentFilter()
 }
 
 double averageLength(const SegmentedRegion& scans, Colour colour) {
-    const vector<vector<ColourSegment> >& segments = scans.getSegments();
-    vector<vector<ColourSegment> >::const_iterator line_it;
-    vector<ColourSegment>::const_iterator seg_it;
+    const SegmentScans& segments = scans.getSegments();
+    SegmentScans::const_iterator line_it;
+    SegmentScan::const_iterator seg_it;
     double sum = 0,
            num = 0;
     //loop through each scan
@@ -42,7 +42,7 @@ void SegmentFilter::run() const
     const SegmentedRegion& h_segments = vbb->getHorizontalSegmentedRegion();
     const SegmentedRegion& v_segments = vbb->getVerticalSegmentedRegion();
     SegmentedRegion h_filtered, v_filtered;
-    map<COLOUR_CLASS, vector<ColourSegment> > h_result, v_result;
+    TransitionMap h_result, v_result;
     
     if(PREFILTER_ON) {
 
@@ -72,16 +72,16 @@ void SegmentFilter::run() const
     
 #if VISION_FILTER_VERBOSITY > 1
     ofstream outfile("1.txt");
-    outfile << h_segments.getSegments();
+    outfile << h_segments;
     outfile.close();
     outfile.open("1f.txt");
-    outfile << h_filtered.getSegments();
+    outfile << h_filtered;
     outfile.close();
     outfile.open("2.txt");
-    outfile << v_segments.getSegments();
+    outfile << v_segments;
     outfile.close();
     outfile.open("2f.txt");
-    outfile << v_filtered.getSegments();
+    outfile << v_filtered;
     outfile.close();
 #endif
     //push results to BB
@@ -91,12 +91,12 @@ void SegmentFilter::run() const
 
 void SegmentFilter::preFilter(const SegmentedRegion &scans, SegmentedRegion &result) const
 {
-    const vector<vector<ColourSegment> >& segments = scans.getSegments();
-    vector<vector<ColourSegment> >& final_segments = result.m_segmented_scans;
-    vector<ColourSegment> line;
+    const SegmentScans& segments = scans.getSegments();
+    SegmentScans& final_segments = result.m_segmented_scans;
+    SegmentScan line;
     
-    vector<vector<ColourSegment> >::const_iterator line_it;
-    vector<ColourSegment>::const_iterator before_it, middle_it, after_it;
+    SegmentScans::const_iterator line_it;
+    SegmentScan::const_iterator before_it, middle_it, after_it;
     ScanDirection dir = scans.getDirection();
     
     result.m_direction = dir;
@@ -128,71 +128,83 @@ void SegmentFilter::preFilter(const SegmentedRegion &scans, SegmentedRegion &res
     }
 }
 
-void SegmentFilter::filter(const SegmentedRegion &scans, map<COLOUR_CLASS, vector<ColourSegment> > &result) const
+void SegmentFilter::filter(const SegmentedRegion &scans, TransitionMap &result) const
 {
+    const vector<ColourTransitionRule>* rules;
+    const ColourRuleTable<ColourTransitionRule>* table;
+
     switch(scans.getDirection()) {
     case VERTICAL:
-        BOOST_FOREACH(const ColourTransitionRule& rule, rules_v) {
-            vector<ColourSegment>& segments = result[rule.getColourClass()];
-            checkRuleAgainstRegion(scans, rule, segments);
-        }
+        rules = &rules_v;
+        table = &rules_table_v;
         break;
     case HORIZONTAL:
-        BOOST_FOREACH(const ColourTransitionRule& rule, rules_h) {
-            vector<ColourSegment>& segments = result[rule.getColourClass()];
-            checkRuleAgainstRegion(scans, rule, segments);
-        }
+        rules = &rules_h;
+        table = &rules_table_h;
         break;
     default:
         errorlog << "SegmentFilter::filter - invalid direction";
         return;
-    }   
-}
+    }
 
-void SegmentFilter::checkRuleAgainstRegion(const SegmentedRegion &scans, const ColourTransitionRule &rule, vector<ColourSegment> &matches) const
-{
-    const vector<vector<ColourSegment> >& segments = scans.getSegments();
-    vector<ColourSegment>::const_iterator it;
+    //the matches of each rule, kept separate so the buckets are filled rule by rule as before
+    vector< vector<const ColourSegment*> > matches(rules->size());
+    const SegmentScans& segments = scans.getSegments();
+    SegmentScan::const_iterator it;
 
     //loop through each scan
-    BOOST_FOREACH(const vector<ColourSegment>& vs, segments) {
+    BOOST_FOREACH(const SegmentScan& vs, segments) {
         // Only check for multiple segments
         if(vs.size() > 1) {
             //move down segments in scan pairwise
             it = vs.begin();
             //first check start pair alone
-            if(rule.match(ColourTransitionRule::nomatch, *it, *(it+1))) {
-                matches.push_back(*it);
-            }
+            checkTripletAgainstRules(ColourTransitionRule::nomatch, *it, *(it+1), *rules, *table, matches);
             it++;
             //then check the rest in triplets
             while(it < vs.end() - 1) {
-                if(rule.match(*(it-1), *it, *(it+1))) {
-                    matches.push_back(*it);
-                }
+                checkTripletAgainstRules(*(it-1), *it, *(it+1), *rules, *table, matches);
                 it++;
             }
             //lastly check final pair alone
-            if(rule.match(*(it-1), *it, ColourTransitionRule::nomatch)) {
-                matches.push_back(*it);
-            }
+            checkTripletAgainstRules(*(it-1), *it, ColourTransitionRule::nomatch, *rules, *table, matches);
+        }
+    }
+
+    for(unsigned int i = 0; i < rules->size(); i++) {
+        SegmentScan& class_segments = result[(*rules)[i].getColourClass()];
+        BOOST_FOREACH(const ColourSegment* seg, matches[i]) {
+            class_segments.push_back(*seg);
         }
     }
 }
 
-void SegmentFilter::applyReplacements(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after, vector<ColourSegment>& replacements, ScanDirection dir) const
+void SegmentFilter::checkTripletAgainstRules(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after,
+                                             const vector<ColourTransitionRule>& rules, const ColourRuleTable<ColourTransitionRule>& table,
+                                             vector< vector<const ColourSegment*> >& matches) const
 {
-    vector<ColourReplacementRule>::const_iterator rules_it, begin, end;
+    ColourRuleTable<ColourTransitionRule>::Candidates candidates = table.lookup(before.getColour(), middle.getColour(), after.getColour());
+    for(const unsigned short* i = candidates.first; i < candidates.last; i++) {
+        if(rules[*i].match(before, middle, after)) {
+            matches[*i].push_back(&middle);
+        }
+    }
+}
+
+void SegmentFilter::applyReplacements(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after, SegmentScan& replacements, ScanDirection dir) const
+{
+    const vector<ColourReplacementRule>* rules;
+    ColourRuleTable<ColourReplacementRule>::Candidates candidates;
     ColourSegment temp_seg;
     
     switch(dir) {
     case VERTICAL:
-        begin = replacement_rules_v.begin();
-        end = replacement_rules_v.end();
+        rules = &replacement_rules_v;
+        candidates = replacement_table_v.lookup(before.getColour(), middle.getColour(), after.getColour());
         break;
     case HORIZONTAL:
-        begin = replacement_rules_h.begin();
-        end = replacement_rules_h.end();
+        rules = &replacement_rules_h;
+        candidates = replacement_table_h.lookup(before.getColour(), middle.getColour(), after.getColour());
         break;
     default:
         errorlog << "SegmentFilter::applyReplacements - invalid direction" << endl;
@@ -201,7 +213,9 @@ void SegmentFilter::applyReplacements(const ColourSegment& before, const ColourS
     
     temp_seg = middle;
     
-    for(rules_it = begin; rules_it < end; rules_it++) {
+    //the candidates are in rule order, so the first to match is the same rule a full search would find
+    for(const unsigned short* i = candidates.first; i < candidates.last; i++) {
+        const ColourReplacementRule* rules_it = &(*rules)[*i];
         if(rules_it->match(before, middle, after)) {
             //replace middle using replacement method
             switch(rules_it->getMethod()) {
@@ -237,9 +251,9 @@ void SegmentFilter::applyReplacements(const ColourSegment& before, const ColourS
     replacements.push_back(middle); //no replacement so keep middle
 }
 
-void SegmentFilter::joinMatchingSegments(vector<ColourSegment> &line) const
+void SegmentFilter::joinMatchingSegments(SegmentScan &line) const
 {
-    vector<ColourSegment>::iterator before_it, after_it;
+    SegmentScan::iterator before_it, after_it;
     before_it = line.begin();
     after_it=before_it+1;
     while(after_it<line.end()) {
@@ -282,6 +296,9 @@ void SegmentFilter::loadTransitionRules(string filename)
     }
     input.close();
 
+    rules_table_h.compile(rules_h);
+    rules_table_v.compile(rules_v);
+
     if(rules_h.size()  == 0 || rules_v.size() == 0){
         cout <<"=========================WARNING=========================\n"
              << "SegmentFilter::loadTransitionRules - " << filename
@@ -322,6 +339,9 @@ void SegmentFilter::loadReplacementRules(string filename)
         debug << "SegmentFilter::loadReplacementRules - failed to read from " << temp_filename << endl;
     }
     input.close();
+
+    replacement_table_h.compile(replacement_rules_h);
+    replacement_table_v.compile(replacement_rules_v);
     
     //DEBUG
 #if VISION_FILTER_VERBOSITY > 0
@@ -6,6 +6,7 @@
 
 #include "Vision/VisionTypes/colourreplacementrule.h"
 #include "Vision/VisionTypes/colourtransitionrule.h"
+#include "Vision/VisionTypes/colourruletable.h"
 #include "Vision/VisionTypes/segmentedregion.h"
 
 class SegmentFilter
@@ -30,18 +31,26 @@ private:
     void preFilter(const SegmentedRegion& scans, SegmentedRegion &result) const;
     /**
       @brief runs the transition rules over a segment list.
+      The region is walked once, each triplet is only checked against the rules the compiled
+      table lists for its colours. The matches are gathered in the same order as applying each
+      rule to the whole region in turn.
       @param scans the lists of segments - smoothed or unsmoothed.
       @param result vectors of transition rule matches and the field object ids they map to.
       */
-    void filter(const SegmentedRegion& scans, map<COLOUR_CLASS, vector<ColourSegment> >& result) const;
+    void filter(const SegmentedRegion& scans, TransitionMap& result) const;
     
     /**
-      @brief Applies a single rule to a segmented region.
-      @param scans the lists of segments - smoothed or unsmoothed.
-      @param rule The transition rule to apply.
-      @param matches the resulting list of transitions.
+      @brief Applies the candidate transition rules to a triplet of segments.
+      @param before the first segment (nomatch if there is none).
+      @param middle the second segment.
+      @param after the last segment (nomatch if there is none).
+      @param rules the transition rules for the scan direction.
+      @param table the compiled table of the rules.
+      @param matches the matched segments for each rule, the middle is added to each rule that matches.
       */
-    void checkRuleAgainstRegion(const SegmentedRegion& scans, const ColourTransitionRule& rule, vector<ColourSegment>& matches) const;
+    void checkTripletAgainstRules(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after,
+                                  const vector<ColourTransitionRule>& rules, const ColourRuleTable<ColourTransitionRule>& table,
+                                  vector< vector<const ColourSegment*> >& matches) const;
     /**
       @brief Applies a replacement rule to a triplet of segments.
       @param before the first segment.
@@ -50,13 +59,13 @@ private:
       @param replacement a reference to a vector of segments that should replace the middle segment.
       @param dir the scan direction (vertical or horizontal).
       */
-    void applyReplacements(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after, vector<ColourSegment>& replacement, ScanDirection dir) const;
+    void applyReplacements(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after, SegmentScan& replacement, ScanDirection dir) const;
         
     /**
       @brief Joins any adjacent segments that are the same colour.
       @param line the list of segments.
       */
-    void joinMatchingSegments(vector<ColourSegment>& line) const;
+    void joinMatchingSegments(SegmentScan& line) const;
 
     /**
       @brief Loads the transition rules from a pair of files.
@@ -79,6 +88,11 @@ private:
     vector<ColourReplacementRule> replacement_rules_v;  //! @variable The list of vertical replacement rules
     vector<ColourTransitionRule> rules_h;               //! @variable The list of horizontal transition rules
     vector<ColourTransitionRule> rules_v;               //! @variable The list of vertical transition rules
+
+    ColourRuleTable<ColourReplacementRule> replacement_table_h; //! @variable The horizontal replacement rules by colour triplet
+    ColourRuleTable<ColourReplacementRule> replacement_table_v; //! @variable The vertical replacement rules by colour triplet
+    ColourRuleTable<ColourTransitionRule> rules_table_h;        //! @variable The horizontal transition rules by colour triplet
+    ColourRuleTable<ColourTransitionRule> rules_table_v;        //! @variable The vertical transition rules by colour triplet
     
 };
 
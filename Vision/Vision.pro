@@ -26,7 +26,10 @@ win32 {
     PLATFORM = win
 }
 !win32 {
-    PLATFORM = pc
+    # "qmake PLATFORM=benchmark" builds the headless benchmark instead
+    isEmpty(PLATFORM) {
+        PLATFORM = pc
+    }
 }
 
 contains(PLATFORM, "darwin") {
@@ -75,6 +78,58 @@ contains(PLATFORM, "pc") {
         VisionTools/pccamera.cpp
 }
 
+contains(PLATFORM, "benchmark") {
+     message("Compiling the benchmark")
+    DEFINES += TARGET_IS_BENCHMARK
+    # keep the stage percentiles of every frame for the report
+    DEFINES += VISION_PROFILE_WINDOW=0
+    CONFIG += console
+
+    INCLUDEPATH += ../Vision/Debug/
+
+    HEADERS += \
+        VisionWrapper/datawrapperbenchmark.h \
+        VisionWrapper/visioncontrolwrapperbenchmark.h \
+        VisionTools/scanlineclassifierbenchmark.h \
+        VisionTools/lookuptablebenchmark.h \
+        ../Infrastructure/NUImage/NUImageBenchmark.h \
+        ../Tools/Threading/QueueBenchmark.h \
+        ../Tools/Threading/QueueThread.h \
+        ../Tools/Threading/EventCount.h \
+        ../Tools/Threading/MPSCRing.h \
+        ../Tools/Threading/SPSCRing.h \
+        ../NUPlatform/NUSensorsBenchmark.h \
+        ../NUPlatform/NUSensors.h \
+        ../NUPlatform/NUSensors/EndEffectorTouch.h \
+        ../NUPlatform/NUSensors/OdometryEstimator.h \
+        ../Kinematics/OrientationUKF.h \
+        ../Tools/Math/depUKF.h \
+        ../Tools/Math/FIRFilter.h \
+        ../Motion/Tools/MotionFileTools.h \
+        ../Vision/Debug/debugverbosityvision.h \
+        ../Vision/Debug/debugverbositythreading.h \
+        ../Vision/Debug/debugverbositynusensors.h \
+        ../Vision/Debug/debug.h \
+        ../Vision/Debug/nubotdataconfig.h \
+
+    SOURCES += \
+        VisionWrapper/datawrapperbenchmark.cpp \
+        VisionWrapper/visioncontrolwrapperbenchmark.cpp \
+        GenericAlgorithms/ransacbenchmark.cpp \
+        VisionTools/scanlineclassifierbenchmark.cpp \
+        VisionTools/lookuptablebenchmark.cpp \
+        ../Infrastructure/NUImage/NUImageBenchmark.cpp \
+        ../Tools/Threading/QueueBenchmark.cpp \
+        ../NUPlatform/NUSensorsBenchmark.cpp \
+        ../NUPlatform/NUSensors.cpp \
+        ../NUPlatform/NUSensors/EndEffectorTouch.cpp \
+        ../NUPlatform/NUSensors/OdometryEstimator.cpp \
+        ../Kinematics/OrientationUKF.cpp \
+        ../Tools/Math/depUKF.cpp \
+        ../Tools/Math/FIRFilter.cpp \
+        ../Motion/Tools/MotionFileTools.cpp \
+}
+
 contains(PLATFORM, "win") {
      message("Compiling for Windows")
 #    DEFINES += TARGET_IS_PC
@@ -128,6 +183,11 @@ HEADERS += \
     VisionTools/classificationcolours.h \
     VisionTools/GTAssert.h \
     VisionTools/lookuptable.h \
+    VisionTools/compressedlut.h \
+    VisionTools/scanlineclassifier.h \
+    VisionTools/subsampledimage.h \
+    VisionTools/framearena.h \
+    VisionTools/imageclassifier.h \
     VisionTools/transformer.h \
     ../Vision/Modules/*.h \
     ../Vision/Modules/LineDetectionAlgorithms/*.h \
@@ -138,6 +198,7 @@ HEADERS += \
     visionconstants.h \
     #Threads/SaveImagesThread.h
     GenericAlgorithms/ransac.h \
+    GenericAlgorithms/ransacbenchmark.h \
     Modules/GoalDetectionAlgorithms/goaldetectorhistogram.h \
     Modules/cornerdetector.h \
     VisionWrapper/mainwindow.h \
@@ -151,6 +212,11 @@ SOURCES += \
     ../Vision/VisionTypes/RANSACTypes/*.cpp \
     ../Vision/VisionTypes/VisionFieldObjects/*.cpp \
     VisionTools/lookuptable.cpp \
+    VisionTools/compressedlut.cpp \
+    VisionTools/scanlineclassifier.cpp \
+    VisionTools/subsampledimage.cpp \
+    VisionTools/framearena.cpp \
+    VisionTools/imageclassifier.cpp \
     ../Vision/Modules/*.cpp \
     VisionTools/transformer.cpp \
     VisionTools/classificationcolours.cpp \
@@ -172,18 +238,25 @@ SOURCES += \
 ##robocup
 HEADERS += \
     ../Tools/FileFormats/LUTTools.h \
+    ../Tools/FileFormats/SensorLogFormat.h \
     ../Tools/Optimisation/Parameter.h \
     ../Tools/Math/Line.h \
     ../Tools/Math/LSFittedLine.h \
     ../Tools/Math/Matrix.h \
     ../Tools/Math/TransformMatrices.h \
+    ../Tools/Profiling/ProfileRecorder.h \
+    ../Tools/Threading/Thread.h \
+    ../Tools/Threading/TaskPool.h \
     ../Tools/Math/Vector2.h \
     ../Tools/Math/Vector3.h \
     ../Infrastructure/NUImage/NUImage.h \
+    ../Infrastructure/NUImage/NUImageView.h \
     ../Infrastructure/NUImage/ColorModelConversions.h \
     ../Infrastructure/NUSensorsData/NUData.h \
     ../Infrastructure/NUSensorsData/NUSensorsData.h \
     ../Infrastructure/NUSensorsData/NULocalisationSensors.h \
+    ../Infrastructure/NUSensorsData/SensorFrame.h \
+    ../Infrastructure/NUSensorsData/SensorSnapshots.h \
     ../Infrastructure/Sensor.h \
     ../NUPlatform/NUCamera/CameraSettings.h \
     ../NUPlatform/NUCamera/NUCameraData.h \
@@ -199,16 +272,22 @@ HEADERS += \
 
 SOURCES += \
     ../Tools/FileFormats/LUTTools.cpp \
+    ../Tools/FileFormats/SensorLogFormat.cpp \
     ../Tools/Optimisation/Parameter.cpp \
     ../Tools/Math/Line.cpp \
     ../Tools/Math/LSFittedLine.cpp \
     ../Tools/Math/Matrix.cpp \
     ../Tools/Math/TransformMatrices.cpp \
+    ../Tools/Profiling/ProfileRecorder.cpp \
+    ../Tools/Threading/Thread.cpp \
+    ../Tools/Threading/TaskPool.cpp \
     ../Infrastructure/NUImage/NUImage.cpp \
     ../Infrastructure/NUData.cpp \
     ../Infrastructure/NUSensorsData/NUSensorsData.cpp \
     ../Infrastructure/NUSensorsData/NULocalisationSensors.cpp \
     ../Infrastructure/NUSensorsData/Sensor.cpp \
+    ../Infrastructure/NUSensorsData/SensorFrame.cpp \
+    ../Infrastructure/NUSensorsData/SensorSnapshots.cpp \
     ../NUPlatform/NUCamera/CameraSettings.cpp \
     ../NUPlatform/NUCamera/NUCameraData.cpp \
     ../Kinematics/Horizon.cpp \
@@ -22,6 +22,11 @@ ENDIF()
 ########## List your source files here! ############################################
 SET (YOUR_SRCS
 lookuptable.cpp
+compressedlut.cpp
+scanlineclassifier.cpp
+subsampledimage.cpp
+framearena.cpp
+imageclassifier.cpp
 transformer.cpp
 classificationcolours.cpp
 )
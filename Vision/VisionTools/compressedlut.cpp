@@ -0,0 +1,79 @@
+#include "compressedlut.h"
+#include "Tools/FileFormats/LUTTools.h"
+#include "Vision/VisionTools/classificationcolours.h"
+
+#include <cstring>
+
+CompressedLUT::CompressedLUT()
+{
+    //start as an entirely unclassified table
+    m_index.assign(NUM_BLOCKS, 0);
+    m_pool.assign(BLOCK_BYTES, 0);
+}
+
+/*!
+  @brief Hashes a block for the deduplication table.
+  */
+static inline unsigned int hashBlock(const unsigned char* block)
+{
+    //FNV-1a over the block's 32 bit words
+    unsigned int hash = 2166136261u;
+    for(int i=0; i<CompressedLUT::BLOCK_BYTES; i+=4) {
+        unsigned int word;
+        memcpy(&word, block + i, sizeof(word));
+        hash = (hash ^ word)*16777619u;
+    }
+    return hash ^ (hash >> 16);
+}
+
+void CompressedLUT::build(const unsigned char* lut)
+{
+    const int BLOCK_SIZE = 1 << BLOCK_BITS,
+              BLOCKS_PER_CHANNEL = 128/BLOCK_SIZE,
+              HASH_SLOTS = 2*NUM_BLOCKS;            //at most half full, so probe sequences stay short
+    unsigned char strip[BLOCKS_PER_CHANNEL][BLOCK_BYTES];
+
+    //open addressed table of pool block + 1 for each hash slot, 0 when the slot is empty
+    std::vector<unsigned short> hash_slots(HASH_SLOTS, 0);
+    m_pool.clear();
+
+    for(int by=0; by<BLOCKS_PER_CHANNEL; by++) {
+        for(int bcb=0; bcb<BLOCKS_PER_CHANNEL; bcb++) {
+            //gather the strip of blocks along cr from whole table rows, in the same entry order as getEntryIndex
+            for(int dy=0; dy<BLOCK_SIZE; dy++) {
+                for(int dcb=0; dcb<BLOCK_SIZE; dcb++) {
+                    const unsigned char* row = lut + ((by*BLOCK_SIZE + dy) << 14) + ((bcb*BLOCK_SIZE + dcb) << 7);
+                    const int entry = (dy << 4) | (dcb << 2);
+                    for(int bcr=0; bcr<BLOCKS_PER_CHANNEL; bcr++)
+                        memcpy(&strip[bcr][entry], row + bcr*BLOCK_SIZE, BLOCK_SIZE);
+                }
+            }
+            //anything outside the colour enum is stored as invalid
+            unsigned char* values = &strip[0][0];
+            for(int i=0; i<BLOCKS_PER_CHANNEL*BLOCK_BYTES; i++)
+                values[i] = values[i] < Vision::num_colours ? values[i] : static_cast<unsigned char>(Vision::invalid);
+
+            for(int bcr=0; bcr<BLOCKS_PER_CHANNEL; bcr++) {
+                const unsigned char* block = strip[bcr];
+                //linear probe until the block or an empty slot is found
+                unsigned int slot = hashBlock(block) & (HASH_SLOTS - 1);
+                unsigned short pool_index;
+                while(true) {
+                    unsigned short stored = hash_slots[slot];
+                    if(stored == 0) {
+                        pool_index = m_pool.size()/BLOCK_BYTES;
+                        m_pool.insert(m_pool.end(), block, block + BLOCK_BYTES);
+                        hash_slots[slot] = pool_index + 1;
+                        break;
+                    }
+                    if(memcmp(&m_pool[(stored - 1)*BLOCK_BYTES], block, BLOCK_BYTES) == 0) {
+                        pool_index = stored - 1;
+                        break;
+                    }
+                    slot = (slot + 1) & (HASH_SLOTS - 1);
+                }
+                m_index[(by << 10) | (bcb << 5) | bcr] = pool_index;
+            }
+        }
+    }
+}
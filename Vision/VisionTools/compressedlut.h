@@ -0,0 +1,89 @@
+/**
+*       @name CompressedLUT
+*       @file compressedlut.h
+*       @brief Two level colour lookup table small enough to stay in cache.
+*
+*       The 128x128x128 table is split into 4x4x4 blocks of 64 colours. Identical blocks are
+*       stored once in a pool and a 64KB index gives the pool block for each of the 32768 block
+*       positions. A typical field table has around two thousand distinct blocks, so the whole
+*       table is around 200KB instead of 2MB and fits in the L2 cache of the robot CPUs.
+*       Packing entries at 4 bits would halve the pool but the extra shifts cost more than the
+*       cache saving.
+*
+*       Entries are stored as colour indices with anything outside the colour enum folded to
+*       invalid, so classification gives exactly the colours the flat table would.
+*/
+
+#ifndef COMPRESSEDLUT_H
+#define COMPRESSEDLUT_H
+
+#include <vector>
+#include <cstddef>
+#include "Infrastructure/NUImage/Pixel.h"
+
+class CompressedLUT
+{
+public:
+    static const int BLOCK_BITS = 2;                                //! @variable Bits per channel within a block.
+    static const int BLOCK_ENTRIES = 1 << (3*BLOCK_BITS);           //! @variable Colours per block.
+    static const int BLOCK_BYTES = BLOCK_ENTRIES;   //! @variable Bytes per block.
+    static const int NUM_BLOCKS = 1 << (3*(7 - BLOCK_BITS));        //! @variable Block positions in the table.
+
+    CompressedLUT();
+
+    /*!
+      @brief Builds the compressed table from a flat table.
+      @param lut The flat table of LUTTools::LUT_SIZE entries.
+      */
+    void build(const unsigned char* lut);
+
+    /*!
+      @brief Calculates the index of the block holding a pixel.
+      @param p The pixel.
+      @return The block position.
+      */
+    static inline unsigned int getBlockIndex(const Pixel& p)
+    {
+        return ((p.y >> 3) << 10) | ((p.cb >> 3) << 5) | (p.cr >> 3);
+    }
+
+    /*!
+      @brief Calculates the position of a pixel within its block.
+      @param p The pixel.
+      @return The entry within the block.
+      */
+    static inline unsigned int getEntryIndex(const Pixel& p)
+    {
+        return (((p.y >> 1) & 3) << 4) | (((p.cb >> 1) & 3) << 2) | ((p.cr >> 1) & 3);
+    }
+
+    /*!
+      @brief Looks up a colour by its block position and entry.
+      @return The colour index, always less than num_colours or invalid.
+      */
+    inline unsigned char lookup(unsigned int block, unsigned int entry) const
+    {
+        return m_pool[m_index[block]*BLOCK_BYTES + entry];
+    }
+
+    /*!
+      @brief Classifies an individual pixel.
+      @param p The pixel to be classified.
+      @return The colour index, always less than num_colours or invalid.
+      */
+    inline unsigned char classify(const Pixel& p) const
+    {
+        return lookup(getBlockIndex(p), getEntryIndex(p));
+    }
+
+    //! Returns the number of distinct blocks stored.
+    size_t getNumUniqueBlocks() const {return m_pool.size()/BLOCK_BYTES;}
+    //! Returns the memory used by the table in bytes.
+    size_t getSize() const {return m_index.size()*sizeof(unsigned short) + m_pool.size();}
+
+private:
+    std::vector<unsigned short> m_index;    //! @variable Pool block for each block position.
+    std::vector<unsigned char> m_pool;      //! @variable The distinct blocks.
+};
+
+#endif // COMPRESSEDLUT_H
@@ -0,0 +1,96 @@
+#include "framearena.h"
+
+FrameArena* FrameArena::instance = 0;
+
+/**
+*   @brief return unique instance of the arena - lazy initialisation.
+*/
+FrameArena* FrameArena::getInstance()
+{
+    if(!instance)
+        instance = new FrameArena();
+    return instance;
+}
+
+FrameArena::FrameArena(size_t chunk_size)
+{
+    m_current = 0;
+    m_offset = 0;
+    m_arena_allocations = 0;
+    m_heap_allocations = 0;
+    m_bytes_used = 0;
+    m_last_arena_allocations = 0;
+    m_last_heap_allocations = 0;
+    m_last_bytes_used = 0;
+    addChunk(chunk_size);
+    m_heap_allocations = 0;     //the initial chunk does not count against a frame
+}
+
+FrameArena::~FrameArena()
+{
+    for(size_t i=0; i<m_chunks.size(); i++)
+        delete [] m_chunks[i].data;
+}
+
+void* FrameArena::allocate(size_t bytes)
+{
+    //round up so every allocation keeps the alignment of the chunk
+    bytes = (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    if(bytes == 0)
+        bytes = ALIGNMENT;
+
+    m_arena_allocations++;
+    m_bytes_used += bytes;
+
+    //move on to the next chunk that can fit this, adding a new one if none do
+    while(m_offset + bytes > m_chunks[m_current].size) {
+        if(m_current + 1 < m_chunks.size()) {
+            m_current++;
+            m_offset = 0;
+        }
+        else {
+            size_t size = m_chunks.back().size*2;
+            addChunk(size > bytes ? size : bytes);
+            m_current = m_chunks.size() - 1;
+            m_offset = 0;
+        }
+    }
+
+    void* result = m_chunks[m_current].data + m_offset;
+    m_offset += bytes;
+    return result;
+}
+
+void FrameArena::reset()
+{
+    m_last_arena_allocations = m_arena_allocations;
+    m_last_heap_allocations = m_heap_allocations;
+    m_last_bytes_used = m_bytes_used;
+
+    m_arena_allocations = 0;
+    m_heap_allocations = 0;
+    m_bytes_used = 0;
+
+    //merge into one chunk big enough for the whole of the last frame, counted against the new frame
+    if(m_chunks.size() > 1) {
+        size_t total = 0;
+        for(size_t i=0; i<m_chunks.size(); i++) {
+            total += m_chunks[i].size;
+            delete [] m_chunks[i].data;
+        }
+        m_chunks.clear();
+        addChunk(total);
+    }
+
+    m_current = 0;
+    m_offset = 0;
+}
+
+void FrameArena::addChunk(size_t size)
+{
+    Chunk chunk;
+    chunk.data = new char[size];
+    chunk.size = size;
+    m_chunks.push_back(chunk);
+    m_heap_allocations++;
+}
@@ -0,0 +1,155 @@
+/**
+*   @name   FrameArena
+*   @file   framearena.h
+*   @brief  Per-frame bump allocator for the vision system's intermediate data.
+*
+*   The vision blackboard rebuilds its segments and transition matches every frame. Containers
+*   using ArenaAllocator take their memory from a single arena, which VisionBlackboard::update()
+*   resets at the start of each frame. Deallocation is a no-op and the arena keeps its memory
+*   between frames, so once it has grown to the size of a typical frame the hot path does no
+*   heap allocation at all.
+*
+*   @note Anything allocated from the arena is invalid after the next reset, data that must
+*   live longer than a frame has to be copied into normal containers.
+*/
+
+#ifndef FRAMEARENA_H
+#define FRAMEARENA_H
+
+#include <cstddef>
+#include <map>
+#include <new>
+#include <vector>
+
+class FrameArena
+{
+public:
+    static const size_t DEFAULT_CHUNK_SIZE = 256*1024;  //! @variable The initial size of the arena in bytes.
+    static const size_t ALIGNMENT = 16;                 //! @variable Allocation sizes are rounded up to a multiple of this.
+
+    //! Returns the arena used by the vision system - lazy initialisation.
+    static FrameArena* getInstance();
+
+    explicit FrameArena(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+    ~FrameArena();
+
+    /**
+    *   @brief Allocates memory that remains valid until the next reset.
+    *   @param bytes The number of bytes required.
+    *   @return A pointer to the memory.
+    */
+    void* allocate(size_t bytes);
+
+    /**
+    *   @brief Releases everything allocated this frame.
+    *   If the previous frame needed more than one chunk the chunks are merged into a single
+    *   larger one. That is one heap allocation, counted against the new frame, after which
+    *   frames of the same size need none.
+    */
+    void reset();
+
+    //! Returns the number of allocations served from the arena since the last reset - without it these would all have been heap allocations.
+    unsigned int getArenaAllocations() const {return m_arena_allocations;}
+    //! Returns the number of heap allocations the arena itself made since the last reset, including merging the chunks at the reset.
+    unsigned int getHeapAllocations() const {return m_heap_allocations;}
+    //! Returns the number of bytes handed out since the last reset.
+    size_t getBytesUsed() const {return m_bytes_used;}
+
+    //! Returns the number of allocations served from the arena in the previous frame.
+    unsigned int getLastFrameArenaAllocations() const {return m_last_arena_allocations;}
+    //! Returns the number of heap allocations made in the previous frame.
+    unsigned int getLastFrameHeapAllocations() const {return m_last_heap_allocations;}
+    //! Returns the number of bytes used in the previous frame.
+    size_t getLastFrameBytesUsed() const {return m_last_bytes_used;}
+
+private:
+    struct Chunk
+    {
+        char* data;     //! @variable The chunk's memory.
+        size_t size;    //! @variable The size of the chunk in bytes.
+    };
+
+    void addChunk(size_t size);
+
+    //not copyable
+    FrameArena(const FrameArena&);
+    FrameArena& operator=(const FrameArena&);
+
+private:
+    static FrameArena* instance;    //! @variable Singleton instance.
+
+    std::vector<Chunk> m_chunks;    //! @variable The memory owned by the arena.
+    size_t m_current;               //! @variable The chunk currently being allocated from.
+    size_t m_offset;                //! @variable The first free byte in the current chunk.
+
+    unsigned int m_arena_allocations;   //! @variable Allocations served from the arena this frame.
+    unsigned int m_heap_allocations;    //! @variable Chunks allocated this frame, by growing or merging.
+    size_t m_bytes_used;                //! @variable Bytes handed out this frame.
+    unsigned int m_last_arena_allocations;
+    unsigned int m_last_heap_allocations;
+    size_t m_last_bytes_used;
+};
+
+/**
+*   @brief STL allocator drawing from the vision frame arena.
+*   The allocator is stateless, all instances share FrameArena::getInstance().
+*/
+template <typename T>
+class ArenaAllocator
+{
+public:
+    typedef T           value_type;
+    typedef T*          pointer;
+    typedef const T*    const_pointer;
+    typedef T&          reference;
+    typedef const T&    const_reference;
+    typedef size_t      size_type;
+    typedef ptrdiff_t   difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef ArenaAllocator<U> other;
+    };
+
+    ArenaAllocator() {}
+    ArenaAllocator(const ArenaAllocator&) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>&) {}
+
+    pointer address(reference x) const {return &x;}
+    const_pointer address(const_reference x) const {return &x;}
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+        return static_cast<pointer>(FrameArena::getInstance()->allocate(n*sizeof(T)));
+    }
+    //! Memory is only released when the arena is reset.
+    void deallocate(pointer, size_type) {}
+
+    size_type max_size() const {return size_type(-1)/sizeof(T);}
+
+    void construct(pointer p, const T& val) {new(static_cast<void*>(p)) T(val);}
+    void destroy(pointer p) {p->~T();}
+};
+
+template <typename T, typename U>
+inline bool operator==(const ArenaAllocator<T>&, const ArenaAllocator<U>&) {return true;}
+template <typename T, typename U>
+inline bool operator!=(const ArenaAllocator<T>&, const ArenaAllocator<U>&) {return false;}
+
+//! A vector allocated from the frame arena.
+template <typename T>
+struct ArenaVector
+{
+    typedef std::vector<T, ArenaAllocator<T> > type;
+};
+
+//! A map allocated from the frame arena.
+template <typename K, typename V>
+struct ArenaMap
+{
+    typedef std::map<K, V, std::less<K>, ArenaAllocator<std::pair<const K, V> > > type;
+};
+
+#endif // FRAMEARENA_H
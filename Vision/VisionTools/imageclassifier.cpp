@@ -0,0 +1,136 @@
+/**
+*   @name   ImageClassifier
+*   @file   imageclassifier.cpp
+*   @brief  Classifies a whole image at once, into colours or straight into display pixels.
+*/
+
+#include "imageclassifier.h"
+#include "Vision/VisionTools/scanlineclassifier.h"
+#include "Vision/VisionTools/classificationcolours.h"
+#include "Tools/Threading/TaskPool.h"
+
+#include <vector>
+#include <cstring>
+
+/**
+*   @brief  the display pixel of every possible colour byte, for both pixel formats.
+*/
+struct ImageClassifierPalettes
+{
+    unsigned int rgba[256];
+    unsigned int rgb32[256];
+
+    ImageClassifierPalettes()
+    {
+        unsigned char r, g, b;
+        for(int i=0; i<256; i++) {
+            Colour c = getColourFromIndex(i);
+            getColourAsRGB(c, r, g, b);
+            //the bytes in memory order, whatever the endianness
+            unsigned char bytes[4] = {r, g, b, static_cast<unsigned char>(c == unclassified ? 0 : 255)};
+            memcpy(&rgba[i], bytes, sizeof(bytes));
+            rgb32[i] = 0xff000000u | (r << 16) | (g << 8) | b;
+        }
+    }
+};
+
+/**
+*   @brief  a contiguous range of rows, classified by one thread.
+*/
+class ImageClassifier::Band : public Task
+{
+public:
+    Band() : lut(0), img(0), colours(0), pixels(0), palette(0), first_row(0), last_row(0), use_simd(true) {}
+
+    void run()
+    {
+        int width = img->getWidth();
+        //with a palette each row is classified into a buffer and expanded while it is in the cache
+        if(palette)
+            row.resize(width);
+
+        for(int y = first_row; y < last_row; y++) {
+            //flipped images are read backwards along the opposite row, avoiding a flip check per pixel
+            NUImage::Span span = img->getRowSpan(y);
+            unsigned char* dest = palette ? &row[0] : colours + y*width;
+            ScanLineClassifier::classifyPixels(*lut, span.first, width, span.step < 0, dest, use_simd);
+            if(palette) {
+                unsigned int* out = pixels + y*width;
+                for(int x = 0; x < width; x++)
+                    out[x] = palette[dest[x]];
+            }
+        }
+    }
+
+    const LookUpTable* lut;
+    const NUImage* img;
+    unsigned char* colours;
+    unsigned int* pixels;
+    const unsigned int* palette;
+    int first_row, last_row;
+    bool use_simd;
+    std::vector<unsigned char> row;
+};
+
+ImageClassifier::ImageClassifier(unsigned int num_workers)
+{
+    m_pool = num_workers > 0 ? new TaskPool("ImageClassifier", num_workers, 0) : 0;
+}
+
+ImageClassifier::~ImageClassifier()
+{
+    delete m_pool;
+}
+
+void ImageClassifier::classify(const LookUpTable& lut, const NUImage& img, unsigned char* colours, bool use_simd) const
+{
+    run(lut, img, colours, 0, RGBA, use_simd);
+}
+
+void ImageClassifier::classify(const LookUpTable& lut, const NUImage& img, unsigned int* pixels, PixelFormat format, bool use_simd) const
+{
+    run(lut, img, 0, pixels, format, use_simd);
+}
+
+void ImageClassifier::coloursToPixels(const unsigned char* colours, int count, unsigned int* pixels, PixelFormat format)
+{
+    const unsigned int* palette = getPalette(format);
+    for(int i = 0; i < count; i++)
+        pixels[i] = palette[colours[i]];
+}
+
+void ImageClassifier::run(const LookUpTable& lut, const NUImage& img, unsigned char* colours, unsigned int* pixels, PixelFormat format, bool use_simd) const
+{
+    int height = img.getHeight();
+    int num_bands = m_pool ? m_pool->getNumWorkers() + 1 : 1;
+    if(num_bands > height)
+        num_bands = height > 0 ? height : 1;
+
+    std::vector<Band> bands(num_bands);
+    for(int i = 0; i < num_bands; i++) {
+        Band& band = bands[i];
+        band.lut = &lut;
+        band.img = &img;
+        band.colours = colours;
+        band.pixels = pixels;
+        band.palette = pixels ? getPalette(format) : 0;
+        band.first_row = height*i/num_bands;
+        band.last_row = height*(i + 1)/num_bands;
+        band.use_simd = use_simd;
+    }
+
+    if(num_bands > 1) {
+        for(int i = 0; i < num_bands; i++)
+            m_pool->add(&bands[i]);
+        m_pool->waitForAll();
+    }
+    else {
+        bands[0].run();
+    }
+}
+
+const unsigned int* ImageClassifier::getPalette(PixelFormat format)
+{
+    static const ImageClassifierPalettes palettes;
+    return format == RGB32 ? palettes.rgb32 : palettes.rgba;
+}
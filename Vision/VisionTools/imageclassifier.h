@@ -0,0 +1,73 @@
+/**
+*   @name   ImageClassifier
+*   @file   imageclassifier.h
+*   @brief  Classifies a whole image at once, into colours or straight into display pixels.
+*
+*   Each row is classified with the ScanLineClassifier, so the vectorised lookups are used where
+*   they are available, and for display the colours are expanded through a palette of 32 bit
+*   pixels while the row is still in the cache. The rows can be split into bands that are
+*   classified in parallel on a TaskPool. This replaces the per pixel NUImage::operator(),
+*   LookUpTable::classifyPixel and QImage::setPixel loops in NUView and VisionTraining.
+*/
+
+#ifndef IMAGECLASSIFIER_H
+#define IMAGECLASSIFIER_H
+
+#include "Infrastructure/NUImage/NUImage.h"
+#include "Vision/VisionTools/lookuptable.h"
+
+class TaskPool;
+
+class ImageClassifier
+{
+public:
+    enum PixelFormat {
+        RGBA,   //! Bytes r, g, b, a as glTexImage2D takes with GL_RGBA and GL_UNSIGNED_BYTE, unclassified is transparent.
+        RGB32   //! Words 0xffrrggbb as in a QImage::Format_RGB32 scanline, unclassified is black.
+    };
+
+    /**
+    *   @param num_workers The number of threads the rows are shared with, with none the calling
+    *   thread classifies the whole image.
+    */
+    ImageClassifier(unsigned int num_workers = 0);
+    ~ImageClassifier();
+
+    /**
+    *   @brief  classifies every pixel of an image into a colour index.
+    *   @param lut The lookup table to classify with.
+    *   @param img The image, its flip is taken into account.
+    *   @param colours The destination, width*height bytes in image order.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    void classify(const LookUpTable& lut, const NUImage& img, unsigned char* colours, bool use_simd=true) const;
+
+    /**
+    *   @brief  classifies every pixel of an image into the display colour of its class.
+    *   @param lut The lookup table to classify with.
+    *   @param img The image, its flip is taken into account.
+    *   @param pixels The destination, width*height 32 bit pixels in image order.
+    *   @param format The layout of the destination pixels.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    void classify(const LookUpTable& lut, const NUImage& img, unsigned int* pixels, PixelFormat format, bool use_simd=true) const;
+
+    /**
+    *   @brief  converts colour indices to their display colours.
+    *   @param colours The colour indices, values outside the colour enum are shown as invalid.
+    *   @param count The number of colours.
+    *   @param pixels The destination for count 32 bit pixels.
+    *   @param format The layout of the destination pixels.
+    */
+    static void coloursToPixels(const unsigned char* colours, int count, unsigned int* pixels, PixelFormat format);
+
+private:
+    class Band;
+
+    void run(const LookUpTable& lut, const NUImage& img, unsigned char* colours, unsigned int* pixels, PixelFormat format, bool use_simd) const;
+    static const unsigned int* getPalette(PixelFormat format);
+
+    TaskPool* m_pool;       //! @variable Workers the bands are classified on, null if the image is classified serially.
+};
+
+#endif // IMAGECLASSIFIER_H
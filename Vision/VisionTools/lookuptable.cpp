@@ -3,26 +3,32 @@
 #include "debugverbosityvision.h"
 #include "Vision/VisionTools/classificationcolours.h"
 
+#include <cstring>
+
 LookUpTable::LookUpTable()
 {
     LUTbuffer = new unsigned char[LUTTools::LUT_SIZE];
     for(int i=0; i<LUTTools::LUT_SIZE; i++)
         LUTbuffer[i] = Vision::unclassified;
     LUT = LUTbuffer;
+    compressed.build(LUT);
 }
 
 LookUpTable::LookUpTable(unsigned char *vals)
 {
     LUTbuffer = new unsigned char[LUTTools::LUT_SIZE];
+    LUT = 0;
     set(vals);
 }
 
 void LookUpTable::set(unsigned char *vals)
 {
-    for(int i=0; i<LUTTools::LUT_SIZE; i++) {
-        LUTbuffer[i] = vals[i];
-    }
+    //NUView sets the table every frame, the compressed table is only rebuilt when it has changed
+    if(LUT != 0 && memcmp(LUTbuffer, vals, LUTTools::LUT_SIZE) == 0)
+        return;
+    memcpy(LUTbuffer, vals, LUTTools::LUT_SIZE);
     LUT = LUTbuffer;
+    compressed.build(LUT);
 }
 
 bool LookUpTable::loadLUTFromFile(const string& fileName)
@@ -32,6 +38,7 @@ bool LookUpTable::loadLUTFromFile(const string& fileName)
     load_success = loader.LoadLUT(LUTbuffer, LUTTools::LUT_SIZE,fileName.c_str());
     if(load_success) {
         LUT = LUTbuffer;
+        compressed.build(LUT);
     }
     else {
         errorlog << "Vision::loadLUTFromFile(" << fileName << "). Failed to load lut." << endl;
@@ -77,4 +84,5 @@ void LookUpTable::zero()
     for(int i=0; i<LUTTools::LUT_SIZE; i++)
         LUTbuffer[i] = Vision::unclassified;
     LUT = LUTbuffer;
+    compressed.build(LUT);
 }
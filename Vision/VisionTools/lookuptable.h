@@ -13,6 +13,7 @@
 #include <string>
 #include "Tools/FileFormats/LUTTools.h"
 #include "Vision/VisionTools/classificationcolours.h"
+#include "Vision/VisionTools/compressedlut.h"
 #include "Infrastructure/NUImage/NUImage.h"
 #include "debug.h"
 
@@ -25,7 +26,7 @@ public:
     LookUpTable(unsigned char* vals);
 
     /*!
-      @brief sets a LUT given an array of values
+      @brief sets a LUT given an array of values, nothing is rebuilt if the values are unchanged
       @param vals the array of values.
       */
     void set(unsigned char* vals);
@@ -45,7 +46,8 @@ public:
     inline Colour classifyPixel(const Pixel& p) const
     {
         //return  currentLookupTable[(temp->y<<16) + (temp->cb<<8) + temp->cr]; //8 bit LUT
-        return getColourFromIndex(LUT[LUTTools::getLUTIndex(p)]); // 7bit LUT
+        //return getColourFromIndex(LUT[LUTTools::getLUTIndex(p)]); // 7bit LUT
+        return getColourFromIndex(compressed.classify(p));  // 7bit LUT, compressed to stay in cache
     }
 
 //    /*!
@@ -57,9 +59,13 @@ public:
 
     void zero();
 
+    //! Returns the compressed table used for classification.
+    const CompressedLUT& getCompressed() const {return compressed;}
+
 private:
     const unsigned char* LUT;           //! @variable Colour Look Up Table - protected.
     unsigned char* LUTbuffer;           //! @variable temp LUT for loading.
+    CompressedLUT compressed;           //! @variable Compressed copy of LUT, rebuilt whenever LUT changes.
 };
 
 #endif // LOOKUPTABLE_H
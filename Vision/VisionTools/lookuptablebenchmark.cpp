@@ -0,0 +1,209 @@
+#include "lookuptablebenchmark.h"
+#include "lookuptable.h"
+#include "scanlineclassifier.h"
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include <time.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+using namespace std;
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+/**
+*   @brief Counts hardware cache misses for the calling thread, if the kernel allows it.
+*/
+class CacheMissCounter
+{
+public:
+    CacheMissCounter() : m_fd(-1)
+    {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if(m_fd >= 0)
+            close(m_fd);
+#endif
+    }
+
+    bool available() const {return m_fd >= 0;}
+
+    void start()
+    {
+#ifdef __linux__
+        if(m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    //! Stops counting and returns the misses since start.
+    long long stop()
+    {
+        long long count = 0;
+#ifdef __linux__
+        if(m_fd >= 0) {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if(read(m_fd, &count, sizeof(count)) != sizeof(count))
+                count = 0;
+        }
+#endif
+        return count;
+    }
+
+private:
+    int m_fd;
+};
+
+//! Classifies every pixel through the flat table, as LookUpTable did before compression.
+static unsigned int classifyFlat(const unsigned char* flat, const NUImage& img)
+{
+    unsigned int sum = 0;
+    for(int y=0; y<img.getHeight(); y++) {
+        const Pixel* row = img.getRow(y);
+        for(int x=0; x<img.getWidth(); x++)
+            sum += getColourFromIndex(flat[LUTTools::getLUTIndex(row[x])]);
+    }
+    return sum;
+}
+
+//! Classifies every pixel through LookUpTable::classifyPixel.
+static unsigned int classifyCompressed(const LookUpTable& lut, const NUImage& img)
+{
+    unsigned int sum = 0;
+    for(int y=0; y<img.getHeight(); y++) {
+        const Pixel* row = img.getRow(y);
+        for(int x=0; x<img.getWidth(); x++)
+            sum += lut.classifyPixel(row[x]);
+    }
+    return sum;
+}
+
+//! Checks every table entry through classifyPixel and both ScanLineClassifier paths.
+static bool checkAllColours(const unsigned char* flat, const LookUpTable& lut)
+{
+    vector<Pixel> pixels(128);
+    unsigned char scalar[128], simd[128];
+
+    for(int y=0; y<128; y++) {
+        for(int cb=0; cb<128; cb++) {
+            for(int cr=0; cr<128; cr++) {
+                pixels[cr].yCbCrPadding = 0;
+                pixels[cr].y = y << 1;
+                pixels[cr].cb = cb << 1;
+                pixels[cr].cr = cr << 1;
+            }
+            ScanLineClassifier::classifyPixels(lut, &pixels[0], 128, false, scalar, false);
+            ScanLineClassifier::classifyPixels(lut, &pixels[0], 128, false, simd, true);
+            for(int cr=0; cr<128; cr++) {
+                Colour expected = getColourFromIndex(flat[LUTTools::getLUTIndex(pixels[cr])]);
+                if(lut.classifyPixel(pixels[cr]) != expected || scalar[cr] != expected || simd[cr] != expected) {
+                    cout << "LookUpTableBenchmark - mismatch at y=" << y << " cb=" << cb << " cr=" << cr << endl;
+                    return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+bool LookUpTableBenchmark(const string& image_stream, const string& lut_file)
+{
+    vector<unsigned char> flat(LUTTools::LUT_SIZE);
+    LookUpTable lut;
+    if(!LUTTools::LoadLUT(&flat[0], LUTTools::LUT_SIZE, lut_file.c_str()) || !lut.loadLUTFromFile(lut_file)) {
+        cout << "LookUpTableBenchmark - unable to load " << lut_file << endl;
+        return false;
+    }
+
+    const CompressedLUT& compressed = lut.getCompressed();
+    cout << "LookUpTableBenchmark - compressed table: " << compressed.getSize()/1024 << "KB (" << compressed.getNumUniqueBlocks()
+         << " distinct blocks), flat table: " << LUTTools::LUT_SIZE/1024 << "KB" << endl;
+
+    bool success = checkAllColours(&flat[0], lut);
+    cout << "\tall " << LUTTools::LUT_SIZE << " colours " << (success ? "identical" : "DIFFER") << endl;
+
+    ifstream input(image_stream.c_str(), ios::binary);
+    if(!input.is_open()) {
+        cout << "LookUpTableBenchmark - unable to open " << image_stream << endl;
+        return false;
+    }
+
+    CacheMissCounter counter;
+    double flat_time = 0, compressed_time = 0;
+    long long flat_misses = 0, compressed_misses = 0;
+    long long pixels = 0;
+
+    while(input.good()) {
+        NUImage img;
+        try {
+            input >> img;
+        }
+        catch(exception&) {
+            break;
+        }
+
+        counter.start();
+        double start = benchmarkTime();
+        unsigned int flat_sum = classifyFlat(&flat[0], img);
+        flat_time += benchmarkTime() - start;
+        flat_misses += counter.stop();
+
+        counter.start();
+        start = benchmarkTime();
+        unsigned int compressed_sum = classifyCompressed(lut, img);
+        compressed_time += benchmarkTime() - start;
+        compressed_misses += counter.stop();
+
+        pixels += img.getTotalPixels();
+        if(flat_sum != compressed_sum) {
+            cout << "LookUpTableBenchmark - classifications differ" << endl;
+            success = false;
+        }
+    }
+
+    if(pixels == 0) {
+        cout << "LookUpTableBenchmark - no images in " << image_stream << endl;
+        return false;
+    }
+
+    cout << "\tflat:       " << flat_time*1e6/pixels << " ns/pixel";
+    if(counter.available())
+        cout << ", " << flat_misses << " cache misses";
+    cout << endl;
+    cout << "\tcompressed: " << compressed_time*1e6/pixels << " ns/pixel";
+    if(counter.available())
+        cout << ", " << compressed_misses << " cache misses";
+    cout << endl;
+    if(!counter.available())
+        cout << "\t(cache miss counter unavailable)" << endl;
+    return success;
+}
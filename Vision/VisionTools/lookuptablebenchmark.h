@@ -0,0 +1,23 @@
+/**
+*   @name   LookUpTableBenchmark
+*   @file   lookuptablebenchmark.h
+*   @brief  Compares classification through the flat and compressed colour lookup tables.
+*/
+
+#ifndef LOOKUPTABLEBENCHMARK_H
+#define LOOKUPTABLEBENCHMARK_H
+
+#include <string>
+
+/**
+*   @brief  checks and times the compressed lookup table against the flat one.
+*   Every one of the 128^3 table entries is checked for identical classification, then every
+*   pixel of every image in the stream is classified through both tables. The time per pixel
+*   and, where the kernel allows it, the hardware cache misses are printed for each.
+*   @param image_stream The recorded image.strm file.
+*   @param lut_file The lookup table to classify with.
+*   @return Whether the tables classified every colour identically.
+*/
+bool LookUpTableBenchmark(const std::string& image_stream, const std::string& lut_file);
+
+#endif // LOOKUPTABLEBENCHMARK_H
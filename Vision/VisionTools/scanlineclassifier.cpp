@@ -0,0 +1,313 @@
+/**
+*   @name   ScanLineClassifier
+*   @file   scanlineclassifier.cpp
+*   @brief  Run-length classification of single scanlines straight from the raw image buffer.
+*/
+
+#include "scanlineclassifier.h"
+#include "debug.h"
+#include "debugverbosityvision.h"
+
+#include <cstring>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+bool ScanLineClassifier::simdAvailable()
+{
+#ifdef __SSE2__
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ScanLineClassifier::classifyHorizontal(const LookUpTable& lut, const NUImage& img, int y, SegmentScan& result, bool use_simd)
+{
+    int width = img.getWidth();
+    unsigned char colours[MAX_SCAN_LENGTH];
+
+    if(width <= 0)
+        return;
+    if(width > MAX_SCAN_LENGTH) {
+        errorlog << "ScanLineClassifier::classifyHorizontal - image too wide: " << width << endl;
+        width = MAX_SCAN_LENGTH;
+    }
+
+    //flipped images are read backwards along the opposite row, avoiding a flip check per pixel
+    NUImage::Span row = img.getRowSpan(y);
+    classifyPixels(lut, row.first, width, row.step < 0, colours, use_simd);
+
+    addHorizontalSegments(colours, width, y, result, use_simd);
+}
+
+void ScanLineClassifier::classifyVertical(const LookUpTable& lut, const NUImage& img, int x, int start_y, SegmentScan& result, bool use_simd)
+{
+    int height = img.getHeight(),
+        count = height - start_y;
+    Pixel column[MAX_SCAN_LENGTH];
+    unsigned char colours[MAX_SCAN_LENGTH];
+
+    if(count <= 0)
+        return;
+    if(count > MAX_SCAN_LENGTH) {
+        errorlog << "ScanLineClassifier::classifyVertical - image too tall: " << height << endl;
+        count = MAX_SCAN_LENGTH;
+    }
+
+    //gather the column into a contiguous buffer so it can be classified like a row
+    NUImage::Span span = img.getColumnSpan(x, start_y);
+    const Pixel* px = span.first;
+    for(int i=0; i<count; i++) {
+        column[i] = *px;
+        px += span.step;
+    }
+
+    classifyPixels(lut, column, count, false, colours, use_simd);
+
+    addVerticalSegments(colours, count, x, start_y, result, use_simd);
+}
+
+void ScanLineClassifier::classifyHorizontal(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, int y, SegmentScan& result, bool use_simd)
+{
+    int width = img.getWidth();
+    unsigned char colours[MAX_SCAN_LENGTH];
+
+    if(!coarse.valid() || y % coarse.getFactor() != 0 || width > MAX_SCAN_LENGTH) {
+        classifyHorizontal(lut, img, y, result, use_simd);
+        return;
+    }
+    if(width <= 0)
+        return;
+
+    refineColours(lut.getCompressed(), img.getRowSpan(y), width, coarse.getRow(y/coarse.getFactor()), 1, 0, coarse.getFactor(), colours, use_simd);
+
+    addHorizontalSegments(colours, width, y, result, use_simd);
+}
+
+void ScanLineClassifier::classifyVertical(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, int x, int start_y, SegmentScan& result, bool use_simd)
+{
+    int count = img.getHeight() - start_y;
+    unsigned char colours[MAX_SCAN_LENGTH];
+
+    if(!coarse.valid() || x % coarse.getFactor() != 0 || count > MAX_SCAN_LENGTH) {
+        classifyVertical(lut, img, x, start_y, result, use_simd);
+        return;
+    }
+    if(count <= 0)
+        return;
+
+    //the samples start at the first coarse row at or below the start, the pixels above it are classified individually
+    int first_row = coarse.ceilToCoarse(start_y);
+    const unsigned char* samples = first_row < coarse.getHeight() ? coarse.getPixel(x/coarse.getFactor(), first_row) : 0;
+    refineColours(lut.getCompressed(), img.getColumnSpan(x, start_y), count, samples, coarse.getWidth(),
+                  first_row*coarse.getFactor() - start_y, coarse.getFactor(), colours, use_simd);
+
+    addVerticalSegments(colours, count, x, start_y, result, use_simd);
+}
+
+void ScanLineClassifier::addHorizontalSegments(const unsigned char* colours, int width, int y, SegmentScan& result, bool use_simd)
+{
+    int run_starts[MAX_SCAN_LENGTH];
+    int runs = findRuns(colours, width, run_starts, use_simd);
+
+    //segments share their boundary pixel with the next segment, the last finishes on the final pixel
+    for(int i=0; i<runs-1; i++) {
+        result.push_back(ColourSegment(Point(run_starts[i], y), Point(run_starts[i+1], y), static_cast<Colour>(colours[run_starts[i]])));
+    }
+    result.push_back(ColourSegment(Point(run_starts[runs-1], y), Point(width-1, y), static_cast<Colour>(colours[run_starts[runs-1]])));
+}
+
+void ScanLineClassifier::addVerticalSegments(const unsigned char* colours, int count, int x, int start_y, SegmentScan& result, bool use_simd)
+{
+    int run_starts[MAX_SCAN_LENGTH];
+    int runs = findRuns(colours, count, run_starts, use_simd);
+
+    //as for the original scan the last segment finishes one past the bottom row
+    for(int i=0; i<runs-1; i++) {
+        result.push_back(ColourSegment(Point(x, start_y + run_starts[i]), Point(x, start_y + run_starts[i+1]), static_cast<Colour>(colours[run_starts[i]])));
+    }
+    result.push_back(ColourSegment(Point(x, start_y + run_starts[runs-1]), Point(x, start_y + count), static_cast<Colour>(colours[run_starts[runs-1]])));
+}
+
+/**
+*   @brief Fills the colours of a scanline from its coarse samples, classifying only the pixels that may differ.
+*
+*   The runs of equal colour are found in the samples first, the pixels within a run are given its
+*   colour and only those between the last sample of a run and the first of the next, before the
+*   first sample and after the last are classified individually.
+*   @param pixels The full resolution scanline.
+*   @param count The number of pixels in the scanline.
+*   @param samples The first coarse sample, may be null if there are none in the scanline.
+*   @param sample_step The distance between consecutive samples.
+*   @param first_sample The index in the scanline of the first sample.
+*   @param factor The number of pixels between samples.
+*   @param colours The destination, must have space for count bytes.
+*   @param use_simd Whether to use the vectorised path to find the runs (ignored if it is not available).
+*/
+void ScanLineClassifier::refineColours(const CompressedLUT& lut, const NUImage::Span& pixels, int count,
+                                       const unsigned char* samples, int sample_step, int first_sample, int factor,
+                                       unsigned char* colours, bool use_simd)
+{
+    unsigned char coarse[MAX_SCAN_LENGTH];
+    int run_starts[MAX_SCAN_LENGTH];
+    int num_samples = (samples && first_sample < count) ? (count - first_sample + factor - 1)/factor : 0;
+    int unsampled_end = num_samples > 0 ? first_sample : count;
+
+    for(int i=0; i<unsampled_end; i++)
+        colours[i] = lut.classify(pixels[i]);
+    if(num_samples == 0)
+        return;
+
+    //columns are strided in the subsampled image, the runs are found in a contiguous copy
+    const unsigned char* contiguous = samples;
+    if(sample_step != 1) {
+        for(int k=0; k<num_samples; k++)
+            coarse[k] = samples[k*sample_step];
+        contiguous = coarse;
+    }
+    int runs = findRuns(contiguous, num_samples, run_starts, use_simd);
+
+    for(int r=0; r<runs; r++) {
+        int run_end = r + 1 < runs ? run_starts[r+1] : num_samples,
+            first = first_sample + run_starts[r]*factor,
+            last = first_sample + (run_end - 1)*factor,
+            next = min(last + factor, count);
+        memset(colours + first, contiguous[run_starts[r]], last - first + 1);
+        //the boundary lies somewhere between the last sample of this run and the first of the next
+        for(int i=last+1; i<next; i++)
+            colours[i] = lut.classify(pixels[i]);
+    }
+}
+
+void ScanLineClassifier::classifyPixels(const LookUpTable& lut, const Pixel* pixels, int count, bool reverse, unsigned char* colours, bool use_simd)
+{
+#ifdef __SSE2__
+    if(use_simd) {
+        classifyPixelsSSE2(lut.getCompressed(), pixels, count, reverse, colours);
+        return;
+    }
+#endif
+    classifyPixelsScalar(lut.getCompressed(), pixels, count, reverse, colours);
+}
+
+int ScanLineClassifier::findRuns(const unsigned char* colours, int count, int* run_starts, bool use_simd)
+{
+#ifdef __SSE2__
+    if(use_simd)
+        return findRunsSSE2(colours, count, run_starts);
+#endif
+    return findRunsScalar(colours, count, run_starts);
+}
+
+void ScanLineClassifier::classifyPixelsScalar(const CompressedLUT& lut, const Pixel* pixels, int count, bool reverse, unsigned char* colours)
+{
+    int step = reverse ? -1 : 1;
+    for(int i=0; i<count; i++) {
+        colours[i] = lut.classify(*pixels);
+        pixels += step;
+    }
+}
+
+int ScanLineClassifier::findRunsScalar(const unsigned char* colours, int count, int* run_starts)
+{
+    int runs = 0;
+    if(count <= 0)
+        return 0;
+
+    run_starts[runs++] = 0;
+    for(int i=1; i<count; i++) {
+        if(colours[i] != colours[i-1])
+            run_starts[runs++] = i;
+    }
+    return runs;
+}
+
+#ifdef __SSE2__
+/**
+*   @brief Calculates the compressed LUT block indices of four packed pixels.
+*
+*   A pixel word is [padding | cb<<8 | y<<16 | cr<<24], the block index is
+*   ((y>>3)<<10) | ((cb>>3)<<5) | (cr>>3), see CompressedLUT::getBlockIndex.
+*/
+static inline __m128i blockIndices(__m128i px)
+{
+    const __m128i y_mask = _mm_set1_epi32(0x1F << 10),
+                  cb_mask = _mm_set1_epi32(0x1F << 5);
+    __m128i y  = _mm_and_si128(_mm_srli_epi32(px, 9), y_mask),
+            cb = _mm_and_si128(_mm_srli_epi32(px, 6), cb_mask),
+            cr = _mm_srli_epi32(px, 27);
+    return _mm_or_si128(_mm_or_si128(y, cb), cr);
+}
+
+/**
+*   @brief Calculates the positions of four packed pixels within their blocks.
+*   The entry is (((y>>1)&3)<<4) | (((cb>>1)&3)<<2) | ((cr>>1)&3), see CompressedLUT::getEntryIndex.
+*/
+static inline __m128i entryIndices(__m128i px)
+{
+    const __m128i y_mask = _mm_set1_epi32(3 << 4),
+                  cb_mask = _mm_set1_epi32(3 << 2),
+                  cr_mask = _mm_set1_epi32(3);
+    __m128i y  = _mm_and_si128(_mm_srli_epi32(px, 13), y_mask),
+            cb = _mm_and_si128(_mm_srli_epi32(px, 7), cb_mask),
+            cr = _mm_and_si128(_mm_srli_epi32(px, 25), cr_mask);
+    return _mm_or_si128(_mm_or_si128(y, cb), cr);
+}
+
+void ScanLineClassifier::classifyPixelsSSE2(const CompressedLUT& lut, const Pixel* pixels, int count, bool reverse, unsigned char* colours)
+{
+    int blocks[16] __attribute__((aligned(16)));
+    int entries[16] __attribute__((aligned(16)));
+    int i = 0;
+
+    //16 indices are calculated four at a time, the table lookups themselves have to be scalar
+    for(; i + 16 <= count; i += 16) {
+        for(int j=0; j<4; j++) {
+            __m128i px;
+            if(reverse) {
+                px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels - i - 4*j - 3));
+                px = _mm_shuffle_epi32(px, _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            else {
+                px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i + 4*j));
+            }
+            _mm_store_si128(reinterpret_cast<__m128i*>(blocks + 4*j), blockIndices(px));
+            _mm_store_si128(reinterpret_cast<__m128i*>(entries + 4*j), entryIndices(px));
+        }
+        for(int j=0; j<16; j++)
+            colours[i + j] = lut.lookup(blocks[j], entries[j]);
+    }
+
+    if(i < count)
+        classifyPixelsScalar(lut, reverse ? pixels - i : pixels + i, count - i, reverse, colours + i);
+}
+
+int ScanLineClassifier::findRunsSSE2(const unsigned char* colours, int count, int* run_starts)
+{
+    int runs = 0,
+        i = 1;
+    if(count <= 0)
+        return 0;
+
+    run_starts[runs++] = 0;
+    //compare each block of 16 colours against the same block shifted back by one,
+    //every unequal lane is the start of a new run
+    for(; i + 16 <= count; i += 16) {
+        __m128i current = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colours + i)),
+                previous = _mm_loadu_si128(reinterpret_cast<const __m128i*>(colours + i - 1));
+        unsigned int changes = ~_mm_movemask_epi8(_mm_cmpeq_epi8(current, previous)) & 0xFFFF;
+        while(changes) {
+            run_starts[runs++] = i + __builtin_ctz(changes);
+            changes &= changes - 1;
+        }
+    }
+
+    for(; i<count; i++) {
+        if(colours[i] != colours[i-1])
+            run_starts[runs++] = i;
+    }
+    return runs;
+}
+#endif
@@ -0,0 +1,113 @@
+/**
+*   @name   ScanLineClassifier
+*   @file   scanlineclassifier.h
+*   @brief  Run-length classification of single scanlines straight from the raw image buffer.
+*
+*   Pixels are classified a block at a time into a buffer of colour bytes using the LUT's
+*   compressed table, and the colour boundaries are found with vector compares, so ColourSegment
+*   runs are emitted directly without going through NUImage::operator() and
+*   LookUpTable::classifyPixel per pixel.
+*   When SSE2 is not available (e.g. the Geode) the scalar path is used, it produces exactly
+*   the same segments.
+*
+*   Given a SubsampledImage the scanlines are read coarse first, only the pixels between two
+*   samples of different colour are classified at full resolution, so the segment boundaries are
+*   still exact to the pixel but a run narrower than the subsampling factor can be missed.
+*/
+
+#ifndef SCANLINECLASSIFIER_H
+#define SCANLINECLASSIFIER_H
+
+#include "Infrastructure/NUImage/NUImage.h"
+#include "Vision/VisionTools/lookuptable.h"
+#include "Vision/VisionTools/subsampledimage.h"
+#include "Vision/VisionTypes/coloursegment.h"
+
+class ScanLineClassifier
+{
+public:
+    static const int MAX_SCAN_LENGTH = 2048;   //! @variable The longest scanline that can be classified in one pass.
+
+    //! Returns whether this build has the vectorised implementation.
+    static bool simdAvailable();
+
+    /**
+    *   @brief  classifies a single horizontal scanline.
+    *   @param lut The lookup table to classify with.
+    *   @param img The image to classify.
+    *   @param y The height of the scanline in image coordinates.
+    *   @param result The vector the segments are appended to.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    static void classifyHorizontal(const LookUpTable& lut, const NUImage& img, int y, SegmentScan& result, bool use_simd=true);
+
+    /**
+    *   @brief  classifies a single vertical scanline from the start point to the bottom of the image.
+    *   @param lut The lookup table to classify with.
+    *   @param img The image to classify.
+    *   @param x The column of the scanline in image coordinates.
+    *   @param start_y The first row of the scanline in image coordinates.
+    *   @param result The vector the segments are appended to.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    static void classifyVertical(const LookUpTable& lut, const NUImage& img, int x, int start_y, SegmentScan& result, bool use_simd=true);
+
+    /**
+    *   @brief  classifies a single horizontal scanline from the subsampled image, refining the boundaries at full resolution.
+    *   @param lut The lookup table to classify with.
+    *   @param img The full resolution image.
+    *   @param coarse The subsampled classification of img.
+    *   @param y The height of the scanline in image coordinates, the full scan is used if it is not a coarse row.
+    *   @param result The vector the segments are appended to, in full resolution coordinates.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    static void classifyHorizontal(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, int y, SegmentScan& result, bool use_simd=true);
+
+    /**
+    *   @brief  classifies a single vertical scanline from the subsampled image, refining the boundaries at full resolution.
+    *   @param lut The lookup table to classify with.
+    *   @param img The full resolution image.
+    *   @param coarse The subsampled classification of img.
+    *   @param x The column of the scanline in image coordinates, the full scan is used if it is not a coarse column.
+    *   @param start_y The first row of the scanline in image coordinates.
+    *   @param result The vector the segments are appended to, in full resolution coordinates.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    static void classifyVertical(const LookUpTable& lut, const NUImage& img, const SubsampledImage& coarse, int x, int start_y, SegmentScan& result, bool use_simd=true);
+
+    /**
+    *   @brief  classifies a contiguous run of pixels into colour bytes.
+    *   @param lut The lookup table to classify with.
+    *   @param pixels The first pixel of the run.
+    *   @param count The number of pixels.
+    *   @param reverse Whether the run is read backwards from pixels (for flipped images).
+    *   @param colours The destination, must have space for count bytes.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    static void classifyPixels(const LookUpTable& lut, const Pixel* pixels, int count, bool reverse, unsigned char* colours, bool use_simd=true);
+
+    /**
+    *   @brief  finds the start of every run of equal colour.
+    *   @param colours The classified colours.
+    *   @param count The number of colours.
+    *   @param run_starts The destination for the run start indices, must have space for count entries.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    *   @return The number of runs found.
+    */
+    static int findRuns(const unsigned char* colours, int count, int* run_starts, bool use_simd=true);
+
+private:
+    static void addHorizontalSegments(const unsigned char* colours, int width, int y, SegmentScan& result, bool use_simd);
+    static void addVerticalSegments(const unsigned char* colours, int count, int x, int start_y, SegmentScan& result, bool use_simd);
+    static void refineColours(const CompressedLUT& lut, const NUImage::Span& pixels, int count,
+                              const unsigned char* samples, int sample_step, int first_sample, int factor,
+                              unsigned char* colours, bool use_simd);
+    static void classifyPixelsScalar(const CompressedLUT& lut, const Pixel* pixels, int count, bool reverse, unsigned char* colours);
+    static int findRunsScalar(const unsigned char* colours, int count, int* run_starts);
+#ifdef __SSE2__
+    static void classifyPixelsSSE2(const CompressedLUT& lut, const Pixel* pixels, int count, bool reverse, unsigned char* colours);
+    static int findRunsSSE2(const unsigned char* colours, int count, int* run_starts);
+#endif
+};
+
+#endif // SCANLINECLASSIFIER_H
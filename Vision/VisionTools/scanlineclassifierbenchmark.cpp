@@ -0,0 +1,96 @@
+#include "scanlineclassifierbenchmark.h"
+#include "scanlineclassifier.h"
+
+#include <fstream>
+#include <iostream>
+#include <time.h>
+
+using namespace std;
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+//! Classifies every row and column of the image, returning the total number of segments.
+static size_t classifyAll(const LookUpTable& lut, const NUImage& img, bool use_simd, SegmentScan& segments)
+{
+    segments.clear();
+    for(int y=0; y<img.getHeight(); y++)
+        ScanLineClassifier::classifyHorizontal(lut, img, y, segments, use_simd);
+    for(int x=0; x<img.getWidth(); x++)
+        ScanLineClassifier::classifyVertical(lut, img, x, 0, segments, use_simd);
+    return segments.size();
+}
+
+static bool sameSegments(const SegmentScan& a, const SegmentScan& b)
+{
+    if(a.size() != b.size())
+        return false;
+    for(size_t i=0; i<a.size(); i++) {
+        if(a[i].getStart() != b[i].getStart() || a[i].getEnd() != b[i].getEnd() || a[i].getColour() != b[i].getColour())
+            return false;
+    }
+    return true;
+}
+
+bool ScanLineClassifierBenchmark(const string& image_stream, const string& lut_file)
+{
+    LookUpTable lut;
+    if(!lut.loadLUTFromFile(lut_file)) {
+        cout << "ScanLineClassifierBenchmark - unable to load " << lut_file << endl;
+        return false;
+    }
+
+    ifstream input(image_stream.c_str(), ios::binary);
+    if(!input.is_open()) {
+        cout << "ScanLineClassifierBenchmark - unable to open " << image_stream << endl;
+        return false;
+    }
+
+    double scalar_time = 0, simd_time = 0;
+    int frames = 0;
+    bool success = true;
+
+    while(input.good()) {
+        NUImage img;
+        try {
+            input >> img;
+        }
+        catch(exception&) {
+            break;
+        }
+
+        //both results are allocated from the frame arena, as they would be on the robot
+        FrameArena::getInstance()->reset();
+        SegmentScan scalar_segments, simd_segments;
+
+        double start = benchmarkTime();
+        classifyAll(lut, img, false, scalar_segments);
+        double middle = benchmarkTime();
+        classifyAll(lut, img, true, simd_segments);
+        double end = benchmarkTime();
+
+        scalar_time += middle - start;
+        simd_time += end - middle;
+        frames++;
+
+        if(!sameSegments(scalar_segments, simd_segments)) {
+            cout << "ScanLineClassifierBenchmark - segments differ on frame " << frames << endl;
+            success = false;
+        }
+    }
+
+    if(frames == 0) {
+        cout << "ScanLineClassifierBenchmark - no images in " << image_stream << endl;
+        return false;
+    }
+
+    cout << "ScanLineClassifierBenchmark - " << frames << " frames (SIMD " << (ScanLineClassifier::simdAvailable() ? "on" : "unavailable") << ")" << endl;
+    cout << "\tscalar: " << scalar_time/frames << " ms/frame" << endl;
+    cout << "\tsimd:   " << simd_time/frames << " ms/frame" << endl;
+    cout << "\tspeedup: " << scalar_time/simd_time << endl;
+    return success;
+}
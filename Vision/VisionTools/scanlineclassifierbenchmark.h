@@ -0,0 +1,21 @@
+/**
+*   @name   ScanLineClassifierBenchmark
+*   @file   scanlineclassifierbenchmark.h
+*   @brief  Compares the scalar and vectorised scanline classifiers on recorded images.
+*/
+
+#ifndef SCANLINECLASSIFIERBENCHMARK_H
+#define SCANLINECLASSIFIERBENCHMARK_H
+
+#include <string>
+
+/**
+*   @brief  classifies every row and column of every image in a stream with both implementations.
+*   Prints the time per image for each and checks that they give identical segments.
+*   @param image_stream The recorded image.strm file.
+*   @param lut_file The lookup table to classify with.
+*   @return Whether the segments matched for every image.
+*/
+bool ScanLineClassifierBenchmark(const std::string& image_stream, const std::string& lut_file);
+
+#endif // SCANLINECLASSIFIERBENCHMARK_H
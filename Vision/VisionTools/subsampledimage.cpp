@@ -0,0 +1,59 @@
+/**
+*   @name   SubsampledImage
+*   @file   subsampledimage.cpp
+*   @brief  A half or quarter resolution image classified into colours in one pass.
+*/
+
+#include "subsampledimage.h"
+#include "Vision/VisionTools/scanlineclassifier.h"
+
+SubsampledImage::SubsampledImage()
+{
+    m_width = 0;
+    m_height = 0;
+    m_factor = 1;
+}
+
+void SubsampledImage::classify(const LookUpTable& lut, const NUImage& img, int factor, bool use_simd)
+{
+    if(factor <= 1) {
+        clear();
+        return;
+    }
+
+    //a coarse pixel for every sample inside the image, so the last row and column may be closer than factor to the edge
+    m_factor = factor;
+    m_width = (img.getWidth() + factor - 1)/factor;
+    m_height = (img.getHeight() + factor - 1)/factor;
+    m_colours.resize(m_width*m_height);
+    m_gathered.resize(m_width);
+
+    for(int y=0; y<m_height; y++) {
+        //gather the samples of the row so they can be classified as a contiguous block, the span resolves any flip
+        //index from the start of the row rather than stepping a pointer, so it never steps past the last sample
+        NUImage::Span row = img.getRowSpan(y*factor);
+        int step = row.step*factor;
+        for(int x=0; x<m_width; x++)
+            m_gathered[x] = row.first[x*step];
+
+        ScanLineClassifier::classifyPixels(lut, &m_gathered[0], m_width, false, &m_colours[y*m_width], use_simd);
+    }
+}
+
+SubsampledImage::Column SubsampledImage::getColumn(int x, int start_y) const
+{
+    Column column;
+    int first_row = ceilToCoarse(start_y);
+    column.step = m_width;
+    column.length = first_row < m_height ? m_height - first_row : 0;
+    column.first = column.length > 0 ? &m_colours[first_row*m_width + x/m_factor] : 0;
+    return column;
+}
+
+void SubsampledImage::clear()
+{
+    m_colours.clear();
+    m_width = 0;
+    m_height = 0;
+    m_factor = 1;
+}
@@ -0,0 +1,87 @@
+/**
+*   @name   SubsampledImage
+*   @file   subsampledimage.h
+*   @brief  A half or quarter resolution image classified into colours in one pass.
+*
+*   Every factor'th pixel of every factor'th row is gathered and classified with the
+*   ScanLineClassifier, so the coarse pass uses the vectorised lookups where they are available.
+*   Coarse pixel (x, y) is the classification of full resolution pixel (x*factor, y*factor), the
+*   modules that search it report their results in full resolution coordinates.
+*/
+
+#ifndef SUBSAMPLEDIMAGE_H
+#define SUBSAMPLEDIMAGE_H
+
+#include <vector>
+
+#include "Infrastructure/NUImage/NUImage.h"
+#include "Vision/VisionTools/lookuptable.h"
+#include "Vision/VisionTools/classificationcolours.h"
+#include "Vision/basicvisiontypes.h"
+
+using std::vector;
+
+class SubsampledImage
+{
+public:
+    /**
+    *   @brief  a coarse column, read like an NUImage::Span but giving colour indices.
+    */
+    struct Column
+    {
+        const unsigned char* first; //! @variable The first coarse pixel of the column.
+        int step;                   //! @variable The distance between consecutive coarse pixels.
+        int length;                 //! @variable The number of coarse pixels in the column.
+
+        unsigned char operator[](int i) const {return first[i*step];}
+    };
+
+    SubsampledImage();
+
+    /**
+    *   @brief  classifies every factor'th pixel of every factor'th row of an image.
+    *   @param lut The lookup table to classify with.
+    *   @param img The full resolution image.
+    *   @param factor The subsampling factor, 1 leaves the image empty.
+    *   @param use_simd Whether to use the vectorised path (ignored if it is not available).
+    */
+    void classify(const LookUpTable& lut, const NUImage& img, int factor, bool use_simd=true);
+
+    //! Empties the image, so the modules use the full resolution image.
+    void clear();
+
+    //! Returns whether the image holds a classification, i.e. whether the subsampled mode is on.
+    bool valid() const {return m_factor > 1;}
+
+    int getFactor() const {return m_factor;}    //! Returns the number of full resolution pixels between coarse pixels.
+    int getWidth() const {return m_width;}      //! Returns the width in coarse pixels.
+    int getHeight() const {return m_height;}    //! Returns the height in coarse pixels.
+
+    //! Returns the colour of a coarse pixel.
+    Colour at(int x, int y) const {return getColourFromIndex(m_colours[y*m_width + x]);}
+
+    //! Returns the colour index of the first coarse pixel of a row, the row is contiguous.
+    const unsigned char* getRow(int y) const {return &m_colours[y*m_width];}
+
+    //! Returns the colour index of a coarse pixel, the next in its column is getWidth() on.
+    const unsigned char* getPixel(int x, int y) const {return &m_colours[y*m_width + x];}
+
+    //! Returns the coarse index of the first sample at or after a full resolution coordinate.
+    int ceilToCoarse(int full) const {return (full + m_factor - 1)/m_factor;}
+
+    /**
+    *   @brief  returns the coarse column holding a full resolution column, from the first coarse row at or below a start.
+    *   @param x The full resolution column, rounded down to a coarse column.
+    *   @param start_y The full resolution row to start from, element 0 is at row ceilToCoarse(start_y)*getFactor().
+    */
+    Column getColumn(int x, int start_y) const;
+
+private:
+    vector<unsigned char> m_colours;    //! @variable The colours of the coarse pixels, row by row.
+    vector<Pixel> m_gathered;           //! @variable The pixels of the current row, gathered to be classified.
+    int m_width;                        //! @variable The width in coarse pixels.
+    int m_height;                       //! @variable The height in coarse pixels.
+    int m_factor;                       //! @variable The subsampling factor.
+};
+
+#endif // SUBSAMPLEDIMAGE_H
@@ -46,10 +46,18 @@ public:
     GroundPoint screenToGroundCartesian(const Point& pt) const;
     vector<GroundPoint> screenToGroundCartesian(const vector<Point>& pts) const;
 
+    //2D pixel - 2D cartesian (feet relative) for a batch of pixels - the closed form of
+    //screenToGroundCartesian, only the ground coordinates are calculated
+    void screenToGroundCartesianBatch(const vector<Point>& pts, vector<Point>& ground) const;
+    void screenToGroundCartesianBatch(vector<GroundPoint>& pts) const;
+
     double getCameraDistanceInPixels() const { return effective_camera_dist_pixels; }
 
     Vector2<double> getFOV() const {return FOV;}
 
+    bool isCameraYawValid() const {return camera_yaw_valid;}
+    double getCameraYaw() const {return camera_yaw;}
+
 private:
     //! Calculate the field of view and effective camera distance in pixels.
     void setKinematicParams(bool cam_pitch_valid, double cam_pitch,
@@ -59,6 +67,10 @@ private:
                             bool ctg_valid, vector<float> ctg_vector);
     void setCamParams(Vector2<double> imagesize,
                       Vector2<double> fov);
+    //! Precalculate the per frame constants of the closed form screen to ground projection.
+    void setGroundProjection();
+    //! Project a contiguous array of pixels to the ground using the precalculated constants.
+    void projectToGround(const Point* pts, Point* ground, size_t count) const;
 
 private:
     Vector2<double> FOV;
@@ -81,6 +93,11 @@ private:
     bool camera_height_valid;   //! @variable Whether the camera height is valid.
     double body_pitch;           //! @variable The body pitch angle.
     bool body_pitch_valid;      //! @variable Whether the body pitch is valid.
+
+    //closed form screen to ground projection, see setGroundProjection
+    double ground_tan_yaw;              //! @variable The tangent of the bearing offset of every pixel.
+    double ground_tan_elevation;        //! @variable The tangent of the elevation offset of every pixel.
+    double ground_transform[2][4];      //! @variable The x and y rows of the camera to ground transform, pre-scaled by -camera_height (and sec(yaw) for z).
 };
 
 #endif // TRANSFORMER_H
@@ -10,7 +10,7 @@ public:
 
     virtual unsigned int minPointsForFit() const = 0;
 
-    virtual double calculateError(DataPoint p) const = 0;
+    virtual double calculateError(const DataPoint& p) const = 0;
 };
 
 #endif // RANSACMODEL_H
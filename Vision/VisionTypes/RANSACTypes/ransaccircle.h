@@ -26,7 +26,7 @@ public:
 
     unsigned int minPointsForFit() const {return 3;}
 
-    double calculateError(T p) const
+    double calculateError(const T& p) const
     {
         return std::abs( (p.screen - m_centre.screen).abs() - m_radius);
     }
@@ -81,7 +81,7 @@ public:
 
     unsigned int minPointsForFit() const {return 3;}
 
-    double calculateError(GroundPoint p) const
+    double calculateError(const GroundPoint& p) const
     {
         return std::abs( (p.ground - m_centre.ground).abs() - m_radius);
     }
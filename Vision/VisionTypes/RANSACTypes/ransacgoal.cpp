@@ -32,7 +32,7 @@ bool RANSACGoal::regenerate(const vector<ColourSegment>& segments)
     }
 }
 
-double RANSACGoal::calculateError(ColourSegment c) const
+double RANSACGoal::calculateError(const ColourSegment& c) const
 {
     Point p = c.getCentre();
     double d = l.getLinePointDistance(p);
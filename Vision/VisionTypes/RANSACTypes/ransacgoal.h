@@ -15,7 +15,7 @@ public:
 
     unsigned int minPointsForFit() const {return 2;}
 
-    double calculateError(ColourSegment c) const;
+    double calculateError(const ColourSegment& c) const;
 
     double getInterpolatedWidth(Point p) const;
 
@@ -23,7 +23,7 @@ public:
 
     inline size_t minPointsForFit() const {return 2;}
 
-    double calculateError(T p) const { return getLinePointDistance(p); }
+    double calculateError(const T& p) const { return getLinePointDistance(p); }
 };
 
 
@@ -45,7 +45,7 @@ public:
 
     inline size_t minPointsForFit() const { return 3; }
 
-    double calculateError(GroundPoint p) const { return getLinePointDistance(p.ground); }
+    double calculateError(const GroundPoint& p) const { return getLinePointDistance(p.ground); }
 };
 
 #endif // RANSACLINE_H
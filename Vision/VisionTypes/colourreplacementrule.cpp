@@ -60,12 +60,17 @@ bool ColourReplacementRule::match(const ColourSegment& before, const ColourSegme
         return false;
     }
 
+    return matchColours(before.getColour(), middle.getColour(), after.getColour());
+}
+
+bool ColourReplacementRule::matchColours(Colour before, Colour middle, Colour after) const
+{
     bool valid;
     vector<Colour>::const_iterator it;
     if(!m_middle.empty()) {
         valid = false;
         for(it = m_middle.begin(); it != m_middle.end(); it++) {
-            if(*it == middle.getColour())
+            if(*it == middle)
                 valid = true;   //a match has been found
         }
         if(!valid)
@@ -75,11 +80,11 @@ bool ColourReplacementRule::match(const ColourSegment& before, const ColourSegme
         return false;	//if middle is empty the rule matches nothing
 
     if(!m_before.empty()) {
-        if(before.getColour() == invalid)
+        if(before == invalid)
             return false;   //there is a before set, but no before colour
         valid = false;
         for(it = m_before.begin(); it != m_before.end(); it++) {
-            if(*it == before.getColour())
+            if(*it == before)
                 valid = true;   //a match has been found
         }
         if(!valid)
@@ -87,11 +92,11 @@ bool ColourReplacementRule::match(const ColourSegment& before, const ColourSegme
     }
 
     if(!m_after.empty()) {
-        if(after.getColour() == invalid)
+        if(after == invalid)
             return false;   //there is an after set, but no after colour
         valid = false;
         for(it = m_after.begin(); it != m_after.end(); it++) {
-            if(*it == after.getColour())
+            if(*it == after)
                 valid = true;   //a match has been found
         }
         if(!valid)
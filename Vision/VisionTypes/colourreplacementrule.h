@@ -46,6 +46,16 @@ public:
       @return Whether it is a match.
       */
     bool match(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after) const;
+
+    /*!
+      Checks only the colours of a segment triplet against this rule, match can only be true for
+      segments of these colours if this is.
+      @param before the colour of the first segment.
+      @param middle the colour of the second segment.
+      @param after the colour of the last segment.
+      @return Whether the colours match.
+      */
+    bool matchColours(Colour before, Colour middle, Colour after) const;
     
     /*!
       Returns the replacement method (before, after or split) for this rule.
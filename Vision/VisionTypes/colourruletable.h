@@ -0,0 +1,92 @@
+/*!
+  * @file colourruletable.h
+  * @class ColourRuleTable
+  *
+  * @brief A list of colour rules compiled into a table indexed by colour triplet.
+  *
+  * Every (before, middle, after) colour combination, including invalid for a missing
+  * neighbour, maps to the indices of the rules whose colour lists accept it, in the order
+  * the rules were loaded. Only those candidates need their segment lengths checked, so a
+  * segment is compared against a handful of rules instead of all of them.
+  *
+  * Rule must provide bool matchColours(Colour before, Colour middle, Colour after) const.
+  *
+  */
+
+#ifndef COLOURRULETABLE_H
+#define COLOURRULETABLE_H
+
+#include <vector>
+
+#include "Vision/VisionTools/classificationcolours.h"
+
+using std::vector;
+
+template<typename Rule>
+class ColourRuleTable
+{
+public:
+    //! The range of candidate rule indices for a colour triplet, in rule order.
+    struct Candidates
+    {
+        const unsigned short* first;
+        const unsigned short* last;
+    };
+
+    ColourRuleTable() {}
+
+    /*!
+      Rebuilds the table for a list of rules, the indices refer to positions in that list.
+      @param rules the rules to compile.
+      */
+    void compile(const vector<Rule>& rules)
+    {
+        m_offsets.assign(NUM_TRIPLETS + 1, 0);
+        m_indices.clear();
+        for(unsigned int b = 0; b < NUM_COLOURS; b++) {
+            for(unsigned int m = 0; m < NUM_COLOURS; m++) {
+                for(unsigned int a = 0; a < NUM_COLOURS; a++) {
+                    for(unsigned int i = 0; i < rules.size(); i++) {
+                        if(rules[i].matchColours(Colour(b), Colour(m), Colour(a)))
+                            m_indices.push_back(i);
+                    }
+                    m_offsets[tripletIndex(Colour(b), Colour(m), Colour(a)) + 1] = m_indices.size();
+                }
+            }
+        }
+    }
+
+    /*!
+      Returns the rules that may match a colour triplet.
+      @param before the colour of the preceeding segment, invalid if there is none.
+      @param middle the colour of the middle segment.
+      @param after the colour of the following segment, invalid if there is none.
+      */
+    Candidates lookup(Colour before, Colour middle, Colour after) const
+    {
+        Candidates c;
+        if(m_indices.empty()) {
+            c.first = c.last = 0;
+        }
+        else {
+            unsigned int t = tripletIndex(before, middle, after);
+            c.first = &m_indices[0] + m_offsets[t];
+            c.last = &m_indices[0] + m_offsets[t + 1];
+        }
+        return c;
+    }
+
+private:
+    static const unsigned int NUM_COLOURS = invalid + 1;
+    static const unsigned int NUM_TRIPLETS = NUM_COLOURS*NUM_COLOURS*NUM_COLOURS;
+
+    static unsigned int tripletIndex(Colour before, Colour middle, Colour after)
+    {
+        return (before*NUM_COLOURS + middle)*NUM_COLOURS + after;
+    }
+
+    vector<unsigned int> m_offsets;     //! @variable The start of each triplet's candidates in m_indices.
+    vector<unsigned short> m_indices;   //! @variable The candidate rule indices for all triplets.
+};
+
+#endif // COLOURRULETABLE_H
@@ -57,3 +57,14 @@ ostream& operator<< (ostream& output, const vector<ColourSegment>& c)
         output << c[i];
     return output;
 }
+
+/*! @brief Stream insertion operator for a scan of ColourSegments.
+ *      Each segment is terminated by a newline.
+ *  @relates ColourSegment
+ */
+ostream& operator<< (ostream& output, const SegmentScan& c)
+{
+    for (size_t i=0; i<c.size(); i++)
+        output << c[i];
+    return output;
+}
@@ -17,6 +17,7 @@
 #include "Vision/basicvisiontypes.h"
 #include "Vision/VisionTools/classificationcolours.h"
 #include "Tools/Math/Vector2.h"
+#include "Vision/VisionTools/framearena.h"
 
 using namespace Vision;
 using std::vector;
@@ -77,4 +78,10 @@ private:
           m_centre;       //! @variable The centre pixellocation.
 };
 
+//! The segments of a single scan, allocated from the vision frame arena.
+typedef ArenaVector<ColourSegment>::type SegmentScan;
+
+//! output stream operator for a scan of segments.
+ostream& operator<< (ostream& output, const SegmentScan& c);
+
 #endif // COLOURSEGMENT_H
@@ -13,6 +13,11 @@ bool ColourTransitionRule::match(const ColourSegment &before, const ColourSegmen
     return oneWayMatch(before, middle, after) || oneWayMatch(after, middle, before); //test both directions
 }
 
+bool ColourTransitionRule::matchColours(Colour before, Colour middle, Colour after) const
+{
+    return oneWayMatchColours(before, middle, after) || oneWayMatchColours(after, middle, before); //test both directions
+}
+
 //! @brief Returns the ID of the VFO this rule is related to.
 COLOUR_CLASS ColourTransitionRule::getColourClass() const
 {
@@ -185,15 +190,20 @@ bool ColourTransitionRule::oneWayMatch(const ColourSegment &before, const Colour
         return false;
     }
 
+    return oneWayMatchColours(before.getColour(), middle.getColour(), after.getColour());
+}
+
+bool ColourTransitionRule::oneWayMatchColours(Colour before, Colour middle, Colour after) const
+{
     bool valid;
     vector<Colour>::const_iterator it;
 
     if(!m_middle.empty()) {
-        if(middle.getColour() == invalid)
+        if(middle == invalid)
             return false;   //there is a before set, but no before colour
         valid = false;
         for(it = m_middle.begin(); it != m_middle.end(); it++) {
-            if(*it == middle.getColour())
+            if(*it == middle)
                 valid = true;   //a match has been found
         }
         if(!valid)
@@ -201,11 +211,11 @@ bool ColourTransitionRule::oneWayMatch(const ColourSegment &before, const Colour
     }
 
     if(!m_before.empty()) {
-        if(before.getColour() == invalid)
+        if(before == invalid)
             return false;   //there is a before set, but no before colour
         valid = false;
         for(it = m_before.begin(); it != m_before.end(); it++) {
-            if(*it == before.getColour())
+            if(*it == before)
                 valid = true;   //a match has been found
         }
         if(!valid)
@@ -213,11 +223,11 @@ bool ColourTransitionRule::oneWayMatch(const ColourSegment &before, const Colour
     }
 
     if(!m_after.empty()) {
-        if(after.getColour() == invalid)
+        if(after == invalid)
             return false;   //there is an after set, but no after colour
         valid = false;
         for(it = m_after.begin(); it != m_after.end(); it++) {
-            if(*it == after.getColour())
+            if(*it == after)
                 valid = true;   //a match has been found
         }
         if(!valid)
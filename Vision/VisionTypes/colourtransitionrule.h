@@ -36,6 +36,15 @@ public:
       @return Whether it is a match in either direction.
       */
     bool match(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after) const;
+    /*!
+      Checks only the colours of a segment triplet against this rule (forward and reverse), match
+      can only be true for segments of these colours if this is.
+      @param before the colour of the preceeding segment.
+      @param middle the colour of the middle segment.
+      @param after the colour of the following segment.
+      @return Whether the colours match in either direction.
+      */
+    bool matchColours(Colour before, Colour middle, Colour after) const;
     //! Returns the ID of the field object that this rule is for.
     COLOUR_CLASS getColourClass() const;
 
@@ -72,6 +81,8 @@ private:
       @return Whether it is a match.
       */
     bool oneWayMatch(const ColourSegment& before, const ColourSegment& middle, const ColourSegment& after) const;
+    //! Checks the colours of a segment triplet against this rule in one direction.
+    bool oneWayMatchColours(Colour before, Colour middle, Colour after) const;
 };
 
 #endif // COLOURTRANSITIONRULE_H
@@ -0,0 +1,36 @@
+#ifndef FIELDPOINTSET_H
+#define FIELDPOINTSET_H
+
+#include <iostream>
+#include <vector>
+
+#include "Vision/VisionTypes/groundpoint.h"
+
+/**
+  * Field point files hold one set of field points per frame, a line with the number of points
+  * followed by a line per point with its screen x, y and ground x, y. FieldPointDetector writes
+  * them and RANSACBenchmark reads them back.
+  */
+
+//! Appends a set of field points to a point file.
+inline void writeFieldPointSet(std::ostream& output, const std::vector<GroundPoint>& points)
+{
+    output << points.size() << "\n";
+    for(size_t i=0; i<points.size(); i++)
+        output << points[i].screen.x << " " << points[i].screen.y << " " << points[i].ground.x << " " << points[i].ground.y << "\n";
+}
+
+//! Reads the next set of field points from a point file, returning false at the end of the file.
+inline bool readFieldPointSet(std::istream& input, std::vector<GroundPoint>& points)
+{
+    size_t count;
+    points.clear();
+    if(!(input >> count))
+        return false;
+    points.resize(count);
+    for(size_t i=0; i<count; i++)
+        input >> points[i].screen.x >> points[i].screen.y >> points[i].ground.x >> points[i].ground.y;
+    return !input.fail();
+}
+
+#endif // FIELDPOINTSET_H
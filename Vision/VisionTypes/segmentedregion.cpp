@@ -9,22 +9,34 @@ SegmentedRegion::SegmentedRegion(const SegmentedRegion& other)
     SegmentedRegion(other.m_segmented_scans, other.m_direction);
 }
 
-SegmentedRegion::SegmentedRegion(const vector<vector<ColourSegment> >& segmented_scans, ScanDirection direction)
+SegmentedRegion::SegmentedRegion(const SegmentScans& segmented_scans, ScanDirection direction)
 {
     set(segmented_scans, direction);
 }
 
-void SegmentedRegion::set(const vector<vector<ColourSegment> >& segmented_scans, ScanDirection direction)
+void SegmentedRegion::set(const SegmentScans& segmented_scans, ScanDirection direction)
 {
     m_segmented_scans = segmented_scans; //vector assignment operator copies elements
     m_direction = direction;
 }
 
-const vector<vector<ColourSegment> >& SegmentedRegion::getSegments() const 
+void SegmentedRegion::clear()
+{
+    SegmentScans().swap(m_segmented_scans);
+}
+
+const SegmentScans& SegmentedRegion::getSegments() const 
 {
     return m_segmented_scans;
 } 
 
+void SegmentedRegion::copySegments(vector<vector<ColourSegment> >& segments) const
+{
+    segments.resize(m_segmented_scans.size());
+    for(size_t i=0; i<m_segmented_scans.size(); i++)
+        segments[i].assign(m_segmented_scans[i].begin(), m_segmented_scans[i].end());
+}
+
 size_t SegmentedRegion::getNumberOfScans() const
 {
     return m_segmented_scans.size();
@@ -34,3 +46,10 @@ ScanDirection SegmentedRegion::getDirection() const
 {
     return m_direction;
 }
+
+ostream& operator<< (ostream& output, const SegmentedRegion& region)
+{
+    for(size_t i=0; i<region.m_segmented_scans.size(); i++)
+        output << region.m_segmented_scans[i];
+    return output;
+}
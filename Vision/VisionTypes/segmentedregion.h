@@ -4,10 +4,17 @@
 #include <vector>
 
 #include "Vision/VisionTypes/coloursegment.h"
+#include "Vision/VisionTools/framearena.h"
 #include "Vision/basicvisiontypes.h"
 
 using std::vector;
 using Vision::ScanDirection;
+using Vision::COLOUR_CLASS;
+
+//! A set of scans, allocated from the vision frame arena.
+typedef ArenaVector<SegmentScan>::type SegmentScans;
+//! Transition rule matches for each colour class, allocated from the vision frame arena.
+typedef ArenaMap<COLOUR_CLASS, SegmentScan>::type TransitionMap;
 
 class SegmentedRegion
 {
@@ -16,28 +23,43 @@ friend class SegmentFilter;
 public:
     SegmentedRegion();
     SegmentedRegion(const SegmentedRegion& other);
-    SegmentedRegion(const vector<vector<ColourSegment> >& segmented_scans, ScanDirection direction);
+    SegmentedRegion(const SegmentScans& segmented_scans, ScanDirection direction);
     
     /**
       * Sets the segments and direction of this region.
       * @param segmented_scans A 2D vector of segments.
       * @param direction The alignment of the segments in this region (vertical or horizontal).
       */
-    void set(const vector<vector<ColourSegment> >& segmented_scans, ScanDirection direction);
+    void set(const SegmentScans& segmented_scans, ScanDirection direction);
+
+    /**
+      * Removes all segments, releasing their memory back to the frame arena.
+      * This must be done before the arena is reset.
+      */
+    void clear();
 
     bool empty() const {return m_segmented_scans.empty();}
     
     //consider removing later and replacing with iterator
     //! Returns a const reference to the segments.
-    const vector<vector<ColourSegment> >& getSegments() const;
+    const SegmentScans& getSegments() const;
+
+    /**
+      * Copies the segments into heap storage, for use after the current frame.
+      * @param segments The destination.
+      */
+    void copySegments(vector<vector<ColourSegment> >& segments) const;
 
     //! Returns the number of segments in the region.
     size_t getNumberOfScans() const;
     //! Returns the alignment of the scans.
     ScanDirection getDirection() const;
 
+    //! output stream operator, each scan is printed in turn.
+    friend ostream& operator<< (ostream& output, const SegmentedRegion& region);
+
 private:
-    vector< vector<ColourSegment> > m_segmented_scans;  //! @variable The segments in this region.
+    SegmentScans m_segmented_scans;  //! @variable The segments in this region.
     ScanDirection m_direction;  //! The alignment of the scans in this region.
 };
 
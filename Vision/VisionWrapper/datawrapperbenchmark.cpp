@@ -0,0 +1,209 @@
+#include <boost/foreach.hpp>
+#include "datawrapperbenchmark.h"
+#include "debug.h"
+#include "nubotdataconfig.h"
+
+DataWrapper* DataWrapper::instance = 0;
+
+DataWrapper::DataWrapper()
+{
+    if(!m_camspecs.LoadFromConfigFile((string(CONFIG_DIR) + string("CameraSpecs.cfg")).c_str())) {
+        errorlog << "DataWrapper::DataWrapper() - failed to load camera specifications: " << string(CONFIG_DIR) + string("CameraSpecs.cfg") << endl;
+    }
+    numFramesProcessed = 0;
+    binary_sensors = false;
+}
+
+DataWrapper::~DataWrapper()
+{
+    imagestrm.close();
+    sensorstrm.close();
+}
+
+DataWrapper* DataWrapper::getInstance()
+{
+    if(!instance)
+        instance = new DataWrapper();
+    return instance;
+}
+
+/**
+*   @brief Returns the current frame.
+*/
+NUImage* DataWrapper::getFrame()
+{
+    return &m_current_image;
+}
+
+//! @brief Returns the logged camera to ground transform.
+bool DataWrapper::getCTGVector(vector<float> &ctgvector)
+{
+    return m_current_sensors.get(NUSensorsData::CameraToGroundTransform, ctgvector);
+}
+
+//! @brief Returns the logged camera transform.
+bool DataWrapper::getCTVector(vector<float> &ctvector)
+{
+    return m_current_sensors.get(NUSensorsData::CameraTransform, ctvector);
+}
+
+//! @brief Returns the logged camera height.
+bool DataWrapper::getCameraHeight(float& height)
+{
+    return m_current_sensors.getCameraHeight(height);
+}
+
+//! @brief Returns the logged camera pitch.
+bool DataWrapper::getCameraPitch(float& pitch)
+{
+    return m_current_sensors.getPosition(NUSensorsData::HeadPitch, pitch);
+}
+
+//! @brief Returns the logged camera yaw.
+bool DataWrapper::getCameraYaw(float& yaw)
+{
+    return m_current_sensors.getPosition(NUSensorsData::HeadYaw, yaw);
+}
+
+//! @brief Returns the logged body pitch.
+bool DataWrapper::getBodyPitch(float& pitch)
+{
+    vector<float> orientation;
+    bool valid = m_current_sensors.get(NUSensorsData::Orientation, orientation);
+    if(valid && orientation.size() > 2) {
+        pitch = orientation.at(1);
+        return true;
+    }
+    return false;
+}
+
+Vector2<double> DataWrapper::getCameraFOV() const
+{
+    return Vector2<double>(m_camspecs.m_horizontalFov, m_camspecs.m_verticalFov);
+}
+
+//! @brief Returns the horizon from the sensor log.
+const Horizon& DataWrapper::getKinematicsHorizon()
+{
+    return kinematics_horizon;
+}
+
+//! @brief Returns camera settings.
+CameraSettings DataWrapper::getCameraSettings()
+{
+    return m_current_image.getCameraSettings();
+}
+
+//! @brief Returns LUT
+const LookUpTable& DataWrapper::getLUT() const
+{
+    return LUT;
+}
+
+//! @brief Records detections for the current frame.
+void DataWrapper::publish(const vector<const VisionFieldObject*> &visual_objects)
+{
+    BOOST_FOREACH(const VisionFieldObject* vfo, visual_objects) {
+        publish(vfo);
+    }
+}
+
+//! @brief Records a detection for the current frame.
+void DataWrapper::publish(const VisionFieldObject* visual_object)
+{
+    BenchmarkDetection detection;
+    detection.id = visual_object->getID();
+    if(detection.id == FIELDLINE) {
+        Vector2<GroundPoint> end_points = static_cast<const FieldLine*>(visual_object)->getEndPoints();
+        detection.values[0] = end_points.x.screen.x;
+        detection.values[1] = end_points.x.screen.y;
+        detection.values[2] = end_points.y.screen.x;
+        detection.values[3] = end_points.y.screen.y;
+    }
+    else {
+        detection.values[0] = visual_object->getLocationPixels().x;
+        detection.values[1] = visual_object->getLocationPixels().y;
+        detection.values[2] = visual_object->getScreenSize().x;
+        detection.values[3] = visual_object->getScreenSize().y;
+    }
+    detections.push_back(detection);
+}
+
+/**
+*   @brief Reads the next image and sensors from the streams.
+*   @return Whether a frame was read, false at the end of either stream.
+*/
+bool DataWrapper::updateFrame()
+{
+    imagestrm.peek();
+    sensorstrm.peek();
+    if(!imagestrm.good() || !sensorstrm.good())
+        return false;
+
+    try {
+        imagestrm >> m_current_image;
+        if(binary_sensors) {
+            if(!sensor_log.readFrame(sensorstrm, m_current_sensors)) {
+                errorlog << "DataWrapper::updateFrame() - failed to read sensor log frame " << numFramesProcessed << endl;
+                return false;
+            }
+        }
+        else {
+            sensorstrm >> m_current_sensors;
+        }
+    }
+    catch(std::exception& e) {
+        errorlog << "DataWrapper::updateFrame() - failed to read frame " << numFramesProcessed << ": " << e.what() << endl;
+        return false;
+    }
+
+    detections.clear();
+    numFramesProcessed++;
+
+    vector<float> hor_data;
+    if(m_current_sensors.getHorizon(hor_data)) {
+        kinematics_horizon.setLine(hor_data.at(0), hor_data.at(1), hor_data.at(2));
+    }
+    return true;
+}
+
+/**
+*   @brief Opens a log to replay.
+*   @param image_stream_name The filename of the image stream.
+*   @param sensor_stream_name The filename of the sensor stream recorded with it, either a binary
+*   sensor log or the text format, told apart by the sensor log magic.
+*   @return The success of the operation.
+*/
+bool DataWrapper::openStreams(const string& image_stream_name, const string& sensor_stream_name)
+{
+    imagestrm.close();
+    imagestrm.clear();
+    imagestrm.open(image_stream_name.c_str(), ios_base::binary);
+    sensorstrm.close();
+    sensorstrm.clear();
+    sensorstrm.open(sensor_stream_name.c_str(), ios_base::binary);
+    if(!imagestrm.is_open()) {
+        errorlog << "DataWrapper::openStreams() - failed to load image stream: " << image_stream_name << endl;
+        return false;
+    }
+    if(!sensorstrm.is_open()) {
+        errorlog << "DataWrapper::openStreams() - failed to load sensor stream: " << sensor_stream_name << endl;
+        return false;
+    }
+    binary_sensors = SensorLog::isSensorLog(sensorstrm);
+    if(binary_sensors && !sensor_log.readHeader(sensorstrm, m_current_sensors)) {
+        errorlog << "DataWrapper::openStreams() - failed to read sensor log header: " << sensor_stream_name << endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+*   @brief loads the colour look up table.
+*   @param filename The filename for the LUT stored on disk.
+*   @return The success of the operation.
+*/
+bool DataWrapper::loadLUTFromFile(const string& filename)
+{
+    return LUT.loadLUTFromFile(filename);
+}
@@ -0,0 +1,116 @@
+#ifndef DATAWRAPPERBENCHMARK_H
+#define DATAWRAPPERBENCHMARK_H
+
+#include <iostream>
+#include <fstream>
+
+#include "Kinematics/Horizon.h"
+#include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/FileFormats/SensorLogFormat.h"
+#include "NUPlatform/NUCamera/NUCameraData.h"
+
+#include "Vision/basicvisiontypes.h"
+#include "Vision/VisionTypes/segmentedregion.h"
+#include "Vision/VisionTools/lookuptable.h"
+#include "Vision/VisionTypes/histogram1d.h"
+#include "Vision/VisionTypes/VisionFieldObjects/ball.h"
+#include "Vision/VisionTypes/VisionFieldObjects/goal.h"
+#include "Vision/VisionTypes/VisionFieldObjects/obstacle.h"
+#include "Vision/VisionTypes/VisionFieldObjects/fieldline.h"
+#include "Vision/VisionTypes/VisionFieldObjects/centrecircle.h"
+#include "Vision/VisionTypes/VisionFieldObjects/cornerpoint.h"
+
+using namespace Vision;
+
+/**
+*   @brief A detection reduced to its type and screen position, so it can be kept after the frame and
+*          written to and compared with a golden file.
+*
+*   Field lines keep the screen positions of their end points, everything else its location and size.
+*/
+struct BenchmarkDetection
+{
+    VFO_ID id;
+    double values[4];
+};
+
+/**
+*   @brief A headless DataWrapper that replays image and sensor streams as fast as they can be read.
+*
+*   Nothing is displayed; the debug publishing calls do nothing so they do not add to the timing, and
+*   the published field objects are only recorded as BenchmarkDetections for the current frame.
+*/
+class DataWrapper
+{
+    friend class VisionController;
+    friend class VisionControlWrapper;
+
+public:
+    static DataWrapper* getInstance();
+
+    //! RETRIEVAL METHODS
+    NUImage* getFrame();
+
+    bool getCTGVector(vector<float>& ctgvector);    //for transforms
+    bool getCTVector(vector<float>& ctvector);    //for transforms
+    bool getCameraHeight(float& height);            //for transforms
+    bool getCameraPitch(float& pitch);              //for transforms
+    bool getCameraYaw(float& yaw);                  //for transforms
+    bool getBodyPitch(float& pitch);
+    Vector2<double> getCameraFOV() const;
+
+    //! @brief Returns the horizon from the sensor log.
+    const Horizon& getKinematicsHorizon();
+
+    CameraSettings getCameraSettings();
+
+    const LookUpTable& getLUT() const;
+
+    //! PUBLISH METHODS
+    void publish(const vector<const VisionFieldObject*> &visual_objects);
+    void publish(const VisionFieldObject* visual_object);
+
+    void debugPublish(const vector<Ball>& data) {}
+    void debugPublish(const vector<Goal>& data) {}
+    void debugPublish(const vector<Obstacle>& data) {}
+    void debugPublish(const vector<FieldLine>& data) {}
+    void debugPublish(const vector<CentreCircle>& data) {}
+    void debugPublish(const vector<CornerPoint>& data) {}
+    void debugPublish(DEBUG_ID id) {}
+    template <typename T>
+    void debugPublish(DEBUG_ID id, const T& data) {}
+
+    void plotCurve(string name, vector< Point > pts) {}
+    void plotLineSegments(string name, vector< Point > pts) {}
+    void plotHistogram(string name, const Histogram1D& hist, Colour colour = yellow) {}
+
+private:
+    DataWrapper();
+    ~DataWrapper();
+    bool updateFrame();
+    bool openStreams(const string& image_stream_name, const string& sensor_stream_name);
+    bool loadLUTFromFile(const string& filename);
+    int getNumFramesProcessed() const {return numFramesProcessed;}  //! @brief Returns the number of processed frames since start.
+    const vector<BenchmarkDetection>& getDetections() const {return detections;}
+
+private:
+    static DataWrapper* instance;   //! @var static singleton instance
+
+    NUImage m_current_image;        //! @var the current image
+    NUSensorsData m_current_sensors;//! @var the sensors logged with the current image
+
+    LookUpTable LUT;                //! @var look up table
+    Horizon kinematics_horizon;     //! @var the kinematics horizon - represents "level"
+    NUCameraData m_camspecs;        //! @var the camera specifications, for the field of view
+
+    ifstream imagestrm;             //! @var image stream
+    ifstream sensorstrm;            //! @var sensor stream
+    bool binary_sensors;            //! @var whether the sensor stream is a binary sensor log rather than the text format
+    SensorLogReader sensor_log;     //! @var decodes the binary sensor log, holds the previous frame for delta frames
+
+    int numFramesProcessed;         //! @var the number of frames read from all streams so far
+
+    vector<BenchmarkDetection> detections;  //! @var the field objects published for the current frame
+};
+
+#endif // DATAWRAPPERBENCHMARK_H
@@ -10,6 +10,8 @@
     #include "Vision/VisionWrapper/datawrappernuview.h"
 #elif TARGET_IS_TRAINING
     #include "Vision/VisionWrapper/datawrappertraining.h"
+#elif TARGET_IS_BENCHMARK
+    #include "Vision/VisionWrapper/datawrapperbenchmark.h"
 #else
     #include "Vision/VisionWrapper/datawrapperdarwin.h"
 #endif
@@ -34,6 +34,7 @@ DataWrapper::DataWrapper()
     Blackboard->lookForGoals = true; //initialise
     isSavingImages = false;
     isSavingImagesWithVaryingSettings = false;
+    sensor_snapshots.setSnapshots(Blackboard->SensorHistory);
     VisionConstants::loadFromFile(string(CONFIG_DIR) + string("VisionOptions.cfg"));
 }
 
@@ -300,10 +301,10 @@ void DataWrapper::debugPublish(DEBUG_ID id, const SegmentedRegion& region)
     //! @todo better debug printing + Comment
     switch(id) {
     case HORIZONTAL:
-        Blackboard->horizontalScans = region;
+        region.copySegments(Blackboard->horizontalScans);
         break;
     case VERTICAL:
-        Blackboard->verticalScans = region;
+        region.copySegments(Blackboard->verticalScans);
         break;
     }
 
@@ -311,7 +312,7 @@ void DataWrapper::debugPublish(DEBUG_ID id, const SegmentedRegion& region)
 
     #if VISION_WRAPPER_VERBOSITY > 2
         debug << "DataWrapper::debugPublish - DEBUG_ID = " << getIDName(id) << endl;
-        BOOST_FOREACH(const vector<ColourSegment>& line, region.getSegments()) {
+        BOOST_FOREACH(const SegmentScan& line, region.getSegments()) {
             if(region.getDirection() == VisionID::HORIZONTAL)
                 debug << "y: " << line.front().getStart().y << endl;
             else
@@ -344,6 +345,9 @@ void DataWrapper::plotCurve(string name, vector<Vector2<double> > pts)
 /*! @brief Updates the held information ready for a new frame.
 *   Gets copies of the actions and sensors pointers from the blackboard and
 *   gets a new image from the blackboard. Updates framecounts.
+*   The sensors are a copy of those published closest to the time the image was
+*   taken, so the transforms match the image, falling back to the live sensors
+*   until the first are published.
 *   @return Whether the fetched data is valid.
 */
 bool DataWrapper::updateFrame()
@@ -361,6 +365,8 @@ bool DataWrapper::updateFrame()
         numFramesDropped++;
     numFramesProcessed++;
     current_frame = Blackboard->Image;
+    if (current_frame != NULL and sensor_snapshots.closest(current_frame->GetTimestamp(), image_sensor_data))
+        sensor_data = &image_sensor_data;
     
     if (current_frame == NULL || sensor_data == NULL || actions == NULL || field_objects == NULL)
     {
@@ -411,7 +417,7 @@ bool DataWrapper::loadLUTFromFile(const string& fileName)
 }
 
 /**
-*   @brief Processes saving images jobs.
+*   @brief Processes saving images and subsample image jobs.
 *   @param jobs The current JobList
 *   @note Taken from original vision system
 */
@@ -456,6 +462,16 @@ void DataWrapper::process(JobList* jobs)
             isSavingImagesWithVaryingSettings = job->varyCameraSettings();
             it = jobs->removeVisionJob(it);
         }
+        else if ((*it)->getID() == Job::VISION_SUBSAMPLE_IMAGE)
+        {
+            #if VISION_WRAPPER_VERBOSITY > 1
+                debug << "DataWrapper::process(): Processing a subsample image job." << endl;
+            #endif
+            SubsampleImageJob* job = (SubsampleImageJob*) (*it);
+            //the blackboard classifies the next frame at the new resolution
+            VisionConstants::setSubsampling(job->getFactor());
+            it = jobs->removeVisionJob(it);
+        }
         else 
         {
             ++it;
@@ -5,9 +5,11 @@
 #include <fstream>
 
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Infrastructure/NUSensorsData/SensorSnapshots.h"
 #include "Infrastructure/FieldObjects/FieldObjects.h"
 #include "Infrastructure/Jobs/JobList.h"
 #include "Infrastructure/Jobs/VisionJobs/SaveImagesJob.h"
+#include "Infrastructure/Jobs/VisionJobs/SubsampleImageJob.h"
 #include "Kinematics/Horizon.h"
 
 #include "Vision/VisionTools/lookuptable.h"
@@ -115,9 +117,10 @@ private:
     
     //! Shared data objects
     NUImage* current_frame;
-    NUSensorsData* sensor_data;             //! pointer to shared sensor data
+    NUSensorsData* sensor_data;             //! pointer to the sensor data for this frame
     NUCameraData* camera_data;
-    //NUSensorsData sensor_data_copy;
+    NUSensorsData image_sensor_data;        //! copy of the sensors published closest to the time the image was taken
+    SensorSnapshotReader sensor_snapshots;  //! reads image_sensor_data from Blackboard->SensorHistory
     NUActionatorsData* actions;             //! pointer to shared actionators data
     FieldObjects* field_objects;            //! pointer to shared fieldobject data
 };
@@ -1,6 +1,7 @@
 #include <boost/foreach.hpp>
 #include "datawrappernuview.h"
 #include "Infrastructure/NUImage/ColorModelConversions.h"
+#include <QThread>
 #include "debug.h"
 #include "debugverbosityvision.h"
 #include "nubotdataconfig.h"
@@ -13,9 +14,9 @@
 
 DataWrapper* DataWrapper::instance = 0;
 
-void getPointsAndColoursFromSegments(const vector< vector<ColourSegment> >& segments, vector<Colour>& colours, vector<Point>& pts)
+void getPointsAndColoursFromSegments(const SegmentScans& segments, vector<Colour>& colours, vector<Point>& pts)
 {
-    BOOST_FOREACH(const vector<ColourSegment>& line, segments) {
+    BOOST_FOREACH(const SegmentScan& line, segments) {
         BOOST_FOREACH(const ColourSegment& seg, line) {
             pts.push_back(seg.getStart());
             pts.push_back(seg.getEnd());
@@ -29,10 +30,13 @@ DataWrapper::DataWrapper()
     camera_data.LoadFromConfigFile((string(CONFIG_DIR) + string("CameraSpecs.cfg")).c_str());
     VisionConstants::loadFromFile(string(CONFIG_DIR) + string("VisionOptions.cfg"));
     numFramesDropped = numFramesProcessed = 0;
+    int cores = QThread::idealThreadCount();
+    image_classifier = new ImageClassifier(cores > 1 ? cores - 1 : 0);
 }
 
 DataWrapper::~DataWrapper()
 {
+    delete image_classifier;
 }
 
 DataWrapper* DataWrapper::getInstance()
@@ -201,10 +205,13 @@ void DataWrapper::debugPublish(DEBUG_ID id, const vector<Point> &data_points)
 //! Outputs debug data to the appropriate external interface
 void DataWrapper::debugPublish(DEBUG_ID id, const SegmentedRegion& region)
 {
+    //the region is only valid for this frame, the display gets its own copy
+    vector<vector<ColourSegment> > segments;
+    region.copySegments(segments);
 
     switch(id) {
     case DBID_SEGMENTS:
-        emit segmentsUpdated(region.getSegments(), GLDisplay::Segments);
+        emit segmentsUpdated(segments, GLDisplay::Segments);
 //        c_it = colours.begin();
 //        for (it = data_points.begin(); it < data_points.end()-1; it+=2) {
 //            //draws a line between each consecutive pair of points of the corresponding colour
@@ -213,7 +220,7 @@ void DataWrapper::debugPublish(DEBUG_ID id, const SegmentedRegion& region)
 //        }
         break;
     case DBID_FILTERED_SEGMENTS:
-        emit segmentsUpdated(region.getSegments(), GLDisplay::FilteredSegments);
+        emit segmentsUpdated(segments, GLDisplay::FilteredSegments);
 //        c_it = colours.begin();
 //        for (it = data_points.begin(); it < data_points.end()-1; it+=2) {
 //            //draws a line between each consecutive pair of points of the corresponding colour
@@ -336,16 +343,20 @@ void DataWrapper::classifyImage(ClassifiedImage &target) const
         int height = m_current_image->getHeight();
 
         target.setImageDimensions(width,height);
-        for (int y = 0; y < height; y++)
-        {
-            for (int x = 0; x < width; x++)
-            {
-                target.image[y][x] = LUT.classifyPixel((*m_current_image)(x,y));
-            }
-        }
+        image_classifier->classify(LUT, *m_current_image, target.image[0]);
     }
 }
 
+/**
+*   @brief Classifies the current frame straight into pixels for glTexImage2D.
+*   @param target The destination, width*height RGBA pixels.
+*/
+void DataWrapper::classifyImageRGBA(unsigned int* target) const
+{
+    if(m_current_image != NULL)
+        image_classifier->classify(LUT, *m_current_image, target, ImageClassifier::RGBA);
+}
+
 void DataWrapper::classifyPreviewImage(ClassifiedImage &target,unsigned char* temp_vals) const
 {
     int width = m_current_image->getWidth();
@@ -353,14 +364,7 @@ void DataWrapper::classifyPreviewImage(ClassifiedImage &target,unsigned char* te
 
     target.setImageDimensions(width,height);
     LookUpTable tempLUT(temp_vals);
-    //qDebug() << "Begin Loop:";
-    for (int y = 0; y < height; y++)
-    {
-        for (int x = 0; x < width; x++)
-        {
-            target.image[y][x] = tempLUT.classifyPixel((*m_current_image)(x,y));
-        }
-    }
+    image_classifier->classify(tempLUT, *m_current_image, target.image[0]);
 }
 
 void DataWrapper::saveAnImage()
@@ -23,6 +23,7 @@
 #include "Vision/VisionTypes/VisionFieldObjects/cornerpoint.h"
 #include "Vision/VisionTools/pccamera.h"
 #include "Vision/VisionTools/lookuptable.h"
+#include "Vision/VisionTools/imageclassifier.h"
 #include "Infrastructure/NUImage/ClassifiedImage.h"
 #include "NUPlatform/NUCamera/NUCameraData.h"
 
@@ -102,6 +103,7 @@ private:
     void setFieldObjects(FieldObjects* fieldObjects);
     void setLUT(unsigned char* vals);
     void classifyImage(ClassifiedImage &target) const;
+    void classifyImageRGBA(unsigned int* target) const;
     void classifyPreviewImage(ClassifiedImage &target,unsigned char* temp_vals) const;
     
 signals:
@@ -118,6 +120,7 @@ private:
 
     string LUTname;
     LookUpTable LUT;
+    ImageClassifier* image_classifier;      //! classifies whole frames for display, shared across the cores
 
     vector<float> m_horizon_coefficients;
     Horizon m_kinematics_horizon;
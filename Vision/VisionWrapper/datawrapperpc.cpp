@@ -53,11 +53,11 @@ string DataWrapper::getIDName(DEBUG_ID id) {
     }
 }
 
-void getPointsAndColoursFromSegments(const vector< vector<ColourSegment> >& segments, vector<cv::Scalar>& colours, vector<Point >& pts)
+void getPointsAndColoursFromSegments(const SegmentScans& segments, vector<cv::Scalar>& colours, vector<Point >& pts)
 {
     unsigned char r, g, b;
     
-    BOOST_FOREACH(const vector<ColourSegment>& line, segments) {
+    BOOST_FOREACH(const SegmentScan& line, segments) {
         BOOST_FOREACH(const ColourSegment& seg, line) {
             getColourAsRGB(seg.getColour(), r, g, b);
             pts.push_back(seg.getStart());
@@ -115,10 +115,11 @@ DataWrapper::DataWrapper()
     else
         m_method = STREAM;
 
+    binary_sensors = false;
     switch(m_method) {
     case CAMERA:
         m_camera = new PCCamera();
-        m_current_image = *(m_camera->grabNewImage());
+        mapCameraFrame();
         LUTname = string(getenv("HOME")) +  string("/nubot/default.lut");
         break;
     case STREAM:
@@ -146,6 +147,14 @@ DataWrapper::DataWrapper()
             QMessageBox::warning(NULL, "Error", QString("Failed to read sensors from: ") + QString(sensorstreamname.c_str()) + QString(" defaulting to sensors off."));
             using_sensors = false;
         }
+        else {
+            binary_sensors = SensorLog::isSensorLog(sensorstrm);
+            if(binary_sensors && !sensor_log.readHeader(sensorstrm, m_sensor_data)) {
+                errorlog << "DataWrapper::DataWrapper() - failed to read sensor log header: " << sensorstreamname << endl;
+                QMessageBox::warning(NULL, "Error", QString("Failed to read the sensor log header from: ") + QString(sensorstreamname.c_str()) + QString(" defaulting to sensors off."));
+                using_sensors = false;
+            }
+        }
 
         if(!imagestrm.is_open()) {
             errorlog << "DataWrapper::DataWrapper() - failed to load stream: " << streamname << endl;
@@ -804,11 +813,21 @@ bool DataWrapper::debugPublish(DEBUG_ID id, const vector<LSFittedLine>& data)
     return true;
 }
 
+/**
+*   @brief Grabs a new camera frame and references its buffer as the current image without copying it.
+*/
+void DataWrapper::mapCameraFrame()
+{
+    const NUImage* frame = m_camera->grabNewImage();
+    m_current_image.cloneExisting(*frame);
+    m_current_image.setCameraSettings(frame->getCameraSettings());
+}
+
 bool DataWrapper::updateFrame()
 {
     switch(m_method) {
     case CAMERA:
-        m_current_image = *(m_camera->grabNewImage());   //force get new frame
+        mapCameraFrame();   //force get new frame
         break;
     case STREAM:
         VisionConstants::loadFromFile(configname);
@@ -831,14 +850,22 @@ bool DataWrapper::updateFrame()
             if(using_sensors) {
                 sensorstrm.clear() ;
                 sensorstrm.seekg(0, ios::beg);
+                if(binary_sensors)
+                    sensor_log.readHeader(sensorstrm, m_sensor_data);
             }
         }
         if(using_sensors) {
-            try {
-                sensorstrm >> m_sensor_data;
+            if(binary_sensors) {
+                if(!sensor_log.readFrame(sensorstrm, m_sensor_data))
+                    errorlog << "Sensor stream error: failed to read sensor log frame " << numFramesProcessed << endl;
             }
-            catch(std::exception& e){
-                errorlog << "Sensor stream error: " << e.what() << endl;
+            else {
+                try {
+                    sensorstrm >> m_sensor_data;
+                }
+                catch(std::exception& e){
+                    errorlog << "Sensor stream error: " << e.what() << endl;
+                }
             }
         }
         break;
@@ -21,6 +21,7 @@
 #include "Tools/Math/LSFittedLine.h"
 
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/FileFormats/SensorLogFormat.h"
 
 #define GROUP_NAME "/home/shannon/Images/paper"
 #define GROUP_EXT ".png"
@@ -103,6 +104,7 @@ private:
     DataWrapper();
     ~DataWrapper();
     bool updateFrame();
+    void mapCameraFrame();
     bool loadLUTFromFile(const string& fileName);
     int getNumFramesDropped() const {return numFramesDropped;}      //! @brief Returns the number of dropped frames since start.
     int getNumFramesProcessed() const {return numFramesProcessed;}  //! @brief Returns the number of processed frames since start.
@@ -139,6 +141,8 @@ private:
     bool using_sensors;
     string sensorstreamname;
     ifstream sensorstrm;
+    bool binary_sensors;            //! @var whether the sensor stream is a binary sensor log rather than the text format
+    SensorLogReader sensor_log;     //! @var decodes the binary sensor log, holds the previous frame for delta frames
 
     //! Used for debugging
     int debug_window_num;
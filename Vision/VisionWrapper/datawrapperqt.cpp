@@ -26,6 +26,7 @@ DataWrapper::DataWrapper(MainWindow* ui, bool ok, INPUT_METHOD method, string is
 
     kinematics_horizon.setLine(0, 1, 0);
     numFramesDropped = numFramesProcessed = 0;
+    binary_sensors = false;
 
     switch(method) {
     case STREAM:
@@ -42,6 +43,14 @@ DataWrapper::DataWrapper(MainWindow* ui, bool ok, INPUT_METHOD method, string is
                 QMessageBox::warning(NULL, "Error", QString("Failed to read sensors from: ") + QString(sensorstreamname.c_str()) + QString(" defaulting to sensors off."));
                 using_sensors = false;
             }
+            else {
+                binary_sensors = SensorLog::isSensorLog(sensorstrm);
+                if(binary_sensors && !sensor_log.readHeader(sensorstrm, m_sensor_data)) {
+                    errorlog << "DataWrapper::DataWrapper() - failed to read sensor log header: " << sensorstreamname << endl;
+                    QMessageBox::warning(NULL, "Error", QString("Failed to read the sensor log header from: ") + QString(sensorstreamname.c_str()) + QString(" defaulting to sensors off."));
+                    using_sensors = false;
+                }
+            }
         }
 
         if(!imagestrm.is_open()) {
@@ -418,7 +427,7 @@ void DataWrapper::debugPublish(DEBUG_ID id, const vector<Point> &data_points)
 void DataWrapper::debugPublish(DEBUG_ID id, const SegmentedRegion& region)
 {
     unsigned char r, g, b;
-    BOOST_FOREACH(const vector<ColourSegment>& line, region.getSegments()) {
+    BOOST_FOREACH(const SegmentScan& line, region.getSegments()) {
         BOOST_FOREACH(const ColourSegment& seg, line) {
             getColourAsRGB(seg.getColour(), r, g, b);
             gui->addToLayer(id, QLineF(seg.getStart().x, seg.getStart().y, seg.getEnd().x, seg.getEnd().y), QColor(r, g, b));
@@ -604,12 +613,20 @@ bool DataWrapper::updateFrame()
                 return false;
             }
             if(using_sensors) {
-                try {
-                    sensorstrm >> m_sensor_data;
+                if(binary_sensors) {
+                    if(!sensor_log.readFrame(sensorstrm, m_sensor_data)) {
+                        errorlog << "Sensor stream error: failed to read sensor log frame " << numFramesProcessed << endl;
+                        return false;
+                    }
                 }
-                catch(std::exception& e){
-                    errorlog << "Sensor stream error: " << e.what() << endl;
-                    return false;
+                else {
+                    try {
+                        sensorstrm >> m_sensor_data;
+                    }
+                    catch(std::exception& e){
+                        errorlog << "Sensor stream error: " << e.what() << endl;
+                        return false;
+                    }
                 }
             }
             break;
@@ -26,6 +26,7 @@
 #include "Vision/VisionTypes/RANSACTypes/ransacgoal.h"
 
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/FileFormats/SensorLogFormat.h"
 #include "NUPlatform/NUCamera/NUCameraData.h"
 
 #include "mainwindow.h"
@@ -142,6 +143,8 @@ private:
     bool using_sensors;
     string sensorstreamname;
     ifstream sensorstrm;
+    bool binary_sensors;            //! @var whether the sensor stream is a binary sensor log rather than the text format
+    SensorLogReader sensor_log;     //! @var decodes the binary sensor log, holds the previous frame for delta frames
 
     //! Frame info
     int numFramesDropped;
@@ -47,11 +47,11 @@ string DataWrapper::getIDName(DEBUG_ID id) {
     }
 }
 
-void getPointsAndColoursFromSegments(const vector< vector<ColourSegment> >& segments, vector<cv::Scalar>& colours, vector<Point>& pts)
+void getPointsAndColoursFromSegments(const SegmentScans& segments, vector<cv::Scalar>& colours, vector<Point>& pts)
 {
     unsigned char r, g, b;
 
-    BOOST_FOREACH(const vector<ColourSegment>& line, segments) {
+    BOOST_FOREACH(const SegmentScan& line, segments) {
         BOOST_FOREACH(const ColourSegment& seg, line) {
             getColourAsRGB(seg.getColour(), r, g, b);
             pts.push_back(seg.getStart());
@@ -19,6 +19,7 @@ DataWrapper::DataWrapper()
     LUTname = string(getenv("HOME")) +  string("/nubot/default.lut");
     imagestrm.open(image_stream_name.c_str());
     sensorstrm.open(sensor_stream_name.c_str());
+    binary_sensors = false;
 
     valid = true;
 
@@ -35,6 +36,9 @@ DataWrapper::DataWrapper()
         errorlog << "DataWrapper::DataWrapper() - failed to load sensor stream: " << sensor_stream_name << endl;
         valid = false;
     }
+    else if(!readSensorLogHeader()) {
+        valid = false;
+    }
     if(!loadLUTFromFile(LUTname)) {
         errorlog << "DataWrapper::DataWrapper() - failed to load LUT: " << LUTname << endl;
         valid = false;
@@ -199,8 +203,17 @@ bool DataWrapper::updateFrame()
 
         // read sensors from the stream
         if(sensorstrm.good()) {
-            sensorstrm >> sensors;
-            sensors_good = true;
+            if(binary_sensors) {
+                sensors_good = sensor_log.readFrame(sensorstrm, m_current_sensors);
+                if(sensors_good)
+                    sensors = m_current_sensors;
+                else
+                    errorlog << "DataWrapper::updateFrame - failed to read sensor log frame: " << sensor_stream_name << endl;
+            }
+            else {
+                sensorstrm >> sensors;
+                sensors_good = true;
+            }
         }
         else {
             debug << "DataWrapper::updateFrame - failed to read sensor stream: " << sensor_stream_name << endl;
@@ -366,6 +379,21 @@ bool DataWrapper::setSensorStream(const string &filename)
         errorlog << "DataWrapper::DataWrapper() - failed to load sensor stream: " << sensor_stream_name << endl;
         return false;
     }
+    return readSensorLogHeader();
+}
+
+/**
+*   @brief Checks whether the sensor stream is a binary sensor log or the text format, and
+*   reads the header of a binary log so its frames can be decoded.
+*   @return The success of the operation.
+*/
+bool DataWrapper::readSensorLogHeader()
+{
+    binary_sensors = SensorLog::isSensorLog(sensorstrm);
+    if(binary_sensors && !sensor_log.readHeader(sensorstrm, m_current_sensors)) {
+        errorlog << "DataWrapper::readSensorLogHeader() - failed to read sensor log header: " << sensor_stream_name << endl;
+        return false;
+    }
     return true;
 }
 
@@ -379,6 +407,7 @@ void DataWrapper::resetStream()
     imagestrm.seekg(0, ios::beg);
     sensorstrm.clear();
     sensorstrm.seekg(0, ios::beg);
+    readSensorLogHeader();
 }
 
 /**
@@ -6,6 +6,7 @@
 
 #include "Kinematics/Horizon.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Tools/FileFormats/SensorLogFormat.h"
 #include "NUPlatform/NUCamera/NUCameraData.h"
 
 #include "Vision/basicvisiontypes.h"
@@ -87,6 +88,7 @@ private:
     void printHistory(ostream& out);
     bool setImageStream(const string& filename);
     bool setSensorStream(const string &filename);
+    bool readSensorLogHeader();
     bool loadLUTFromFile(const string& filename);
     void resetStream();
     
@@ -112,6 +114,8 @@ private:
     ifstream imagestrm;             //! @var image stream
     string sensor_stream_name;
     ifstream sensorstrm;
+    bool binary_sensors;            //! @var whether the sensor stream is a binary sensor log rather than the text format
+    SensorLogReader sensor_log;     //! @var decodes the binary sensor log, holds the previous frame for delta frames
 
     int numFramesProcessed;         //! @var the number of frames processed so far
 
@@ -0,0 +1,235 @@
+#include "visioncontrolwrapperbenchmark.h"
+#include "Vision/visionconstants.h"
+#include "Tools/Profiling/ProfileRecorder.h"
+#include "debug.h"
+#include "nubotdataconfig.h"
+
+#include <boost/foreach.hpp>
+#include <QDir>
+#include <QFile>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+//! The largest difference in pixels between a detection and the golden file that still matches
+static const double c_golden_tolerance = 0.5;
+
+static double benchmarkTime()
+{
+    timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec*1e3 + t.tv_nsec*1e-6;
+}
+
+//! @brief Returns the value below which a fraction of the sorted times fall
+static double percentile(const vector<double>& sorted_times, double fraction)
+{
+    if(sorted_times.empty())
+        return 0;
+    unsigned int index = static_cast<unsigned int>(fraction*(sorted_times.size() - 1) + 0.5);
+    return sorted_times[index];
+}
+
+static bool isLog(const QDir& dir)
+{
+    return dir.exists("image.strm") && dir.exists("sensor.strm");
+}
+
+VisionControlWrapper* VisionControlWrapper::instance = 0;
+
+VisionControlWrapper* VisionControlWrapper::getInstance()
+{
+    if(!instance)
+        instance = new VisionControlWrapper();
+    return instance;
+}
+
+VisionControlWrapper::VisionControlWrapper()
+{
+    data_wrapper = DataWrapper::getInstance();
+}
+
+/*!
+  * @brief Replays every log in the directory, reports the timing and writes or checks the golden file.
+  * @param log_directory The log, or the directory of logs, to replay.
+  * @param golden_filename The golden file, or empty to only time the logs.
+  * @param record Whether to write the golden file instead of checking the detections against it.
+  * @return 0 if the detections match the golden file, 1 if they do not, and -1 if the logs could not be replayed.
+  */
+int VisionControlWrapper::run(const string& log_directory, const string& golden_filename, bool record)
+{
+    vector<string> logs = findLogs(log_directory);
+    if(logs.empty()) {
+        errorlog << "VisionControlWrapper::run() - no image.strm and sensor.strm pairs found in: " << log_directory << endl;
+        return -1;
+    }
+
+    string lut_name = log_directory + "/default.lut";
+    if(!QFile::exists(lut_name.c_str()))
+        lut_name = string(DATA_DIR) + string("default.lut");
+    if(!data_wrapper->loadLUTFromFile(lut_name)) {
+        errorlog << "VisionControlWrapper::run() - failed to load LUT: " << lut_name << endl;
+        return -1;
+    }
+    string config_name = log_directory + "/VisionOptions.cfg";
+    if(QFile::exists(config_name.c_str()))
+        VisionConstants::loadFromFile(config_name);
+
+    ofstream golden_out;
+    ifstream golden_in;
+    if(!golden_filename.empty()) {
+        if(record)
+            golden_out.open(golden_filename.c_str());
+        else
+            golden_in.open(golden_filename.c_str());
+        if(!golden_out.is_open() && !golden_in.is_open()) {
+            errorlog << "VisionControlWrapper::run() - failed to open golden file: " << golden_filename << endl;
+            return -1;
+        }
+    }
+
+    vector<double> frame_times;
+    int mismatches = 0;
+    double start = benchmarkTime();
+    BOOST_FOREACH(const string& log, logs) {
+        if(!data_wrapper->openStreams(log + "/image.strm", log + "/sensor.strm"))
+            return -1;
+        while(data_wrapper->updateFrame()) {
+            double frame_start = benchmarkTime();
+            controller.runFrame(true, true, true, true);
+            frame_times.push_back(benchmarkTime() - frame_start);
+
+            int frame = frame_times.size() - 1;
+            if(golden_out.is_open())
+                writeDetections(golden_out, frame);
+            else if(golden_in.is_open() && !checkDetections(golden_in, frame))
+                mismatches++;
+        }
+    }
+    double total_time = benchmarkTime() - start;
+
+    if(golden_in.is_open()) {
+        golden_in >> ws;
+        if(!golden_in.eof()) {
+            errorlog << "VisionControlWrapper::run() - the golden file has more frames than the logs" << endl;
+            mismatches++;
+        }
+    }
+
+    //report the timing
+    double vision_time = 0;
+    BOOST_FOREACH(double t, frame_times) {
+        vision_time += t;
+    }
+    vector<double> sorted_times = frame_times;
+    sort(sorted_times.begin(), sorted_times.end());
+
+    cout << frame_times.size() << " frames from " << logs.size() << " logs in " << total_time << " ms" << endl;
+    cout << fixed << setprecision(3);
+    if(vision_time > 0)
+        cout << "vision:  " << 1e3*frame_times.size()/vision_time << " frames/sec" << endl;
+    if(total_time > 0)
+        cout << "replay:  " << 1e3*frame_times.size()/total_time << " frames/sec including reading the logs" << endl;
+    cout << "frame (ms):  p50 " << percentile(sorted_times, 0.5) << "  p95 " << percentile(sorted_times, 0.95)
+         << "  p99 " << percentile(sorted_times, 0.99) << "  max " << percentile(sorted_times, 1) << endl;
+
+    ProfileRecorder::collect();
+    ProfileSummary summary = ProfileRecorder::summary();
+    cout << setw(16) << "stage (ms)" << setw(10) << "count" << setw(10) << "p50" << setw(10) << "p95" << setw(10) << "p99" << setw(10) << "max" << endl;
+    BOOST_FOREACH(const ProfileStatistics& stage, summary.Modules) {
+        cout << setw(16) << stage.Name << setw(10) << stage.Count << setw(10) << stage.Median << setw(10) << stage.P95
+             << setw(10) << stage.P99 << setw(10) << stage.Max << endl;
+    }
+
+    if(golden_out.is_open()) {
+        cout << "golden file written: " << golden_filename << endl;
+    }
+    else if(golden_in.is_open()) {
+        if(mismatches == 0)
+            cout << "all frames match the golden file" << endl;
+        else
+            cout << mismatches << " frames differ from the golden file" << endl;
+    }
+    return mismatches > 0 ? 1 : 0;
+}
+
+/*!
+  * @brief Returns the logs in a directory in name order; the directory itself if it is a log, and each subdirectory that is one.
+  */
+vector<string> VisionControlWrapper::findLogs(const string& log_directory) const
+{
+    vector<string> logs;
+    QDir dir(log_directory.c_str());
+    if(isLog(dir))
+        logs.push_back(log_directory);
+
+    QStringList subdirectories = dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
+    for(int i=0; i<subdirectories.size(); i++) {
+        QDir subdirectory(dir.filePath(subdirectories[i]));
+        if(isLog(subdirectory))
+            logs.push_back(subdirectory.path().toStdString());
+    }
+    return logs;
+}
+
+/*!
+  * @brief Writes the detections of the current frame in the golden file format.
+  */
+void VisionControlWrapper::writeDetections(ostream& out, int frame) const
+{
+    const vector<BenchmarkDetection>& detections = data_wrapper->getDetections();
+    out << "frame " << frame << " " << detections.size() << endl;
+    out << setprecision(10);
+    BOOST_FOREACH(const BenchmarkDetection& detection, detections) {
+        out << VFOName(detection.id);
+        for(int i=0; i<4; i++)
+            out << " " << detection.values[i];
+        out << endl;
+    }
+}
+
+/*!
+  * @brief Reads the next frame from the golden file and compares it with the detections of the current frame.
+  * @return Whether the frame matches, the differences are written to errorlog.
+  */
+bool VisionControlWrapper::checkDetections(istream& in, int frame) const
+{
+    const vector<BenchmarkDetection>& detections = data_wrapper->getDetections();
+    string word;
+    int golden_frame = -1;
+    unsigned int count = 0;
+    in >> word >> golden_frame >> count;
+    if(!in.good() || word.compare("frame") != 0 || golden_frame != frame) {
+        errorlog << "frame " << frame << ": not in the golden file" << endl;
+        in.setstate(ios_base::failbit);
+        return false;
+    }
+
+    bool match = count == detections.size();
+    if(!match)
+        errorlog << "frame " << frame << ": " << detections.size() << " detections, " << count << " in the golden file" << endl;
+
+    for(unsigned int d=0; d<count; d++) {
+        string name;
+        double values[4];
+        in >> name >> values[0] >> values[1] >> values[2] >> values[3];
+        if(d >= detections.size())
+            continue;
+
+        const BenchmarkDetection& detection = detections[d];
+        bool same = name.compare(VFOName(detection.id)) == 0;
+        for(int i=0; i<4 && same; i++)
+            same = fabs(values[i] - detection.values[i]) <= c_golden_tolerance;
+        if(!same) {
+            errorlog << "frame " << frame << ": detection " << d << " is " << VFOName(detection.id);
+            for(int i=0; i<4; i++)
+                errorlog << " " << detection.values[i];
+            errorlog << ", golden file has " << name;
+            for(int i=0; i<4; i++)
+                errorlog << " " << values[i];
+            errorlog << endl;
+            match = false;
+        }
+    }
+    return match;
+}
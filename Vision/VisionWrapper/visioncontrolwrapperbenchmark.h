@@ -0,0 +1,40 @@
+#ifndef CONTROLWRAPPERBENCHMARK_H
+#define CONTROLWRAPPERBENCHMARK_H
+
+#include "Vision/visioncontroller.h"
+#include "Vision/VisionWrapper/datawrapperbenchmark.h"
+
+/**
+*   @brief Replays a directory of logs through the vision system as fast as possible, reports the timing
+*          and checks the detections against a golden file.
+*
+*   A log is a directory holding an image.strm and the sensor.strm recorded with it. The directory given
+*   can be a log itself, and each of its subdirectories that is a log is replayed in name order. A
+*   default.lut or VisionOptions.cfg in the directory given is used instead of the ones in ~/nubot.
+*
+*   The golden file has a line "frame <number> <detections>" for each frame, followed by a line for
+*   each detection with its name and four values; the end points of a field line on the screen, or
+*   the screen location and size of anything else. A frame matches if it has the same detections in
+*   the same order, with every value within c_golden_tolerance pixels.
+*/
+class VisionControlWrapper
+{
+public:
+    static VisionControlWrapper* getInstance();
+
+    int run(const string& log_directory, const string& golden_filename, bool record);
+
+private:
+    VisionControlWrapper();
+
+    vector<string> findLogs(const string& log_directory) const;
+    void writeDetections(ostream& out, int frame) const;
+    bool checkDetections(istream& in, int frame) const;
+
+    static VisionControlWrapper* instance;  //! @var static singleton instance
+
+    VisionController controller;            //! @var the system controller
+    DataWrapper* data_wrapper;              //! @var the data wrapper
+};
+
+#endif // CONTROLWRAPPERBENCHMARK_H
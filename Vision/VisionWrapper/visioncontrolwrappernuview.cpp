@@ -75,6 +75,11 @@ void VisionControlWrapper::classifyImage(ClassifiedImage &classed_image)
     wrapper->classifyImage(classed_image);
 }
 
+void VisionControlWrapper::classifyImageRGBA(unsigned int* pixels)
+{
+    wrapper->classifyImageRGBA(pixels);
+}
+
 void VisionControlWrapper::classifyPreviewImage(ClassifiedImage &target,unsigned char* temp_vals) const
 {
     wrapper->classifyPreviewImage(target, temp_vals);
@@ -31,6 +31,7 @@ private:
     void setFieldObjects(FieldObjects* field_objects);
     void setLUT(unsigned char* vals);
     void classifyImage(ClassifiedImage& classed_image);
+    void classifyImageRGBA(unsigned int* pixels);
     void classifyPreviewImage(ClassifiedImage &target,unsigned char* temp_vals) const;
 
 };
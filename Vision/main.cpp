@@ -9,11 +9,25 @@
     #include "Vision/VisionWrapper/visioncontrolwrappernuview.h"
 #elif TARGET_IS_TRAINING
     #include "Vision/VisionWrapper/visioncontrolwrappertraining.h"
+#elif TARGET_IS_BENCHMARK
+    #include "Vision/VisionWrapper/visioncontrolwrapperbenchmark.h"
+    #include "Vision/GenericAlgorithms/ransacbenchmark.h"
+    #include "Vision/VisionTools/scanlineclassifierbenchmark.h"
+    #include "Vision/VisionTools/lookuptablebenchmark.h"
+    #include "Infrastructure/NUImage/NUImageBenchmark.h"
+    #include "Tools/Threading/QueueBenchmark.h"
+    #include "NUPlatform/NUSensorsBenchmark.h"
+    #include <cstdlib>
 #else
     #include "Vision/VisionWrapper/visioncontrolwrapperdarwin.h"
 #endif
 
-#ifndef TARGET_IS_RPI
+#ifdef TARGET_IS_BENCHMARK
+    class NUPlatform;
+    NUPlatform* Platform = NULL;    // the benchmark runs without a robot, so there is no platform
+#endif
+
+#if !(defined TARGET_IS_RPI || defined TARGET_IS_BENCHMARK)
 #include <QApplication>
 #include <QFileDialog>
 #include <QMessageBox>
@@ -52,6 +66,7 @@ using namespace std;
 int qt();
 int pc();
 int rpi(bool disp_on, bool cam);
+int benchmark(int argc, char** argv);
 
 //#include "Infrastructure/NUSensorsData/NUSensorsData.h"
 //#include "Infrastructure/NUImage/NUImage.h"
@@ -104,12 +119,99 @@ int main(int argc, char** argv)
     #elif TARGET_IS_PC
     //return pc();
     return qt();
+    #elif TARGET_IS_BENCHMARK
+    return benchmark(argc, argv);
     #else
     cout << "Error not a valid define! Must be TARGET_IS_RPI or TARGET_IS_PC" << endl;
     return 0;
     #endif
 }
 
+/**
+*   @brief Replays a directory of logs headless, reports the timing and checks the golden file.
+*
+*   Usage: Vision <log directory> [golden file] [record]
+*   With "record" the golden file is written instead of checked. Returns non-zero if the
+*   detections differ from the golden file, so it can be used as a regression check.
+*
+*   Usage: Vision --ransac <point file> [repetitions]
+*   Times the field line RANSAC on the field points recorded by FieldPointDetector.
+*
+*   Usage: Vision --sensors <kinematic model> [frames]
+*   Times the kinematics and soft sensors of NUSensors with a kinematic model.
+*
+*   Usage: Vision --scanlines <image stream> <lut>
+*   Compares the scalar and vectorised scanline classifiers on the recorded images.
+*
+*   Usage: Vision --lut <image stream> <lut>
+*   Checks and times the compressed lookup table against the flat one on the recorded images.
+*
+*   Usage: Vision --image [repetitions]
+*   Times full traversals of a synthetic camera image through the NUImage spans.
+*
+*   Usage: Vision --queues [items] [wakeups]
+*   Times the throughput and wake-up latency of the QueueThread queues.
+*/
+int benchmark(int argc, char** argv)
+{
+#ifdef TARGET_IS_BENCHMARK
+    if(argc < 2) {
+        cout << "Usage: " << argv[0] << " <log directory> [golden file] [record]" << endl;
+        cout << "       " << argv[0] << " --ransac <point file> [repetitions]" << endl;
+        cout << "       " << argv[0] << " --sensors <kinematic model> [frames]" << endl;
+        cout << "       " << argv[0] << " --scanlines <image stream> <lut>" << endl;
+        cout << "       " << argv[0] << " --lut <image stream> <lut>" << endl;
+        cout << "       " << argv[0] << " --image [repetitions]" << endl;
+        cout << "       " << argv[0] << " --queues [items] [wakeups]" << endl;
+        return -1;
+    }
+    if(string(argv[1]).compare("--ransac") == 0) {
+        if(argc < 3) {
+            cout << "Usage: " << argv[0] << " --ransac <point file> [repetitions]" << endl;
+            return -1;
+        }
+        int repetitions = argc > 3 ? atoi(argv[3]) : 20;
+        return RANSACBenchmark(argv[2], repetitions > 0 ? repetitions : 20) ? 0 : -1;
+    }
+    if(string(argv[1]).compare("--sensors") == 0) {
+        if(argc < 3) {
+            cout << "Usage: " << argv[0] << " --sensors <kinematic model> [frames]" << endl;
+            return -1;
+        }
+        int frames = argc > 3 ? atoi(argv[3]) : 20000;
+        return NUSensorsBenchmark(argv[2], frames > 0 ? frames : 20000) ? 0 : -1;
+    }
+    if(string(argv[1]).compare("--scanlines") == 0) {
+        if(argc < 4) {
+            cout << "Usage: " << argv[0] << " --scanlines <image stream> <lut>" << endl;
+            return -1;
+        }
+        return ScanLineClassifierBenchmark(argv[2], argv[3]) ? 0 : -1;
+    }
+    if(string(argv[1]).compare("--lut") == 0) {
+        if(argc < 4) {
+            cout << "Usage: " << argv[0] << " --lut <image stream> <lut>" << endl;
+            return -1;
+        }
+        return LookUpTableBenchmark(argv[2], argv[3]) ? 0 : -1;
+    }
+    if(string(argv[1]).compare("--image") == 0) {
+        int repetitions = argc > 2 ? atoi(argv[2]) : 200;
+        return NUImageTraversalBenchmark(640, 480, repetitions > 0 ? repetitions : 200) ? 0 : -1;
+    }
+    if(string(argv[1]).compare("--queues") == 0) {
+        int items = argc > 2 ? atoi(argv[2]) : 2000000;
+        int wakeups = argc > 3 ? atoi(argv[3]) : 2000;
+        return QueueThreadBenchmark(items > 0 ? items : 2000000, wakeups > 0 ? wakeups : 2000) ? 0 : -1;
+    }
+    string golden = argc > 2 ? string(argv[2]) : string();
+    bool record = argc > 3 && string(argv[3]).compare("record") == 0;
+    return VisionControlWrapper::getInstance()->run(argv[1], golden, record);
+#else
+    return 0;
+#endif
+}
+
 int rpi(bool disp_on, bool cam)
 {
 #ifdef TARGET_IS_RPI
@@ -186,6 +288,7 @@ int rpi(bool disp_on, bool cam)
 
 int qt()
 {
+#ifndef TARGET_IS_BENCHMARK
 #ifndef TARGET_IS_RPI
     MyApplication app(NULL);
 #endif
@@ -194,5 +297,6 @@ int qt()
     int error = vision->run();
     if(error != 0)
         cout << "Error: " << error << endl;
+#endif
     return 0;
 }
@@ -16,7 +16,7 @@ VisionBlackboard::VisionBlackboard()
 {
     wrapper = DataWrapper::getInstance();
     //Get Image
-    original_image = NULL;
+    m_arena = FrameArena::getInstance();
 
     VisionConstants::loadFromFile(string(CONFIG_DIR) + string("VisionOptions.cfg"));
 }
@@ -195,7 +195,7 @@ void VisionBlackboard::setHorizontalScanlines(const vector<int>& scanlines)
 *   @brief sets the horizontal segments.
 *   @param segmented_scanlines A vector of vectors of colour segments.
 */
-void VisionBlackboard::setHorizontalSegments(const vector<vector<ColourSegment> >& segmented_scanlines)
+void VisionBlackboard::setHorizontalSegments(const SegmentScans& segmented_scanlines)
 {
     horizontal_segmented_scanlines.set(segmented_scanlines, HORIZONTAL);
 }
@@ -204,7 +204,7 @@ void VisionBlackboard::setHorizontalSegments(const vector<vector<ColourSegment>
 *   @brief sets the vertical segments.
 *   @param segmented_scanlines A vector of vectors of colour segments.
 */
-void VisionBlackboard::setVerticalSegments(const vector<vector<ColourSegment> >& segmented_scanlines)
+void VisionBlackboard::setVerticalSegments(const SegmentScans& segmented_scanlines)
 {
     vertical_segmented_scanlines.set(segmented_scanlines, VERTICAL);
 }
@@ -213,7 +213,7 @@ void VisionBlackboard::setVerticalSegments(const vector<vector<ColourSegment> >&
 *   @brief sets the filtered horizontal segments.
 *   @param segmented_scanlines A vector of vectors of colour segments.
 */
-void VisionBlackboard::setHorizontalFilteredSegments(const vector<vector<ColourSegment> >& segmented_scanlines)
+void VisionBlackboard::setHorizontalFilteredSegments(const SegmentScans& segmented_scanlines)
 {
     horizontal_filtered_segments.set(segmented_scanlines, HORIZONTAL);
 }
@@ -222,7 +222,7 @@ void VisionBlackboard::setHorizontalFilteredSegments(const vector<vector<ColourS
 *   @brief sets the filtered vertical segments.
 *   @param segmented_scanlines A vector of vectors of colour segments.
 */
-void VisionBlackboard::setVerticalFilteredSegments(const vector<vector<ColourSegment> >& segmented_scanlines)
+void VisionBlackboard::setVerticalFilteredSegments(const SegmentScans& segmented_scanlines)
 {
     vertical_filtered_segments.set(segmented_scanlines, VERTICAL);
 }
@@ -232,7 +232,7 @@ void VisionBlackboard::setVerticalFilteredSegments(const vector<vector<ColourSeg
 *   @param vfo_if The identifier of the field object
 *   @param transitions A vector of transitions that matched the horizontal rules.
 */
-void VisionBlackboard::setHorizontalTransitions(COLOUR_CLASS colour_class, const vector<ColourSegment> &transitions)
+void VisionBlackboard::setHorizontalTransitions(COLOUR_CLASS colour_class, const SegmentScan &transitions)
 {
     matched_horizontal_segments[colour_class] = transitions;
 }
@@ -242,7 +242,7 @@ void VisionBlackboard::setHorizontalTransitions(COLOUR_CLASS colour_class, const
 *   @param vfo_if The identifier of the field object
 *   @param transitions A vector of transitions that matched the vertical rules.
 */
-void VisionBlackboard::setVerticalTransitions(COLOUR_CLASS colour_class, const vector<ColourSegment> &transitions)
+void VisionBlackboard::setVerticalTransitions(COLOUR_CLASS colour_class, const SegmentScan &transitions)
 {
     matched_vertical_segments[colour_class] = transitions;
 }
@@ -251,7 +251,7 @@ void VisionBlackboard::setVerticalTransitions(COLOUR_CLASS colour_class, const v
 *   @brief sets the horizontal transition rule matches for all vision field objects.
 *   @param t_map A map from COLOUR_CLASSs to transitions that matched the horizontal rules.
 */
-void VisionBlackboard::setHorizontalTransitionsMap(const map<COLOUR_CLASS, vector<ColourSegment> > &t_map)
+void VisionBlackboard::setHorizontalTransitionsMap(const TransitionMap &t_map)
 {
     matched_horizontal_segments = t_map;
 }
@@ -260,7 +260,7 @@ void VisionBlackboard::setHorizontalTransitionsMap(const map<COLOUR_CLASS, vecto
 *   @brief sets the vertical transition rule matches for all vision field objects.
 *   @param t_map A map from COLOUR_CLASSs to transitions that matched the vertical rules.
 */
-void VisionBlackboard::setVerticalTransitionsMap(const map<COLOUR_CLASS, vector<ColourSegment> > &t_map)
+void VisionBlackboard::setVerticalTransitionsMap(const TransitionMap &t_map)
 {
     matched_vertical_segments = t_map;
 }
@@ -390,14 +390,12 @@ const SegmentedRegion& VisionBlackboard::getVerticalFilteredRegion() const
 *   @param vfo_if The identifier of the field object
 *   @return horizontal_segments The horizontal transition rule matches
 *
-*   @note This method cannot be const as an element is accessed by the [] operator
-*   in the case that this does not find a mapping (using the default constructor). This
-*   is good as there is no need to worry about manually inserting a vector for each field object
-*   or doing any checks in this method for missing mappings.
+*   @note Missing mappings return an empty scan rather than inserting one, so the
+*   detectors can call this concurrently.
 */
-const vector<ColourSegment> &VisionBlackboard::getHorizontalTransitions(COLOUR_CLASS colour_class)
+const SegmentScan &VisionBlackboard::getHorizontalTransitions(COLOUR_CLASS colour_class) const
 {
-    return matched_horizontal_segments[colour_class];
+    return findTransitions(matched_horizontal_segments, colour_class);
 }
 
 /**
@@ -405,21 +403,32 @@ const vector<ColourSegment> &VisionBlackboard::getHorizontalTransitions(COLOUR_C
 *   @param vfo_if The identifier of the field object
 *   @return vertical_segments The vertical transition rule matches
 *
-*   @note This method cannot be const as an element is accessed by the [] operator
-*   in the case that this does not find a mapping (using the default constructor). This
-*   is good as there is no need to worry about manually inserting a vector for each field object
-*   or doing any checks in this method for missing mappings.
+*   @note Missing mappings return an empty scan rather than inserting one, so the
+*   detectors can call this concurrently.
 */
-const vector<ColourSegment> &VisionBlackboard::getVerticalTransitions(COLOUR_CLASS colour_class)
+const SegmentScan &VisionBlackboard::getVerticalTransitions(COLOUR_CLASS colour_class) const
 {
-    return matched_vertical_segments[colour_class];
+    return findTransitions(matched_vertical_segments, colour_class);
+}
+
+/**
+*   @brief looks up the transitions for a colour class without modifying the map.
+*   @param t_map The transition map to search.
+*   @param colour_class The colour class.
+*   @return The matched transitions, or an empty scan if there are none.
+*/
+const SegmentScan& VisionBlackboard::findTransitions(const TransitionMap& t_map, COLOUR_CLASS colour_class)
+{
+    static const SegmentScan empty;
+    TransitionMap::const_iterator it = t_map.find(colour_class);
+    return it != t_map.end() ? it->second : empty;
 }
 
 /**
 *   @brief returns the horizontal transition rule matches for all VFOs
 *   @return horizontal_segments The horizontal transition rule matches for all VFOs
 */
-const map<COLOUR_CLASS, vector<ColourSegment> > &VisionBlackboard::getHorizontalTransitionsMap() const
+const TransitionMap &VisionBlackboard::getHorizontalTransitionsMap() const
 {
     return matched_horizontal_segments;
 }
@@ -428,7 +437,7 @@ const map<COLOUR_CLASS, vector<ColourSegment> > &VisionBlackboard::getHorizontal
 *   @brief returns the vertical transition rule matches for all VFOs
 *   @return vertical_segments The vertical transition rule matches for all VFOs
 */
-const map<COLOUR_CLASS, vector<ColourSegment> > &VisionBlackboard::getVerticalTransitionsMap() const
+const TransitionMap &VisionBlackboard::getVerticalTransitionsMap() const
 {
     return matched_vertical_segments;
 }
@@ -439,7 +448,28 @@ const map<COLOUR_CLASS, vector<ColourSegment> > &VisionBlackboard::getVerticalTr
 */
 const NUImage& VisionBlackboard::getOriginalImage() const
 {
-    return *original_image;
+    return original_image.image();
+}
+
+/**
+*   @brief returns a read-only view of the current image.
+*   The view references the wrapper's image directly, detectors should use this rather than copying the image.
+*   @return The image view.
+*/
+const NUImageView& VisionBlackboard::getImageView() const
+{
+    return original_image;
+}
+
+/**
+*   @brief returns the coarse classification of the current image.
+*   It is only valid() when VisionConstants::IMAGE_SUBSAMPLING is above 1, coarse pixel (x, y) is
+*   full resolution pixel (x*factor, y*factor).
+*   @return The subsampled image.
+*/
+const SubsampledImage& VisionBlackboard::getSubsampledImage() const
+{
+    return m_subsampled_image;
 }
 
 /**
@@ -487,11 +517,15 @@ void VisionBlackboard::update()
 
     wrapper = DataWrapper::getInstance();
 
+    //last frame's segments and transitions live in the arena, release them before it is reset
+    releaseFrameData();
+    m_arena->reset();
+
     //get new image pointer
-    original_image = wrapper->getFrame();
+    original_image = NUImageView(wrapper->getFrame());
 
     //WARNING The following warning may not be triggered properly
-    if(original_image == NULL) {
+    if(!original_image.valid()) {
         cout << "VisionBlackboard::update() - WARNING - Camera Image pointer is null - Camera may be disconnected or faulty." << endl;
         errorlog << "VisionBlackboard::update() - WARNING - Camera Image pointer is null - Camera may be disconnected or faulty." << endl;
     }
@@ -525,11 +559,13 @@ void VisionBlackboard::update()
 
     kinematics_horizon = wrapper->getKinematicsHorizon();
     checkKinematicsHorizon();
-        
-    //clear intermediates
-    matched_horizontal_segments.clear();
-    matched_vertical_segments.clear();
 
+    //the modules share one coarse classification of the image when subsampling
+    if(VisionConstants::IMAGE_SUBSAMPLING > 1 && original_image.valid() && original_image->getWidth() > 0 && original_image->getHeight() > 0)
+        m_subsampled_image.classify(getLUT(), *original_image, VisionConstants::IMAGE_SUBSAMPLING);
+    else
+        m_subsampled_image.clear();
+        
     //clear out result vectors
     m_balls.clear();
     //m_beacons.clear();
@@ -590,8 +626,7 @@ void VisionBlackboard::debugPublish() const
         debug << "VisionBlackboard::debugPublish() - Begin" << endl;
     #endif
     vector<Vector2<double> > pts;
-    map<COLOUR_CLASS, vector<ColourSegment> >::const_iterator it;
-    vector<ColourSegment> v_s;
+    TransitionMap::const_iterator it;
 
 #if VISION_BLACKBOARD_VERBOSITY > 1
     debug << "VisionBlackboard::debugPublish - " << endl;
@@ -613,9 +648,11 @@ void VisionBlackboard::debugPublish() const
         size += it->second.size();
     }
     debug << "matched_vertical_segments: " << size << endl;
+    debug << "frame arena: " << m_arena->getArenaAllocations() << " arena allocations (" << m_arena->getBytesUsed() << " bytes) from "
+          << m_arena->getHeapAllocations() << " heap allocations" << endl;
 #endif
 
-    wrapper->debugPublish(DBID_IMAGE, original_image);
+    wrapper->debugPublish(DBID_IMAGE, original_image.get());
     
     //horizon
     pts.clear();
@@ -671,8 +708,7 @@ void VisionBlackboard::debugPublish() const
     //horizontal transitions
     pts.clear();
     for(it=matched_horizontal_segments.begin(); it!=matched_horizontal_segments.end(); it++) {
-        v_s = it->second;
-        BOOST_FOREACH(const ColourSegment& s, v_s) {
+        BOOST_FOREACH(const ColourSegment& s, it->second) {
             if(s.getColour() == white) {
                 pts.push_back(Point(s.getCentre().x, s.getCentre().y));
             }
@@ -687,8 +723,7 @@ void VisionBlackboard::debugPublish() const
     //vertical transitions
     pts.clear();
     for(it=matched_vertical_segments.begin(); it!=matched_vertical_segments.end(); it++) {
-        v_s = it->second;
-        BOOST_FOREACH(const ColourSegment& s, v_s) {
+        BOOST_FOREACH(const ColourSegment& s, it->second) {
             if(s.getColour() == white) {
                 pts.push_back(Point(s.getCentre().x, s.getCentre().y));
             }
@@ -746,3 +781,28 @@ void VisionBlackboard::checkKinematicsHorizon()
         #endif
     }
 }
+
+/**
+*   @brief Releases all of the frame data allocated from the arena and the view of the last image.
+*   Must be called before the arena is reset as the containers would otherwise
+*   be left pointing into reused memory.
+*/
+void VisionBlackboard::releaseFrameData()
+{
+    horizontal_segmented_scanlines.clear();
+    vertical_segmented_scanlines.clear();
+    horizontal_filtered_segments.clear();
+    vertical_filtered_segments.clear();
+    TransitionMap().swap(matched_horizontal_segments);
+    TransitionMap().swap(matched_vertical_segments);
+    original_image.reset();
+}
+
+/**
+*   @brief Releases the view of the image once the frame has been processed, so the wrapper
+*   can remap the image for the next frame while no views reference it.
+*/
+void VisionBlackboard::releaseImage()
+{
+    original_image.reset();
+}
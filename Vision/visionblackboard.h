@@ -11,12 +11,15 @@
 #include <map>
 
 #include "Kinematics/Horizon.h"
+#include "Infrastructure/NUImage/NUImageView.h"
 #include "NUPlatform/NUCamera/NUCameraData.h"
 #include "Tools/Math/Vector2.h"
 
 #include "VisionWrapper/datawrappercurrent.h"
 #include "VisionTools/lookuptable.h"
 #include "VisionTools/transformer.h"
+#include "VisionTools/framearena.h"
+#include "VisionTools/subsampledimage.h"
 #include "basicvisiontypes.h"
 #include "VisionTypes/coloursegment.h"
 #include "VisionTypes/segmentedregion.h"
@@ -55,15 +58,15 @@ public:
     void setGreenHorizonScanPoints(const vector< Vector2<double> >& points);
 
     void setHorizontalScanlines(const vector<int> &scanlines);
-    void setHorizontalSegments(const vector<vector<ColourSegment> >& segmented_scanlines);
-    void setVerticalSegments(const vector<vector<ColourSegment> >& segmented_scanlines);
-    void setHorizontalFilteredSegments(const vector<vector<ColourSegment> >& segmented_scanlines);
-    void setVerticalFilteredSegments(const vector<vector<ColourSegment> >& segmented_scanlines);
+    void setHorizontalSegments(const SegmentScans& segmented_scanlines);
+    void setVerticalSegments(const SegmentScans& segmented_scanlines);
+    void setHorizontalFilteredSegments(const SegmentScans& segmented_scanlines);
+    void setVerticalFilteredSegments(const SegmentScans& segmented_scanlines);
 
-    void setHorizontalTransitions(COLOUR_CLASS colour_class, const vector<ColourSegment>& transitions);
-    void setVerticalTransitions(COLOUR_CLASS colour_class, const vector<ColourSegment>& transitions);
-    void setHorizontalTransitionsMap(const map<COLOUR_CLASS, vector<ColourSegment> >& t_map);
-    void setVerticalTransitionsMap(const map<COLOUR_CLASS, vector<ColourSegment> >& t_map);
+    void setHorizontalTransitions(COLOUR_CLASS colour_class, const SegmentScan& transitions);
+    void setVerticalTransitions(COLOUR_CLASS colour_class, const SegmentScan& transitions);
+    void setHorizontalTransitionsMap(const TransitionMap& t_map);
+    void setVerticalTransitionsMap(const TransitionMap& t_map);
 
     void setObstaclePoints(const vector<Point> &points);
     
@@ -87,6 +90,8 @@ public:
     //ACCESSORS
 //    const Mat* getOriginalImageMat() const;
     const NUImage& getOriginalImage() const;
+    const NUImageView& getImageView() const;
+    const SubsampledImage& getSubsampledImage() const;
 
     const GreenHorizon& getGreenHorizon() const;
     const vector<Vector2<double> >& getGreenHorizonScanPoints() const;
@@ -98,10 +103,10 @@ public:
     const SegmentedRegion& getHorizontalFilteredRegion() const;
     const SegmentedRegion& getVerticalFilteredRegion() const;
 
-    const vector<ColourSegment>& getHorizontalTransitions(COLOUR_CLASS colour_class);
-    const vector<ColourSegment>& getVerticalTransitions(COLOUR_CLASS colour_class);
-    const map<COLOUR_CLASS, vector<ColourSegment> >& getHorizontalTransitionsMap() const;
-    const map<COLOUR_CLASS, vector<ColourSegment> >& getVerticalTransitionsMap() const;
+    const SegmentScan& getHorizontalTransitions(COLOUR_CLASS colour_class) const;
+    const SegmentScan& getVerticalTransitions(COLOUR_CLASS colour_class) const;
+    const TransitionMap& getHorizontalTransitionsMap() const;
+    const TransitionMap& getVerticalTransitionsMap() const;
     
     const Horizon& getKinematicsHorizon() const;
     const Transformer& getTransformer() const;
@@ -141,6 +146,9 @@ private:
     void debugPublish() const;
     
     void checkKinematicsHorizon();
+    void releaseFrameData();
+    void releaseImage();
+    static const SegmentScan& findTransitions(const TransitionMap& t_map, COLOUR_CLASS colour_class);
 
     CameraSettings getCameraSettings() const;
 
@@ -154,9 +162,12 @@ private:
     DataWrapper* wrapper;
 //    Mat* original_image_cv;                 //! @variable Opencv mat for storing the original image 3 channels.
 //    Mat* original_image_cv_4ch;             //! @variable Opencv mat for storing the original image 4 channels.
-    const NUImage* original_image;                  //! @variable Image for storing the original image.
+    NUImageView original_image;                     //! @variable View of the wrapper's current image, no copy is made.
+    SubsampledImage m_subsampled_image;             //! @variable The coarse classification of the image, empty unless subsampling.
 
     LookUpTable LUT;
+
+    FrameArena* m_arena;            //! @variable The arena the per-frame segment data is allocated from.
     
     //! Green Horizon data
     GreenHorizon m_green_horizon;   //! @variable The green horizon.
@@ -179,8 +190,8 @@ private:
     SegmentedRegion vertical_filtered_segments;         //! @variable The filtered segmented vertical scanlines.
 
     //! Transitions
-    map<COLOUR_CLASS, vector<ColourSegment> > matched_horizontal_segments;
-    map<COLOUR_CLASS, vector<ColourSegment> > matched_vertical_segments;
+    TransitionMap matched_horizontal_segments;
+    TransitionMap matched_vertical_segments;
     //vector<Transition> horizontal_transitions;  //! @variable The transition rule matches in the horizontal segments.
     //vector<Transition> vertical_transitions;    //! @variable The transition rule matches in the vertical segments.
     
@@ -79,12 +79,16 @@ float VisionConstants::BALL_WIDTH;
 float VisionConstants::CENTRE_CIRCLE_RADIUS;
 //float VisionConstants::BEACON_WIDTH;
 //! ScanLine options
+unsigned int VisionConstants::IMAGE_SUBSAMPLING;
 unsigned int VisionConstants::HORIZONTAL_SCANLINE_SPACING;
 unsigned int VisionConstants::VERTICAL_SCANLINE_SPACING;
 unsigned int VisionConstants::GREEN_HORIZON_SCAN_SPACING;
 unsigned int VisionConstants::GREEN_HORIZON_MIN_GREEN_PIXELS;
 float VisionConstants::GREEN_HORIZON_LOWER_THRESHOLD_MULT;
 float VisionConstants::GREEN_HORIZON_UPPER_THRESHOLD_MULT;
+bool VisionConstants::GREEN_HORIZON_INCREMENTAL;
+unsigned int VisionConstants::GREEN_HORIZON_SEARCH_WINDOW;
+unsigned int VisionConstants::GREEN_HORIZON_FULL_SCAN_PERIOD;
 //! Split and Merge constants
 unsigned int VisionConstants::SAM_MAX_LINES;
 float VisionConstants::SAM_SPLIT_DISTANCE;
@@ -100,6 +104,8 @@ bool VisionConstants::SAM_CLEAR_DIRTY;
 //! RANSAC constants
 float VisionConstants::RANSAC_MAX_ANGLE_DIFF_TO_MERGE; //
 float VisionConstants::RANSAC_MAX_DISTANCE_TO_MERGE; //
+float VisionConstants::RANSAC_CONFIDENCE;
+bool VisionConstants::RANSAC_PROGRESSIVE_SAMPLING;
 
 VisionConstants::VisionConstants()
 {
@@ -116,12 +122,16 @@ void VisionConstants::loadFromFile(std::string filename)
     BALL_WIDTH = 6.5;
     CENTRE_CIRCLE_RADIUS = 60;
 
-    HORIZONTAL_SCANLINE_SPACING = 5; //defaults in case of bad file
+    IMAGE_SUBSAMPLING = 1; //defaults in case of bad file
+    HORIZONTAL_SCANLINE_SPACING = 5;
     VERTICAL_SCANLINE_SPACING = 5;
     GREEN_HORIZON_SCAN_SPACING = 11;
     GREEN_HORIZON_MIN_GREEN_PIXELS = 5;
     GREEN_HORIZON_LOWER_THRESHOLD_MULT = 1;
     GREEN_HORIZON_UPPER_THRESHOLD_MULT = 2.5;
+    GREEN_HORIZON_INCREMENTAL = true;
+    GREEN_HORIZON_SEARCH_WINDOW = 4;
+    GREEN_HORIZON_FULL_SCAN_PERIOD = 30;
     GOAL_HEIGHT_TO_WIDTH_RATIO_MIN = 1.5,
     MIN_GOAL_SEPARATION = 20;
     SAM_MAX_LINES = 100;
@@ -143,6 +153,8 @@ void VisionConstants::loadFromFile(std::string filename)
     GOAL_RANSAC_MATCHING_TOLERANCE = 0.2;
     RANSAC_MAX_ANGLE_DIFF_TO_MERGE = SAM_MAX_ANGLE_DIFF_TO_MERGE; //
     RANSAC_MAX_DISTANCE_TO_MERGE = SAM_MAX_DISTANCE_TO_MERGE; //
+    RANSAC_CONFIDENCE = 0.99;
+    RANSAC_PROGRESSIVE_SAMPLING = false;
 
     std::ifstream in(filename.c_str());
     if(!in.is_open())
@@ -214,7 +226,7 @@ void VisionConstants::loadFromFile(std::string filename)
             in >> D2P_INCLUDE_BODY_PITCH;
         }
         else if(name.compare("D2P_ANGLE_CORRECTION") == 0) {
-            #if (defined TARGET_IS_PC || defined TARGET_IS_TRAINING || defined TARGET_IS_RPI)
+            #if (defined TARGET_IS_PC || defined TARGET_IS_TRAINING || defined TARGET_IS_RPI || defined TARGET_IS_BENCHMARK)
                 in >> D2P_ANGLE_CORRECTION;
                 D2P_ANGLE_CORRECTION = 0;   //discard the value
             #else
@@ -315,6 +327,11 @@ void VisionConstants::loadFromFile(std::string filename)
         else if(name.compare("MIN_TRANSITIONS_FOR_SIGNIFICANCE_BALL") == 0) {
             in >> MIN_TRANSITIONS_FOR_SIGNIFICANCE_BALL;
         }
+        else if(name.compare("IMAGE_SUBSAMPLING") == 0) {
+            unsigned int factor = 0;
+            in >> factor;
+            setSubsampling(factor);
+        }
         else if(name.compare("HORIZONTAL_SCANLINE_SPACING") == 0) {
             in >> HORIZONTAL_SCANLINE_SPACING;
         }
@@ -333,6 +350,15 @@ void VisionConstants::loadFromFile(std::string filename)
         else if(name.compare("GREEN_HORIZON_UPPER_THRESHOLD_MULT") == 0) {
             in >> GREEN_HORIZON_UPPER_THRESHOLD_MULT;
         }
+        else if(name.compare("GREEN_HORIZON_INCREMENTAL") == 0) {
+            in >> GREEN_HORIZON_INCREMENTAL;
+        }
+        else if(name.compare("GREEN_HORIZON_SEARCH_WINDOW") == 0) {
+            in >> GREEN_HORIZON_SEARCH_WINDOW;
+        }
+        else if(name.compare("GREEN_HORIZON_FULL_SCAN_PERIOD") == 0) {
+            in >> GREEN_HORIZON_FULL_SCAN_PERIOD;
+        }
         else if(name.compare("THROWOUT_NARROW_GOALS") == 0) {
             in >> THROWOUT_NARROW_GOALS;
         }
@@ -390,6 +416,12 @@ void VisionConstants::loadFromFile(std::string filename)
         else if(name.compare("RANSAC_MAX_DISTANCE_TO_MERGE") == 0) {
             in >> RANSAC_MAX_DISTANCE_TO_MERGE;
         }
+        else if(name.compare("RANSAC_CONFIDENCE") == 0) {
+            in >> RANSAC_CONFIDENCE;
+        }
+        else if(name.compare("RANSAC_PROGRESSIVE_SAMPLING") == 0) {
+            in >> RANSAC_PROGRESSIVE_SAMPLING;
+        }
         else if(name.compare("GOAL_MAX_OBJECTS") == 0) {
             in >> GOAL_MAX_OBJECTS;
         }
@@ -482,6 +514,12 @@ bool VisionConstants::setParameter(string name, bool val)
     else if(name.compare("BALL_DISTANCE_POSITION_BOTTOM") == 0) {
         BALL_DISTANCE_POSITION_BOTTOM = val;
     }
+    else if(name.compare("GREEN_HORIZON_INCREMENTAL") == 0) {
+        GREEN_HORIZON_INCREMENTAL = val;
+    }
+    else if(name.compare("RANSAC_PROGRESSIVE_SAMPLING") == 0) {
+        RANSAC_PROGRESSIVE_SAMPLING = val;
+    }
     else {
         return false;
     }
@@ -536,9 +574,29 @@ bool VisionConstants::setParameter(string name, int val)
 }
 
 
+/**
+*   @brief Sets the image subsampling factor.
+*   The subsampled image and the detectors reading it only support factors of 1, 2 and 4, any
+*   other factor is reported and IMAGE_SUBSAMPLING is left unchanged.
+*   @param factor The new subsampling factor.
+*   @return Whether the factor was supported.
+*/
+bool VisionConstants::setSubsampling(unsigned int factor)
+{
+    if(factor != 1 && factor != 2 && factor != 4) {
+        errorlog << "VisionConstants::setSubsampling - unsupported IMAGE_SUBSAMPLING: " << factor << ", must be 1, 2 or 4. Keeping " << IMAGE_SUBSAMPLING << endl;
+        return false;
+    }
+    IMAGE_SUBSAMPLING = factor;
+    return true;
+}
+
 bool VisionConstants::setParameter(string name, unsigned int val)
 {
-    if(name.compare("HORIZONTAL_SCANLINE_SPACING") == 0) {
+    if(name.compare("IMAGE_SUBSAMPLING") == 0) {
+        return setSubsampling(val);
+    }
+    else if(name.compare("HORIZONTAL_SCANLINE_SPACING") == 0) {
         HORIZONTAL_SCANLINE_SPACING = val;
     }
     else if(name.compare("VERTICAL_SCANLINE_SPACING") == 0) {
@@ -550,6 +608,12 @@ bool VisionConstants::setParameter(string name, unsigned int val)
     else if(name.compare("GREEN_HORIZON_MIN_GREEN_PIXELS") == 0) {
         GREEN_HORIZON_MIN_GREEN_PIXELS = val;
     }
+    else if(name.compare("GREEN_HORIZON_SEARCH_WINDOW") == 0) {
+        GREEN_HORIZON_SEARCH_WINDOW = val;
+    }
+    else if(name.compare("GREEN_HORIZON_FULL_SCAN_PERIOD") == 0) {
+        GREEN_HORIZON_FULL_SCAN_PERIOD = val;
+    }
     else if(name.compare("SAM_MAX_LINES") == 0) {
         SAM_MAX_LINES = val;
     }
@@ -660,6 +724,9 @@ bool VisionConstants::setParameter(string name, float val)
     else if(name.compare("RANSAC_MAX_DISTANCE_TO_MERGE") == 0) {
         RANSAC_MAX_DISTANCE_TO_MERGE = val;
     }
+    else if(name.compare("RANSAC_CONFIDENCE") == 0) {
+        RANSAC_CONFIDENCE = val;
+    }
     else if(name.compare("GOAL_SDEV_THRESHOLD") == 0) {
         GOAL_SDEV_THRESHOLD = val;
     }
@@ -744,12 +811,16 @@ void VisionConstants::print(ostream& out)
     out << "BALL_WIDTH: " << BALL_WIDTH << std::endl;
     out << "CENTRE_CIRCLE_RADIUS: " << CENTRE_CIRCLE_RADIUS << std::endl;
 
+    out << "IMAGE_SUBSAMPLING: " << IMAGE_SUBSAMPLING << std::endl;
     out << "HORIZONTAL_SCANLINE_SPACING: " << HORIZONTAL_SCANLINE_SPACING << std::endl;
     out << "VERTICAL_SCANLINE_SPACING: " << VERTICAL_SCANLINE_SPACING << std::endl;
     out << "GREEN_HORIZON_SCAN_SPACING: " << GREEN_HORIZON_SCAN_SPACING << std::endl;
     out << "GREEN_HORIZON_MIN_GREEN_PIXELS: " << GREEN_HORIZON_MIN_GREEN_PIXELS << std::endl;
     out << "GREEN_HORIZON_LOWER_THRESHOLD_MULT: " << GREEN_HORIZON_LOWER_THRESHOLD_MULT << std::endl;
     out << "GREEN_HORIZON_UPPER_THRESHOLD_MULT: " << GREEN_HORIZON_UPPER_THRESHOLD_MULT << std::endl;
+    out << "GREEN_HORIZON_INCREMENTAL: " << GREEN_HORIZON_INCREMENTAL << std::endl;
+    out << "GREEN_HORIZON_SEARCH_WINDOW: " << GREEN_HORIZON_SEARCH_WINDOW << std::endl;
+    out << "GREEN_HORIZON_FULL_SCAN_PERIOD: " << GREEN_HORIZON_FULL_SCAN_PERIOD << std::endl;
 
     out << "SAM_MAX_LINES: " << SAM_MAX_LINES << std::endl;
     out << "SAM_SPLIT_DISTANCE: " << SAM_SPLIT_DISTANCE << std::endl;
@@ -765,6 +836,8 @@ void VisionConstants::print(ostream& out)
 
     out << "RANSAC_MAX_ANGLE_DIFF_TO_MERGE: " << RANSAC_MAX_ANGLE_DIFF_TO_MERGE << std::endl;
     out << "RANSAC_MAX_DISTANCE_TO_MERGE: " << RANSAC_MAX_DISTANCE_TO_MERGE << std::endl;
+    out << "RANSAC_CONFIDENCE: " << RANSAC_CONFIDENCE << std::endl;
+    out << "RANSAC_PROGRESSIVE_SAMPLING: " << RANSAC_PROGRESSIVE_SAMPLING << std::endl;
 
 }
 
@@ -86,12 +86,16 @@ public:
     static float CENTRE_CIRCLE_RADIUS;
     
     //! ScanLine options
+    static unsigned int IMAGE_SUBSAMPLING;              //! The image is searched coarse first at this fraction of the resolution, 1 for full resolution.
     static unsigned int HORIZONTAL_SCANLINE_SPACING;    //! The spacing between horizontal scans.
     static unsigned int VERTICAL_SCANLINE_SPACING;      //! The spacing between vertical scans.
     static unsigned int GREEN_HORIZON_SCAN_SPACING;     //! The spacing between scans used to locate the GH.
     static unsigned int GREEN_HORIZON_MIN_GREEN_PIXELS; //! Dave?
     static float GREEN_HORIZON_LOWER_THRESHOLD_MULT;    //! Dave?
     static float GREEN_HORIZON_UPPER_THRESHOLD_MULT;    //! Dave?
+    static bool GREEN_HORIZON_INCREMENTAL;              //! Whether to search near the previous frame's green horizon first.
+    static unsigned int GREEN_HORIZON_SEARCH_WINDOW;    //! The rows either side of the predicted green horizon searched first.
+    static unsigned int GREEN_HORIZON_FULL_SCAN_PERIOD; //! The frames between full green horizon scans when incremental.
 
     //! Split and Merge constants
     //maximum field objects rules
@@ -114,6 +118,8 @@ public:
     //! RANSAC constants
     static float RANSAC_MAX_ANGLE_DIFF_TO_MERGE; //
     static float RANSAC_MAX_DISTANCE_TO_MERGE; //
+    static float RANSAC_CONFIDENCE;             //! The probability of an outlier free sample before RANSAC stops early, 1 always tries every hypothesis.
+    static bool RANSAC_PROGRESSIVE_SAMPLING;    //! Whether field line RANSAC samples the nearest points first.
 
     static void loadFromFile(std::string filename); //! Loads the constants from a file
     static void print(ostream& out);
@@ -123,6 +129,7 @@ public:
     static bool setParameter(string name, unsigned int val);
     static bool setParameter(string name, float val);
     static bool setParameter(string name, DistanceMethod val);
+    static bool setSubsampling(unsigned int factor);    //! Sets IMAGE_SUBSAMPLING, a factor other than 1, 2 or 4 is logged and ignored
 
     static void setFlags(bool val=true);
 
@@ -4,7 +4,7 @@
 
 //#include "Infrastructure/Jobs/JobList.h"
 
-#include "Tools/Profiling/Profiler.h"
+#include "Tools/Profiling/ProfileRecorder.h"
 
 #include "Vision/VisionTools/lookuptable.h"
 #include "Vision/Modules/greenhorizonch.h"
@@ -17,9 +17,117 @@
 #include "Vision/Modules/GoalDetectionAlgorithms/goaldetectorransacedges.h"
 #include "Vision/Modules/GoalDetectionAlgorithms/goaldetectorransaccentres.h"
 
+#include "Vision/GenericAlgorithms/ransac.h"
+
 #include <boost/foreach.hpp>
 #include <limits>
 
+#if VISION_DETECTOR_WORKERS > 0
+    #include "nubotconfig.h"
+#endif
+
+/**
+*   The stages of a frame timed by the ProfileRecorder. A new window of percentiles is started
+*   every VISION_PROFILE_WINDOW frames; a window of 0 keeps the percentiles of every frame, for the
+*   benchmark to report. With VISION_PROFILER_ON the percentiles are also written to
+*   VisionProfiling.txt at the end of each window, and the last few seconds of the stages are
+*   written to VisionTrace.json as a Chrome trace when the controller is destroyed.
+*/
+#ifndef VISION_PROFILE_WINDOW
+    #define VISION_PROFILE_WINDOW 300
+#endif
+
+enum ProfileStage
+{
+    PROFILE_FRAME,
+    PROFILE_UPDATE,
+    PROFILE_GREEN_HORIZON,
+    PROFILE_SCAN_LINES,
+    PROFILE_SEGMENT_FILTER,
+    PROFILE_GOALS,
+    PROFILE_FIELD_POINTS,
+    PROFILE_BALL,
+    PROFILE_OBSTACLES,
+    PROFILE_PUBLISH,
+    PROFILE_DEBUG_PUBLISH,
+    PROFILE_NUM_STAGES
+};
+
+static const char* c_profile_names[PROFILE_NUM_STAGES] = {"Vision", "Update", "GreenHorizonCH", "ScanLines", "SegmentFilter", "Goals",
+                                                          "Field Points", "Ball", "Obstacles", "Publish", "Debug Publish"};
+
+/**
+*   @brief A detection module run as a task in the detector pool.
+*
+*   Detectors only read the blackboard, so they can run in any order and on any thread. Each
+*   task seeds its own thread's RANSAC generator so a frame gives the same result whether the
+*   tasks are run serially or in parallel. Results that must be added to the blackboard are
+*   held by the task and added in the serial order once all tasks have joined.
+*/
+class DetectorTask : public Task
+{
+public:
+    DetectorTask(unsigned int profile_module) : m_profile_module(profile_module), m_seed(1) {}
+
+    void prepare(unsigned int seed) {m_seed = seed;}
+
+    void run()
+    {
+        ProfileScope scope(m_profile_module);
+        RANSAC::seed(m_seed);
+        detect();
+    }
+
+protected:
+    virtual void detect() = 0;
+
+private:
+    unsigned int m_profile_module;
+    unsigned int m_seed;
+};
+
+class GoalDetectionTask : public DetectorTask
+{
+public:
+    GoalDetectionTask(GoalDetector* detector, unsigned int profile_module) : DetectorTask(profile_module), m_detector(detector) {}
+    vector<Goal> goals;
+protected:
+    void detect() {goals = m_detector->run();}
+private:
+    GoalDetector* m_detector;
+};
+
+class FieldPointTask : public DetectorTask
+{
+public:
+    FieldPointTask(const FieldPointDetector* detector, unsigned int profile_module) : DetectorTask(profile_module), m_detector(detector) {}
+protected:
+    // Edit here to change whether centre circles, lines or corners are found
+    //      (note lines cannot be published yet)
+    void detect() {m_detector->run(true, true, true);}
+private:
+    const FieldPointDetector* m_detector;
+};
+
+class BallDetectionTask : public DetectorTask
+{
+public:
+    BallDetectionTask(BallDetector* detector, unsigned int profile_module) : DetectorTask(profile_module), m_detector(detector) {}
+    vector<Ball> balls;
+protected:
+    void detect() {balls = m_detector->run();}
+private:
+    BallDetector* m_detector;
+};
+
+class ObstacleDetectionTask : public DetectorTask
+{
+public:
+    ObstacleDetectionTask(unsigned int profile_module) : DetectorTask(profile_module) {}
+protected:
+    void detect() {ObjectDetectionCH::detectObjects();}
+};
+
 VisionController::VisionController() : m_corner_detector(0.1), m_circle_detector(0.25, 50, 100, 8.0, 3)
 {
     m_data_wrapper = DataWrapper::getInstance();
@@ -32,6 +140,15 @@ VisionController::VisionController() : m_corner_detector(0.1), m_circle_detector
     //requires other detectors
     m_field_point_detector = new FieldPointDetector(m_line_detector_ransac, &m_circle_detector, &m_corner_detector);
 
+    m_frame_count = 0;
+#if VISION_DETECTOR_WORKERS > 0
+    m_detector_pool = new TaskPool("VisionDetectors", VISION_DETECTOR_WORKERS, THREAD_SEETHINK_PRIORITY);
+#else
+    m_detector_pool = 0;
+#endif
+
+    for(unsigned int i=0; i<PROFILE_NUM_STAGES; i++)
+        m_profile_modules.push_back(ProfileRecorder::module(c_profile_names[i]));
 #ifdef VISION_PROFILER_ON
     m_profiling_stream.open("VisionProfiling.txt");
 #endif
@@ -39,9 +156,16 @@ VisionController::VisionController() : m_corner_detector(0.1), m_circle_detector
 
 VisionController::~VisionController()
 {
+#if VISION_DETECTOR_WORKERS > 0
+    delete m_detector_pool;
+#endif
+    ProfileRecorder::collect();
 #ifdef VISION_PROFILER_ON
+    ofstream trace("VisionTrace.json");
+    ProfileRecorder::writeChromeTrace(trace);
     m_profiling_stream.close();
 #endif
+    ProfileRecorder::release();     // the detector workers have been joined, so nothing is recording
     delete m_line_detector_ransac;
     delete m_line_detector_sam;
     delete m_goal_detector_hist;
@@ -50,25 +174,26 @@ VisionController::~VisionController()
 
 int VisionController::runFrame(bool lookForBall, bool lookForGoals, bool lookForFieldPoints, bool lookForObstacles)
 {
-#ifdef VISION_PROFILER_ON
-    Profiler prof("Vision");
-    prof.start();
-#endif
+    uint64_t frame_start = ProfileRecorder::now();
+    uint64_t stage_start = frame_start;
 
     m_data_wrapper = DataWrapper::getInstance();
 #if VISION_CONTROLLER_VERBOSITY > 1
     debug << "VisionController::runFrame()" << endl;
     debug << "\tBegin"
 #endif
+#ifndef NDEBUG
+    //the image should only ever be viewed between grab and publish, never copied
+    unsigned int image_copies = NUImage::getDeepCopyCount();
+#endif
+
     //force blackboard to update from wrapper
     m_blackboard->update();
 #if VISION_CONTROLLER_VERBOSITY > 1
     debug << "\tVisionBlackboard updated" << endl;
 #endif
 
-#ifdef VISION_PROFILER_ON
-    prof.split("Update");
-#endif
+    stage_start = profileStage(PROFILE_UPDATE, stage_start);
 
     //! HORIZON
 
@@ -77,9 +202,7 @@ int VisionController::runFrame(bool lookForBall, bool lookForGoals, bool lookFor
     debug << "\tcalculateHorizon done" << endl;
 #endif
 
-#ifdef VISION_PROFILER_ON
-    prof.split("Green Horizon");
-#endif
+    stage_start = profileStage(PROFILE_GREEN_HORIZON, stage_start);
 
     //! PRE-DETECTION PROCESSING
 
@@ -98,121 +221,127 @@ int VisionController::runFrame(bool lookForBall, bool lookForGoals, bool lookFor
     debug << "\tclassifyVerticalScanLines done" << endl;
 #endif
 
-#ifdef VISION_PROFILER_ON
-    prof.split("Classify Scanlines");
-#endif
+    stage_start = profileStage(PROFILE_SCAN_LINES, stage_start);
 
     m_segment_filter.run();
 #if VISION_CONTROLLER_VERBOSITY > 2
     debug << "\tsegment filter done" << endl;
 #endif
 
-
-#ifdef VISION_PROFILER_ON
-    prof.split("Segment Filters");
-#endif
+    stage_start = profileStage(PROFILE_SEGMENT_FILTER, stage_start);
 
     //! DETECTION MODULES
 
-    if(lookForGoals) {
-//       vector<Goal> hist_goals = m_goal_detector_hist->run();   // histogram method
-        vector<Goal> ransac_goals_edges = m_goal_detector_ransac_edges->run();  //ransac method
-        m_blackboard->addGoals(ransac_goals_edges);
-    }
-    else {
-        #if VISION_CONTROLLER_VERBOSITY > 2
-            debug << "\tnot looking for goals" << endl;
-        #endif
-    }
+    // the detectors only read what has been found so far, so they are run together and
+    // joined before anything is published
+    GoalDetectionTask goal_task(m_goal_detector_ransac_edges, m_profile_modules[PROFILE_GOALS]);    //ransac method
+    FieldPointTask field_point_task(m_field_point_detector, m_profile_modules[PROFILE_FIELD_POINTS]);
+    BallDetectionTask ball_task(&m_ball_detector, m_profile_modules[PROFILE_BALL]);
+    ObstacleDetectionTask obstacle_task(m_profile_modules[PROFILE_OBSTACLES]);
+    vector<DetectorTask*> tasks;
 
-    #ifdef VISION_PROFILER_ON
-    prof.split("Goals");
+    if(lookForGoals)
+        tasks.push_back(&goal_task);
+    #if VISION_CONTROLLER_VERBOSITY > 2
+    else
+        debug << "\tnot looking for goals" << endl;
     #endif
 
+    if(lookForFieldPoints)
+        tasks.push_back(&field_point_task);
     #if VISION_CONTROLLER_VERBOSITY > 2
-    debug << "\tgoal detection done" << endl;
+    else
+        debug << "\tnot looking for lines, corners or the centre circle" << endl;
     #endif
 
-    if(lookForFieldPoints) {
-        // Edit here to change whether centre circles, lines or corners are found
-        //      (note lines cannot be published yet)
-        m_field_point_detector->run(true, true, true);
-    }
-    else {
-        #if VISION_CONTROLLER_VERBOSITY > 2
-            debug << "\tnot looking for lines, corners or the centre circle" << endl;
-        #endif
-    }
-
-    #ifdef VISION_PROFILER_ON
-    prof.split("Field Points");
+    if(lookForBall)
+        tasks.push_back(&ball_task);
+    #if VISION_CONTROLLER_VERBOSITY > 2
+    else
+        debug << "\tnot looking for ball" << endl;
     #endif
 
+    if(lookForObstacles)
+        tasks.push_back(&obstacle_task);
     #if VISION_CONTROLLER_VERBOSITY > 2
-        debug << "\tcentre circle, line and corner detection done" << endl;
+    else
+        debug << "\tnot looking for obstacles" << endl;
     #endif
 
-    //find balls and publish to BB
-    if(lookForBall) {
-        m_blackboard->addBalls(m_ball_detector.run());
-        #if VISION_CONTROLLER_VERBOSITY > 2
-            debug << "\tball detection done" << endl;
-        #endif
-        #ifdef VISION_PROFILER_ON
-        prof.split("Ball");
-        #endif
-    }
-    else {
-        #if VISION_CONTROLLER_VERBOSITY > 2
-            debug << "\tnot looking for ball" << endl;
-        #endif
-    }
+    for(unsigned int i=0; i<tasks.size(); i++)
+        tasks[i]->prepare(m_frame_count*tasks.size() + i + 1);
 
-    //OBSTACLES
-    if(lookForObstacles)
-    {
-        ObjectDetectionCH::detectObjects();
-        #if VISION_CONTROLLER_VERBOSITY > 2
-        debug << "\tdetectObjects done" << endl;
-        #endif
+    if(m_detector_pool) {
+        BOOST_FOREACH(DetectorTask* task, tasks) {
+            m_detector_pool->add(task);
+        }
+        m_detector_pool->waitForAll();
     }
-    else
-    {
-        #if VISION_CONTROLLER_VERBOSITY > 2
-        debug << "\tnot looking for obstacles" << endl;
-        #endif
+    else {
+        BOOST_FOREACH(DetectorTask* task, tasks) {
+            task->run();
+        }
     }
+    m_frame_count++;
 
+    //results are added in the order the detectors were originally run
+    if(lookForGoals)
+        m_blackboard->addGoals(goal_task.goals);
+    if(lookForBall)
+        m_blackboard->addBalls(ball_task.balls);
 
-    #ifdef VISION_PROFILER_ON
-    prof.split("Obstacles");
+    #if VISION_CONTROLLER_VERBOSITY > 2
+    debug << "\tgoal, field point, ball and obstacle detection done" << endl;
     #endif
 
     // publishing
     //force blackboard to publish results through wrapper
+    stage_start = ProfileRecorder::now();
     m_blackboard->publish();
+    stage_start = profileStage(PROFILE_PUBLISH, stage_start);
     #if VISION_CONTROLLER_VERBOSITY > 1
     debug << "\tResults published" << endl;
     #endif
 
-    #ifdef VISION_PROFILER_ON
-    prof.split("Publishing");
+    #ifndef NDEBUG
+    if(NUImage::getDeepCopyCount() != image_copies) {
+        errorlog << "VisionController::runFrame() - WARNING - " << NUImage::getDeepCopyCount() - image_copies << " full image copies made this frame." << endl;
+    }
     #endif
 
     //publish debug information as well
 
+    stage_start = ProfileRecorder::now();
     m_blackboard->debugPublish();   //only debug publish if some verbosity is on
+    stage_start = profileStage(PROFILE_DEBUG_PUBLISH, stage_start);
+    m_blackboard->releaseImage();
 
     #if VISION_CONTROLLER_VERBOSITY > 1
     debug << "\tDebugging info published" << endl;
     debug << "\tFinish" << endl;
     #endif
 
+    ProfileRecorder::record(m_profile_modules[PROFILE_FRAME], frame_start, stage_start);
+    ProfileRecorder::collect();
+#if VISION_PROFILE_WINDOW > 0
+    if(m_frame_count % VISION_PROFILE_WINDOW == 0) {
     #ifdef VISION_PROFILER_ON
-    prof.split("Debug publishing");
-    prof.stop();
-    m_profiling_stream << prof << endl;
+        m_profiling_stream << ProfileRecorder::summary() << flush;
     #endif
+        ProfileRecorder::roll();
+    }
+#endif
 
     return 0;
 }
+
+/**
+*   @brief Records a stage of the frame that started at start and finished now.
+*   @return The time the stage finished, which is the start of the next stage.
+*/
+uint64_t VisionController::profileStage(unsigned int stage, uint64_t start)
+{
+    uint64_t end = ProfileRecorder::now();
+    ProfileRecorder::record(m_profile_modules[stage], start, end);
+    return end;
+}
@@ -21,6 +21,23 @@
 #include "Vision/Modules/goaldetector.h"
 #include "Vision/Modules/balldetector.h"
 #include "debugverbosityvision.h"
+#include "Tools/Threading/TaskPool.h"
+
+#include <fstream>
+
+/**
+*   The number of worker threads the detection modules are spread over, the thread running
+*   the frame always runs tasks as well. The DataWrapper debug output on the PC, NUView and
+*   training targets is not thread safe, so those run the detectors one after another. The
+*   benchmark does as well, so that it does not depend on the robot's thread configuration.
+*/
+#ifndef VISION_DETECTOR_WORKERS
+    #if (defined TARGET_IS_PC || defined TARGET_IS_NUVIEW || defined TARGET_IS_TRAINING || defined TARGET_IS_RPI || defined TARGET_IS_BENCHMARK)
+        #define VISION_DETECTOR_WORKERS 0
+    #else
+        #define VISION_DETECTOR_WORKERS 1
+    #endif
+#endif
 
 class VisionController
 {
@@ -34,6 +51,8 @@ public:
     int runFrame(bool lookForBall, bool lookForGoals, bool lookForFieldPoints, bool lookForObstacles);
 
 private:
+    uint64_t profileStage(unsigned int stage, uint64_t start);
+
 //! VARIABLES
     DataWrapper* m_data_wrapper;               //! @variable Reference to singleton Wrapper for vision system
     VisionBlackboard* m_blackboard;     //! @variable Reference to singleton Blackboard for vision system
@@ -51,9 +70,12 @@ private:
     CornerDetector m_corner_detector;
     CircleDetector m_circle_detector;
 
+    TaskPool* m_detector_pool;          //! @variable Workers the detection modules run on, null if they run serially
+    unsigned int m_frame_count;         //! @variable Number of frames run, used to seed the RANSAC generators
 
+    vector<unsigned int> m_profile_modules; //! @variable ProfileRecorder ids of the stages of a frame
 #ifdef VISION_PROFILER_ON
-    ofstream m_profiling_stream;
+    ofstream m_profiling_stream;        //! @variable Stream the profile summary is written to every window
 #endif
 };
 
@@ -31,7 +31,8 @@ HEADERS += \
     ../Vision/Debug/debug.h \
     ../Vision/Debug/nubotdataconfig.h \
     ../Vision/Debug/debugverbositynusensors.h \
-    ../Vision/Debug/debugverbositynuactionators.h
+    ../Vision/Debug/debugverbositynuactionators.h \
+    ../Vision/Debug/debugverbositythreading.h
 
 SOURCES += \
     ../Vision/VisionTools/pccamera.cpp \
@@ -49,6 +50,11 @@ HEADERS += \
     ../Vision/VisionTools/classificationcolours.h \
     ../Vision/VisionTools/GTAssert.h \
     ../Vision/VisionTools/lookuptable.h \
+    ../Vision/VisionTools/compressedlut.h \
+    ../Vision/VisionTools/scanlineclassifier.h \
+    ../Vision/VisionTools/subsampledimage.h \
+    ../Vision/VisionTools/framearena.h \
+    ../Vision/VisionTools/imageclassifier.h \
     ../Vision/Modules/*.h \
     ../Vision/Modules/LineDetectionAlgorithms/*.h \
     ../Vision/Modules/GoalDetectionAlgorithms/*.h \
@@ -62,6 +68,11 @@ SOURCES += \
     ../Vision/VisionTypes/VisionFieldObjects/*.cpp \
     ../Vision/VisionTypes/RANSACTypes/*.cpp \
     ../Vision/VisionTools/lookuptable.cpp \
+    ../Vision/VisionTools/compressedlut.cpp \
+    ../Vision/VisionTools/scanlineclassifier.cpp \
+    ../Vision/VisionTools/subsampledimage.cpp \
+    ../Vision/VisionTools/framearena.cpp \
+    ../Vision/VisionTools/imageclassifier.cpp \
     ../Vision/Modules/*.cpp \
     ../Vision/Modules/LineDetectionAlgorithms/*.cpp \
     ../Vision/Modules/GoalDetectionAlgorithms/*.cpp \
@@ -75,11 +86,15 @@ SOURCES += \
 ##robocup
 HEADERS += \
     ../Tools/FileFormats/LUTTools.h \
+    ../Tools/FileFormats/SensorLogFormat.h \
     ../Tools/Optimisation/Parameter.h \
     ../Tools/Math/Line.h \
     ../Tools/Math/LSFittedLine.h \
     ../Tools/Math/Matrix.h \
     ../Tools/Math/TransformMatrices.h \
+    ../Tools/Profiling/ProfileRecorder.h \
+    ../Tools/Threading/Thread.h \
+    ../Tools/Threading/TaskPool.h \
     ../Tools/Math/Vector2.h \
     ../Tools/Math/Vector3.h \
     ../Tools/Math/General.h \
@@ -89,6 +104,7 @@ HEADERS += \
     ../Tools/Optimisation/PSOOptimiser.h \
     ../Tools/Optimisation/PGAOptimiser.h \
     ../Infrastructure/NUImage/NUImage.h \
+    ../Infrastructure/NUImage/NUImageView.h \
     ../NUPlatform/NUCamera/CameraSettings.h \
     ../NUPlatform/NUCamera/NUCameraData.h \
     ../Kinematics/Horizon.h \
@@ -99,6 +115,7 @@ HEADERS += \
     ../Infrastructure/FieldObjects/StationaryObject.h \
     ../Infrastructure/NUSensorsData/NUSensorsData.h \
     ../Infrastructure/NUSensorsData/Sensor.h \
+    ../Infrastructure/NUSensorsData/SensorFrame.h \
     ../Infrastructure/NUSensorsData/NULocalisationSensors.h \
     ../Infrastructure/NUData.h \
     ../Tools/FileFormats/TimestampedData.h \
@@ -108,11 +125,15 @@ HEADERS += \
 
 SOURCES += \
     ../Tools/FileFormats/LUTTools.cpp \
+    ../Tools/FileFormats/SensorLogFormat.cpp \
     ../Tools/Optimisation/Parameter.cpp \
     ../Tools/Math/Line.cpp \
     ../Tools/Math/LSFittedLine.cpp \
     ../Tools/Math/Matrix.cpp \
     ../Tools/Math/TransformMatrices.cpp \
+    ../Tools/Profiling/ProfileRecorder.cpp \
+    ../Tools/Threading/Thread.cpp \
+    ../Tools/Threading/TaskPool.cpp \
     ../Tools/Optimisation/Optimiser.cpp \
     ../Tools/Optimisation/EHCLSOptimiser.cpp \
     ../Tools/Optimisation/PGRLOptimiser.cpp \
@@ -129,6 +150,7 @@ SOURCES += \
     ../Infrastructure/FieldObjects/StationaryObject.cpp \
     ../Infrastructure/NUSensorsData/NUSensorsData.cpp \
     ../Infrastructure/NUSensorsData/Sensor.cpp \
+    ../Infrastructure/NUSensorsData/SensorFrame.cpp \
     ../Infrastructure/NUSensorsData/NULocalisationSensors.cpp \
     ../Infrastructure/NUData.cpp \
     ../Kinematics/Kinematics.cpp \
@@ -2,6 +2,7 @@
 #include "ui_labeleditor.h"
 #include <QMessageBox>
 #include <QInputDialog>
+#include <QThread>
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/NUImage/ColorModelConversions.h"
 #include "Tools/Math/General.h"
@@ -9,7 +10,8 @@
 
 LabelEditor::LabelEditor(QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::LabelEditor)
+    ui(new Ui::LabelEditor),
+    m_image_classifier(QThread::idealThreadCount() > 1 ? QThread::idealThreadCount() - 1 : 0)
 {
     ui->setupUi(this);
     m_halted = m_image_updated = false;
@@ -148,21 +150,13 @@ void LabelEditor::display(const NUImage& frame, const LookUpTable& lut)
     //generate images
     int w = frame.getWidth();
     int h = frame.getHeight();
-    unsigned char r, g, b;
     QImage plain(w, h, QImage::Format_RGB888);
-    QImage classified(w, h, QImage::Format_RGB888);
+    QImage classified(w, h, QImage::Format_RGB32);
 
     renderFrame(frame, plain, m_ground_truth); //render the frame, along with current labels
 
-    //classify the image
-    for(int y = 0; y < h; y++)
-    {
-        for(int x = 0; x < w; x++)
-        {
-            Vision::getColourAsRGB(lut.classifyPixel(frame(x,y)), r, g, b);
-            classified.setPixel(x, y, qRgb(r, g, b));
-        }
-    }
+    //classify the image, 32 bit scanlines are contiguous so it is written in one go
+    m_image_classifier.classify(lut, frame, reinterpret_cast<unsigned int*>(classified.bits()), ImageClassifier::RGB32);
 
     //clear old display
     if(!m_plain_scene.items().empty())
@@ -10,6 +10,7 @@
 #include <QGraphicsPixmapItem>
 #include <vector>
 #include "Vision/VisionWrapper/visioncontrolwrappertraining.h"
+#include "Vision/VisionTools/imageclassifier.h"
 
 using namespace std;
 using namespace Vision;
@@ -66,6 +67,8 @@ private:
     bool m_halted,          //! @var Whether the user has halted the labelling.
          m_image_updated,   //! @var Whether the image needs to be re-rendered.
          m_next;            //! @var Whether to progress to the next image.
+
+    ImageClassifier m_image_classifier;     //! @var Classifies the displayed images.
 };
 
 #endif // LABELEDITOR_H
@@ -4,10 +4,12 @@
 #include "Vision/visionconstants.h"
 #include <QMessageBox>
 #include <QInputDialog>
+#include <QThread>
 
 VisionComparitor::VisionComparitor(QWidget *parent) :
     QMainWindow(parent),
-    ui(new Ui::VisionComparitor)
+    ui(new Ui::VisionComparitor),
+    m_image_classifier(QThread::idealThreadCount() > 1 ? QThread::idealThreadCount() - 1 : 0)
 {
     ui->setupUi(this);
 
@@ -110,15 +112,9 @@ void VisionComparitor::run(string image_name, string sensor_name, string lut_nam
         vision->renderFrame(img1, lines_only);
 
         //classify the image
-        unsigned char r, g, b;
-        for(int y = 0; y < m_frames[m_frame_no].first.getHeight(); y++)
-        {
-            for(int x = 0; x < m_frames[m_frame_no].first.getWidth(); x++)
-            {
-                Vision::getColourAsRGB(lut.classifyPixel(m_frames[m_frame_no].first(x,y)), r, g, b);
-                img_c.setPixel(x, y, qRgb(r, g, b));
-            }
-        }
+        const NUImage& frame = m_frames[m_frame_no].first;
+        img_c = QImage(frame.getWidth(), frame.getHeight(), QImage::Format_RGB32);
+        m_image_classifier.classify(lut, frame, reinterpret_cast<unsigned int*>(img_c.bits()), ImageClassifier::RGB32);
 
         //display the rendered images
         display(img0, img1, img_c);
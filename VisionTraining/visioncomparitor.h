@@ -6,6 +6,7 @@
 #include <QGraphicsPixmapItem>
 #include "Infrastructure/NUImage/NUImage.h"
 #include "Infrastructure/NUSensorsData/NUSensorsData.h"
+#include "Vision/VisionTools/imageclassifier.h"
 
 namespace Ui {
 class VisionComparitor;
@@ -42,6 +43,8 @@ private:
     bool m_halted,              //! @var Flag for user selecting to exit
          m_next,                //! @var Flag for user selecting to go to next frame
          m_prev;                //! @var Flag for user selecting to go to prev frame
+
+    ImageClassifier m_image_classifier; //! @var Classifies the displayed images
 };
 
 #endif // VISIONCOMPARITOR_H